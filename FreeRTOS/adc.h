@@ -1,7 +1,7 @@
-/* 
+/*
  * File:   ADC.h
  * Author: Ali
- * 
+ *
  * Created on October 29, 2025, 12:42 PM
  */
 
@@ -10,17 +10,51 @@
 
 #include <xc.h>
 #include <stdint.h>
+#include <stdbool.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "hw_config.h"
+#include "winagg.h"
+#include "pingpong.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-uint16_t do_ADC(void);   // Function prototype
-void init_ADC(void);
+/* One completed scan, published by the end-of-scan interrupt */
+typedef struct {
+    TickType_t timestamp;               /* Tick count at end of scan */
+    uint16_t sequence;                  /* Incremented every scan */
+    uint16_t value[ADC_SCAN_COUNT];     /* Results, in ADC_SCAN_LIST order */
+} AdcScanVector_t;
+
+uint16_t do_ADC(void);   // Latest potentiometer sample (does not block)
+void init_ADC(void);     // Configure and start the background scan
 
 /* Additional function for percentage conversion */
 uint8_t ADC_ToPercent(uint16_t adc_value);
 
+/* Copy the most recent scan vector. Returns false before the first scan. */
+bool ADC_GetScan(AdcScanVector_t *out);
+
+/* Notify task only when the pot moves more than half_width counts from
+ * the last reported value (software window compare in the scan ISR) */
+void ADC_PotWatch(TaskHandle_t task, uint16_t half_width);
+
+/* Feed every pot sample to agg (the scan ISR is its producer). Up to two
+ * aggregators; returns false if both slots are taken. */
+bool ADC_PotAggregate(WinAgg_t *agg);
+
+/* Copy every scan vector into pp's producer half and swap it to the
+ * consumer once it holds scans vectors (pingpong.h); the halves must be
+ * AdcScanVector_t arrays. A partly filled half is dropped when this is
+ * called again; NULL stops. */
+void ADC_ScanBlocks(PingPong_t *pp, uint8_t scans);
+
+/* AVdd in millivolts, derived from the band gap reading in a scan
+ * (0 if the band gap read 0) */
+uint16_t ADC_SupplyMillivolts(const AdcScanVector_t *scan);
+
 #ifdef __cplusplus
 }
 #endif
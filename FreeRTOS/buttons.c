@@ -10,33 +10,44 @@
  * 
  * Debouncing Algorithm:
  *   - Sample button at regular intervals (~10ms)
- *   - Only change debounced state after DEBOUNCE_COUNT consistent readings
+ *   - Only change debounced state after DEBOUNCE_MS of consistent readings
  *   - This filters out mechanical bounce noise
  * 
  * Event Detection:
  *   - Click: Button pressed then released (short press)
  *   - Long Press: Button held for > LONG_PRESS_THRESHOLD_MS
  * 
+ * Wake on press:
+ *   - Falling-edge interrupt-on-change on all three pins, enabled only
+ *     while the task is parked in Buttons_ArmWake(). The first edge
+ *     disarms it; the debouncer then runs from the next poll as usual.
+ * 
  * Created on Nov 2025
  */
 
 #include "buttons.h"
 #include "hw_config.h"
 #include "app.h"
+#include "appcfg.h"
+#include <xc.h>
 
 /*============================================================================
  * CONFIGURATION CONSTANTS
  *============================================================================*/
 
-/* Number of consistent readings required for debounce (at 10ms update rate) */
-#define DEBOUNCE_COUNT          5       /* 50ms debounce time */
-
-/* Long press threshold in milliseconds */
-#define LONG_PRESS_THRESHOLD_MS 1000
+/* Debounce time and long press threshold in milliseconds, read in place
+ * from the configuration image (BUTTON_DEBOUNCE_MS and BUTTON_LONG_PRESS_MS
+ * in hw_config.h by default) */
+#define DEBOUNCE_MS             (AppCfg_Get()->button_debounce_ms)
+#define LONG_PRESS_THRESHOLD_MS (AppCfg_Get()->button_long_press_ms)
 
 /* Time window for detecting simultaneous button press (ms) */
 #define COMBO_WINDOW_MS         200
 
+/* Interrupt-on-change priority; the ISR notifies a task, so not above the
+ * kernel */
+#define BUTTONS_WAKE_IPL        configKERNEL_INTERRUPT_PRIORITY
+
 /*============================================================================
  * STATIC VARIABLES
  *============================================================================*/
@@ -53,6 +64,9 @@ static uint16_t pb2_pb3_combo_duration = 0;
 static bool pb2_was_pressed_in_combo = false;
 static bool pb3_was_pressed_in_combo = false;
 
+/* Task notified by the next press */
+static TaskHandle_t buttons_wake_task = NULL;
+
 /*============================================================================
  * STATIC HELPER FUNCTIONS
  *============================================================================*/
@@ -74,11 +88,11 @@ static void UpdateButtonState(ButtonState_t *state, bool raw_reading, uint16_t e
         /* Reading matches current state, reset debounce counter */
         state->debounce_counter = 0;
     } else {
-        /* Reading differs, increment debounce counter */
-        state->debounce_counter++;
+        /* Reading differs, accumulate time in the new state */
+        state->debounce_counter += elapsed_ms;
         
-        /* Check if we've had enough consistent different readings */
-        if (state->debounce_counter >= DEBOUNCE_COUNT) {
+        /* Check if the new state has held long enough */
+        if (state->debounce_counter >= DEBOUNCE_MS) {
             /* State change confirmed */
             state->last_state = state->current_state;
             state->current_state = raw_reading;
@@ -123,6 +137,40 @@ static bool CheckLongPress(ButtonState_t *state)
     return false;
 }
 
+static void ClearWakeFlags(void)
+{
+    IOCFBbits.IOCFB8 = 0;
+    IOCFBbits.IOCFB9 = 0;
+    IOCFAbits.IOCFA4 = 0;
+    IFS1bits.IOCIF = 0;
+}
+
+static bool ButtonIdle(const ButtonState_t *state)
+{
+    return !state->current_state && state->debounce_counter == 0 &&
+           !state->click_pending;
+}
+
+/*============================================================================
+ * INTERRUPT-ON-CHANGE ISR
+ * 
+ * One edge is enough - disarm and hand the button back to polling.
+ *============================================================================*/
+
+void __attribute__((interrupt, no_auto_psv)) _IOCInterrupt(void)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    
+    IEC1bits.IOCIE = 0;
+    ClearWakeFlags();
+    
+    if (buttons_wake_task != NULL) {
+        vTaskNotifyGiveFromISR(buttons_wake_task, &xHigherPriorityTaskWoken);
+    }
+    
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
 /*============================================================================
  * PUBLIC FUNCTION IMPLEMENTATIONS
  *============================================================================*/
@@ -134,9 +182,8 @@ void Buttons_Init(void)
     PB2_Init();
     PB3_Init();
     
-    /* Small delay to let pull-ups stabilize */
-    volatile uint16_t i;
-    for (i = 0; i < 1000; i++) { }
+    /* No settle delay: HW_InitAllPins() enabled the pull-ups before the
+     * scheduler started, long before the button task gets here */
     
     /* Initialize button state structures with ACTUAL current state */
     /* This prevents false triggers at startup */
@@ -170,6 +217,15 @@ void Buttons_Init(void)
     pb2_pb3_combo_duration = 0;
     pb2_was_pressed_in_combo = false;
     pb3_was_pressed_in_combo = false;
+    
+    /* Falling edges (press) on the three pins, left disarmed until needed */
+    IEC1bits.IOCIE = 0;
+    IOCNBbits.IOCNB8 = 1;
+    IOCNBbits.IOCNB9 = 1;
+    IOCNAbits.IOCNA4 = 1;
+    PADCONbits.IOCON = 1;
+    IPC4bits.IOCIP = BUTTONS_WAKE_IPL;
+    ClearWakeFlags();
 }
 
 void Buttons_Update(uint16_t elapsed_ms)
@@ -378,3 +434,23 @@ bool Buttons_SendPendingEvents(void)
     return false;
 }
 
+bool Buttons_Idle(void)
+{
+    return ButtonIdle(&pb1_state) && ButtonIdle(&pb2_state) &&
+           ButtonIdle(&pb3_state) && !pb2_pb3_combo_click_pending &&
+           !pb2_was_pressed_in_combo && !pb3_was_pressed_in_combo;
+}
+
+bool Buttons_ArmWake(TaskHandle_t task)
+{
+    buttons_wake_task = task;
+    ClearWakeFlags();
+    IEC1bits.IOCIE = 1;
+    
+    /* A press before the flags were cleared left no edge to catch */
+    if (PB1_Read() || PB2_Read() || PB3_Read()) {
+        IEC1bits.IOCIE = 0;
+        return false;
+    }
+    return true;
+}
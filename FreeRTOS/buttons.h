@@ -7,6 +7,8 @@
  * Description: Provides button initialization, debouncing, and event detection.
  *              Supports short click and long press detection.
  *              Uses polling-based approach integrated with FreeRTOS task.
+ *              While nothing is pressed the task stops polling and waits
+ *              for an interrupt-on-change wake instead.
  * 
  * Created on Nov 2025
  */
@@ -28,7 +30,7 @@ typedef struct {
     bool current_state;         /* Current debounced state (true = pressed) */
     bool last_state;            /* Previous debounced state */
     bool raw_state;             /* Raw reading from GPIO */
-    uint16_t debounce_counter;  /* Debounce timing counter */
+    uint16_t debounce_counter;  /* Time the raw reading has differed (ms) */
     uint16_t press_duration;    /* How long button has been held (ms) */
     bool click_pending;         /* Click event waiting to be sent */
     bool long_press_sent;       /* Long press already sent for this press */
@@ -144,5 +146,24 @@ void Buttons_ClearEvents(void);
  */
 bool Buttons_SendPendingEvents(void);
 
+/**
+ * @brief Check if polling can stop
+ * 
+ * @return true if no button is held or bouncing and no event is waiting
+ */
+bool Buttons_Idle(void);
+
+/**
+ * @brief Notify a task on the next press of any button
+ * 
+ * Arms interrupt-on-change for a falling edge on PB1, PB2 and PB3. The
+ * ISR disarms it again and gives the task a notification. IOC needs no
+ * clock, so the press also wakes the CPU from Sleep.
+ * 
+ * @param task Task to notify
+ * @return false if a button is already down (keep polling instead)
+ */
+bool Buttons_ArmWake(TaskHandle_t task);
+
 #endif /* BUTTONS_H */
 
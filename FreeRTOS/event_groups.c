@@ -666,8 +666,8 @@
             {
                 /* Unblock the task, returning 0 as the event list is being deleted
                  * and cannot therefore have any bits set. */
-                configASSERT( pxTasksWaitingForBits->xListEnd.pxNext != ( const ListItem_t * ) &( pxTasksWaitingForBits->xListEnd ) );
-                vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
+                configASSERT( listGET_HEAD_ENTRY( pxTasksWaitingForBits ) != listGET_END_MARKER( pxTasksWaitingForBits ) );
+                vTaskRemoveFromUnorderedEventList( listGET_HEAD_ENTRY( pxTasksWaitingForBits ), eventUNBLOCKED_DUE_TO_BIT_SET );
             }
         }
         ( void ) xTaskResumeAll();
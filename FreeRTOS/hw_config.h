@@ -23,35 +23,68 @@
  * LED1 - Blinks during countdown (1s on/1s off)
  * LED2 - Variable brightness LED controlled by potentiometer (software PWM)
  * 
+ * LED writes go through the framebuffer in ledfb.c: each macro updates a
+ * shadow word and commits it to LATB. Use LedFb_Write(), or LedFb_Update()
+ * calls closed by LedFb_Commit(), to change several LEDs in one port write.
+ * 
  * Modify these macros to match your hardware pin connections.
  *============================================================================*/
 
+/* Pin numbers on PORTB - LEDn_MASK and LEDFB_MASK are derived from these.
+ * All LEDs must be on PORTB; ledfb.c commits them with one LATB write. */
+#define LED0_BIT        5
+#define LED1_BIT        6
+#define LED2_BIT        7
+
+#define LED0_MASK       (1u << LED0_BIT)
+#define LED1_MASK       (1u << LED1_BIT)
+#define LED2_MASK       (1u << LED2_BIT)
+
+#define LEDFB_LAT       LATB
+#define LEDFB_MASK      (LED0_MASK | LED1_MASK | LED2_MASK)
+
+#if (LED0_BIT > 15) || (LED1_BIT > 15) || (LED2_BIT > 15)
+#error LED pins must be RB0-RB15: ledfb.c commits them with one LATB write
+#endif
+#if (LED0_BIT == LED1_BIT) || (LED0_BIT == LED2_BIT) || (LED1_BIT == LED2_BIT)
+#error Each LED needs its own PORTB pin
+#endif
+
+/* PORTB bitfields by pin number, so LEDn_TRIS/LAT/PORT follow LEDn_BIT */
+#define RB_TRIS(bit)    RB_TRIS_(bit)
+#define RB_TRIS_(bit)   TRISBbits.TRISB##bit
+#define RB_LAT(bit)     RB_LAT_(bit)
+#define RB_LAT_(bit)    LATBbits.LATB##bit
+#define RB_PORT(bit)    RB_PORT_(bit)
+#define RB_PORT_(bit)   PORTBbits.RB##bit
+
 /* LED0 - Completion indicator LED (RB5) */
-#define LED0_TRIS       TRISBbits.TRISB5    /* Data direction register */
-#define LED0_LAT        LATBbits.LATB5      /* Latch register for output */
-#define LED0_PORT       PORTBbits.RB5       /* Port register for reading */
-#define LED0_Init()     do { LED0_TRIS = 0; LED0_LAT = 0; } while(0)
-#define LED0_On()       (LED0_LAT = 1)
-#define LED0_Off()      (LED0_LAT = 0)
-#define LED0_Toggle()   (LED0_LAT ^= 1)
+#define LED0_TRIS       RB_TRIS(LED0_BIT)   /* Data direction register */
+#define LED0_LAT        RB_LAT(LED0_BIT)    /* Latch register for output */
+#define LED0_PORT       RB_PORT(LED0_BIT)   /* Port register for reading */
+#define LED0_Init()     do { LED0_TRIS = 0; LED0_Off(); } while(0)
+#define LED0_On()       LedFb_Write(LED0_MASK, 0)
+#define LED0_Off()      LedFb_Write(0, LED0_MASK)
+#define LED0_Toggle()   LedFb_Toggle(LED0_MASK)
 
 /* LED1 - Countdown blink LED (RB6) */
-#define LED1_TRIS       TRISBbits.TRISB6
-#define LED1_LAT        LATBbits.LATB6
-#define LED1_PORT       PORTBbits.RB6
-#define LED1_Init()     do { LED1_TRIS = 0; LED1_LAT = 0; } while(0)
-#define LED1_On()       (LED1_LAT = 1)
-#define LED1_Off()      (LED1_LAT = 0)
-#define LED1_Toggle()   (LED1_LAT ^= 1)
+#define LED1_TRIS       RB_TRIS(LED1_BIT)
+#define LED1_LAT        RB_LAT(LED1_BIT)
+#define LED1_PORT       RB_PORT(LED1_BIT)
+#define LED1_Init()     do { LED1_TRIS = 0; LED1_Off(); } while(0)
+#define LED1_On()       LedFb_Write(LED1_MASK, 0)
+#define LED1_Off()      LedFb_Write(0, LED1_MASK)
+#define LED1_Toggle()   LedFb_Toggle(LED1_MASK)
 
 /* LED2 - PWM controlled brightness LED (RB7) */
-#define LED2_TRIS       TRISBbits.TRISB7
-#define LED2_LAT        LATBbits.LATB7
-#define LED2_PORT       PORTBbits.RB7
-#define LED2_Init()     do { LED2_TRIS = 0; LED2_LAT = 0; } while(0)
-#define LED2_On()       (LED2_LAT = 1)
-#define LED2_Off()      (LED2_LAT = 0)
-#define LED2_Toggle()   (LED2_LAT ^= 1)
+#define LED2_TRIS       RB_TRIS(LED2_BIT)
+#define LED2_LAT        RB_LAT(LED2_BIT)
+#define LED2_PORT       RB_PORT(LED2_BIT)
+#define LED2_Init()     do { LED2_TRIS = 0; LED2_Off(); } while(0)
+#define LED2_On()       LedFb_Write(LED2_MASK, 0)
+#define LED2_Off()      LedFb_Write(0, LED2_MASK)
+#define LED2_Toggle()   LedFb_Toggle(LED2_MASK)
+#define LED2_IsOn()     ((LedFb_Get() & LED2_MASK) != 0)
 
 /* Alias for LED0 (backwards compatibility with original demo code) */
 #define LED_DEMO_TRIS   LED0_TRIS
@@ -111,10 +144,66 @@
 #define ADC_MAX_VALUE       1023            /* 10-bit ADC maximum */
 #define ADC_Init_Pin()      do { ADC_POT_TRIS = 1; ADC_POT_ANSEL = 1; } while(0)
 
+/* Internal ADC inputs (CH0SA / AD1CSSH numbering) */
+#define ADC_CH_TEMP_DIODE   26              /* CTMU temperature diode */
+#define ADC_CH_VBG          28              /* Internal band gap reference */
+#define ADC_VBG_MV          1200            /* Nominal band gap voltage */
+
+/* Background scan: channels converted every ADC_SCAN_PERIOD_MS.
+ * List them in ascending order - the sequencer converts in channel order
+ * and results land in the scan vector in that same order. A build may
+ * supply its own list (tests/hw/adc_scan.h does) by defining all five. */
+#ifndef ADC_SCAN_COUNT
+#define ADC_SCAN_LIST       { ADC_POT_CHANNEL, ADC_CH_TEMP_DIODE, ADC_CH_VBG }
+#define ADC_SCAN_COUNT      3
+#define ADC_SCAN_POT_INDEX  0               /* Position of the pot in the list */
+#define ADC_SCAN_TEMP_INDEX 1
+#define ADC_SCAN_VBG_INDEX  2
+#endif
+#define ADC_SCAN_PERIOD_MS  10
+
+/* AVdd below this is logged as TELEM_ERR_LOW_VDD; it must recover past
+ * the hysteresis before another drop is logged */
+#define ADC_LOW_VDD_MV      3000
+#define ADC_LOW_VDD_HYST_MV 100
+
+/* Pot movement (counts either side) that counts as a real change */
+#define ADC_POT_WINDOW      6
+
+/*============================================================================
+ * UART CONFIGURATION
+ * 
+ * UART2 runs with BRGH = 1 (4 clocks per bit): baud = FCY / (4 * (BRG + 1)).
+ * At FCY = 4 MHz the standard rates up to 38400 are within 0.2%; 57600
+ * and 115200 are off by 2-4% and not reliable. 250000, 500000 and 1000000
+ * are exact. 460800 needs an FCY that is a multiple of 1.8432 MHz.
+ * 
+ * With flow control on, the UART hardware stops sending while CTS is high
+ * and drives RTS high while its RX FIFO is full. CTS has a pull-down so
+ * the transmitter still runs when nothing is connected to it.
+ * 
+ * Modify these macros to match your hardware pin connections.
+ *============================================================================*/
+
+#define UART_BAUD_RATE          38400UL
+#define UART_FLOW_CONTROL       1       /* 1 = RTS/CTS, 0 = TX/RX only */
+
+/* Remappable pin (RPn) assignments */
+#define UART_TX_RP              10      /* RB10 */
+#define UART_RX_RP              11      /* RB11 */
+#define UART_RTS_RP             12      /* RB12 */
+#define UART_CTS_RP             13      /* RB13 */
+
+#define UART_RTS_Init_Pin()     do { ANSELBbits.ANSB12 = 0; TRISBbits.TRISB12 = 0; } while(0)
+#define UART_CTS_Init_Pin()     do { ANSELBbits.ANSB13 = 0; TRISBbits.TRISB13 = 1; \
+                                     CNPDBbits.CNPDB13 = 1; } while(0)
+
 /*============================================================================
  * TIMING CONFIGURATION
  * 
- * Timing constants for various system operations.
+ * Timing constants for various system operations. The debounce, long
+ * press, PWM frequency and ADC scan period values here are defaults; a
+ * configuration image in flash can override them (see appcfg.h).
  *============================================================================*/
 
 /* Debounce time for buttons (in milliseconds) */
@@ -126,6 +215,9 @@
 /* Software PWM frequency (Hz) - must be >60Hz to avoid flicker */
 #define PWM_FREQUENCY_HZ        500
 
+/* LED2 fade time when the potentiometer moves (in milliseconds) */
+#define PWM_POT_FADE_MS         150
+
 /* LED pulsing period for waiting state (full cycle in ms) */
 #define PULSE_PERIOD_MS         2000
 
@@ -148,5 +240,8 @@
     ADC_Init_Pin();             \
 } while(0)
 
+/* LED macros above expand to framebuffer calls */
+#include "ledfb.h"
+
 #endif /* HW_CONFIG_H */
 
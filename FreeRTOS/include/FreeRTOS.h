@@ -1302,6 +1302,14 @@
     #define traceRETURN_xQueueReceive( xReturn )
 #endif
 
+#ifndef traceENTER_xQueueReceiveMatching
+    #define traceENTER_xQueueReceiveMatching( xQueue, pvBuffer, pxMatch, pvContext, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xQueueReceiveMatching
+    #define traceRETURN_xQueueReceiveMatching( xReturn )
+#endif
+
 #ifndef traceENTER_xQueueSemaphoreTake
     #define traceENTER_xQueueSemaphoreTake( xQueue, xTicksToWait )
 #endif
@@ -2744,6 +2752,48 @@
     #define configUSE_QUEUE_SETS    0
 #endif
 
+#ifndef configUSE_QUEUE_RECEIVE_MATCHING
+    #define configUSE_QUEUE_RECEIVE_MATCHING    0
+#endif
+
+#ifndef configUSE_QUEUE_FAST_PATH
+    #define configUSE_QUEUE_FAST_PATH    0
+#endif
+
+#if ( ( configUSE_QUEUE_FAST_PATH == 1 ) && ( configUSE_QUEUE_SETS == 1 ) )
+    #error configUSE_QUEUE_FAST_PATH cannot be used with configUSE_QUEUE_SETS
+#endif
+
+#ifndef configUSE_QUEUE_DIRECT_HANDOFF
+    #define configUSE_QUEUE_DIRECT_HANDOFF    0
+#endif
+
+#if ( ( configUSE_QUEUE_DIRECT_HANDOFF == 1 ) && ( configUSE_QUEUE_SETS == 1 ) )
+    #error configUSE_QUEUE_DIRECT_HANDOFF cannot be used with configUSE_QUEUE_SETS
+#endif
+
+#ifndef configUSE_LIST_INDEX8
+    #define configUSE_LIST_INDEX8    0
+#endif
+
+#ifndef configLIST_INDEX8_MAX_OWNERS
+    #define configLIST_INDEX8_MAX_OWNERS    16
+#endif
+
+#ifndef configLIST_INDEX8_MAX_LISTS
+    #define configLIST_INDEX8_MAX_LISTS    32
+#endif
+
+#if ( configUSE_LIST_INDEX8 == 1 )
+    #if ( ( configLIST_INDEX8_MAX_OWNERS > 127 ) || ( configLIST_INDEX8_MAX_LISTS > 255 ) )
+        #error configLIST_INDEX8_MAX_OWNERS must be at most 127 and configLIST_INDEX8_MAX_LISTS at most 255
+    #endif
+
+    #if ( ( configUSE_CO_ROUTINES == 1 ) || ( configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES == 1 ) || ( configNUMBER_OF_CORES > 1 ) )
+        #error configUSE_LIST_INDEX8 cannot be used with co-routines, list integrity check bytes or SMP
+    #endif
+#endif
+
 #ifndef portTASK_USES_FLOATING_POINT
     #define portTASK_USES_FLOATING_POINT()
 #endif
@@ -3106,6 +3156,19 @@
  * real objects are used for this purpose.  The dummy list and list item
  * structures below are used for inclusion in such a dummy structure.
  */
+#if ( configUSE_LIST_INDEX8 == 1 )
+    struct xSTATIC_LIST_ITEM
+    {
+        TickType_t xDummy2;
+        uint8_t ucDummy3[ 4 ];
+    };
+    typedef struct xSTATIC_LIST_ITEM StaticListItem_t;
+
+    typedef struct xSTATIC_LIST
+    {
+        uint8_t ucDummy2[ 4 ];
+    } StaticList_t;
+#else /* if ( configUSE_LIST_INDEX8 == 1 ) */
 struct xSTATIC_LIST_ITEM
 {
     #if ( configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES == 1 )
@@ -3147,6 +3210,7 @@ typedef struct xSTATIC_LIST
         TickType_t xDummy5;
     #endif
 } StaticList_t;
+#endif /* if ( configUSE_LIST_INDEX8 == 1 ) */
 
 /*
  * In line with software engineering best practice, especially when supplying a
@@ -3219,6 +3283,9 @@ typedef struct xSTATIC_TCB
     #if ( configUSE_POSIX_ERRNO == 1 )
         int iDummy22;
     #endif
+    #if ( configUSE_QUEUE_DIRECT_HANDOFF == 1 )
+        void * pvDummy27;
+    #endif
 } StaticTask_t;
 
 /*
@@ -3257,6 +3324,10 @@ typedef struct xSTATIC_QUEUE
         void * pvDummy7;
     #endif
 
+    #if ( configUSE_QUEUE_RECEIVE_MATCHING == 1 )
+        UBaseType_t uxDummy10;
+    #endif
+
     #if ( configUSE_TRACE_FACILITY == 1 )
         UBaseType_t uxDummy8;
         uint8_t ucDummy9;
@@ -137,6 +137,117 @@
 #endif /* configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES */
 
 
+#if ( configUSE_LIST_INDEX8 == 1 )
+
+/*
+ * Lists linked by 8-bit numbers rather than pointers, for parts where a
+ * pointer is as wide as the whole list item it links.  Every list, and every
+ * object that owns list items, is entered once in a table in list.c; a list
+ * item is then named by its owner's number and its place among the owner's
+ * items ( number << 1 | slot ), and a list by its own number.  An owner's
+ * list items must be adjacent members ( xStateListItem then xEventListItem
+ * in the TCB ), and no owner may have more than two.  Table entries are never
+ * given back: a list or owner created again at the same address finds its
+ * old number.
+ *
+ * The list is a ring with no end marker.  ucHead is its first item and
+ * ucIndex the item last returned by listGET_OWNER_OF_NEXT_ENTRY(), or
+ * listINDEX8_NONE where the pointer version would have pxIndex on the end
+ * marker.  The iteration macros return NULL for the end marker.
+ */
+#define listINDEX8_NONE    ( ( uint8_t ) 0xFFU )
+
+struct xLIST;
+struct xLIST_ITEM
+{
+    configLIST_VOLATILE TickType_t xItemValue; /**< The value being listed.  In most cases this is used to sort the list in ascending order. */
+    configLIST_VOLATILE uint8_t ucNext;        /**< Number of the next ListItem_t in the list. */
+    configLIST_VOLATILE uint8_t ucPrevious;    /**< Number of the previous ListItem_t in the list. */
+    configLIST_VOLATILE uint8_t ucContainer;   /**< Number of the list the item is in, listINDEX8_NONE if none. */
+    uint8_t ucSelf;                            /**< The item's own number, set with its owner. */
+};
+typedef struct xLIST_ITEM ListItem_t;
+typedef struct xLIST_ITEM MiniListItem_t;
+
+typedef struct xLIST
+{
+    configLIST_VOLATILE uint8_t ucNumberOfItems;
+    configLIST_VOLATILE uint8_t ucHead;  /**< Number of the first item, listINDEX8_NONE when empty. */
+    configLIST_VOLATILE uint8_t ucIndex; /**< Number of the last item returned by listGET_OWNER_OF_NEXT_ENTRY (). */
+    uint8_t ucSelf;                      /**< The list's own number, set by vListInitialise (). */
+} List_t;
+
+/* The tables the numbers index, filled by vListInitialise () and
+ * listSET_LIST_ITEM_OWNER (). */
+extern void * pvListIndex8Owners[ configLIST_INDEX8_MAX_OWNERS ];
+extern uint8_t ucListIndex8ItemOffsets[ configLIST_INDEX8_MAX_OWNERS ];
+extern List_t * pxListIndex8Lists[ configLIST_INDEX8_MAX_LISTS ];
+
+#define listINDEX8_OWNER( ucItem )    ( pvListIndex8Owners[ ( ucItem ) >> 1 ] )
+#define listINDEX8_ITEM( ucItem )                                                                           \
+    ( ( ( ListItem_t * ) ( ( ( uint8_t * ) listINDEX8_OWNER( ucItem ) ) + ucListIndex8ItemOffsets[ ( ucItem ) >> 1 ] ) ) + \
+      ( ( ucItem ) & 1U ) )
+
+#define listSET_LIST_ITEM_OWNER( pxListItem, pxOwner )    vListIndex8SetOwner( ( pxListItem ), ( void * ) ( pxOwner ) )
+#define listGET_LIST_ITEM_OWNER( pxListItem )             listINDEX8_OWNER( ( pxListItem )->ucSelf )
+#define listSET_LIST_ITEM_VALUE( pxListItem, xValue )     ( ( pxListItem )->xItemValue = ( xValue ) )
+#define listGET_LIST_ITEM_VALUE( pxListItem )             ( ( pxListItem )->xItemValue )
+
+/* An empty list reads as the end marker's value, as in the pointer version. */
+#define listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxList ) \
+    ( ( ( pxList )->ucHead == listINDEX8_NONE ) ? portMAX_DELAY : listINDEX8_ITEM( ( pxList )->ucHead )->xItemValue )
+
+#define listGET_HEAD_ENTRY( pxList ) \
+    ( ( ( pxList )->ucHead == listINDEX8_NONE ) ? NULL : listINDEX8_ITEM( ( pxList )->ucHead ) )
+
+/* The item after the last is the head again: that is the end of the list. */
+#define listGET_NEXT( pxListItem )                                                                        \
+    ( ( ( pxListItem )->ucNext == pxListIndex8Lists[ ( pxListItem )->ucContainer ]->ucHead ) ? NULL : \
+      listINDEX8_ITEM( ( pxListItem )->ucNext ) )
+
+#define listGET_END_MARKER( pxList )                      ( ( ListItem_t const * ) NULL )
+#define listLIST_IS_EMPTY( pxList )                       ( ( ( pxList )->ucNumberOfItems == ( uint8_t ) 0 ) ? pdTRUE : pdFALSE )
+#define listCURRENT_LIST_LENGTH( pxList )                 ( ( UBaseType_t ) ( pxList )->ucNumberOfItems )
+
+#define listGET_OWNER_OF_NEXT_ENTRY( pxTCB, pxList )                                      \
+    do {                                                                                  \
+        List_t * const pxConstList = ( pxList );                                          \
+        /* Move the index on, from no item to the head. */                                \
+        if( pxConstList->ucIndex == listINDEX8_NONE )                                     \
+        {                                                                                 \
+            pxConstList->ucIndex = pxConstList->ucHead;                                   \
+        }                                                                                 \
+        else                                                                              \
+        {                                                                                 \
+            pxConstList->ucIndex = listINDEX8_ITEM( pxConstList->ucIndex )->ucNext;       \
+        }                                                                                 \
+        ( pxTCB ) = listINDEX8_OWNER( pxConstList->ucIndex );                             \
+    } while( 0 )
+
+/* The ring has more to update than the pointer version, so the "inline"
+ * forms are the functions themselves. */
+#define listREMOVE_ITEM( pxItemToRemove )                 ( ( void ) uxListRemove( pxItemToRemove ) )
+#define listINSERT_END( pxList, pxNewListItem )           vListInsertEnd( ( pxList ), ( pxNewListItem ) )
+
+#define listGET_OWNER_OF_HEAD_ENTRY( pxList )             listINDEX8_OWNER( ( pxList )->ucHead )
+#define listLIST_ITEM_CONTAINER( pxListItem ) \
+    ( ( ( pxListItem )->ucContainer == listINDEX8_NONE ) ? NULL : pxListIndex8Lists[ ( pxListItem )->ucContainer ] )
+
+/* Through the table, as the kernel also asks about NULL ( in no list ). */
+#define listIS_CONTAINED_WITHIN( pxList, pxListItem )     ( ( listLIST_ITEM_CONTAINER( pxListItem ) == ( pxList ) ) ? ( pdTRUE ) : ( pdFALSE ) )
+#define listLIST_IS_INITIALISED( pxList ) \
+    ( ( ( pxList )->ucSelf < ( uint8_t ) configLIST_INDEX8_MAX_LISTS ) && ( pxListIndex8Lists[ ( pxList )->ucSelf ] == ( pxList ) ) )
+
+/*
+ * Gives pvOwner a number the first time it is seen, or finds the one it has,
+ * and numbers pxListItem from it.  Asserts when the owner table is full or
+ * the item is not one of the owner's first two list items.
+ */
+void vListIndex8SetOwner( ListItem_t * const pxListItem,
+                          void * const pvOwner ) PRIVILEGED_FUNCTION;
+
+#else /* if ( configUSE_LIST_INDEX8 == 1 ) */
+
 /*
  * Definition of the only type of object that a list can contain.
  */
@@ -428,6 +539,8 @@ typedef struct xLIST
  */
 #define listLIST_IS_INITIALISED( pxList )                ( ( pxList )->xListEnd.xItemValue == portMAX_DELAY )
 
+#endif /* if ( configUSE_LIST_INDEX8 == 1 ) */
+
 /*
  * Must be called before a list is used!  This initialises all the members
  * of the list structure and inserts the xListEnd item into the list as a
@@ -914,6 +914,67 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
                           void * const pvBuffer,
                           TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 
+/**
+ * Prototype of the predicate used by xQueueReceiveMatching().  Return pdTRUE
+ * if pvItem is wanted by the caller.  The predicate is called from inside a
+ * critical section, once per queued item, so it must be short and must not
+ * call any FreeRTOS API function.
+ */
+typedef BaseType_t (* QueueMatchFunction_t)( const void * pvItem,
+                                             void * pvContext );
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueReceiveMatching(
+ *                               QueueHandle_t xQueue,
+ *                               void *pvBuffer,
+ *                               QueueMatchFunction_t pxMatch,
+ *                               void *pvContext,
+ *                               TickType_t xTicksToWait
+ *                          );
+ * @endcode
+ *
+ * Receive the oldest item in a queue for which pxMatch returns pdTRUE.  The
+ * item is removed in place; the remaining items keep their FIFO order.  If
+ * no queued item matches, the calling task blocks until a matching item is
+ * posted or xTicksToWait expires.
+ *
+ * While any task is blocked in xQueueReceiveMatching() on a queue, posting
+ * to that queue unblocks every waiting receiver rather than only the highest
+ * priority one, so the task whose predicate matches the new item is always
+ * among those woken.
+ *
+ * configUSE_QUEUE_RECEIVE_MATCHING must be set to 1 in FreeRTOSConfig.h for
+ * this function to be available.  It cannot be used on semaphores or mutexes,
+ * or from an interrupt service routine.
+ *
+ * @param xQueue The handle to the queue from which the item is to be
+ * received.
+ *
+ * @param pvBuffer Pointer to the buffer into which the received item will
+ * be copied.
+ *
+ * @param pxMatch Predicate selecting the items the caller wants.
+ *
+ * @param pvContext Passed unchanged to pxMatch.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for a matching item.
+ *
+ * @return pdPASS if a matching item was received, otherwise errQUEUE_EMPTY.
+ *
+ * \defgroup xQueueReceiveMatching xQueueReceiveMatching
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_QUEUE_RECEIVE_MATCHING == 1 )
+    BaseType_t xQueueReceiveMatching( QueueHandle_t xQueue,
+                                      void * const pvBuffer,
+                                      QueueMatchFunction_t pxMatch,
+                                      void * pvContext,
+                                      TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * queue. h
  * @code{c}
@@ -3697,6 +3697,23 @@ void vTaskPriorityDisinheritAfterTimeout( TaskHandle_t const pxMutexHolder,
  */
 TaskHandle_t pvTaskIncrementMutexHeldCount( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * For internal use only.  Direct hand-off from xQueueGenericSend() to a task
+ * blocked in xQueueReceive().  The receiver publishes its buffer with
+ * vTaskSetQueueHandoff() before blocking and reads it back with
+ * pvTaskTakeQueueHandoff() when it runs again - NULL means a sender has
+ * already copied an item into the buffer.  A sender calls
+ * pvTaskClaimQueueHandoff() on a non-empty event list to get (and clear) the
+ * buffer of the task at its head, then unblocks that task as usual.  All
+ * three must be called from a critical section or with the scheduler
+ * suspended.
+ */
+#if ( configUSE_QUEUE_DIRECT_HANDOFF == 1 )
+    void vTaskSetQueueHandoff( void * pvBuffer ) PRIVILEGED_FUNCTION;
+    void * pvTaskTakeQueueHandoff( void ) PRIVILEGED_FUNCTION;
+    void * pvTaskClaimQueueHandoff( const List_t * const pxEventList ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * For internal use only.  Same as vTaskSetTimeOutState(), but without a critical
  * section.
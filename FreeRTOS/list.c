@@ -46,6 +46,261 @@
 * PUBLIC LIST API documented in list.h
 *----------------------------------------------------------*/
 
+#if ( configUSE_LIST_INDEX8 == 1 )
+
+PRIVILEGED_DATA void * pvListIndex8Owners[ configLIST_INDEX8_MAX_OWNERS ];
+PRIVILEGED_DATA uint8_t ucListIndex8ItemOffsets[ configLIST_INDEX8_MAX_OWNERS ];
+PRIVILEGED_DATA List_t * pxListIndex8Lists[ configLIST_INDEX8_MAX_LISTS ];
+PRIVILEGED_DATA static UBaseType_t uxListIndex8Owners = 0U;
+PRIVILEGED_DATA static UBaseType_t uxListIndex8Lists = 0U;
+
+void vListIndex8SetOwner( ListItem_t * const pxListItem,
+                          void * const pvOwner )
+{
+    UBaseType_t uxOwner;
+    size_t uxOffset;
+
+    /* A timer sets its owner on every start; it has its number already. */
+    if( ( pxListItem->ucSelf != listINDEX8_NONE ) && ( listINDEX8_OWNER( pxListItem->ucSelf ) == pvOwner ) )
+    {
+        return;
+    }
+
+    /* Task creation is not a critical section, and two tasks may create at
+     * once. */
+    portENTER_CRITICAL();
+    {
+        /* The newest owner is the likeliest: a TCB's second item follows
+         * its first. */
+        for( uxOwner = uxListIndex8Owners; uxOwner > 0U; uxOwner-- )
+        {
+            if( pvListIndex8Owners[ uxOwner - 1U ] == pvOwner )
+            {
+                break;
+            }
+        }
+
+        if( uxOwner == 0U )
+        {
+            uxOffset = ( size_t ) ( ( uint8_t * ) pxListItem - ( uint8_t * ) pvOwner );
+            configASSERT( uxListIndex8Owners < ( UBaseType_t ) configLIST_INDEX8_MAX_OWNERS );
+            configASSERT( ( ( uint8_t * ) pxListItem >= ( uint8_t * ) pvOwner ) && ( uxOffset <= 0xFFU ) );
+
+            pvListIndex8Owners[ uxListIndex8Owners ] = pvOwner;
+            ucListIndex8ItemOffsets[ uxListIndex8Owners ] = ( uint8_t ) uxOffset;
+            uxListIndex8Owners++;
+            uxOwner = uxListIndex8Owners;
+        }
+
+        uxOwner--;
+
+        /* Slot 0 is the item the owner was numbered from, slot 1 the one
+         * after it. */
+        uxOffset = ( size_t ) ( ( uint8_t * ) pxListItem - ( ( uint8_t * ) pvOwner + ucListIndex8ItemOffsets[ uxOwner ] ) );
+        configASSERT( ( uxOffset == 0U ) || ( uxOffset == sizeof( ListItem_t ) ) );
+
+        pxListItem->ucSelf = ( uint8_t ) ( ( uxOwner << 1 ) | ( ( uxOffset == 0U ) ? 0U : 1U ) );
+    }
+    portEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vListInitialise( List_t * const pxList )
+{
+    UBaseType_t uxList;
+
+    traceENTER_vListInitialise( pxList );
+
+    /* A list initialised again ( a queue reset ) keeps its number. */
+    if( listLIST_IS_INITIALISED( pxList ) == pdFALSE )
+    {
+        portENTER_CRITICAL();
+        {
+            for( uxList = 0U; uxList < uxListIndex8Lists; uxList++ )
+            {
+                if( pxListIndex8Lists[ uxList ] == pxList )
+                {
+                    break;
+                }
+            }
+
+            if( uxList == uxListIndex8Lists )
+            {
+                configASSERT( uxListIndex8Lists < ( UBaseType_t ) configLIST_INDEX8_MAX_LISTS );
+                pxListIndex8Lists[ uxListIndex8Lists ] = pxList;
+                uxListIndex8Lists++;
+            }
+
+            pxList->ucSelf = ( uint8_t ) uxList;
+        }
+        portEXIT_CRITICAL();
+    }
+
+    pxList->ucNumberOfItems = 0U;
+    pxList->ucHead = listINDEX8_NONE;
+    pxList->ucIndex = listINDEX8_NONE;
+
+    traceRETURN_vListInitialise();
+}
+/*-----------------------------------------------------------*/
+
+void vListInitialiseItem( ListItem_t * const pxItem )
+{
+    traceENTER_vListInitialiseItem( pxItem );
+
+    /* Make sure the list item is not recorded as being on a list, nor as
+     * belonging to whatever last lived at this address. */
+    pxItem->ucContainer = listINDEX8_NONE;
+    pxItem->ucSelf = listINDEX8_NONE;
+
+    traceRETURN_vListInitialiseItem();
+}
+/*-----------------------------------------------------------*/
+
+/* Links pxNewListItem in before ucBefore, or makes it the only item. */
+static void prvListIndex8Link( List_t * const pxList,
+                               ListItem_t * const pxNewListItem,
+                               uint8_t ucBefore )
+{
+    ListItem_t * pxBefore;
+    const uint8_t ucNew = pxNewListItem->ucSelf;
+
+    /* listSET_LIST_ITEM_OWNER () must have numbered the item. */
+    configASSERT( ucNew != listINDEX8_NONE );
+
+    if( ucBefore == listINDEX8_NONE )
+    {
+        pxNewListItem->ucNext = ucNew;
+        pxNewListItem->ucPrevious = ucNew;
+        pxList->ucHead = ucNew;
+    }
+    else
+    {
+        pxBefore = listINDEX8_ITEM( ucBefore );
+        pxNewListItem->ucNext = ucBefore;
+        pxNewListItem->ucPrevious = pxBefore->ucPrevious;
+        listINDEX8_ITEM( pxBefore->ucPrevious )->ucNext = ucNew;
+        pxBefore->ucPrevious = ucNew;
+    }
+
+    pxNewListItem->ucContainer = pxList->ucSelf;
+    pxList->ucNumberOfItems++;
+}
+/*-----------------------------------------------------------*/
+
+void vListInsertEnd( List_t * const pxList,
+                     ListItem_t * const pxNewListItem )
+{
+    const uint8_t ucIndex = pxList->ucIndex;
+
+    traceENTER_vListInsertEnd( pxList, pxNewListItem );
+
+    /* The pointer version links the item in just before pxIndex.  With no
+     * index that is before the end marker: the tail, which is before the
+     * head in the ring.  Before the index item the new item is only the
+     * head when the index is. */
+    if( ucIndex == listINDEX8_NONE )
+    {
+        prvListIndex8Link( pxList, pxNewListItem, pxList->ucHead );
+    }
+    else
+    {
+        prvListIndex8Link( pxList, pxNewListItem, ucIndex );
+
+        if( ucIndex == pxList->ucHead )
+        {
+            pxList->ucHead = pxNewListItem->ucSelf;
+        }
+    }
+
+    traceRETURN_vListInsertEnd();
+}
+/*-----------------------------------------------------------*/
+
+void vListInsert( List_t * const pxList,
+                  ListItem_t * const pxNewListItem )
+{
+    const TickType_t xValueOfInsertion = pxNewListItem->xItemValue;
+    uint8_t ucBefore = pxList->ucHead;
+    UBaseType_t uxLeft = ( UBaseType_t ) pxList->ucNumberOfItems;
+
+    traceENTER_vListInsert( pxList, pxNewListItem );
+
+    /* Sorted in xItemValue order and after any item of the same value, as in
+     * the pointer version: before the first greater item, else at the tail.
+     * portMAX_DELAY goes straight to the tail. */
+    if( xValueOfInsertion != portMAX_DELAY )
+    {
+        while( ( uxLeft > 0U ) && ( listINDEX8_ITEM( ucBefore )->xItemValue <= xValueOfInsertion ) )
+        {
+            ucBefore = listINDEX8_ITEM( ucBefore )->ucNext;
+            uxLeft--;
+        }
+    }
+    else
+    {
+        uxLeft = 0U;
+    }
+
+    prvListIndex8Link( pxList, pxNewListItem, ucBefore );
+
+    /* Before the head item rather than after the tail one. */
+    if( ( uxLeft > 0U ) && ( ucBefore == pxList->ucHead ) )
+    {
+        pxList->ucHead = pxNewListItem->ucSelf;
+    }
+
+    traceRETURN_vListInsert();
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxListRemove( ListItem_t * const pxItemToRemove )
+{
+    List_t * const pxList = pxListIndex8Lists[ pxItemToRemove->ucContainer ];
+    const uint8_t ucItem = pxItemToRemove->ucSelf;
+
+    traceENTER_uxListRemove( pxItemToRemove );
+
+    listINDEX8_ITEM( pxItemToRemove->ucNext )->ucPrevious = pxItemToRemove->ucPrevious;
+    listINDEX8_ITEM( pxItemToRemove->ucPrevious )->ucNext = pxItemToRemove->ucNext;
+
+    /* Make sure the index is left on a valid item: the one before, or the
+     * end marker when the head goes. */
+    if( pxList->ucIndex == ucItem )
+    {
+        pxList->ucIndex = ( ucItem == pxList->ucHead ) ? listINDEX8_NONE : pxItemToRemove->ucPrevious;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    pxList->ucNumberOfItems--;
+
+    if( pxList->ucNumberOfItems == 0U )
+    {
+        pxList->ucHead = listINDEX8_NONE;
+        pxList->ucIndex = listINDEX8_NONE;
+    }
+    else if( pxList->ucHead == ucItem )
+    {
+        pxList->ucHead = pxItemToRemove->ucNext;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    pxItemToRemove->ucContainer = listINDEX8_NONE;
+
+    traceRETURN_uxListRemove( pxList->ucNumberOfItems );
+
+    return ( UBaseType_t ) pxList->ucNumberOfItems;
+}
+/*-----------------------------------------------------------*/
+
+#else /* if ( configUSE_LIST_INDEX8 == 1 ) */
+
 void vListInitialise( List_t * const pxList )
 {
     traceENTER_vListInitialise( pxList );
@@ -246,3 +501,5 @@ UBaseType_t uxListRemove( ListItem_t * const pxItemToRemove )
     return pxList->uxNumberOfItems;
 }
 /*-----------------------------------------------------------*/
+
+#endif /* if ( configUSE_LIST_INDEX8 == 1 ) */
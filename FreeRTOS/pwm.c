@@ -17,6 +17,16 @@
  *   - LED is OFF when counter >= duty_cycle
  *   - This creates duty_cycle% ON time
  * 
+ * Double buffering:
+ *   - PWM_SetDutyCycle() only writes pwm_duty_pending. The ISR copies it
+ *     to pwm_duty_cycle when the counter wraps, so a period is never cut
+ *     short or stretched by a change arriving part way through it.
+ * 
+ * Fade engine:
+ *   - PWM_FadeTo() loads an 8.8 fixed-point level and a per-period step.
+ *     The ISR advances the level once per PWM period (at the same boundary
+ *     as the latch) and snaps to the exact target on the last period.
+ * 
  * IMPORTANT: Timer2 is dedicated to PWM. Timer1 is used by FreeRTOS.
  * 
  * Created on Nov 2025
@@ -25,6 +35,8 @@
 #include "pwm.h"
 #include "hw_config.h"
 #include "FreeRTOSConfig.h"  /* For configCPU_CLOCK_HZ */
+#include "appcfg.h"
+#include "stateprof.h"
 #include <xc.h>
 
 /*============================================================================
@@ -34,11 +46,12 @@
 /* PWM resolution - number of steps per period */
 #define PWM_RESOLUTION      100UL
 
-/* Target PWM frequency in Hz */
-#define PWM_TARGET_FREQ     PWM_FREQUENCY_HZ    /* From hw_config.h */
+/* Target PWM frequency in Hz - from the configuration image (appcfg.h),
+ * PWM_FREQUENCY_HZ in hw_config.h by default */
+#define PWM_TARGET_FREQ     ((unsigned long)AppCfg_Get()->pwm_frequency_hz)
 
 /* Timer2 interrupt frequency = PWM_FREQ * PWM_RESOLUTION */
-#define TIMER2_FREQ         ((unsigned long)PWM_TARGET_FREQ * PWM_RESOLUTION)
+#define TIMER2_FREQ         (PWM_TARGET_FREQ * PWM_RESOLUTION)
 
 /* System clock frequency (Fosc/2 for instruction cycle) */
 #define FCY                 ((unsigned long)configCPU_CLOCK_HZ)    /* 4MHz from FreeRTOSConfig.h */
@@ -53,9 +66,18 @@
  * STATIC VARIABLES
  *============================================================================*/
 
-/* Current duty cycle (0-100) */
+/* Duty cycle used by the ISR for the current period (0-100) */
 static volatile uint8_t pwm_duty_cycle = 0;
 
+/* Duty cycle latched at the next period boundary (0-100) */
+static volatile uint8_t pwm_duty_pending = 0;
+
+/* Fade state: level and step in 8.8 fixed point, periods left to run */
+static volatile int16_t pwm_fade_level = 0;
+static volatile int16_t pwm_fade_step = 0;
+static volatile uint16_t pwm_fade_periods = 0;
+static volatile uint8_t pwm_fade_target = 0;
+
 /* PWM counter (0-99) */
 static volatile uint8_t pwm_counter = 0;
 
@@ -87,6 +109,8 @@ static const uint8_t sine_table[16] = {
 
 void __attribute__((interrupt, no_auto_psv)) _T2Interrupt(void)
 {
+    STATEPROF_ISR_ENTER();
+    
     /* Clear interrupt flag immediately */
     IFS0bits.T2IF = 0;
     
@@ -94,14 +118,32 @@ void __attribute__((interrupt, no_auto_psv)) _T2Interrupt(void)
     pwm_counter++;
     if (pwm_counter >= PWM_RESOLUTION) {
         pwm_counter = 0;
+        
+        /* Period boundary: step any fade, then latch the new duty */
+        if (pwm_fade_periods != 0) {
+            pwm_fade_periods--;
+            if (pwm_fade_periods == 0) {
+                pwm_fade_level = (int16_t)pwm_fade_target << 8;
+            } else {
+                pwm_fade_level += pwm_fade_step;
+            }
+            pwm_duty_pending = (uint8_t)((pwm_fade_level + 0x80) >> 8);
+        }
+        pwm_duty_cycle = pwm_duty_pending;
     }
     
-    /* Update LED output based on duty cycle and enable state */
+    /* Update LED output based on duty cycle and enable state. The pin
+     * only changes at most twice a period, so skip the port write when
+     * the framebuffer already holds the right level. */
     if (pwm_output_enabled && (pwm_counter < pwm_duty_cycle)) {
-        LED2_On();
-    } else {
+        if (!LED2_IsOn()) {
+            LED2_On();
+        }
+    } else if (LED2_IsOn()) {
         LED2_Off();
     }
+    
+    STATEPROF_ISR_EXIT(STATEPROF_ISR_T2);
 }
 
 /*============================================================================
@@ -150,6 +192,8 @@ void PWM_Init(void)
     
     /* Initialize PWM state */
     pwm_duty_cycle = 0;
+    pwm_duty_pending = 0;
+    pwm_fade_periods = 0;
     pwm_counter = 0;
     pwm_output_enabled = true;
 }
@@ -189,7 +233,51 @@ void PWM_SetDutyCycle(uint8_t duty_percent)
         duty_percent = 100;
     }
     
-    pwm_duty_cycle = duty_percent;
+    /* Cancel any fade first so the ISR cannot overwrite the new value */
+    pwm_fade_periods = 0;
+    pwm_duty_pending = duty_percent;
+}
+
+void PWM_FadeTo(uint8_t target_percent, uint16_t ms)
+{
+    uint32_t periods;
+    int16_t start;
+    uint16_t saved_ipl;
+    
+    if (target_percent > 100) {
+        target_percent = 100;
+    }
+    
+    periods = ((uint32_t)ms * PWM_TARGET_FREQ) / 1000UL;
+    if (periods == 0) {
+        PWM_SetDutyCycle(target_percent);
+        return;
+    }
+    if (periods > 0xFFFF) {
+        periods = 0xFFFF;
+    }
+    
+    /* Above the Timer2 ISR so it never sees a half-loaded ramp */
+    SET_AND_SAVE_CPU_IPL(saved_ipl, 7);
+    
+    /* Start from where a running fade has got to, else the latched duty */
+    if (pwm_fade_periods != 0) {
+        start = pwm_fade_level;
+    } else {
+        start = (int16_t)pwm_duty_pending << 8;
+    }
+    
+    pwm_fade_level = start;
+    pwm_fade_step = (int16_t)((((int32_t)target_percent << 8) - start) / (int32_t)periods);
+    pwm_fade_target = target_percent;
+    pwm_fade_periods = (uint16_t)periods;
+    
+    RESTORE_CPU_IPL(saved_ipl);
+}
+
+bool PWM_IsFading(void)
+{
+    return (pwm_fade_periods != 0);
 }
 
 uint8_t PWM_GetDutyCycle(void)
@@ -212,6 +300,16 @@ bool PWM_IsOutputEnabled(void)
     return pwm_output_enabled;
 }
 
+bool PWM_IsSteady(void)
+{
+    uint8_t duty = pwm_duty_cycle;
+    
+    if (pwm_fade_periods != 0 || pwm_duty_pending != duty) {
+        return false;
+    }
+    return !pwm_output_enabled || duty == 0 || duty >= PWM_RESOLUTION;
+}
+
 void PWM_UpdatePulse(uint16_t elapsed_ms, uint16_t period_ms)
 {
     /*------------------------------------------------------------------------
@@ -236,12 +334,12 @@ void PWM_UpdatePulse(uint16_t elapsed_ms, uint16_t period_ms)
     table_index = pulse_phase >> 12;
     
     /* Set duty cycle from table */
-    pwm_duty_cycle = sine_table[table_index];
+    PWM_SetDutyCycle(sine_table[table_index]);
 }
 
 void PWM_ResetPulse(void)
 {
     pulse_phase = 0;
-    pwm_duty_cycle = sine_table[0];
+    PWM_SetDutyCycle(sine_table[0]);
 }
 
@@ -51,12 +51,33 @@ void PWM_Stop(void);
 /**
  * @brief Set PWM duty cycle
  * 
+ * Takes effect at the start of the next PWM period. Cancels any fade.
+ * 
  * @param duty_percent Duty cycle percentage (0-100)
  *        0 = LED fully off
  *        100 = LED fully on
  */
 void PWM_SetDutyCycle(uint8_t duty_percent);
 
+/**
+ * @brief Ramp the duty cycle to a new value
+ * 
+ * The ramp runs entirely in the Timer2 ISR, one step per PWM period, so
+ * no task has to stay awake for it. Starting a new fade from inside a
+ * running one continues from the current level. PWM_SetDutyCycle()
+ * cancels a running fade.
+ * 
+ * @param target_percent Final duty cycle (0-100)
+ * @param ms Ramp duration in milliseconds (0 = change at next period)
+ */
+void PWM_FadeTo(uint8_t target_percent, uint16_t ms);
+
+/**
+ * @brief Check if a fade started by PWM_FadeTo() is still running
+ * @return bool true while ramping
+ */
+bool PWM_IsFading(void);
+
 /**
  * @brief Get current PWM duty cycle
  * 
@@ -81,6 +102,17 @@ void PWM_SetOutputEnabled(bool enabled);
  */
 bool PWM_IsOutputEnabled(void);
 
+/**
+ * @brief Check if LED2 is held at a fixed level
+ * 
+ * True when no fade or duty change is pending and the output is off,
+ * at 0% or at 100%. Timer2 stops in Sleep, so the CPU may only sleep
+ * while this holds - the pin then keeps the right level on its own.
+ * 
+ * @return bool true if stopping Timer2 would not change LED2
+ */
+bool PWM_IsSteady(void);
+
 /**
  * @brief Update brightness for pulsing effect (waiting state)
  * 
@@ -129,6 +129,10 @@ typedef struct QueueDefinition /* The old naming convention is used to prevent b
         struct QueueDefinition * pxQueueSetContainer;
     #endif
 
+    #if ( configUSE_QUEUE_RECEIVE_MATCHING == 1 )
+        UBaseType_t uxMatchingReceivers; /**< Number of tasks blocked in xQueueReceiveMatching() on this queue. */
+    #endif
+
     #if ( configUSE_TRACE_FACILITY == 1 )
         UBaseType_t uxQueueNumber;
         uint8_t ucQueueType;
@@ -210,6 +214,46 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
 static void prvCopyDataFromQueue( Queue_t * const pxQueue,
                                   void * const pvBuffer ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_QUEUE_DIRECT_HANDOFF == 1 )
+
+/*
+ * If the queue is empty and the highest priority task waiting to receive is
+ * blocked in xQueueReceive(), copies the item straight into that task's
+ * buffer and unblocks it, so the item never enters the queue storage.  The
+ * queue must be empty for FIFO order to hold, and no receiver may be
+ * filtering with xQueueReceiveMatching().  Returns pdTRUE if the item was
+ * handed off, with *pxYieldRequired set if the receiver should run next.
+ * Called from a critical section.
+ */
+    static BaseType_t prvHandOffToReceiver( Queue_t * const pxQueue,
+                                            const void * pvItemToQueue,
+                                            BaseType_t * const pxYieldRequired ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_QUEUE_RECEIVE_MATCHING == 1 )
+
+/*
+ * Unblocks the tasks waiting to receive after an item has been posted.  If
+ * any waiter is filtering with xQueueReceiveMatching() the new item may only
+ * be wanted by a lower priority waiter, so every waiter is unblocked and
+ * re-evaluates the queue.  Otherwise only the highest priority waiter is
+ * unblocked, as usual.  Must be called with the list known to be non-empty.
+ */
+    static BaseType_t prvUnblockReceivers( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Finds the oldest item for which pxMatch returns pdTRUE, copies it out and
+ * closes the gap so the other items keep their order.  Called from a
+ * critical section.
+ */
+    static BaseType_t prvCopyMatchingDataFromQueue( Queue_t * const pxQueue,
+                                                    void * const pvBuffer,
+                                                    QueueMatchFunction_t pxMatch,
+                                                    void * pvContext ) PRIVILEGED_FUNCTION;
+#else
+    #define prvUnblockReceivers( pxQueue )    xTaskRemoveFromEventList( &( ( pxQueue )->xTasksWaitingToReceive ) )
+#endif
+
 #if ( configUSE_QUEUE_SETS == 1 )
 
 /*
@@ -608,6 +652,12 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
     }
     #endif /* configUSE_QUEUE_SETS */
 
+    #if ( configUSE_QUEUE_RECEIVE_MATCHING == 1 )
+    {
+        pxNewQueue->uxMatchingReceivers = ( UBaseType_t ) 0U;
+    }
+    #endif /* configUSE_QUEUE_RECEIVE_MATCHING */
+
     traceQUEUE_CREATE( pxNewQueue );
 }
 /*-----------------------------------------------------------*/
@@ -960,12 +1010,43 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
     configASSERT( pxQueue );
     configASSERT( !( ( pvItemToQueue == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
     configASSERT( !( ( xCopyPosition == queueOVERWRITE ) && ( pxQueue->uxLength != 1 ) ) );
+
     #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
     {
         configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
     }
     #endif
 
+    #if ( configUSE_QUEUE_FAST_PATH == 1 )
+    {
+        /* Uncontended case: there is room and no task is waiting to receive,
+         * so the item is posted in this one critical section without the
+         * timeout state, the retry loop or the event list handling below. */
+        taskENTER_CRITICAL();
+        {
+            if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) &&
+                ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE ) )
+            {
+                traceQUEUE_SEND( pxQueue );
+
+                /* Only a mutex give (priority disinheritance) can ask for a
+                 * yield here. */
+                if( prvCopyDataToQueue( pxQueue, pvItemToQueue, xCopyPosition ) != pdFALSE )
+                {
+                    queueYIELD_IF_USING_PREEMPTION();
+                }
+
+                taskEXIT_CRITICAL();
+
+                traceRETURN_xQueueGenericSend( pdPASS );
+
+                return pdPASS;
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+    #endif /* configUSE_QUEUE_FAST_PATH */
+
     for( ; ; )
     {
         taskENTER_CRITICAL();
@@ -1011,7 +1092,7 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
                          * queue then unblock it now. */
                         if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                         {
-                            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                            if( prvUnblockReceivers( pxQueue ) != pdFALSE )
                             {
                                 /* The unblocked task has a priority higher than
                                  * our own so yield immediately.  Yes it is ok to
@@ -1040,13 +1121,37 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
                 }
                 #else /* configUSE_QUEUE_SETS */
                 {
+                    #if ( configUSE_QUEUE_DIRECT_HANDOFF == 1 )
+                    {
+                        if( prvHandOffToReceiver( pxQueue, pvItemToQueue, &xYieldRequired ) != pdFALSE )
+                        {
+                            /* The item went straight to the receiver; the
+                             * queue storage was not touched. */
+                            if( xYieldRequired != pdFALSE )
+                            {
+                                queueYIELD_IF_USING_PREEMPTION();
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+
+                            taskEXIT_CRITICAL();
+
+                            traceRETURN_xQueueGenericSend( pdPASS );
+
+                            return pdPASS;
+                        }
+                    }
+                    #endif /* configUSE_QUEUE_DIRECT_HANDOFF */
+
                     xYieldRequired = prvCopyDataToQueue( pxQueue, pvItemToQueue, xCopyPosition );
 
                     /* If there was a task waiting for data to arrive on the
                      * queue then unblock it now. */
                     if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                     {
-                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                        if( prvUnblockReceivers( pxQueue ) != pdFALSE )
                         {
                             /* The unblocked task has a priority higher than
                              * our own so yield immediately.  Yes it is ok to do
@@ -1256,7 +1361,7 @@ BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
                     {
                         if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                         {
-                            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                            if( prvUnblockReceivers( pxQueue ) != pdFALSE )
                             {
                                 /* The task waiting has a higher priority so
                                  *  record that a context switch is required. */
@@ -1284,7 +1389,7 @@ BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
                 {
                     if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                     {
-                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                        if( prvUnblockReceivers( pxQueue ) != pdFALSE )
                         {
                             /* The task waiting has a higher priority so record that a
                              * context switch is required. */
@@ -1514,6 +1619,10 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
     TimeOut_t xTimeOut;
     Queue_t * const pxQueue = xQueue;
 
+    #if ( configUSE_QUEUE_DIRECT_HANDOFF == 1 )
+        BaseType_t xWasBlocked = pdFALSE;
+    #endif
+
     traceENTER_xQueueReceive( xQueue, pvBuffer, xTicksToWait );
 
     /* Check the pointer is not NULL. */
@@ -1530,12 +1639,59 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
     }
     #endif
 
+    #if ( configUSE_QUEUE_FAST_PATH == 1 )
+    {
+        /* Uncontended case: an item is waiting and no task is blocked on a
+         * full queue, so nothing needs to be woken. */
+        taskENTER_CRITICAL();
+        {
+            const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+
+            if( ( uxMessagesWaiting > ( UBaseType_t ) 0 ) &&
+                ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE ) )
+            {
+                prvCopyDataFromQueue( pxQueue, pvBuffer );
+                traceQUEUE_RECEIVE( pxQueue );
+                pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( uxMessagesWaiting - ( UBaseType_t ) 1 );
+
+                taskEXIT_CRITICAL();
+
+                traceRETURN_xQueueReceive( pdPASS );
+
+                return pdPASS;
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+    #endif /* configUSE_QUEUE_FAST_PATH */
+
     for( ; ; )
     {
         taskENTER_CRITICAL();
         {
             const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
 
+            #if ( configUSE_QUEUE_DIRECT_HANDOFF == 1 )
+            {
+                if( xWasBlocked != pdFALSE )
+                {
+                    xWasBlocked = pdFALSE;
+
+                    /* NULL means a sender copied an item straight into
+                     * pvBuffer while this task was blocked. */
+                    if( pvTaskTakeQueueHandoff() == NULL )
+                    {
+                        traceQUEUE_RECEIVE( pxQueue );
+                        taskEXIT_CRITICAL();
+
+                        traceRETURN_xQueueReceive( pdPASS );
+
+                        return pdPASS;
+                    }
+                }
+            }
+            #endif /* configUSE_QUEUE_DIRECT_HANDOFF */
+
             /* Is there data in the queue now?  To be running the calling task
              * must be the highest priority task wanting to access the queue. */
             if( uxMessagesWaiting > ( UBaseType_t ) 0 )
@@ -1613,6 +1769,18 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
             if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
             {
                 traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+
+                #if ( configUSE_QUEUE_DIRECT_HANDOFF == 1 )
+                {
+                    /* Semaphore-style queues have no buffer to hand off to. */
+                    if( pxQueue->uxItemSize != ( UBaseType_t ) 0U )
+                    {
+                        vTaskSetQueueHandoff( pvBuffer );
+                        xWasBlocked = pdTRUE;
+                    }
+                }
+                #endif /* configUSE_QUEUE_DIRECT_HANDOFF */
+
                 vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
                 prvUnlockQueue( pxQueue );
 
@@ -1656,6 +1824,153 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_QUEUE_RECEIVE_MATCHING == 1 )
+
+    BaseType_t xQueueReceiveMatching( QueueHandle_t xQueue,
+                                      void * const pvBuffer,
+                                      QueueMatchFunction_t pxMatch,
+                                      void * pvContext,
+                                      TickType_t xTicksToWait )
+    {
+        BaseType_t xEntryTimeSet = pdFALSE, xWasBlocked = pdFALSE;
+        TimeOut_t xTimeOut;
+        Queue_t * const pxQueue = xQueue;
+        int8_t * pcScannedWriteTo;
+        int8_t * pcScannedReadFrom;
+        UBaseType_t uxScannedMessages;
+
+        traceENTER_xQueueReceiveMatching( xQueue, pvBuffer, pxMatch, pvContext, xTicksToWait );
+
+        configASSERT( ( pxQueue ) );
+        configASSERT( pxMatch );
+
+        /* Semaphores carry no data to match against. */
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+        configASSERT( pvBuffer );
+
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        for( ; ; )
+        {
+            taskENTER_CRITICAL();
+            {
+                if( xWasBlocked != pdFALSE )
+                {
+                    /* Back from the event list - stop counting this task as a
+                     * filtering waiter. */
+                    pxQueue->uxMatchingReceivers--;
+                    xWasBlocked = pdFALSE;
+                }
+
+                if( prvCopyMatchingDataFromQueue( pxQueue, pvBuffer, pxMatch, pvContext ) != pdFALSE )
+                {
+                    traceQUEUE_RECEIVE( pxQueue );
+
+                    /* There is now space in the queue, were any tasks waiting
+                     * to post to the queue? */
+                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                    {
+                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                        {
+                            queueYIELD_IF_USING_PREEMPTION();
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    taskEXIT_CRITICAL();
+
+                    traceRETURN_xQueueReceiveMatching( pdPASS );
+
+                    return pdPASS;
+                }
+                else
+                {
+                    if( xTicksToWait == ( TickType_t ) 0 )
+                    {
+                        taskEXIT_CRITICAL();
+
+                        traceQUEUE_RECEIVE_FAILED( pxQueue );
+                        traceRETURN_xQueueReceiveMatching( errQUEUE_EMPTY );
+
+                        return errQUEUE_EMPTY;
+                    }
+                    else if( xEntryTimeSet == pdFALSE )
+                    {
+                        vTaskInternalSetTimeOutState( &xTimeOut );
+                        xEntryTimeSet = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    /* Remember what was scanned so items posted between here
+                     * and blocking are not missed. */
+                    pcScannedWriteTo = pxQueue->pcWriteTo;
+                    pcScannedReadFrom = pxQueue->u.xQueue.pcReadFrom;
+                    uxScannedMessages = pxQueue->uxMessagesWaiting;
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            vTaskSuspendAll();
+            prvLockQueue( pxQueue );
+
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                if( ( pxQueue->pcWriteTo == pcScannedWriteTo ) &&
+                    ( pxQueue->u.xQueue.pcReadFrom == pcScannedReadFrom ) &&
+                    ( pxQueue->uxMessagesWaiting == uxScannedMessages ) )
+                {
+                    /* Nothing has changed since the scan, so nothing can match.
+                     * Block until the next post. */
+                    traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+                    pxQueue->uxMatchingReceivers++;
+                    xWasBlocked = pdTRUE;
+                    vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                    prvUnlockQueue( pxQueue );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        taskYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* The queue changed - loop back and scan again. */
+                    prvUnlockQueue( pxQueue );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                /* Timed out.  Loop back for one last scan with no block
+                 * time. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+                xTicksToWait = ( TickType_t ) 0;
+            }
+        }
+    }
+
+#endif /* configUSE_QUEUE_RECEIVE_MATCHING */
+/*-----------------------------------------------------------*/
+
 BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                                 TickType_t xTicksToWait )
 {
@@ -1683,6 +1998,41 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
     }
     #endif
 
+    #if ( configUSE_QUEUE_FAST_PATH == 1 )
+    {
+        /* Uncontended case: the count is non-zero and no task is blocked
+         * giving, so the take is one decrement (plus the holder for a
+         * mutex). */
+        taskENTER_CRITICAL();
+        {
+            const UBaseType_t uxSemaphoreCount = pxQueue->uxMessagesWaiting;
+
+            if( ( uxSemaphoreCount > ( UBaseType_t ) 0 ) &&
+                ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE ) )
+            {
+                traceQUEUE_RECEIVE( pxQueue );
+                pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( uxSemaphoreCount - ( UBaseType_t ) 1 );
+
+                #if ( configUSE_MUTEXES == 1 )
+                {
+                    if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+                    {
+                        pxQueue->u.xSemaphore.xMutexHolder = pvTaskIncrementMutexHeldCount();
+                    }
+                }
+                #endif /* configUSE_MUTEXES */
+
+                taskEXIT_CRITICAL();
+
+                traceRETURN_xQueueSemaphoreTake( pdPASS );
+
+                return pdPASS;
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+    #endif /* configUSE_QUEUE_FAST_PATH */
+
     for( ; ; )
     {
         taskENTER_CRITICAL();
@@ -2494,6 +2844,142 @@ static void prvCopyDataFromQueue( Queue_t * const pxQueue,
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_QUEUE_RECEIVE_MATCHING == 1 )
+
+    static BaseType_t prvUnblockReceivers( Queue_t * const pxQueue )
+    {
+        BaseType_t xReturn = pdFALSE;
+
+        if( pxQueue->uxMatchingReceivers == ( UBaseType_t ) 0U )
+        {
+            xReturn = xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) );
+        }
+        else
+        {
+            while( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+            {
+                if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                {
+                    xReturn = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvCopyMatchingDataFromQueue( Queue_t * const pxQueue,
+                                                    void * const pvBuffer,
+                                                    QueueMatchFunction_t pxMatch,
+                                                    void * pvContext )
+    {
+        const UBaseType_t uxItemSize = pxQueue->uxItemSize;
+        const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+        int8_t * pcOldest;
+        int8_t * pcItem;
+        int8_t * pcPrevious;
+        UBaseType_t uxIndex;
+
+        /* pcReadFrom points at the last item read, so the oldest queued item
+         * is the one after it. */
+        pcOldest = pxQueue->u.xQueue.pcReadFrom + uxItemSize;
+
+        if( pcOldest >= pxQueue->u.xQueue.pcTail )
+        {
+            pcOldest = pxQueue->pcHead;
+        }
+
+        pcItem = pcOldest;
+
+        for( uxIndex = 0; uxIndex < uxMessagesWaiting; uxIndex++ )
+        {
+            if( pxMatch( ( const void * ) pcItem, pvContext ) != pdFALSE )
+            {
+                ( void ) memcpy( pvBuffer, ( void * ) pcItem, ( size_t ) uxItemSize );
+
+                /* Close the gap by moving every older item one slot towards
+                 * the newer end, then drop the (now duplicated) oldest slot.
+                 * Items newer than the match are not touched. */
+                while( pcItem != pcOldest )
+                {
+                    pcPrevious = pcItem - uxItemSize;
+
+                    if( pcPrevious < pxQueue->pcHead )
+                    {
+                        pcPrevious = pxQueue->u.xQueue.pcTail - uxItemSize;
+                    }
+
+                    ( void ) memcpy( ( void * ) pcItem, ( void * ) pcPrevious, ( size_t ) uxItemSize );
+                    pcItem = pcPrevious;
+                }
+
+                pxQueue->u.xQueue.pcReadFrom = pcOldest;
+                pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( uxMessagesWaiting - ( UBaseType_t ) 1 );
+
+                return pdTRUE;
+            }
+
+            pcItem += uxItemSize;
+
+            if( pcItem >= pxQueue->u.xQueue.pcTail )
+            {
+                pcItem = pxQueue->pcHead;
+            }
+        }
+
+        return pdFALSE;
+    }
+
+#endif /* configUSE_QUEUE_RECEIVE_MATCHING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_DIRECT_HANDOFF == 1 )
+
+    static BaseType_t prvHandOffToReceiver( Queue_t * const pxQueue,
+                                            const void * pvItemToQueue,
+                                            BaseType_t * const pxYieldRequired )
+    {
+        void * pvReceiverBuffer;
+
+        if( ( pxQueue->uxMessagesWaiting != ( UBaseType_t ) 0 ) ||
+            ( pxQueue->uxItemSize == ( UBaseType_t ) 0 ) ||
+            ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE ) )
+        {
+            return pdFALSE;
+        }
+
+        #if ( configUSE_QUEUE_RECEIVE_MATCHING == 1 )
+        {
+            if( pxQueue->uxMatchingReceivers != ( UBaseType_t ) 0U )
+            {
+                return pdFALSE;
+            }
+        }
+        #endif
+
+        /* NULL if the head waiter is peeking, or is not in xQueueReceive(). */
+        pvReceiverBuffer = pvTaskClaimQueueHandoff( &( pxQueue->xTasksWaitingToReceive ) );
+
+        if( pvReceiverBuffer == NULL )
+        {
+            return pdFALSE;
+        }
+
+        traceQUEUE_SEND( pxQueue );
+        ( void ) memcpy( pvReceiverBuffer, pvItemToQueue, ( size_t ) pxQueue->uxItemSize );
+        *pxYieldRequired = xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) );
+
+        return pdTRUE;
+    }
+
+#endif /* configUSE_QUEUE_DIRECT_HANDOFF */
+/*-----------------------------------------------------------*/
+
 static void prvUnlockQueue( Queue_t * const pxQueue )
 {
     /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED. */
@@ -2534,7 +3020,7 @@ static void prvUnlockQueue( Queue_t * const pxQueue )
                      * suspended. */
                     if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                     {
-                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                        if( prvUnblockReceivers( pxQueue ) != pdFALSE )
                         {
                             /* The task waiting has a higher priority so record that a
                              * context switch is required. */
@@ -2557,7 +3043,7 @@ static void prvUnlockQueue( Queue_t * const pxQueue )
                  * the pending ready list as the scheduler is still suspended. */
                 if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                 {
-                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                    if( prvUnblockReceivers( pxQueue ) != pdFALSE )
                     {
                         /* The task waiting has a higher priority so record that
                          * a context switch is required. */
@@ -449,6 +449,10 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
     #if ( configUSE_POSIX_ERRNO == 1 )
         int iTaskErrno;
     #endif
+
+    #if ( configUSE_QUEUE_DIRECT_HANDOFF == 1 )
+        void * pvQueueHandoff; /**< Receive buffer while blocked in xQueueReceive(), set to NULL by a sender that copied an item straight into it. */
+    #endif
 } tskTCB;
 
 /* The old tskTCB name is maintained above then typedefed to the new TCB_t name
@@ -7686,6 +7690,37 @@ TickType_t uxTaskResetEventItemValue( void )
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_QUEUE_DIRECT_HANDOFF == 1 )
+
+    void vTaskSetQueueHandoff( void * pvBuffer )
+    {
+        pxCurrentTCB->pvQueueHandoff = pvBuffer;
+    }
+/*-----------------------------------------------------------*/
+
+    void * pvTaskTakeQueueHandoff( void )
+    {
+        void * pvBuffer = pxCurrentTCB->pvQueueHandoff;
+
+        pxCurrentTCB->pvQueueHandoff = NULL;
+
+        return pvBuffer;
+    }
+/*-----------------------------------------------------------*/
+
+    void * pvTaskClaimQueueHandoff( const List_t * const pxEventList )
+    {
+        TCB_t * const pxUnblockedTCB = listGET_OWNER_OF_HEAD_ENTRY( pxEventList );
+        void * pvBuffer = pxUnblockedTCB->pvQueueHandoff;
+
+        pxUnblockedTCB->pvQueueHandoff = NULL;
+
+        return pvBuffer;
+    }
+
+#endif /* configUSE_QUEUE_DIRECT_HANDOFF */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_TASK_NOTIFICATIONS == 1 )
 
     uint32_t ulTaskGenericNotifyTake( UBaseType_t uxIndexToWaitOn,
@@ -30,6 +30,7 @@
 //#include <p24FJ128GA010.h>
 
  #include <xc.h>
+ #include <stdint.h>
 
 /*-----------------------------------------------------------
  * Application specific definitions.
@@ -45,10 +46,10 @@
 
 #define configUSE_PREEMPTION			1
 #define configUSE_IDLE_HOOK				1
-#define configUSE_TICK_HOOK				0
+#define configUSE_TICK_HOOK				1
 #define configTICK_RATE_HZ				( ( TickType_t ) 1000 )
 #define configCPU_CLOCK_HZ				( ( unsigned long ) 4000000 )  /* Fosc / 2 */
-#define configMAX_PRIORITIES			( 5 )   /* Increased to support more priority levels */
+#define configMAX_PRIORITIES			( 4 )   /* Priorities 0-3; each level costs one ready List_t (10 bytes) */
 #define configMINIMAL_STACK_SIZE		( 115 )
 #define configTOTAL_HEAP_SIZE			( ( size_t ) 7168 )  /* Increased for more tasks/queues */
 #define configMAX_TASK_NAME_LEN			( 8 )   /* Increased for longer task names */
@@ -58,27 +59,79 @@
 #define configCHECK_FOR_STACK_OVERFLOW  2
 #define configSUPPORT_DYNAMIC_ALLOCATION 1
 #define configUSE_QUEUE_SETS            0       /* Not needed */
-#define configUSE_COUNTING_SEMAPHORES   0       /* Not needed */
+#define configUSE_COUNTING_SEMAPHORES   1       /* UART DMA transmit slots */
+#define configUSE_QUEUE_RECEIVE_MATCHING 1      /* xQueueReceiveMatching() for xButtonQueue */
+#define configUSE_QUEUE_FAST_PATH       1       /* One critical section when send/receive/take need not block or wake */
+#define configUSE_QUEUE_DIRECT_HANDOFF  1       /* Send copies straight into a blocked xQueueReceive() buffer */
 
-/* Co-routine definitions. */
-#define configUSE_CO_ROUTINES 		1
+/* Co-routine definitions. Not used - disabling them drops the co-routine
+ * ready/delayed/pending lists (64 bytes of RAM) along with croutine.c. */
+#define configUSE_CO_ROUTINES 		0
 #define configMAX_CO_ROUTINE_PRIORITIES ( 2 )
 
+/* 8-bit index lists (list.c): 5 bytes less per TCB and 4 per List_t, about
+ * 140 bytes for the 10 tasks and 24 lists here with the tables sized to
+ * them, for 3 to 6 times the cycles per list operation (tests/test_list).
+ * Off: the tick and every block and wake pay for it. */
+#define configUSE_LIST_INDEX8			0
+
+/* Tickless idle (rtcc.c): during a running countdown the idle task stops
+ * Timer1 and sleeps until the next RTCC second. vApplicationSleep() in
+ * main.c decides whether the peripherals allow it. TickType_t is not
+ * declared yet here; with 16-bit ticks it is uint16_t. */
+#define configUSE_TICKLESS_IDLE         2
+void vApplicationSleep( uint16_t xExpectedIdleTime );
+#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime )   vApplicationSleep( xExpectedIdleTime )
+
 /* Set the following definitions to 1 to include the API function, or zero
 to exclude the API function. */
 
 #define INCLUDE_vTaskPrioritySet		1
-#define INCLUDE_uxTaskPriorityGet		0
+#define INCLUDE_uxTaskPriorityGet		1       /* Kernel inspector (inspect.c) */
 #define INCLUDE_vTaskDelete				0
 #define INCLUDE_vTaskCleanUpResources	0
 #define INCLUDE_vTaskSuspend			1
 #define INCLUDE_xTaskDelayUntil         1
 #define INCLUDE_vTaskDelay				1
+#define INCLUDE_eTaskGetState           1       /* Kernel inspector */
+#define INCLUDE_uxTaskGetStackHighWaterMark 1   /* Kernel inspector, state profiler */
+#define INCLUDE_xSemaphoreGetMutexHolder 1      /* Kernel inspector */
 
 #define configUSE_MUTEXES               1
 
+/* Interrupt priorities: an ISR that calls a FromISR API must run at this
+ * priority, as this port has no separate syscall ceiling. A kernel critical
+ * section only raises the IPL to this level, so state shared with the ISRs
+ * above it (the Timer2 PWM ISR at IPL 4) is guarded by raising the IPL to 7
+ * with SET_AND_SAVE_CPU_IPL/RESTORE_CPU_IPL instead. On this single core
+ * that also stands in for an atomic compare-and-swap. */
 #define configKERNEL_INTERRUPT_PRIORITY	0x01
 
+/* Kernel and application asserts: vAssertCalled() in main.c prints the
+ * file and line on the polled UART path and halts */
+void vAssertCalled( const char *pcFile, unsigned long ulLine );
+#define configASSERT( x )   do { if( ( x ) == 0 ) { vAssertCalled( __FILE__, __LINE__ ); } } while( 0 )
+
+/* Heap ledger (heapstat.c): every pvPortMalloc() block is charged to the
+ * task or queue it was allocated for. ucQueueType is in scope wherever
+ * traceQUEUE_CREATE is expanded. */
+#define HEAPSTAT_KIND_TASK              6
+void HeapStat_RecordBlock( void *block, unsigned int size );
+void HeapStat_ClaimBlocks( void *owner, unsigned char kind );
+#define traceMALLOC( pvAddress, uiSize )    HeapStat_RecordBlock( ( pvAddress ), ( unsigned int ) ( uiSize ) )
+#define traceTASK_CREATE( pxNewTCB )        HeapStat_ClaimBlocks( ( pxNewTCB ), HEAPSTAT_KIND_TASK )
+#define traceQUEUE_CREATE( pxNewQueue )     HeapStat_ClaimBlocks( ( pxNewQueue ), ucQueueType )
+
+/* State profiler (stateprof.c): set to 1 for a profiling build only. Adds
+ * the PROF task, a timestamp on every context switch and on entry/exit of
+ * the application ISRs, and about 500 bytes of RAM. */
+#define STATEPROF_ENABLE                0
+#if STATEPROF_ENABLE
+    #define INCLUDE_xTaskGetIdleTaskHandle      1
+    void StateProf_SwitchedIn( void *tcb );
+    #define traceTASK_SWITCHED_IN()         StateProf_SwitchedIn( ( void * ) pxCurrentTCB )
+#endif
+
 
 #ifndef SIZE_MAX
     #define SIZE_MAX    ( ( size_t ) -1 )
@@ -1,39 +1,237 @@
 #include <xc.h>
 #include <stdint.h>
+#include <stdbool.h>
 #include "adc.h"
 #include "hw_config.h"
+#include "appcfg.h"
+#include "stateprof.h"
 
 #define FCY 16000000UL
 #include <libpic30.h>
 
+/*----------------------------------------------------------------------------
+ * Background scan
+ *
+ * Timer3 triggers one conversion per period (SSRC = TMR3, ASAM = 1), and
+ * the sequencer walks the AD1CSSL/AD1CSSH channel list, filling ADC1BUF0..
+ * in order. The interrupt fires once per scan (SMPI = count - 1), when the
+ * buffer and scan pointers also wrap, so slot i always holds list entry i.
+ * The ISR copies the buffers into a small ring of timestamped vectors.
+ *--------------------------------------------------------------------------*/
+
+#define ADC_SSRC_TMR3           0b0010      /* Timer3 match starts conversion */
+#define ADC_SCAN_IPL            configKERNEL_INTERRUPT_PRIORITY  /* Notifies tasks */
+#define ADC_SCAN_RING_DEPTH     4           /* Power of two */
+
+/* Timer3 at FCY/64; one period per conversion. The scan period comes from
+ * the configuration image (ADC_SCAN_PERIOD_MS by default). */
+#define ADC_T3_PRESCALE         64UL
+#define ADC_T3_PR               ((uint16_t)(((unsigned long)configCPU_CLOCK_HZ / ADC_T3_PRESCALE) \
+                                  * AppCfg_Get()->adc_scan_period_ms / 1000UL / ADC_SCAN_COUNT - 1UL))
+
+/* CTMU current range that biases the temperature diode */
+#define ADC_TEMP_IRNG           0b10
+
+static const uint8_t scan_list[ADC_SCAN_COUNT] = ADC_SCAN_LIST;
+
+static AdcScanVector_t scan_ring[ADC_SCAN_RING_DEPTH];
+static volatile uint16_t scan_count = 0;        /* Completed scans */
+
+/* Pot change window: the watcher is only woken when a scan lands outside
+ * pot_center +/- pot_window, and the window then re-centers on that sample.
+ * Done here rather than with the converter's threshold compare (AD1CON5
+ * CM/ASINTMP): the scan interrupt has to run every period anyway for the
+ * vector ring and the pot aggregators, so hardware compare would save no
+ * interrupts, and its window would need rewriting on every re-center. What
+ * the window saves is task wakes - 0/s for a still pot (test_adc.c). */
+#define ADC_POT_UNSET           0xFFFF
+static TaskHandle_t pot_watcher = NULL;
+static uint16_t pot_center = ADC_POT_UNSET;
+static uint16_t pot_window = 0;
+
+/* Windowed pot statistics, fed from every scan */
+#define ADC_POT_AGGS            2
+static WinAgg_t *pot_aggs[ADC_POT_AGGS] = { NULL, NULL };
+
+/* Scan blocks: the ISR fills the producer half one vector per scan, so a
+ * consumer sees every scan in order at one wake per block, where polling
+ * ADC_GetScan() would need a wake per scan not to skip any */
+static PingPong_t *scan_pp = NULL;
+static AdcScanVector_t *scan_block = NULL;
+static uint8_t scan_block_scans = 0;
+static uint8_t scan_block_fill = 0;
+
 void init_ADC(void) {
+    uint16_t cssl = 0;
+    uint16_t cssh = 0;
+    uint8_t i;
+
     ANSAbits.ANSA3 = 1;     // RA3 = analog
     TRISAbits.TRISA3 = 1;   // RA3 input
     
     AD1CON1bits.ADON = 0;   // Disable ADC
     AD1CON1bits.FORM = 0;   // Integer
-    AD1CON1bits.SSRC = 0b111; // Internal counter ends sampling
-    AD1CON1bits.ASAM = 0;   // Manual sampling
+    AD1CON1bits.SSRC = ADC_SSRC_TMR3; // Timer3 ends sampling, starts conversion
+    AD1CON1bits.ASAM = 1;   // Sampling restarts after each conversion
     AD1CON1bits.MODE12 = 0; // 10-bit mode for lab spec
     
-    AD1CON2 = 0;            // Use MUXA, AVdd/AVss
+    AD1CON2 = 0;            // AVdd/AVss
+    AD1CON2bits.CSCNA = 1;  // Scan the AD1CSSx list on MUXA
+    AD1CON2bits.SMPI = ADC_SCAN_COUNT - 1; // Interrupt once per scan
     
     AD1CON3bits.ADCS = 10;  // TAD
-    AD1CON3bits.SAMC = 15;  // Sample time
+    AD1CON3bits.SAMC = 15;  // Sample time (auto-sample is ended by Timer3)
     
-    AD1CHSbits.CH0SA = 5;   // AN5 input (note: your code says AN3 but CH0SA=5 is AN5)
     AD1CHSbits.CH0NA = 0;   // VSS-
     
+    for (i = 0; i < ADC_SCAN_COUNT; i++) {
+        if (scan_list[i] < 16) {
+            cssl |= (uint16_t)1 << scan_list[i];
+        } else {
+            cssh |= (uint16_t)1 << (scan_list[i] - 16);
+        }
+    }
+    AD1CSSL = cssl;
+    AD1CSSH = cssh;
+
+    /* Temperature diode needs the CTMU current source */
+    CTMUCON1Lbits.IRNG = ADC_TEMP_IRNG;
+    CTMUCON1Lbits.CTMUEN = 1;
+
+    IFS0bits.AD1IF = 0;
+    IPC3bits.AD1IP = ADC_SCAN_IPL;
+    IEC0bits.AD1IE = 1;
+
     AD1CON1bits.ADON = 1;   // Turn on ADC
     __delay_ms(2);
+
+    /* Conversion trigger */
+    T3CON = 0;
+    T3CONbits.TCKPS = 0b10; // 1:64
+    TMR3 = 0;
+    PR3 = ADC_T3_PR;
+    T3CONbits.TON = 1;
+}
+
+void __attribute__((interrupt, no_auto_psv)) _ADC1Interrupt(void)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    volatile uint16_t *buf = &ADC1BUF0;
+    uint16_t count = scan_count;
+    AdcScanVector_t *slot = &scan_ring[count & (ADC_SCAN_RING_DEPTH - 1)];
+    uint8_t i;
+    STATEPROF_ISR_ENTER();
+
+    IFS0bits.AD1IF = 0;
+
+    for (i = 0; i < ADC_SCAN_COUNT; i++) {
+        slot->value[i] = buf[i];
+    }
+    slot->timestamp = xTaskGetTickCountFromISR();
+    slot->sequence = count;
+
+    scan_count = count + 1;
+
+    if (pot_watcher != NULL) {
+        uint16_t pot = slot->value[ADC_SCAN_POT_INDEX];
+
+        if (pot > pot_center + pot_window || pot + pot_window < pot_center) {
+            pot_center = pot;
+            vTaskNotifyGiveFromISR(pot_watcher, &xHigherPriorityTaskWoken);
+        }
+    }
+
+    for (i = 0; i < ADC_POT_AGGS; i++) {
+        if (pot_aggs[i] != NULL) {
+            WinAgg_Add(pot_aggs[i], (int16_t)slot->value[ADC_SCAN_POT_INDEX],
+                       slot->timestamp);
+        }
+    }
+
+    if (scan_pp != NULL) {
+        scan_block[scan_block_fill] = *slot;
+        if (++scan_block_fill == scan_block_scans) {
+            scan_block = (AdcScanVector_t *)PingPong_SwapFromISR(scan_pp,
+                             scan_block_scans * sizeof(AdcScanVector_t),
+                             &xHigherPriorityTaskWoken);
+            scan_block_fill = 0;
+        }
+    }
+    STATEPROF_ISR_EXIT(STATEPROF_ISR_ADC1);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+bool ADC_GetScan(AdcScanVector_t *out) {
+    uint16_t saved_ipl;
+    uint16_t count;
+
+    /* Copy with the ADC interrupt held off so the vector is not torn */
+    SET_AND_SAVE_CPU_IPL(saved_ipl, 7);
+    count = scan_count;
+    if (count != 0) {
+        *out = scan_ring[(count - 1) & (ADC_SCAN_RING_DEPTH - 1)];
+    }
+    RESTORE_CPU_IPL(saved_ipl);
+
+    return (count != 0);
+}
+
+void ADC_PotWatch(TaskHandle_t task, uint16_t half_width) {
+    uint16_t saved_ipl;
+
+    SET_AND_SAVE_CPU_IPL(saved_ipl, 7);
+    pot_watcher = task;
+    pot_window = half_width;
+    pot_center = ADC_POT_UNSET;     /* First scan always reports */
+    RESTORE_CPU_IPL(saved_ipl);
+}
+
+bool ADC_PotAggregate(WinAgg_t *agg) {
+    uint16_t saved_ipl;
+    bool added = false;
+    uint8_t i;
+
+    SET_AND_SAVE_CPU_IPL(saved_ipl, 7);
+    for (i = 0; i < ADC_POT_AGGS && !added; i++) {
+        if (pot_aggs[i] == NULL) {
+            pot_aggs[i] = agg;
+            added = true;
+        }
+    }
+    RESTORE_CPU_IPL(saved_ipl);
+    return added;
+}
+
+void ADC_ScanBlocks(PingPong_t *pp, uint8_t scans) {
+    uint16_t saved_ipl;
+
+    configASSERT(pp == NULL || scans != 0);
+
+    SET_AND_SAVE_CPU_IPL(saved_ipl, 7);
+    scan_pp = pp;
+    scan_block = (pp != NULL) ? (AdcScanVector_t *)PingPong_ProducerBlock(pp) : NULL;
+    scan_block_scans = scans;
+    scan_block_fill = 0;
+    RESTORE_CPU_IPL(saved_ipl);
 }
 
 uint16_t do_ADC(void) {
-    AD1CON1bits.SAMP = 1;   // Start sampling
-    __delay_us(20);
-    AD1CON1bits.SAMP = 0;   // Start conversion
-    while(!AD1CON1bits.DONE); // Wait
-    return ADC1BUF0;
+    AdcScanVector_t scan;
+
+    if (!ADC_GetScan(&scan)) {
+        return 0;
+    }
+    return scan.value[ADC_SCAN_POT_INDEX];
+}
+
+uint16_t ADC_SupplyMillivolts(const AdcScanVector_t *scan) {
+    uint16_t vbg = scan->value[ADC_SCAN_VBG_INDEX];
+
+    if (vbg == 0) {
+        return 0;
+    }
+    /* vbg = VBG * 1023 / AVdd  ->  AVdd = VBG * 1023 / vbg */
+    return (uint16_t)(((uint32_t)ADC_VBG_MV * ADC_MAX_VALUE) / vbg);
 }
 
 uint8_t ADC_ToPercent(uint16_t adc_value)
@@ -134,7 +134,6 @@ extern SemaphoreHandle_t xStartCountdownSem;/* Signal to start countdown */
 extern SemaphoreHandle_t xCompletionSem;    /* Signal countdown complete */
 
 /* Mutexes for shared resource protection */
-extern SemaphoreHandle_t xUartMutex;        /* Protect UART transmissions */
 extern SemaphoreHandle_t xCountdownMutex;   /* Protect countdown data */
 extern SemaphoreHandle_t xBrightnessMutex;  /* Protect brightness data */
 extern SemaphoreHandle_t xStateMutex;       /* Protect system state */
@@ -151,6 +150,43 @@ extern volatile BrightnessData_t g_BrightnessData;
 
 #define BUTTON_QUEUE_SIZE       10
 #define UART_RX_QUEUE_SIZE      32
+#define LOG_TX_CHUNK            32  /* Bytes per UART DMA block; vLogTask alternates two, one per DMA slot */
+
+/*============================================================================
+ * TELEMETRY
+ *============================================================================*/
+
+#define TELEM_FLUSH_PERIOD_MS   10000   /* TLOG task check interval */
+#define TELEM_FLUSH_WORDS       48      /* Flush in any state past this fill */
+#define TELEM_POT_INTERVAL_MS   5000    /* At most one pot record per interval */
+#define TELEM_STREAM_BLOCK_SCANS 5     /* ADC scans per block handed to TLOG */
+#define TELEM_STREAM_BLOCK      72      /* Packed bytes per "@tz" line */
+#define TELEM_STREAM_KEY_BLOCKS 8       /* Every 8th line decodes on its own */
+
+/* Must match portTIMER_PRESCALE in port.c, as in boot.c */
+#define TELEM_TIMER_PRESCALE    8UL
+#define TELEM_COUNTS_PER_TICK   (configCPU_CLOCK_HZ / TELEM_TIMER_PRESCALE / configTICK_RATE_HZ)
+#define TELEM_US_PER_COUNT      (TELEM_TIMER_PRESCALE * 1000000UL / configCPU_CLOCK_HZ)
+
+/* Windowed statistics ('a'): window lengths, and how often the tick hook
+ * samples tick latency and queue depths */
+#define AGG_FAST_WINDOW_MS      100
+#define AGG_SLOW_WINDOW_MS      1000
+#define AGG_SAMPLE_TICKS        10
+
+/* RCON reset-cause flags: TRAPR IOPUWR CM EXTR SWR WDTO BOR POR */
+#define TELEM_RCON_CAUSES       0xC2D3
+
+/*============================================================================
+ * DISPLAY DEFAULTS
+ * 
+ * Power-on values of g_DisplaySettings (0 or 1). These, the queue sizes
+ * above and the timing constants in hw_config.h are only the compiled-in
+ * defaults - a configuration image in flash overrides them (appcfg.h).
+ *============================================================================*/
+
+#define DISPLAY_EXTENDED_INFO_DEFAULT   0
+#define DISPLAY_LED2_SOLID_DEFAULT      0
 
 /*============================================================================
  * TASK PRIORITIES
@@ -162,9 +198,13 @@ extern volatile BrightnessData_t g_BrightnessData;
 #define PRIORITY_PWM            3   /* Highest - timing critical */
 #define PRIORITY_COUNTDOWN      2   /* High - accuracy important */
 #define PRIORITY_BUTTON_HANDLER 2   /* High - responsiveness */
+#define PRIORITY_UART_RX        2   /* High - forwards typed keys */
 #define PRIORITY_TIME_INPUT     1   /* Medium */
 #define PRIORITY_WAITING        1   /* Medium */
+#define PRIORITY_LOG            1   /* Medium - drains UART log buffer */
 #define PRIORITY_ADC            0   /* Low - not time critical */
+#define PRIORITY_TELEM          0   /* Low - flash writes wait for WAITING */
+#define PRIORITY_PROF           0   /* Low - profiling builds only */
 #define PRIORITY_IDLE           0   /* Lowest */
 
 /*============================================================================
@@ -176,7 +216,11 @@ extern volatile BrightnessData_t g_BrightnessData;
 #define STACK_SIZE_COUNTDOWN    (configMINIMAL_STACK_SIZE + 50)
 #define STACK_SIZE_PWM          configMINIMAL_STACK_SIZE
 #define STACK_SIZE_BUTTON       configMINIMAL_STACK_SIZE
+#define STACK_SIZE_UART_RX      configMINIMAL_STACK_SIZE
 #define STACK_SIZE_ADC          configMINIMAL_STACK_SIZE
+#define STACK_SIZE_LOG          configMINIMAL_STACK_SIZE
+#define STACK_SIZE_TELEM        (configMINIMAL_STACK_SIZE + 64)
+#define STACK_SIZE_PROF         (configMINIMAL_STACK_SIZE + 64)
 
 /*============================================================================
  * FUNCTION PROTOTYPES - Task functions
@@ -189,8 +233,11 @@ void vCountdownTask(void *pvParameters);
 
 /* Supporting tasks */
 void vButtonTask(void *pvParameters);
+void vUartRxTask(void *pvParameters);
 void vPwmTask(void *pvParameters);
 void vAdcTask(void *pvParameters);
+void vLogTask(void *pvParameters);
+void vTelemTask(void *pvParameters);
 
 /*============================================================================
  * FUNCTION PROTOTYPES - Initialization
@@ -202,6 +249,9 @@ void App_InitRTOSObjects(void);
 /* Initialize hardware peripherals */
 void App_InitHardware(void);
 
+/* Initialize non-critical peripherals (after the scheduler starts) */
+void App_InitDeferred(void);
+
 /*============================================================================
  * HELPER MACROS
  *============================================================================*/
@@ -0,0 +1,193 @@
+/*
+ * File:   appcfg.c
+ * Author: ENCM 511
+ *
+ * Flash Configuration Image Implementation
+ *
+ * Description: Slot selection at boot and the erase/program/verify update
+ *              path. The slot pages are reserved with a noload array, so
+ *              the linker keeps code out of them and the programmer leaves
+ *              them alone unless an image from tools/cfgimage.py is merged
+ *              into the .hex.
+ *
+ * Created on Nov 2025
+ */
+
+#include "appcfg.h"
+#include "app.h"
+#include "crc.h"
+#include "hw_config.h"
+#include "nvm.h"
+#include <xc.h>
+
+/*============================================================================
+ * CONFIGURATION CONSTANTS
+ *============================================================================*/
+
+/* One data word per instruction, so a slot page holds this many words */
+#define APPCFG_PAGE_WORDS       ((uint16_t)(APPCFG_PAGE_SIZE / 2))
+#define APPCFG_IMAGE_WORDS      (sizeof(AppConfigImage_t) / 2)
+
+/* Fails to compile unless the image is a whole number of double words */
+typedef char appcfg_image_size_check[(APPCFG_IMAGE_WORDS % 2 == 0) ? 1 : -1];
+
+/*============================================================================
+ * STATIC VARIABLES
+ *============================================================================*/
+
+/* Erased flash reads 0xFFFF, so an empty slot fails the magic check */
+static __prog__ const uint16_t appcfg_pages[APPCFG_SLOTS][APPCFG_PAGE_WORDS]
+    __attribute__((space(prog), address(APPCFG_FLASH_ADDR), noload));
+
+static __prog__ const AppConfig_t appcfg_defaults __attribute__((space(prog))) = {
+    BUTTON_DEBOUNCE_MS,
+    BUTTON_LONG_PRESS_MS,
+    PWM_FREQUENCY_HZ,
+    ADC_SCAN_PERIOD_MS,
+    BUTTON_QUEUE_SIZE,
+    UART_RX_QUEUE_SIZE,
+    DISPLAY_EXTENDED_INFO_DEFAULT,
+    DISPLAY_LED2_SOLID_DEFAULT
+};
+
+static const __prog__ AppConfig_t *appcfg_active = &appcfg_defaults;
+static uint8_t appcfg_slot = APPCFG_SLOT_DEFAULTS;
+static uint16_t appcfg_sequence = 0;
+
+/*============================================================================
+ * STATIC HELPER FUNCTIONS
+ *============================================================================*/
+
+static const __prog__ AppConfigImage_t *SlotImage(uint8_t slot)
+{
+    return (const __prog__ AppConfigImage_t *)&appcfg_pages[slot][0];
+}
+
+static bool InRange(uint16_t value, uint16_t min, uint16_t max)
+{
+    return value >= min && value <= max;
+}
+
+static bool SettingsValid(const AppConfig_t *cfg)
+{
+    return InRange(cfg->button_debounce_ms, APPCFG_DEBOUNCE_MIN, APPCFG_DEBOUNCE_MAX) &&
+           InRange(cfg->button_long_press_ms, APPCFG_LONG_PRESS_MIN, APPCFG_LONG_PRESS_MAX) &&
+           cfg->button_long_press_ms > cfg->button_debounce_ms &&
+           InRange(cfg->pwm_frequency_hz, APPCFG_PWM_HZ_MIN, APPCFG_PWM_HZ_MAX) &&
+           InRange(cfg->adc_scan_period_ms, APPCFG_ADC_MS_MIN, APPCFG_ADC_MS_MAX) &&
+           InRange(cfg->button_queue_size, APPCFG_BTN_QUEUE_MIN, APPCFG_BTN_QUEUE_MAX) &&
+           InRange(cfg->uart_rx_queue_size, APPCFG_RX_QUEUE_MIN, APPCFG_RX_QUEUE_MAX) &&
+           cfg->show_extended_info <= 1 &&
+           cfg->led2_solid_mode <= 1;
+}
+
+/**
+ * @brief Check header, CRC and ranges of the image in a slot
+ *
+ * Reads the image in place; this is the whole boot-time cost.
+ */
+static bool SlotValid(uint8_t slot)
+{
+    const __prog__ AppConfigImage_t *img = SlotImage(slot);
+    AppConfig_t cfg;
+    Crc16_t crc;
+
+    if (img->magic != APPCFG_MAGIC || img->version != APPCFG_VERSION ||
+        img->length != sizeof(AppConfigImage_t)) {
+        return false;
+    }
+
+    Crc16_Init(&crc);
+    Crc16_UpdateProg(&crc, img, sizeof(AppConfigImage_t) - 2);
+    if (Crc16_Final(&crc) != img->crc) {
+        return false;
+    }
+
+    /* Stack copy for the range checks only */
+    cfg = img->cfg;
+    return SettingsValid(&cfg);
+}
+
+static void Select(uint8_t slot)
+{
+    const __prog__ AppConfigImage_t *img = SlotImage(slot);
+
+    appcfg_active = &img->cfg;
+    appcfg_slot = slot;
+    appcfg_sequence = img->sequence;
+}
+
+/**
+ * @brief Erase a slot and program an image into it
+ *
+ * @return false if the controller reported a write error
+ */
+static bool ProgramSlot(uint8_t slot, const AppConfigImage_t *img)
+{
+    const uint16_t *w = (const uint16_t *)img;
+    uint16_t i;
+    bool ok;
+
+    ok = Nvm_ErasePage(&appcfg_pages[slot][0]);
+    for (i = 0; ok && i < APPCFG_IMAGE_WORDS; i += 2) {
+        ok = Nvm_ProgramDword(&appcfg_pages[slot][i], w[i], w[i + 1]);
+    }
+    return ok;
+}
+
+/*============================================================================
+ * PUBLIC FUNCTION IMPLEMENTATIONS
+ *============================================================================*/
+
+void AppCfg_Init(void)
+{
+    bool valid0 = SlotValid(0);
+    bool valid1 = SlotValid(1);
+
+    appcfg_active = &appcfg_defaults;
+    appcfg_slot = APPCFG_SLOT_DEFAULTS;
+    appcfg_sequence = 0;
+
+    if (valid0 && valid1) {
+        /* Sequence numbers wrap, so compare by signed distance */
+        int16_t newer = (int16_t)(SlotImage(1)->sequence - SlotImage(0)->sequence);
+        Select(newer > 0 ? 1 : 0);
+    } else if (valid0) {
+        Select(0);
+    } else if (valid1) {
+        Select(1);
+    }
+}
+
+const __prog__ AppConfig_t *AppCfg_Get(void)
+{
+    return appcfg_active;
+}
+
+uint8_t AppCfg_GetSlot(void)
+{
+    return appcfg_slot;
+}
+
+bool AppCfg_Write(const AppConfig_t *cfg)
+{
+    AppConfigImage_t img;
+    uint8_t target = (appcfg_slot == 0) ? 1 : 0;
+
+    img.magic = APPCFG_MAGIC;
+    img.version = APPCFG_VERSION;
+    img.length = sizeof(AppConfigImage_t);
+    img.sequence = appcfg_sequence + 1;
+    img.cfg = *cfg;
+    img.reserved = 0;
+    img.crc = Crc16_Compute(&img, sizeof(AppConfigImage_t) - 2);
+
+    /* Reject before touching flash; the verify below re-checks it */
+    if (!SettingsValid(cfg) ||
+        !ProgramSlot(target, &img) || !SlotValid(target)) {
+        return false;
+    }
+
+    Select(target);
+    return true;
+}
@@ -0,0 +1,135 @@
+/*
+ * File:   appcfg.h
+ * Author: ENCM 511
+ *
+ * Flash Configuration Image Header
+ *
+ * Description: Timing constants, display defaults and queue sizes that used
+ *              to be fixed at compile time. The values live in a CRC-checked
+ *              image in program flash and are read in place through the PSV
+ *              window. Nothing is copied to RAM; AppCfg_Get() just returns a
+ *              pointer into flash.
+ *
+ * Flash layout:
+ *   - Two erase pages just below the configuration-word page. Each page is
+ *     one slot and holds at most one image.
+ *   - Each instruction word holds one 16-bit data word in its low 16 bits,
+ *     which is all that PSV can see. The upper byte is programmed as 0.
+ *   - If neither slot holds a valid image, the compiled-in defaults from
+ *     hw_config.h and app.h are used. Those are also const data in flash.
+ *
+ * Update path (AppCfg_Write, the 'w' key in main.c):
+ *   - The new image goes into the slot that is NOT in use, with the next
+ *     sequence number, and is read back and CRC-checked before it counts.
+ *   - The active slot is never erased. A reset or power loss during an
+ *     update leaves the previous image in charge.
+ *   - At boot the valid image with the newest sequence number wins.
+ *
+ * tools/cfgimage.py builds images as Intel HEX for the programmer and
+ * checks the slots in a .hex file, using the constants below.
+ *
+ * Created on Nov 2025
+ */
+
+#ifndef APPCFG_H
+#define APPCFG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*============================================================================
+ * CONFIGURATION
+ *============================================================================*/
+
+#define APPCFG_MAGIC            0xC0F6
+#define APPCFG_VERSION          1
+
+/* Slot 0 program address and slot size (one erase page, in PC units) */
+#define APPCFG_FLASH_ADDR       0x29800UL
+#define APPCFG_PAGE_SIZE        0x800UL
+#define APPCFG_SLOTS            2
+
+/* Accepted ranges - an image with any field outside them is rejected */
+#define APPCFG_DEBOUNCE_MIN     10
+#define APPCFG_DEBOUNCE_MAX     500
+#define APPCFG_LONG_PRESS_MIN   200
+#define APPCFG_LONG_PRESS_MAX   10000
+#define APPCFG_PWM_HZ_MIN       60      /* Below this the LED flickers */
+#define APPCFG_PWM_HZ_MAX       500     /* Timer2 ISR runs at 100x this */
+#define APPCFG_ADC_MS_MIN       5
+#define APPCFG_ADC_MS_MAX       1000
+#define APPCFG_BTN_QUEUE_MIN    4
+#define APPCFG_BTN_QUEUE_MAX    20
+#define APPCFG_RX_QUEUE_MIN     8
+#define APPCFG_RX_QUEUE_MAX     64
+
+/* AppCfg_GetSlot() result when the compiled-in defaults are in use */
+#define APPCFG_SLOT_DEFAULTS    0xFF
+
+/*============================================================================
+ * TYPE DEFINITIONS
+ *============================================================================*/
+
+/* Settings - layout is fixed by APPCFG_VERSION */
+typedef struct {
+    uint16_t button_debounce_ms;
+    uint16_t button_long_press_ms;
+    uint16_t pwm_frequency_hz;
+    uint16_t adc_scan_period_ms;
+    uint8_t button_queue_size;
+    uint8_t uart_rx_queue_size;
+    uint8_t show_extended_info;     /* 0 or 1 */
+    uint8_t led2_solid_mode;        /* 0 or 1 */
+} AppConfig_t;
+
+/* Image as stored in a slot. An even number of words, so it is written
+ * with double-word programming. The CRC is CRC-16/CCITT-FALSE over every
+ * byte before it. */
+typedef struct {
+    uint16_t magic;
+    uint16_t version;
+    uint16_t length;                /* sizeof(AppConfigImage_t) */
+    uint16_t sequence;              /* Newer image has the higher value */
+    AppConfig_t cfg;
+    uint16_t reserved;              /* 0 */
+    uint16_t crc;
+} AppConfigImage_t;
+
+/*============================================================================
+ * FUNCTION PROTOTYPES
+ *============================================================================*/
+
+/**
+ * @brief Pick the newest valid slot, or the compiled-in defaults
+ *
+ * Must run before anything that reads the configuration.
+ */
+void AppCfg_Init(void);
+
+/**
+ * @brief Get the active settings
+ *
+ * @return Pointer into program flash (read through PSV, never copied)
+ */
+const __prog__ AppConfig_t *AppCfg_Get(void);
+
+/**
+ * @brief Get the slot the settings came from
+ *
+ * @return 0 or 1, or APPCFG_SLOT_DEFAULTS
+ */
+uint8_t AppCfg_GetSlot(void);
+
+/**
+ * @brief Store new settings in the unused slot and switch to them
+ *
+ * The CPU stalls while the page is erased and programmed, so call this
+ * from task context when nothing is timing critical. Timer periods and
+ * queue sizes take effect at the next reset.
+ *
+ * @param cfg New settings
+ * @return true if the image was written, verified and made active
+ */
+bool AppCfg_Write(const AppConfig_t *cfg);
+
+#endif /* APPCFG_H */
@@ -0,0 +1,156 @@
+/*
+ * File:   boot.c
+ * Author: ENCM 511
+ *
+ * Boot Sequencer Implementation
+ *
+ * Description: Stage table plus the Timer1-based boot clock. The report is
+ *              formatted by hand (no printf) and queued on the log buffer
+ *              like any other terminal output.
+ *
+ * Created on Nov 2025
+ */
+
+#include "boot.h"
+#include "task.h"
+#include "logbuf.h"
+#include "fmt.h"
+#include <xc.h>
+#include <stdbool.h>
+#include <string.h>
+
+/*============================================================================
+ * CONFIGURATION CONSTANTS
+ *============================================================================*/
+
+/* Must match portTIMER_PRESCALE in port.c so TMR1 keeps the same units */
+#define BOOT_TIMER_PRESCALE     8UL
+
+/* Microseconds per TMR1 count and per RTOS tick */
+#define BOOT_US_PER_COUNT       ((BOOT_TIMER_PRESCALE * 1000000UL) / configCPU_CLOCK_HZ)
+#define BOOT_US_PER_TICK        (1000000UL / configTICK_RATE_HZ)
+
+/*============================================================================
+ * STATIC VARIABLES
+ *============================================================================*/
+
+typedef struct {
+    const char *name;
+    uint32_t us;
+} BootStage_t;
+
+static BootStage_t boot_stages[BOOT_MAX_STAGES];
+static uint8_t boot_stage_count = 0;
+
+/* Pre-scheduler: TMR1 wraps seen so far. Post-scheduler: time at start. */
+static uint32_t boot_wraps = 0;
+static uint32_t boot_sched_us = 0;
+static bool boot_scheduler_running = false;
+
+/*============================================================================
+ * PUBLIC FUNCTION IMPLEMENTATIONS
+ *============================================================================*/
+
+void Boot_Start(void)
+{
+    /* Free-running; the port reprograms Timer1 when the scheduler starts */
+    T1CON = 0;
+    TMR1 = 0;
+    PR1 = 0xFFFF;
+    IFS0bits.T1IF = 0;
+    T1CONbits.TCKPS = 0b01;     /* 1:8 */
+    T1CONbits.TON = 1;
+
+    boot_stage_count = 0;
+    boot_wraps = 0;
+    boot_scheduler_running = false;
+}
+
+uint32_t Boot_Micros(void)
+{
+    TickType_t ticks;
+    uint16_t counts;
+
+    if (!boot_scheduler_running) {
+        /* Each stage is far shorter than one wrap (131 ms at 4 MHz) */
+        counts = TMR1;
+        if (IFS0bits.T1IF) {
+            IFS0bits.T1IF = 0;
+            boot_wraps++;
+            counts = TMR1;
+        }
+        return ((boot_wraps << 16) + counts) * BOOT_US_PER_COUNT;
+    }
+
+    /* Re-read if a tick lands between the two reads */
+    do {
+        ticks = xTaskGetTickCount();
+        counts = TMR1;
+    } while (ticks != xTaskGetTickCount());
+
+    return boot_sched_us + (uint32_t)ticks * BOOT_US_PER_TICK +
+           (uint32_t)counts * BOOT_US_PER_COUNT;
+}
+
+void Boot_Mark(const char *name)
+{
+    uint32_t now = Boot_Micros();
+
+    if (boot_scheduler_running) {
+        taskENTER_CRITICAL();
+    }
+    if (boot_stage_count < BOOT_MAX_STAGES) {
+        boot_stages[boot_stage_count].name = name;
+        boot_stages[boot_stage_count].us = now;
+        boot_stage_count++;
+    }
+    if (boot_scheduler_running) {
+        taskEXIT_CRITICAL();
+    }
+}
+
+void Boot_SchedulerStarting(void)
+{
+    boot_sched_us = Boot_Micros();
+    Boot_Mark("sched");
+    boot_scheduler_running = true;
+}
+
+void Boot_Report(void)
+{
+    /* Not on the stack: the caller may be a minimal-stack task */
+    static char line[96];
+    char *p;
+    uint8_t count;
+    uint8_t i;
+
+    taskENTER_CRITICAL();
+    count = boot_stage_count;
+    taskEXIT_CRITICAL();
+
+    p = Fmt_AppendStr(line, "\r\n[boot]");
+    for (i = 0; i < count; i++) {
+        /* Flush before " name=4294967295us" could overflow the line */
+        if (p - line > (int)sizeof(line) - 32) {
+            LogBuf_Write(line, (uint16_t)(p - line), pdMS_TO_TICKS(100));
+            p = line;
+        }
+        p = Fmt_AppendStr(p, " ");
+        p = Fmt_AppendStr(p, boot_stages[i].name);
+        p = Fmt_AppendStr(p, "=");
+        p = Fmt_AppendU32(p, boot_stages[i].us);
+        p = Fmt_AppendStr(p, "us");
+    }
+    p = Fmt_AppendStr(p, "\r\n");
+    LogBuf_Write(line, (uint16_t)(p - line), pdMS_TO_TICKS(100));
+
+    for (i = 0; i < count; i++) {
+        if (strcmp(boot_stages[i].name, "prompt") == 0) {
+            p = Fmt_AppendStr(line, "[boot] time to first prompt: ");
+            p = Fmt_AppendU32(p, boot_stages[i].us);
+            p = Fmt_AppendStr(p, " us\r\n");
+            LogBuf_Write(line, (uint16_t)(p - line), pdMS_TO_TICKS(100));
+            break;
+        }
+    }
+}
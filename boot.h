@@ -0,0 +1,71 @@
+/*
+ * File:   boot.h
+ * Author: ENCM 511
+ *
+ * Boot Sequencer Header
+ *
+ * Description: Timestamps each init stage from reset onwards so the cost
+ *              of every stage, and the time until the welcome prompt is
+ *              queued, can be read back on the terminal.
+ *
+ * Time base:
+ *   - Before the scheduler starts, Timer1 free-runs with the same 1:8
+ *     prescale the FreeRTOS port later uses for the tick.
+ *   - Afterwards, time is the value captured at scheduler start plus
+ *     tick count * tick period plus TMR1 within the current tick.
+ *   - Resolution is portTIMER_PRESCALE / FCY (2 us at 4 MHz).
+ *
+ * Created on Nov 2025
+ */
+
+#ifndef BOOT_H
+#define BOOT_H
+
+#include "FreeRTOS.h"
+#include <stdint.h>
+
+/*============================================================================
+ * CONFIGURATION
+ *============================================================================*/
+
+/* Maximum number of stages recorded */
+#define BOOT_MAX_STAGES         12
+
+/*============================================================================
+ * FUNCTION PROTOTYPES
+ *============================================================================*/
+
+/**
+ * @brief Start the boot clock - call first thing in main()
+ */
+void Boot_Start(void);
+
+/**
+ * @brief Record that a stage has finished
+ *
+ * Safe from main() and from tasks. Stages past BOOT_MAX_STAGES are ignored.
+ *
+ * @param name Stage name (must be a string literal or otherwise static)
+ */
+void Boot_Mark(const char *name);
+
+/**
+ * @brief Switch the clock over to the RTOS tick - call just before
+ *        vTaskStartScheduler()
+ */
+void Boot_SchedulerStarting(void);
+
+/**
+ * @brief Microseconds since Boot_Start()
+ */
+uint32_t Boot_Micros(void);
+
+/**
+ * @brief Queue the recorded stages on the log buffer
+ *
+ * Prints every stage with its time since reset and the time-to-first-prompt
+ * figure (the "prompt" stage) if it has been recorded.
+ */
+void Boot_Report(void);
+
+#endif /* BOOT_H */
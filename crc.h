@@ -0,0 +1,117 @@
+/*
+ * File:   crc.h
+ * Author: ENCM 511
+ *
+ * CRC-16 Service Header
+ *
+ * Description: CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF, MSB first,
+ *              no final XOR) for every framed output: configuration
+ *              images, telemetry records, log frames. Check value for
+ *              "123456789" is 0x29B1, the same as tools/cfgimage.py.
+ *
+ * Paths:
+ *   - Hardware: the PIC24 programmable CRC module. Crc16_Update() only
+ *     writes bytes into its 16-deep FIFO and returns; the engine shifts
+ *     the last FIFO load while the caller carries on, and Crc16_Final()
+ *     collects the result.
+ *   - Software: two 256-entry tables in flash, two bytes per step
+ *     (slice-by-2; with a 16-bit CRC a wider slice adds tables without
+ *     saving lookups). Used for the host build (CRC_USE_HARDWARE 0), for
+ *     short streams, and whenever another stream has the engine.
+ *
+ * Engine ownership:
+ *   - A stream claims the engine on its first update if that update is at
+ *     least CRC_HW_MIN_BYTES long and the engine is free, and keeps it
+ *     until Crc16_Final(). Every Crc16_Init() must therefore end in a
+ *     Crc16_Final().
+ *   - The claim is made at IPL 7 (see FreeRTOSConfig.h), so streams may
+ *     run in any task or ISR. A stream that finds the engine busy runs in
+ *     software; it never waits.
+ *   - Crc_Init() checks the engine against the tables at boot and leaves
+ *     it unused if they disagree.
+ *   - Every wait on the engine is bounded. An engine that stalls is
+ *     switched off and later streams run in software; the stream that had
+ *     it gets a CRC that will not verify (for a lost stream,
+ *     Crc16_Final() returns CRC16_INIT).
+ *
+ * Created on Nov 2025
+ */
+
+#ifndef CRC_H
+#define CRC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*============================================================================
+ * CONFIGURATION
+ *============================================================================*/
+
+/* 0 builds the table path only (host builds, parts without the module) */
+#ifndef CRC_USE_HARDWARE
+#define CRC_USE_HARDWARE        1
+#endif
+
+/* Shorter first updates are cheaper in software than claiming the engine */
+#define CRC_HW_MIN_BYTES        16
+
+#define CRC16_INIT              0xFFFF
+
+/*============================================================================
+ * TYPE DEFINITIONS
+ *============================================================================*/
+
+/* Stream state - contents are private to crc.c */
+typedef struct {
+    uint16_t crc;                   /* Software path value */
+    uint8_t mode;
+} Crc16_t;
+
+/*============================================================================
+ * FUNCTION PROTOTYPES
+ *============================================================================*/
+
+/**
+ * @brief Configure the CRC module and check it against the tables
+ *
+ * Call once before the scheduler starts. Without it every stream runs
+ * in software.
+ */
+void Crc_Init(void);
+
+/**
+ * @brief True if Crc_Init() found the engine giving correct results
+ *
+ * Goes false for good if the engine later stalls. The boot report shows
+ * the result at init as the "crc-hw" or "crc-sw" stage.
+ */
+bool Crc_HardwareActive(void);
+
+/**
+ * @brief Start a stream
+ */
+void Crc16_Init(Crc16_t *c);
+
+/**
+ * @brief Add bytes from RAM
+ */
+void Crc16_Update(Crc16_t *c, const void *data, uint16_t len);
+
+/**
+ * @brief Add bytes from program flash (read through PSV)
+ */
+void Crc16_UpdateProg(Crc16_t *c, const __prog__ void *data, uint16_t len);
+
+/**
+ * @brief End the stream and release the engine if it had it
+ *
+ * @return The CRC
+ */
+uint16_t Crc16_Final(Crc16_t *c);
+
+/**
+ * @brief One-shot CRC of a RAM buffer
+ */
+uint16_t Crc16_Compute(const void *data, uint16_t len);
+
+#endif /* CRC_H */
@@ -0,0 +1,121 @@
+/*
+ * File:   deltapack.c
+ * Author: ENCM 511
+ *
+ * Delta/Varint Telemetry Packer Implementation
+ *
+ * Description: Token encoder for deltapack.h. Only 16-bit arithmetic on
+ *              the hot path; a token is at most 17 bits, built in a
+ *              uint32_t only for the varint split.
+ *
+ * Created on Nov 2025
+ */
+
+#include "deltapack.h"
+
+/*============================================================================
+ * CONFIGURATION CONSTANTS
+ *============================================================================*/
+
+/* Runs are sent before they outgrow a 3-byte token */
+#define DELTAPACK_MAX_RUN       0x7FFF
+
+/*============================================================================
+ * STATIC HELPER FUNCTIONS
+ *============================================================================*/
+
+static uint8_t PutVarint(uint8_t *out, uint32_t value)
+{
+    uint8_t n = 0;
+
+    while (value >= 0x80) {
+        out[n++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    out[n++] = (uint8_t)value;
+    return n;
+}
+
+static uint8_t PutRun(DeltaPack_t *s, uint8_t *out)
+{
+    uint8_t n = 0;
+
+    if (s->run != 0) {
+        n = PutVarint(out, ((uint32_t)s->run << 1) | 1);
+        s->run = 0;
+    }
+    return n;
+}
+
+/*============================================================================
+ * PUBLIC FUNCTION IMPLEMENTATIONS
+ *============================================================================*/
+
+void DeltaPack_Init(DeltaPack_t *s, uint8_t fields)
+{
+    s->fields = (fields > DELTAPACK_MAX_FIELDS) ? DELTAPACK_MAX_FIELDS : fields;
+    DeltaPack_Reset(s);
+}
+
+void DeltaPack_Reset(DeltaPack_t *s)
+{
+    uint8_t i;
+
+    for (i = 0; i < DELTAPACK_MAX_FIELDS; i++) {
+        s->prev[i] = 0;
+    }
+    s->run = 0;
+}
+
+uint8_t DeltaPack_Encode(DeltaPack_t *s, const int16_t *sample, uint8_t *out)
+{
+    uint8_t n = 0;
+    uint8_t i;
+
+    for (i = 0; i < s->fields; i++) {
+        int16_t delta = (int16_t)((uint16_t)sample[i] - (uint16_t)s->prev[i]);
+        uint16_t zigzag;
+
+        if (delta == 0) {
+            if (++s->run == DELTAPACK_MAX_RUN) {
+                n += PutRun(s, out + n);
+            }
+            continue;
+        }
+
+        n += PutRun(s, out + n);
+        zigzag = (uint16_t)((uint16_t)delta << 1) ^ (uint16_t)(delta >> 15);
+        n += PutVarint(out + n, (uint32_t)zigzag << 1);
+        s->prev[i] = sample[i];
+    }
+    return n;
+}
+
+uint8_t DeltaPack_Flush(DeltaPack_t *s, uint8_t *out)
+{
+    return PutRun(s, out);
+}
+
+uint16_t DeltaPack_Base64(const uint8_t *in, uint16_t len, char *out)
+{
+    static const char alphabet[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    uint16_t n = 0;
+    uint16_t i;
+
+    for (i = 0; i < len; i += 3) {
+        uint32_t group = (uint32_t)in[i] << 16;
+
+        if (i + 1 < len) {
+            group |= (uint16_t)in[i + 1] << 8;
+        }
+        if (i + 2 < len) {
+            group |= in[i + 2];
+        }
+        out[n++] = alphabet[(group >> 18) & 0x3F];
+        out[n++] = alphabet[(group >> 12) & 0x3F];
+        out[n++] = (i + 1 < len) ? alphabet[(group >> 6) & 0x3F] : '=';
+        out[n++] = (i + 2 < len) ? alphabet[group & 0x3F] : '=';
+    }
+    return n;
+}
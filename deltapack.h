@@ -0,0 +1,97 @@
+/*
+ * File:   deltapack.h
+ * Author: ENCM 511
+ *
+ * Delta/Varint Telemetry Packer Header
+ *
+ * Description: Streaming compressor for fixed-layout telemetry samples
+ *              (ADC readings, duty cycle, state codes) that change slowly.
+ *              Each field is sent as the difference from its previous
+ *              value, and runs of unchanged fields collapse into one token.
+ *              A stream needs only the previous sample and a run counter;
+ *              nothing is buffered.
+ *
+ * Encoding (one token per changed field, or per run of unchanged ones):
+ *   - Fields are int16; the delta wraps modulo 2^16.
+ *   - Changed field:    varint(zigzag(delta) << 1)
+ *   - Unchanged run:    varint(run << 1 | 1), run counted in fields and
+ *                       carried across sample boundaries
+ *   - varint is 7 bits per byte, low group first, top bit = more follows.
+ *   - So a delta of -32..+31 or a run of up to 63 fields is one byte.
+ *
+ * Blocks:
+ *   - DeltaPack_Reset() starts a block with every previous value at 0,
+ *     so a block decodes on its own; DeltaPack_Flush() ends it.
+ *   - tools/deltapack.py decodes blocks and re-encodes recorded traces
+ *     with the same rules to report the compression ratio.
+ *
+ * Created on Nov 2025
+ */
+
+#ifndef DELTAPACK_H
+#define DELTAPACK_H
+
+#include <stdint.h>
+
+/*============================================================================
+ * CONFIGURATION
+ *============================================================================*/
+
+#define DELTAPACK_MAX_FIELDS    8
+
+/* Worst case output of one DeltaPack_Encode() call */
+#define DELTAPACK_MAX_SAMPLE_BYTES(fields)  (3 * (fields) + 3)
+
+/*============================================================================
+ * TYPE DEFINITIONS
+ *============================================================================*/
+
+/* Stream state - contents are private to deltapack.c */
+typedef struct {
+    int16_t prev[DELTAPACK_MAX_FIELDS];
+    uint16_t run;                   /* Unchanged fields not yet sent */
+    uint8_t fields;
+} DeltaPack_t;
+
+/*============================================================================
+ * FUNCTION PROTOTYPES
+ *============================================================================*/
+
+/**
+ * @brief Set the field count and start the first block
+ *
+ * @param fields Values per sample, 1..DELTAPACK_MAX_FIELDS
+ */
+void DeltaPack_Init(DeltaPack_t *s, uint8_t fields);
+
+/**
+ * @brief Start a new block (previous values back to 0)
+ */
+void DeltaPack_Reset(DeltaPack_t *s);
+
+/**
+ * @brief Encode one sample
+ *
+ * @param sample s->fields values
+ * @param out Room for DELTAPACK_MAX_SAMPLE_BYTES(fields) bytes
+ * @return Bytes written (0 if the whole sample is unchanged)
+ */
+uint8_t DeltaPack_Encode(DeltaPack_t *s, const int16_t *sample, uint8_t *out);
+
+/**
+ * @brief End the block: write any pending unchanged run
+ *
+ * @param out Room for 3 bytes
+ * @return Bytes written
+ */
+uint8_t DeltaPack_Flush(DeltaPack_t *s, uint8_t *out);
+
+/**
+ * @brief Base64 (RFC 4648, padded) for sending a block as a text line
+ *
+ * @param out Room for 4 * ((len + 2) / 3) characters; not NUL-terminated
+ * @return Characters written
+ */
+uint16_t DeltaPack_Base64(const uint8_t *in, uint16_t len, char *out);
+
+#endif /* DELTAPACK_H */
@@ -0,0 +1,56 @@
+/*
+ * File:   fmt.c
+ * Author: ENCM 511
+ *
+ * Text Formatting Implementation
+ *
+ * Created on Nov 2025
+ */
+
+#include "fmt.h"
+
+/*============================================================================
+ * PUBLIC FUNCTION IMPLEMENTATIONS
+ *============================================================================*/
+
+char *Fmt_AppendU32(char *out, uint32_t value)
+{
+    char digits[10];
+    uint8_t n = 0;
+
+    do {
+        digits[n++] = (char)('0' + (value % 10));
+        value /= 10;
+    } while (value != 0);
+
+    while (n > 0) {
+        *out++ = digits[--n];
+    }
+    return out;
+}
+
+char *Fmt_AppendI16(char *out, int16_t value)
+{
+    if (value < 0) {
+        *out++ = '-';
+        return Fmt_AppendU32(out, (uint32_t)(-(int32_t)value));
+    }
+    return Fmt_AppendU32(out, (uint32_t)value);
+}
+
+char *Fmt_AppendHex8(char *out, uint8_t value)
+{
+    static const char hex[] = "0123456789abcdef";
+
+    *out++ = hex[value >> 4];
+    *out++ = hex[value & 0x0F];
+    return out;
+}
+
+char *Fmt_AppendStr(char *out, const char *s)
+{
+    while (*s != '\0') {
+        *out++ = *s++;
+    }
+    return out;
+}
@@ -0,0 +1,45 @@
+/*
+ * File:   fmt.h
+ * Author: ENCM 511
+ *
+ * Text Formatting Header
+ *
+ * Description: The few number and string appenders the terminal reports
+ *              need, so no module pulls in printf. Each writes at out and
+ *              returns the position just past what it wrote; nothing is
+ *              NUL-terminated and nothing is bounds-checked, so the caller
+ *              sizes the line for the longest output.
+ *
+ * Created on Nov 2025
+ */
+
+#ifndef FMT_H
+#define FMT_H
+
+#include <stdint.h>
+
+/*============================================================================
+ * FUNCTION PROTOTYPES
+ *============================================================================*/
+
+/**
+ * @brief Append an unsigned decimal number (1 to 10 characters)
+ */
+char *Fmt_AppendU32(char *out, uint32_t value);
+
+/**
+ * @brief Append a signed decimal number (1 to 6 characters)
+ */
+char *Fmt_AppendI16(char *out, int16_t value);
+
+/**
+ * @brief Append two lower-case hex digits
+ */
+char *Fmt_AppendHex8(char *out, uint8_t value);
+
+/**
+ * @brief Append a NUL-terminated string, without the NUL
+ */
+char *Fmt_AppendStr(char *out, const char *s);
+
+#endif /* FMT_H */
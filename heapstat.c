@@ -0,0 +1,200 @@
+/*
+ * File:   heapstat.c
+ * Author: ENCM 511
+ *
+ * Heap Ledger Implementation
+ *
+ * Description: Object table filled in by the kernel trace hooks. The
+ *              record and claim calls run with the scheduler suspended or
+ *              inside a kernel critical section, so they only touch the
+ *              table and never call back into the kernel.
+ *
+ * Created on Nov 2025
+ */
+
+#include "heapstat.h"
+#include "task.h"
+#include "queue.h"
+#include "logbuf.h"
+#include "fmt.h"
+
+/*============================================================================
+ * STATIC VARIABLES
+ *============================================================================*/
+
+typedef struct {
+    void *owner;
+    const char *name;
+    uint16_t bytes;
+    uint8_t blocks;
+    uint8_t kind;
+} HeapStatEntry_t;
+
+static HeapStatEntry_t heap_objects[HEAPSTAT_MAX_OBJECTS];
+static uint8_t heap_object_count = 0;
+
+/* Blocks allocated since the last claim */
+static uint16_t pending_bytes = 0;
+static uint8_t pending_blocks = 0;
+
+/* Blocks claimed after the table filled up */
+static uint16_t overflow_bytes = 0;
+static uint8_t overflow_blocks = 0;
+
+/* Indexed by queueQUEUE_TYPE_* and HEAPSTAT_KIND_TASK. Queue sets are
+ * disabled (configUSE_QUEUE_SETS), so they have no entry; a kind without
+ * a name prints as a queue. */
+static const char * const kind_names[] = {
+    [queueQUEUE_TYPE_BASE]               = "queue",
+    [queueQUEUE_TYPE_MUTEX]              = "mutex",
+    [queueQUEUE_TYPE_COUNTING_SEMAPHORE] = "csem",
+    [queueQUEUE_TYPE_BINARY_SEMAPHORE]   = "bsem",
+    [queueQUEUE_TYPE_RECURSIVE_MUTEX]    = "rmutex",
+    [HEAPSTAT_KIND_TASK]                 = "task"
+};
+
+/*============================================================================
+ * STATIC HELPER FUNCTIONS
+ *============================================================================*/
+
+static const char *KindName(uint8_t kind)
+{
+    if (kind < sizeof(kind_names) / sizeof(kind_names[0]) && kind_names[kind] != NULL) {
+        return kind_names[kind];
+    }
+    return kind_names[queueQUEUE_TYPE_BASE];
+}
+
+/* " 376 B (2 blocks)\r\n" */
+static char *AppendUsage(char *out, uint16_t bytes, uint8_t blocks)
+{
+    out = Fmt_AppendStr(out, " ");
+    out = Fmt_AppendU32(out, bytes);
+    out = Fmt_AppendStr(out, " B (");
+    out = Fmt_AppendU32(out, blocks);
+    out = Fmt_AppendStr(out, blocks == 1 ? " block)\r\n" : " blocks)\r\n");
+    return out;
+}
+
+/*============================================================================
+ * PUBLIC FUNCTION IMPLEMENTATIONS
+ *============================================================================*/
+
+void HeapStat_RecordBlock(void *block, unsigned int size)
+{
+    if (block != NULL) {
+        pending_bytes += (uint16_t)size;
+        pending_blocks++;
+    }
+}
+
+void HeapStat_ClaimBlocks(void *owner, unsigned char kind)
+{
+    if (pending_blocks == 0) {
+        return;
+    }
+
+    if (heap_object_count < HEAPSTAT_MAX_OBJECTS) {
+        HeapStatEntry_t *obj = &heap_objects[heap_object_count++];
+
+        obj->owner = owner;
+        obj->name = NULL;
+        obj->bytes = pending_bytes;
+        obj->blocks = pending_blocks;
+        obj->kind = kind;
+    } else {
+        overflow_bytes += pending_bytes;
+        overflow_blocks += pending_blocks;
+    }
+
+    pending_bytes = 0;
+    pending_blocks = 0;
+}
+
+void HeapStat_Name(void *owner, const char *name)
+{
+    uint8_t i;
+
+    for (i = 0; i < heap_object_count; i++) {
+        if (heap_objects[i].owner == owner) {
+            heap_objects[i].name = name;
+            return;
+        }
+    }
+}
+
+void HeapStat_Report(void)
+{
+    /* Not on the stack: the caller may be a minimal-stack task */
+    static char line[64];
+    char *p;
+    uint8_t count;
+    uint8_t i;
+    uint16_t used = 0;
+    uint16_t other_bytes;
+    uint8_t other_blocks;
+
+    taskENTER_CRITICAL();
+    count = heap_object_count;
+    other_bytes = (uint16_t)(pending_bytes + overflow_bytes);
+    other_blocks = (uint8_t)(pending_blocks + overflow_blocks);
+    taskEXIT_CRITICAL();
+
+    for (i = 0; i < count; i++) {
+        const HeapStatEntry_t *obj = &heap_objects[i];
+        const char *name = obj->name;
+
+        if (obj->kind == HEAPSTAT_KIND_TASK) {
+            name = pcTaskGetName((TaskHandle_t)obj->owner);
+        }
+
+        p = Fmt_AppendStr(line, "[heap] ");
+        p = Fmt_AppendStr(p, KindName(obj->kind));
+        p = Fmt_AppendStr(p, " ");
+        p = Fmt_AppendStr(p, (name != NULL) ? name : "?");
+        p = Fmt_AppendStr(p, ":");
+        p = AppendUsage(p, obj->bytes, obj->blocks);
+        LogBuf_Write(line, (uint16_t)(p - line), pdMS_TO_TICKS(100));
+        used += obj->bytes;
+    }
+
+    if (other_blocks != 0) {
+        p = Fmt_AppendStr(line, "[heap] other:");
+        p = AppendUsage(p, other_bytes, other_blocks);
+        LogBuf_Write(line, (uint16_t)(p - line), pdMS_TO_TICKS(100));
+        used += other_bytes;
+    }
+
+    p = Fmt_AppendStr(line, "[heap] used ");
+    p = Fmt_AppendU32(p, used);
+    p = Fmt_AppendStr(p, " of ");
+    p = Fmt_AppendU32(p, (uint16_t)configTOTAL_HEAP_SIZE);
+    p = Fmt_AppendStr(p, " B, ");
+    p = Fmt_AppendU32(p, (uint16_t)xPortGetFreeHeapSize());
+    p = Fmt_AppendStr(p, " B free\r\n");
+    LogBuf_Write(line, (uint16_t)(p - line), pdMS_TO_TICKS(100));
+}
+
+uint8_t HeapStat_ObjectCount(void)
+{
+    return heap_object_count;
+}
+
+bool HeapStat_GetObject(uint8_t id, HeapStatObject_t *out)
+{
+    const HeapStatEntry_t *obj;
+
+    if (id >= heap_object_count) {
+        return false;
+    }
+
+    obj = &heap_objects[id];
+    out->owner = obj->owner;
+    out->name = obj->name;
+    out->bytes = obj->bytes;
+    out->kind = obj->kind;
+    if (obj->kind == HEAPSTAT_KIND_TASK) {
+        out->name = pcTaskGetName((TaskHandle_t)obj->owner);
+    }
+    return true;
+}
@@ -0,0 +1,105 @@
+/*
+ * File:   heapstat.h
+ * Author: ENCM 511
+ *
+ * Heap Ledger Header
+ *
+ * Description: Run-time companion to tools/mapstat.py. The linker map shows
+ *              the 7 KB ucHeap as one block; this ledger splits it into the
+ *              kernel objects that were carved out of it, so the report
+ *              lists what each task, queue, semaphore and mutex costs.
+ *
+ * How blocks are attributed:
+ *   - traceMALLOC (FreeRTOSConfig.h) adds every pvPortMalloc() block to a
+ *     pending total.
+ *   - traceTASK_CREATE / traceQUEUE_CREATE hand the pending total to the
+ *     object being created (a task owns its TCB and its stack).
+ *   - Anything still pending at report time (stream buffers, event groups)
+ *     is shown as "other".
+ *   - Every object is created in one thread of control: the application
+ *     objects from main(), then the idle task inside vTaskStartScheduler(),
+ *     before any task runs. Nothing can allocate between an object's malloc
+ *     and its create hook.
+ *
+ * Created on Nov 2025
+ */
+
+#ifndef HEAPSTAT_H
+#define HEAPSTAT_H
+
+#include "FreeRTOS.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/*============================================================================
+ * CONFIGURATION
+ *============================================================================*/
+
+/* Maximum number of objects tracked; later ones are counted as "other" */
+#define HEAPSTAT_MAX_OBJECTS    20
+
+/*============================================================================
+ * TYPE DEFINITIONS
+ *============================================================================*/
+
+/* One ledger entry, as seen by the kernel inspector */
+typedef struct {
+    void *owner;                    /* Task or queue handle */
+    const char *name;               /* Task name or HeapStat_Name() label */
+    uint16_t bytes;
+    uint8_t kind;                   /* queueQUEUE_TYPE_* or HEAPSTAT_KIND_TASK */
+} HeapStatObject_t;
+
+/*============================================================================
+ * FUNCTION PROTOTYPES
+ *============================================================================*/
+
+/**
+ * @brief Record one heap block - called from traceMALLOC only
+ *
+ * @param block Block returned by pvPortMalloc() (NULL if it failed)
+ * @param size Size after alignment padding
+ */
+void HeapStat_RecordBlock(void *block, unsigned int size);
+
+/**
+ * @brief Give every pending block to a new object - called from the kernel
+ *        create hooks only
+ *
+ * @param owner Task or queue handle
+ * @param kind queueQUEUE_TYPE_* for queues, HEAPSTAT_KIND_TASK for tasks
+ */
+void HeapStat_ClaimBlocks(void *owner, unsigned char kind);
+
+/**
+ * @brief Label a queue, semaphore or mutex in the report
+ *
+ * Tasks are labelled with their task name automatically.
+ *
+ * @param owner Handle returned by the create call
+ * @param name Label (must be a string literal or otherwise static)
+ */
+void HeapStat_Name(void *owner, const char *name);
+
+/**
+ * @brief Queue one line per object plus the heap totals on the log buffer
+ */
+void HeapStat_Report(void);
+
+/**
+ * @brief Number of objects in the ledger
+ *
+ * Fixed once the scheduler has created the idle task, so an index is a
+ * stable object ID from then on.
+ */
+uint8_t HeapStat_ObjectCount(void);
+
+/**
+ * @brief Copy one ledger entry
+ *
+ * @param id Index, 0..HeapStat_ObjectCount()-1
+ * @return false if id is out of range
+ */
+bool HeapStat_GetObject(uint8_t id, HeapStatObject_t *out);
+
+#endif /* HEAPSTAT_H */
@@ -0,0 +1,207 @@
+/*
+ * File:   inspect.c
+ * Author: ENCM 511
+ *
+ * Kernel Object Inspector Implementation
+ *
+ * Description: Fills fixed-size records straight into a word-aligned frame
+ *              buffer and queues the frame as one log record, so it is
+ *              never split by other output. No number is ever formatted.
+ *
+ * Created on Nov 2025
+ */
+
+#include "inspect.h"
+#include "app.h"
+#include "crc.h"
+#include "logbuf.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include <xc.h>
+
+/*============================================================================
+ * CONFIGURATION CONSTANTS
+ *============================================================================*/
+
+/* Sync, type and length before the payload; CRC after it */
+#define INSPECT_HEAD_BYTES      4
+#define INSPECT_CRC_BYTES       2
+
+#define INSPECT_SNAPSHOT_BYTES  (sizeof(InspectHeader_t) + \
+                                 HEAPSTAT_MAX_OBJECTS * sizeof(InspectRecord_t))
+#define INSPECT_CATALOG_BYTES   (HEAPSTAT_MAX_OBJECTS * sizeof(InspectName_t))
+#define INSPECT_PAYLOAD_MAX     ((INSPECT_SNAPSHOT_BYTES > INSPECT_CATALOG_BYTES) ? \
+                                 INSPECT_SNAPSHOT_BYTES : INSPECT_CATALOG_BYTES)
+
+/*============================================================================
+ * PRIVATE VARIABLES
+ *============================================================================*/
+
+/* Words, so the header and records can be written in place */
+static uint16_t inspect_frame[(INSPECT_HEAD_BYTES + INSPECT_PAYLOAD_MAX +
+                               INSPECT_CRC_BYTES + 1) / 2];
+static uint16_t inspect_seq = 0;
+
+/* Tick count and Timer1 counts read as one time */
+typedef struct {
+    TickType_t tick;
+    uint16_t counts;
+} InspectStamp_t;
+
+/*============================================================================
+ * STATIC HELPER FUNCTIONS
+ *============================================================================*/
+
+/* Never called with the scheduler suspended - the tick count is frozen then */
+static void Stamp(InspectStamp_t *s)
+{
+    do {
+        s->tick = xTaskGetTickCount();
+        s->counts = TMR1;
+    } while (s->tick != xTaskGetTickCount());
+}
+
+/*
+ * For use with the scheduler suspended: the tick count is frozen, so a
+ * Timer1 count below the one in from means one tick has passed. Only good
+ * for spans under a tick, like the suspended pass in Inspect_Snapshot().
+ */
+static void StampSuspended(const InspectStamp_t *from, InspectStamp_t *s)
+{
+    s->counts = TMR1;
+    s->tick = (TickType_t)(from->tick + ((s->counts < from->counts) ? 1 : 0));
+}
+
+static uint16_t ElapsedUs(const InspectStamp_t *from, const InspectStamp_t *to)
+{
+    int32_t counts = (int32_t)(TickType_t)(to->tick - from->tick) * (int32_t)TELEM_COUNTS_PER_TICK +
+                     (int32_t)to->counts - (int32_t)from->counts;
+    uint32_t us;
+
+    if (counts < 0) {
+        counts = 0;
+    }
+    us = (uint32_t)counts * TELEM_US_PER_COUNT;
+    return (us > 0xFFFF) ? 0xFFFF : (uint16_t)us;
+}
+
+static uint8_t FindId(void *const *owners, uint8_t count, void *owner)
+{
+    uint8_t i;
+
+    if (owner != NULL) {
+        for (i = 0; i < count; i++) {
+            if (owners[i] == owner) {
+                return i;
+            }
+        }
+    }
+    return INSPECT_NO_ID;
+}
+
+static void SendFrame(uint8_t type, uint16_t len)
+{
+    uint8_t *f = (uint8_t *)inspect_frame;
+    uint16_t crc;
+
+    f[0] = INSPECT_SYNC;
+    f[1] = type;
+    f[2] = (uint8_t)len;
+    f[3] = (uint8_t)(len >> 8);
+    crc = Crc16_Compute(&f[1], (uint16_t)(len + INSPECT_HEAD_BYTES - 1));
+    f[INSPECT_HEAD_BYTES + len] = (uint8_t)crc;
+    f[INSPECT_HEAD_BYTES + len + 1] = (uint8_t)(crc >> 8);
+    LogBuf_Write((const char *)f, (uint16_t)(len + INSPECT_HEAD_BYTES + INSPECT_CRC_BYTES),
+                 pdMS_TO_TICKS(100));
+}
+
+/*============================================================================
+ * PUBLIC FUNCTION IMPLEMENTATIONS
+ *============================================================================*/
+
+void Inspect_Snapshot(void)
+{
+    uint8_t *f = (uint8_t *)inspect_frame;
+    InspectHeader_t *hdr = (InspectHeader_t *)&f[INSPECT_HEAD_BYTES];
+    InspectRecord_t *rec = (InspectRecord_t *)&f[INSPECT_HEAD_BYTES + sizeof(InspectHeader_t)];
+    void *owners[HEAPSTAT_MAX_OBJECTS];
+    HeapStatObject_t obj;
+    InspectStamp_t start;
+    InspectStamp_t held;
+    InspectStamp_t released;
+    InspectStamp_t end;
+    UBaseType_t items;
+    uint8_t count = HeapStat_ObjectCount();
+    uint8_t i;
+
+    Stamp(&start);
+
+    /* Lock-free pass: identity, heap cost and stack marks */
+    for (i = 0; i < count; i++) {
+        (void)HeapStat_GetObject(i, &obj);
+        owners[i] = obj.owner;
+        rec[i].id = i;
+        rec[i].kind = obj.kind;
+        rec[i].heap_bytes = obj.bytes;
+        rec[i].detail = INSPECT_NO_ID;
+        if (obj.kind == HEAPSTAT_KIND_TASK) {
+            rec[i].detail = (uint16_t)uxTaskGetStackHighWaterMark((TaskHandle_t)obj.owner);
+        }
+    }
+
+    /* One instant for everything that moves */
+    Stamp(&held);
+    vTaskSuspendAll();
+    for (i = 0; i < count; i++) {
+        if (rec[i].kind == HEAPSTAT_KIND_TASK) {
+            rec[i].state = (uint8_t)eTaskGetState((TaskHandle_t)owners[i]);
+            rec[i].level = (uint8_t)uxTaskPriorityGet((TaskHandle_t)owners[i]);
+            continue;
+        }
+        items = uxQueueMessagesWaiting((QueueHandle_t)owners[i]);
+        rec[i].state = (uint8_t)items;
+        rec[i].level = (uint8_t)(items + uxQueueSpacesAvailable((QueueHandle_t)owners[i]));
+        if (rec[i].kind == queueQUEUE_TYPE_MUTEX ||
+            rec[i].kind == queueQUEUE_TYPE_RECURSIVE_MUTEX) {
+            rec[i].detail = FindId(owners, count,
+                                   xSemaphoreGetMutexHolder((SemaphoreHandle_t)owners[i]));
+        }
+    }
+    hdr->tick = xTaskGetTickCount();
+    hdr->heap_free = (uint16_t)xPortGetFreeHeapSize();
+    hdr->app_state = (uint8_t)g_SystemState;
+    StampSuspended(&held, &released);
+    (void)xTaskResumeAll();
+    Stamp(&end);
+
+    hdr->seq = inspect_seq++;
+    hdr->heap_total = (uint16_t)configTOTAL_HEAP_SIZE;
+    hdr->snapshot_us = ElapsedUs(&start, &end);
+    hdr->suspended_us = ElapsedUs(&held, &released);
+    hdr->objects = count;
+    SendFrame(INSPECT_FRAME_SNAPSHOT,
+              (uint16_t)(sizeof(InspectHeader_t) + count * sizeof(InspectRecord_t)));
+}
+
+void Inspect_Catalog(void)
+{
+    InspectName_t *entry = (InspectName_t *)((uint8_t *)inspect_frame + INSPECT_HEAD_BYTES);
+    HeapStatObject_t obj;
+    uint8_t count = HeapStat_ObjectCount();
+    uint8_t i;
+    uint8_t n;
+
+    for (i = 0; i < count; i++, entry++) {
+        (void)HeapStat_GetObject(i, &obj);
+        entry->id = i;
+        entry->kind = obj.kind;
+        for (n = 0; n < INSPECT_NAME_LEN; n++) {
+            entry->name[n] = '\0';
+        }
+        for (n = 0; obj.name != NULL && n < INSPECT_NAME_LEN && obj.name[n] != '\0'; n++) {
+            entry->name[n] = obj.name[n];
+        }
+    }
+    SendFrame(INSPECT_FRAME_CATALOG, (uint16_t)(count * sizeof(InspectName_t)));
+}
@@ -0,0 +1,112 @@
+/*
+ * File:   inspect.h
+ * Author: ENCM 511
+ *
+ * Kernel Object Inspector Header
+ *
+ * Description: Field view of the kernel without a debugger or
+ *              configUSE_TRACE_FACILITY: task states, priorities and stack
+ *              high-water marks, queue and semaphore fill levels, mutex
+ *              holders and free heap. Answers 'k' (snapshot) and 'o'
+ *              (object catalog) on the terminal with one binary frame
+ *              each; tools/kernstat.py renders them.
+ *
+ * Objects:
+ *   - Every task, queue, semaphore and mutex in the heap ledger
+ *     (heapstat.c), idle task included. The ledger index is the object ID.
+ *   - configUSE_TIMERS is 0, so there are no software timers to report.
+ *
+ * Frame (little-endian, CRC-16/CCITT-FALSE over type, length and payload):
+ *   [0xA5][type][len lo][len hi][payload ... len bytes][crc lo][crc hi]
+ *   0xA5 never occurs in the ASCII log text the frames are mixed into.
+ *
+ * Payloads:
+ *   - Snapshot: InspectHeader_t, then one InspectRecord_t per object in
+ *     ID order. Numbers only; names come from the catalog.
+ *   - Catalog: one InspectName_t per object.
+ *
+ * Cost:
+ *   - Stack marks are read first, without any lock: scanning a stack is
+ *     the slow part, the marks only go down and no task is ever deleted.
+ *   - States, fill levels, holders, tick and free heap are then read with
+ *     the scheduler suspended, so they are one consistent instant. ISRs
+ *     keep running.
+ *   - The header carries both times, measured with Timer1 (2 us steps).
+ *
+ * Created on Nov 2025
+ */
+
+#ifndef INSPECT_H
+#define INSPECT_H
+
+#include "heapstat.h"
+#include <stdint.h>
+
+/*============================================================================
+ * CONFIGURATION
+ *============================================================================*/
+
+#define INSPECT_SYNC            0xA5
+#define INSPECT_FRAME_SNAPSHOT  0x01
+#define INSPECT_FRAME_CATALOG   0x02
+
+/* Object kinds: queueQUEUE_TYPE_* (0-5) and HEAPSTAT_KIND_TASK (6) */
+
+/* InspectRecord_t.detail for a mutex nobody holds */
+#define INSPECT_NO_ID           0xFF
+
+#define INSPECT_NAME_LEN        8
+
+/*============================================================================
+ * TYPE DEFINITIONS
+ *============================================================================*/
+
+/* Snapshot header - 14 bytes on the wire */
+typedef struct {
+    uint16_t seq;                   /* Snapshot number since reset */
+    uint16_t tick;                  /* Tick count at the snapshot */
+    uint16_t heap_free;             /* xPortGetFreeHeapSize() */
+    uint16_t heap_total;            /* configTOTAL_HEAP_SIZE */
+    uint16_t snapshot_us;           /* Whole snapshot, frame send excluded */
+    uint16_t suspended_us;          /* Scheduler suspended, resume excluded */
+    uint8_t objects;                /* Records that follow */
+    uint8_t app_state;              /* g_SystemState */
+} InspectHeader_t;
+
+/* One object - 8 bytes on the wire */
+typedef struct {
+    uint8_t id;
+    uint8_t kind;
+    uint8_t state;                  /* Task: eTaskState. Others: items or count */
+    uint8_t level;                  /* Task: priority. Others: capacity */
+    uint16_t detail;                /* Task: stack never used, in words.
+                                       Mutex: holder ID or INSPECT_NO_ID */
+    uint16_t heap_bytes;            /* From the ledger */
+} InspectRecord_t;
+
+/* Catalog entry - 10 bytes on the wire */
+typedef struct {
+    uint8_t id;
+    uint8_t kind;
+    char name[INSPECT_NAME_LEN];    /* Zero-padded, not always terminated */
+} InspectName_t;
+
+/*============================================================================
+ * FUNCTION PROTOTYPES
+ *============================================================================*/
+
+/**
+ * @brief Take a snapshot and queue its frame on the log buffer
+ *
+ * Task context, one caller at a time (the TLOG task).
+ */
+void Inspect_Snapshot(void);
+
+/**
+ * @brief Queue the ID/kind/name catalog frame on the log buffer
+ *
+ * Task context, one caller at a time (the TLOG task).
+ */
+void Inspect_Catalog(void);
+
+#endif /* INSPECT_H */
@@ -0,0 +1,92 @@
+/*
+ * File:   ledfb.c
+ * Author: ENCM 511
+ *
+ * LED Framebuffer Implementation
+ *
+ * Description: The shadow word and LATB are only changed with the CPU IPL
+ *              raised to LEDFB_IPL (see FreeRTOSConfig.h), so a task commit
+ *              can never be interleaved with an ISR commit and write back a
+ *              stale copy of the port. led_port remembers the LED bits the
+ *              last commit stored, which is what lets a commit with
+ *              nothing new skip the port.
+ *
+ * Created on Nov 2025
+ */
+
+#include "ledfb.h"
+#include <xc.h>
+
+/*============================================================================
+ * CONFIGURATION CONSTANTS
+ *============================================================================*/
+
+/* IPL used while touching the shadow or the port - above every LED writer */
+#define LEDFB_IPL               7
+
+/*============================================================================
+ * STATIC VARIABLES
+ *============================================================================*/
+
+static volatile uint16_t led_shadow = 0;
+static volatile uint16_t led_port = 0;      /* LED bits as last committed */
+
+/*============================================================================
+ * STATIC HELPER FUNCTIONS
+ *============================================================================*/
+
+/* Caller holds LEDFB_IPL */
+static void Commit(void)
+{
+    if (led_shadow != led_port) {
+        led_port = led_shadow;
+        LEDFB_LAT = (LEDFB_LAT & ~LEDFB_MASK) | led_port;
+    }
+}
+
+/*============================================================================
+ * PUBLIC FUNCTION IMPLEMENTATIONS
+ *============================================================================*/
+
+void LedFb_Update(uint16_t on_mask, uint16_t off_mask)
+{
+    uint16_t saved_ipl;
+
+    SET_AND_SAVE_CPU_IPL(saved_ipl, LEDFB_IPL);
+    led_shadow = ((led_shadow | on_mask) & ~off_mask) & LEDFB_MASK;
+    RESTORE_CPU_IPL(saved_ipl);
+}
+
+void LedFb_Commit(void)
+{
+    uint16_t saved_ipl;
+
+    SET_AND_SAVE_CPU_IPL(saved_ipl, LEDFB_IPL);
+    Commit();
+    RESTORE_CPU_IPL(saved_ipl);
+}
+
+void LedFb_Write(uint16_t on_mask, uint16_t off_mask)
+{
+    uint16_t saved_ipl;
+
+    SET_AND_SAVE_CPU_IPL(saved_ipl, LEDFB_IPL);
+    led_shadow = ((led_shadow | on_mask) & ~off_mask) & LEDFB_MASK;
+    Commit();
+    RESTORE_CPU_IPL(saved_ipl);
+}
+
+void LedFb_Toggle(uint16_t mask)
+{
+    uint16_t saved_ipl;
+
+    SET_AND_SAVE_CPU_IPL(saved_ipl, LEDFB_IPL);
+    led_shadow = (led_shadow ^ mask) & LEDFB_MASK;
+    Commit();
+    RESTORE_CPU_IPL(saved_ipl);
+}
+
+uint16_t LedFb_Get(void)
+{
+    return led_shadow;
+}
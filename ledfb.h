@@ -0,0 +1,82 @@
+/*
+ * File:   ledfb.h
+ * Author: ENCM 511
+ *
+ * LED Framebuffer Header
+ *
+ * Description: Keeps every LED in one shadow word laid out like LATB.
+ *              Tasks and ISRs change bits in the shadow and a commit
+ *              copies the LED bits to the port in a single masked write,
+ *              so several LEDs changing in the same step cost one LATB
+ *              update instead of one bitfield read-modify-write each.
+ *
+ * Frames:
+ *   - A frame is any number of LedFb_Update() calls closed by one
+ *     LedFb_Commit(). LedFb_Write() and LedFb_Toggle() are one-call
+ *     frames; the LEDn_On()/Off()/Toggle() macros use them.
+ *   - A commit only writes LATB if the shadow differs from what the last
+ *     commit wrote. If another commit (say the PWM ISR switching LED2)
+ *     lands inside a frame, it carries the pending bits with it and the
+ *     frame's own commit writes nothing, so a frame never costs more than
+ *     one LATB write.
+ *
+ * Pin map:
+ *   - LEDn_MASK and LEDFB_MASK come from the LEDn_BIT definitions in
+ *     hw_config.h, so moving an LED to another RBx pin only needs that
+ *     one number changed. hw_config.h refuses to build if a pin number is
+ *     not on PORTB or two LEDs share a pin.
+ *
+ * Created on Nov 2025
+ */
+
+#ifndef LEDFB_H
+#define LEDFB_H
+
+#include "hw_config.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/*============================================================================
+ * FUNCTION PROTOTYPES
+ *============================================================================*/
+
+/**
+ * @brief Change LEDs in the shadow word only
+ *
+ * Nothing reaches the port until the next commit. If a bit is in both
+ * masks it ends up off.
+ *
+ * @param on_mask LEDn_MASK bits to switch on
+ * @param off_mask LEDn_MASK bits to switch off
+ */
+void LedFb_Update(uint16_t on_mask, uint16_t off_mask);
+
+/**
+ * @brief Write the shadow word to the LED pins of LATB in one store
+ *
+ * Does nothing if the port already shows the shadow.
+ */
+void LedFb_Commit(void);
+
+/**
+ * @brief LedFb_Update() followed by LedFb_Commit(), as one step
+ *
+ * Safe from tasks and ISRs.
+ */
+void LedFb_Write(uint16_t on_mask, uint16_t off_mask);
+
+/**
+ * @brief Invert LEDs and commit, as one step
+ *
+ * @param mask LEDn_MASK bits to toggle
+ */
+void LedFb_Toggle(uint16_t mask);
+
+/**
+ * @brief Read the shadow word
+ *
+ * @return uint16_t Current LED bits (LATB layout, LEDFB_MASK bits only)
+ */
+uint16_t LedFb_Get(void);
+
+#endif /* LEDFB_H */
@@ -0,0 +1,200 @@
+/*
+ * File:   logbuf.c
+ * Author: ENCM 511
+ *
+ * Multi-Producer Log Buffer Implementation
+ *
+ * Description: Replaces the xUartMutex-serialized printing path. Any number
+ *              of tasks append records; vLogTask is the only code
+ *              that touches the UART transmitter.
+ *
+ * Reservation:
+ *   - The only shared step is advancing log_head. This is done with the
+ *     CPU IPL raised to LOGBUF_RESERVE_IPL for a handful of instructions
+ *     (see the interrupt priority note in FreeRTOSConfig.h).
+ *   - The header is written as BUSY before the IPL is restored, so the
+ *     consumer can never mistake a half-filled record for a complete one.
+ *
+ * Commit:
+ *   - The payload is copied with interrupts enabled, then the state byte
+ *     is set to READY with a single byte store.
+ *
+ * Consumption:
+ *   - The consumer walks records from log_tail and stops at the first one
+ *     that is still BUSY. log_tail is written only by the consumer.
+ *
+ * Created on Nov 2025
+ */
+
+#include "logbuf.h"
+#include <xc.h>
+#include <string.h>
+
+/*============================================================================
+ * CONFIGURATION CONSTANTS
+ *============================================================================*/
+
+#define LOGBUF_MASK             (LOGBUF_SIZE - 1)
+
+/* IPL used while reserving - not even the tick can preempt it */
+#define LOGBUF_RESERVE_IPL      7
+
+/* Record states */
+#define LOG_REC_BUSY            0x00
+#define LOG_REC_READY           0xA5
+
+#if (LOGBUF_SIZE & LOGBUF_MASK) != 0
+#error LOGBUF_SIZE must be a power of two
+#endif
+
+/* Sentinel returned by Reserve() when the ring is full */
+#define LOGBUF_NO_SPACE         0xFFFF
+
+/*============================================================================
+ * STATIC VARIABLES
+ *============================================================================*/
+
+static uint8_t log_storage[LOGBUF_SIZE];
+
+/* Free-running positions (wrap naturally at 16 bits) */
+static volatile uint16_t log_head = 0;     /* Next byte to reserve */
+static volatile uint16_t log_tail = 0;     /* Oldest unconsumed byte */
+
+/* Consumer position inside the record at log_tail */
+static uint8_t log_read_offset = 0;
+
+static volatile uint16_t log_dropped = 0;
+
+static TaskHandle_t log_consumer = NULL;
+
+/*============================================================================
+ * STATIC HELPER FUNCTIONS
+ *============================================================================*/
+
+/**
+ * @brief Reserve space for one record and mark it BUSY
+ *
+ * @param len Payload length (1 to LOGBUF_MAX_RECORD)
+ * @return Ring position of the record header, or LOGBUF_NO_SPACE
+ */
+static uint16_t Reserve(uint8_t len)
+{
+    uint16_t saved_ipl;
+    uint16_t start;
+
+    SET_AND_SAVE_CPU_IPL(saved_ipl, LOGBUF_RESERVE_IPL);
+
+    start = log_head;
+    if ((uint16_t)(start - log_tail) + LOGBUF_HDR_SIZE + len > LOGBUF_SIZE) {
+        start = LOGBUF_NO_SPACE;
+    } else {
+        log_head = start + LOGBUF_HDR_SIZE + len;
+        log_storage[start & LOGBUF_MASK] = len;
+        log_storage[(start + 1) & LOGBUF_MASK] = LOG_REC_BUSY;
+    }
+
+    RESTORE_CPU_IPL(saved_ipl);
+
+    return start;
+}
+
+/**
+ * @brief Copy the payload into a reserved record and mark it READY
+ */
+static void Commit(uint16_t start, const char *data, uint8_t len)
+{
+    uint16_t pos = (start + LOGBUF_HDR_SIZE) & LOGBUF_MASK;
+    uint16_t first = LOGBUF_SIZE - pos;
+
+    if (first > len) {
+        first = len;
+    }
+    memcpy(&log_storage[pos], data, first);
+    memcpy(&log_storage[0], data + first, len - first);
+
+    log_storage[(start + 1) & LOGBUF_MASK] = LOG_REC_READY;
+}
+
+static void CountDrop(void)
+{
+    if (log_dropped != 0xFFFF) {
+        log_dropped++;
+    }
+}
+
+/*============================================================================
+ * PUBLIC FUNCTION IMPLEMENTATIONS
+ *============================================================================*/
+
+void LogBuf_Init(TaskHandle_t consumer)
+{
+    log_head = 0;
+    log_tail = 0;
+    log_read_offset = 0;
+    log_dropped = 0;
+    log_consumer = consumer;
+}
+
+bool LogBuf_Write(const char *data, uint16_t len, TickType_t xTicksToWait)
+{
+    TickType_t start_tick = xTaskGetTickCount();
+
+    while (len > 0) {
+        uint8_t chunk = (len > LOGBUF_MAX_RECORD) ? LOGBUF_MAX_RECORD : (uint8_t)len;
+        uint16_t start = Reserve(chunk);
+
+        if (start == LOGBUF_NO_SPACE) {
+            /* Let the consumer drain, then retry until the deadline */
+            if ((xTaskGetTickCount() - start_tick) >= xTicksToWait) {
+                CountDrop();
+                return false;
+            }
+            vTaskDelay(1);
+            continue;
+        }
+
+        Commit(start, data, chunk);
+        data += chunk;
+        len -= chunk;
+
+        if (log_consumer != NULL) {
+            xTaskNotifyGive(log_consumer);
+        }
+    }
+
+    return true;
+}
+
+uint16_t LogBuf_Read(uint8_t *out, uint16_t max)
+{
+    uint16_t copied = 0;
+
+    while (copied < max && log_tail != log_head) {
+        uint16_t tail = log_tail;
+        uint8_t len;
+
+        /* Oldest record not finished yet - later ones must wait behind it */
+        if (log_storage[(tail + 1) & LOGBUF_MASK] != LOG_REC_READY) {
+            break;
+        }
+
+        len = log_storage[tail & LOGBUF_MASK];
+        while (log_read_offset < len && copied < max) {
+            out[copied++] = log_storage[(tail + LOGBUF_HDR_SIZE + log_read_offset) & LOGBUF_MASK];
+            log_read_offset++;
+        }
+
+        if (log_read_offset == len) {
+            log_read_offset = 0;
+            /* Release the record to producers */
+            log_tail = tail + LOGBUF_HDR_SIZE + len;
+        }
+    }
+
+    return copied;
+}
+
+uint16_t LogBuf_GetDropped(void)
+{
+    return log_dropped;
+}
@@ -0,0 +1,90 @@
+/*
+ * File:   logbuf.h
+ * Author: ENCM 511
+ *
+ * Multi-Producer Log Buffer Header
+ *
+ * Description: Byte ring shared by every task that prints to the
+ *              terminal. Producers reserve a record under a brief IPL raise,
+ *              fill it without holding any lock, and then mark it ready.
+ *              Records may be committed out of order; the single consumer
+ *              (vLogTask) only ever sees complete records, in reservation
+ *              order.
+ *
+ * Record layout in the ring:
+ *   [len][state][payload ... len bytes]
+ *
+ * Created on Nov 2025
+ */
+
+#ifndef LOGBUF_H
+#define LOGBUF_H
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/*============================================================================
+ * CONFIGURATION
+ *============================================================================*/
+
+/* Ring size in bytes - must be a power of two */
+#define LOGBUF_SIZE             256
+
+/* Record header size: length byte + state byte */
+#define LOGBUF_HDR_SIZE         2
+
+/* Largest payload carried by one record: header and payload must fit the
+ * ring together, and the length is stored in one byte */
+#define LOGBUF_MAX_RECORD       (LOGBUF_SIZE - LOGBUF_HDR_SIZE)
+
+#if LOGBUF_MAX_RECORD > 255
+#error LOGBUF_MAX_RECORD must fit the one-byte length field
+#endif
+
+/*============================================================================
+ * FUNCTION PROTOTYPES
+ *============================================================================*/
+
+/**
+ * @brief Initialize the log buffer
+ *
+ * @param consumer Task to notify when a record is committed
+ */
+void LogBuf_Init(TaskHandle_t consumer);
+
+/**
+ * @brief Append a record from task context
+ *
+ * Waits (by delaying, never by spinning) up to xTicksToWait for space.
+ * Payloads longer than LOGBUF_MAX_RECORD are split into several records;
+ * another producer's records can land between the pieces.
+ *
+ * @param data Bytes to log
+ * @param len Number of bytes
+ * @param xTicksToWait Maximum time to wait for space
+ * @return true if every byte was queued
+ */
+bool LogBuf_Write(const char *data, uint16_t len, TickType_t xTicksToWait);
+
+/**
+ * @brief Copy committed bytes out of the ring (consumer only)
+ *
+ * Stops at the first record that has been reserved but not yet committed,
+ * so a slow producer holds back later records instead of being skipped.
+ *
+ * @param out Destination buffer
+ * @param max Size of destination buffer
+ * @return Number of bytes copied (0 if nothing is ready)
+ */
+uint16_t LogBuf_Read(uint8_t *out, uint16_t max);
+
+/**
+ * @brief Get the number of records dropped for lack of space
+ *
+ * @return uint16_t Dropped record count (saturates at 0xFFFF)
+ */
+uint16_t LogBuf_GetDropped(void);
+
+#endif /* LOGBUF_H */
@@ -104,6 +104,21 @@
 #include "uart.h"
 #include "buttons.h"
 #include "pwm.h"
+#include "adc.h"
+#include "pingpong.h"
+#include "logbuf.h"
+#include "uart_dma.h"
+#include "boot.h"
+#include "heapstat.h"
+#include "appcfg.h"
+#include "crc.h"
+#include "stateprof.h"
+#include "telemlog.h"
+#include "telemstream.h"
+#include "telemagg.h"
+#include "inspect.h"
+#include "rtcc.h"
+#include "fmt.h"
 
 /*============================================================================
  * FREERTOS OBJECT DEFINITIONS
@@ -120,7 +135,6 @@ SemaphoreHandle_t xStartInputSem = NULL;
 SemaphoreHandle_t xStartCountdownSem = NULL;
 
 /* Mutexes for shared resource protection */
-SemaphoreHandle_t xUartMutex = NULL;
 SemaphoreHandle_t xStateMutex = NULL;
 SemaphoreHandle_t xCountdownMutex = NULL;
 
@@ -131,6 +145,38 @@ volatile DisplaySettings_t g_DisplaySettings = {false, false};
 /* Countdown data */
 volatile uint16_t g_CountdownSeconds = 0;
 
+/* Notified when the state returns to WAITING */
+static TaskHandle_t xWaitingTask = NULL;
+
+/* Raw bytes from the RX ISR, sorted by vUartRxTask */
+static QueueHandle_t xUartByteQueue = NULL;
+
+/* Flash telemetry task, and the key requests it serves - one
+ * notification bit each, set by vUartRxTask */
+static TaskHandle_t xTelemTask = NULL;
+
+#define TELEM_REQ_DUMP          0x01UL
+#define TELEM_REQ_CFG_SAVE      0x02UL
+#define TELEM_REQ_STREAM        0x04UL
+#define TELEM_REQ_AGG           0x08UL
+#define TELEM_REQ_SNAPSHOT      0x10UL
+#define TELEM_REQ_CATALOG       0x20UL
+#define TELEM_REQ_SCANS         0x40UL  /* Scan block from the ADC ISR */
+
+typedef struct {
+    char key;                       /* Lower case; upper case matches too */
+    uint32_t request;
+} TelemKey_t;
+
+static const TelemKey_t telem_keys[] = {
+    { 'w', TELEM_REQ_CFG_SAVE },    /* Save 'i'/'b' to the configuration image */
+    { 't', TELEM_REQ_DUMP },        /* Dump the flash telemetry log */
+    { 's', TELEM_REQ_STREAM },      /* Packed telemetry stream on/off */
+    { 'a', TELEM_REQ_AGG },         /* Windowed statistics on/off */
+    { 'k', TELEM_REQ_SNAPSHOT },    /* Kernel snapshot frame */
+    { 'o', TELEM_REQ_CATALOG }      /* Kernel object catalog frame */
+};
+
 /*============================================================================
  * FREERTOS HOOKS
  *============================================================================*/
@@ -141,61 +187,121 @@ void vApplicationIdleHook(void)
     ClrWdt();
 }
 
+void vApplicationTickHook(void)
+{
+    /* Timer1 counts since the tick's period match - read first */
+    uint16_t tick_counts = TMR1;
+    static uint8_t agg_divider = 0;
+    
+    if (++agg_divider >= AGG_SAMPLE_TICKS) {
+        TickType_t now = xTaskGetTickCountFromISR();
+        
+        agg_divider = 0;
+        WinAgg_Add(TelemAgg_Get(AGG_TICK_LATENCY),
+                   (int16_t)(tick_counts * TELEM_US_PER_COUNT), now);
+        WinAgg_Add(TelemAgg_Get(AGG_RX_QUEUE),
+                   (int16_t)uxQueueMessagesWaitingFromISR(xUartRxQueue), now);
+        WinAgg_Add(TelemAgg_Get(AGG_BUTTON_QUEUE),
+                   (int16_t)uxQueueMessagesWaitingFromISR(xButtonQueue), now);
+    }
+    
+    /* Pick up RX bytes left below the URXISEL threshold */
+    UART2_RxIdleTick();
+    
+    /* Restart a TX block held up by a late DMA0 interrupt */
+    UartDma_TxStallTick();
+    
+    TelemLog_Tick();
+    
+#if STATEPROF_ENABLE
+    StateProf_Tick();
+#endif
+}
+
+/* Tickless idle (portSUPPRESS_TICKS_AND_SLEEP): sleep to the next RTCC
+ * second, only during a running countdown and only while nothing on the
+ * instruction clock has work left - LED2 steady, UART quiet both ways.
+ * The RTCC alarm, a button or a UART start bit wakes the CPU.
+ * uint16_t as declared in FreeRTOSConfig.h, where TickType_t is not yet
+ * defined; with 16-bit ticks the two are the same type. */
+void vApplicationSleep(uint16_t xExpectedIdleTime)
+{
+    if (g_SystemState != STATE_COUNTDOWN || !PWM_IsSteady() ||
+        !UartDma_IsIdle() || !U2STAbits.RIDLE || U2STAbits.URXDA) {
+        return;
+    }
+    
+    /* Wake on a UART start bit. The UART is not clocked in Sleep, so the
+     * character that wakes the CPU is lost - only the ones after it are
+     * received. Cleared by the hardware on each wake-up. */
+    U2MODEbits.WAKE = 1;
+    (void)RTCC_Sleep(xExpectedIdleTime);
+}
+
+/* Fault reports: vLogTask and the DMA0 interrupt will never run again, so
+ * the block in flight is dropped and the report goes out polled through
+ * UART2_Write(). Also safe before the scheduler has started. */
+static void FaultBegin(UartStr_t what)
+{
+    SET_CPU_IPL(7);
+    UartDma_Abort();
+    UART2_WriteStr(UART_STR("\r\n[fault] "));
+    UART2_WriteStr(what);
+}
+
+static void FaultHalt(void)
+{
+    UART2_WriteStr(UART_STR("\r\n"));
+    for(;;);
+}
+
 void vApplicationStackOverflowHook(TaskHandle_t pxTask, char *pcTaskName)
 {
-    (void)pcTaskName;
     (void)pxTask;
     
-    /* Stack overflow detected - halt system */
-    taskDISABLE_INTERRUPTS();
-    for(;;);
+    FaultBegin(UART_STR("stack overflow in "));
+    Disp2String(pcTaskName);
+    FaultHalt();
+}
+
+/* configASSERT() failures, from the kernel and the application */
+void vAssertCalled(const char *pcFile, unsigned long ulLine)
+{
+    char line[10];
+    
+    FaultBegin(UART_STR("assert "));
+    Disp2String(pcFile);
+    UART2_WriteStr(UART_STR(":"));
+    UART2_Write(line, (uint16_t)(Fmt_AppendU32(line, ulLine) - line));
+    FaultHalt();
 }
 
 /*============================================================================
  * MODIFIED UART RX ISR
  * 
- * Sends received characters to the UART queue for processing by tasks.
+ * Drains every byte in the RX FIFO into xUartByteQueue; vUartRxTask sorts
+ * them. Fires at the URXISEL threshold or when forced by the idle check in
+ * vApplicationTickHook().
  *============================================================================*/
 
 void __attribute__((interrupt, no_auto_psv)) _U2RXInterrupt(void)
 {
     BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-    UartCmd_t cmd;
     char received;
+    STATEPROF_ISR_ENTER();
     
-    /* Clear interrupt flag */
+    /* Clear interrupt flag before draining so a byte arriving meanwhile
+     * re-triggers the ISR instead of being left behind */
     IFS1bits.U2RXIF = 0;
+    uart2_rx_stats.interrupts++;
     
-    /* Read received character */
-    received = U2RXREG;
-    
-    /* Clear overflow error if set */
-    if (U2STAbits.OERR) {
-        U2STAbits.OERR = 0;
-    }
-    
-    /* Categorize the received character */
-    if (received == '\r' || received == '\n') {
-        cmd.type = UART_CMD_ENTER;
-        cmd.character = received;
-    } else if (received == 0x08 || received == 0x7F) {  /* Backspace or DEL */
-        cmd.type = UART_CMD_BACKSPACE;
-        cmd.character = received;
-    } else if (received == 'i' || received == 'I') {
-        cmd.type = UART_CMD_TOGGLE_INFO;
-        cmd.character = received;
-    } else if (received == 'b' || received == 'B') {
-        cmd.type = UART_CMD_TOGGLE_BLINK;
-        cmd.character = received;
-    } else {
-        cmd.type = UART_CMD_CHAR;
-        cmd.character = received;
+    while (UART2_RxPop(&received)) {
+        if (xUartByteQueue != NULL) {
+            xQueueSendFromISR(xUartByteQueue, &received, &xHigherPriorityTaskWoken);
+        }
     }
     
-    /* Send to queue (non-blocking from ISR) */
-    if (xUartRxQueue != NULL) {
-        xQueueSendFromISR(xUartRxQueue, &cmd, &xHigherPriorityTaskWoken);
-    }
+    STATEPROF_ISR_EXIT(STATEPROF_ISR_U2RX);
     
     /* Yield if a higher priority task was woken */
     portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
@@ -213,15 +319,118 @@ void __attribute__((interrupt, no_auto_psv)) _U2TXInterrupt(void)
 
 /**
  * @brief Thread-safe UART string transmission
+ * 
+ * Queues the string in the log buffer; vLogTask does the actual transmit.
  */
 static void SafeDisp2String(const char *str)
 {
-    if (xSemaphoreTake(xUartMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-        Disp2String((char*)str);
-        xSemaphoreGive(xUartMutex);
+    LogBuf_Write(str, strlen(str), pdMS_TO_TICKS(100));
+}
+
+/**
+ * @brief Thread-safe UART transmission of a length-aware string
+ * 
+ * Same as SafeDisp2String() without the strlen(); literals are passed as
+ * UART_STR("...") so their length is fixed at compile time.
+ */
+static void SafeDispStr(UartStr_t s)
+{
+    LogBuf_Write(s.str, s.len, pdMS_TO_TICKS(100));
+}
+
+/**
+ * @brief Queue a flash telemetry record: a 16-bit value and an optional byte
+ * 
+ * @param len Payload bytes to keep (2 or 3)
+ */
+static void TelemEvent(uint8_t type, uint16_t value, uint8_t extra, uint8_t len)
+{
+    uint8_t payload[3];
+    
+    payload[0] = (uint8_t)value;
+    payload[1] = (uint8_t)(value >> 8);
+    payload[2] = extra;
+    TelemLog_Append(type, payload, len);
+}
+
+/**
+ * @brief xQueueReceiveMatching() predicate: event for one button
+ * 
+ * @param pvContext Pointer to the ButtonId_t wanted
+ */
+static BaseType_t MatchButton(const void *pvItem, void *pvContext)
+{
+    return ((const ButtonEvent_t *)pvItem)->button == *(const ButtonId_t *)pvContext;
+}
+
+/**
+ * @brief xQueueReceiveMatching() predicate: event for any other button
+ * 
+ * @param pvContext Pointer to the ButtonId_t to keep
+ */
+static BaseType_t MatchOtherButton(const void *pvItem, void *pvContext)
+{
+    return ((const ButtonEvent_t *)pvItem)->button != *(const ButtonId_t *)pvContext;
+}
+
+
+/*============================================================================
+ * UART RX TASK
+ * 
+ * Sorts received bytes: telemetry and profiling keys become requests to
+ * the task that serves them, everything else goes to xUartRxQueue as a
+ * command for the state machine tasks.
+ *============================================================================*/
+
+/* True if c was a request key, now passed on */
+static bool DispatchKey(char c)
+{
+    uint8_t i;
+    
+#if STATEPROF_ENABLE
+    /* 'p' prints the state profile instead of reaching the app */
+    if ((c | 0x20) == 'p') {
+        StateProf_RequestReport();
+        return true;
     }
+#endif
+    for (i = 0; i < sizeof(telem_keys) / sizeof(telem_keys[0]); i++) {
+        if ((c | 0x20) == telem_keys[i].key) {
+            xTaskNotify(xTelemTask, telem_keys[i].request, eSetBits);
+            return true;
+        }
+    }
+    return false;
 }
 
+void vUartRxTask(void *pvParameters)
+{
+    (void)pvParameters;
+    UartCmd_t cmd;
+    char received;
+    
+    for(;;) {
+        xQueueReceive(xUartByteQueue, &received, portMAX_DELAY);
+        if (DispatchKey(received)) {
+            continue;
+        }
+        
+        /* Categorize the received character */
+        if (received == '\r' || received == '\n') {
+            cmd.type = UART_CMD_ENTER;
+        } else if (received == 0x08 || received == 0x7F) {  /* Backspace or DEL */
+            cmd.type = UART_CMD_BACKSPACE;
+        } else if (received == 'i' || received == 'I') {
+            cmd.type = UART_CMD_TOGGLE_INFO;
+        } else if (received == 'b' || received == 'B') {
+            cmd.type = UART_CMD_TOGGLE_BLINK;
+        } else {
+            cmd.type = UART_CMD_CHAR;
+        }
+        cmd.character = received;
+        xQueueSend(xUartRxQueue, &cmd, 0);
+    }
+}
 
 /*============================================================================
  * WAITING STATE TASK
@@ -235,22 +444,32 @@ void vWaitingTask(void *pvParameters)
     (void)pvParameters;
     TickType_t xLastWakeTime;
     ButtonEvent_t buttonEvent;
+    ButtonId_t pb1 = BUTTON_PB1;
+    bool first_prompt = true;
     
     for(;;) {
-        /* Wait until we're in WAITING state */
+        /* Wait until we're in WAITING state - no polling, so the idle
+         * task can sleep through a countdown */
         while (g_SystemState != STATE_WAITING) {
-            vTaskDelay(pdMS_TO_TICKS(100));
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
         }
         
-        /* Clear button queue */
-        while (xQueueReceive(xButtonQueue, NULL, 0) == pdTRUE) { }
-        vTaskDelay(pdMS_TO_TICKS(100));
+        /* Clear button queue - anything still queued is from the last cycle.
+         * There is no last cycle at boot, so don't hold up the first prompt. */
+        while (xQueueReceive(xButtonQueue, &buttonEvent, 0) == pdTRUE) { }
+        if (!first_prompt) {
+            vTaskDelay(pdMS_TO_TICKS(100));
+        }
         
         /* Display welcome message */
-        SafeDisp2String("\r\n\n========================================\r\n");
-        SafeDisp2String("      COUNTDOWN TIMER APPLICATION\r\n");
-        SafeDisp2String("========================================\r\n");
-        SafeDisp2String("Press PB1 to enter time...\r\n\n");
+        SafeDispStr(UART_STR("\r\n\n========================================\r\n"));
+        SafeDispStr(UART_STR("      COUNTDOWN TIMER APPLICATION\r\n"));
+        SafeDispStr(UART_STR("========================================\r\n"));
+        SafeDispStr(UART_STR("Press PB1 to enter time...\r\n\n"));
+        if (first_prompt) {
+            first_prompt = false;
+            Boot_Mark("prompt");
+        }
         
         /* Start LED pulsing */
         PWM_ResetPulse();
@@ -263,8 +482,14 @@ void vWaitingTask(void *pvParameters)
         while (g_SystemState == STATE_WAITING) {
             PWM_UpdatePulse(20, PULSE_PERIOD_MS);
             
+            /* Only PB1 means anything here - drop the other buttons' events
+             * so they cannot fill the queue and crowd out PB1 */
+            while (xQueueReceiveMatching(xButtonQueue, &buttonEvent, MatchOtherButton,
+                                         &pb1, 0) == pdTRUE) { }
+            
             /* Check for PB1 click */
-            if (xQueueReceive(xButtonQueue, &buttonEvent, pdMS_TO_TICKS(20)) == pdTRUE) {
+            if (xQueueReceiveMatching(xButtonQueue, &buttonEvent, MatchButton,
+                                      &pb1, pdMS_TO_TICKS(20)) == pdTRUE) {
                 if (buttonEvent.button == BUTTON_PB1 && buttonEvent.event == EVENT_CLICK) {
                     PWM_Stop();
                     /* Change state to ENTER_TIME */
@@ -313,7 +538,7 @@ void vTimeInputTask(void *pvParameters)
             vTaskDelay(pdMS_TO_TICKS(100));
             
             /* Display prompt */
-            SafeDisp2String("\r\nEnter countdown time (MM:SS): ");
+            SafeDispStr(UART_STR("\r\nEnter countdown time (MM:SS): "));
             
             /* Reset input buffer */
             memset(input_buffer, 0, sizeof(input_buffer));
@@ -328,14 +553,14 @@ void vTimeInputTask(void *pvParameters)
                         if (input_index < sizeof(input_buffer) - 1) {
                             input_buffer[input_index++] = uartCmd.character;
                             input_buffer[input_index] = '\0';
-                            XmitUART2(uartCmd.character, 1);
+                            LogBuf_Write(&uartCmd.character, 1, pdMS_TO_TICKS(100));
                         }
                     }
                 } else if (uartCmd.type == UART_CMD_BACKSPACE) {
                     if (input_index > 0) {
                         input_index--;
                         input_buffer[input_index] = '\0';
-                        SafeDisp2String("\b \b");
+                        SafeDispStr(UART_STR("\b \b"));
                     }
                 } else if (uartCmd.type == UART_CMD_ENTER) {
                     if (input_index > 0) {
@@ -360,12 +585,12 @@ void vTimeInputTask(void *pvParameters)
                                     xSemaphoreGive(xStateMutex);
                                 }
                                 
-                                SafeDisp2String("\r\nTime set! Press PB2+PB3 to start (long press to clear).\r\n");
+                                SafeDispStr(UART_STR("\r\nTime set! Press PB2+PB3 to start (long press to clear).\r\n"));
                             } else {
-                                SafeDisp2String("\r\nInvalid time.\r\n");
+                                SafeDispStr(UART_STR("\r\nInvalid time.\r\n"));
                             }
                         } else {
-                            SafeDisp2String("\r\nInvalid format. Use MM:SS\r\n");
+                            SafeDispStr(UART_STR("\r\nInvalid format. Use MM:SS\r\n"));
                         }
                     }
                 }
@@ -374,6 +599,7 @@ void vTimeInputTask(void *pvParameters)
         
             /* Now in READY state - wait for PB3+PB2 click to start countdown */
             ButtonEvent_t buttonEvent;
+            ButtonId_t combo = BUTTON_PB2_AND_PB3;
             bool start_triggered = false;
             
             while (g_SystemState == STATE_READY && !start_triggered && !repeat_input) {
@@ -386,7 +612,7 @@ void vTimeInputTask(void *pvParameters)
                         vTaskDelay(pdMS_TO_TICKS(50));
                         if ((xTaskGetTickCount() - holdStart) >= pdMS_TO_TICKS(1000)) {
                             /* Long press - clear time, re-enter */
-                            SafeDisp2String("\r\nTime cleared. Re-enter value.\r\n");
+                            SafeDispStr(UART_STR("\r\nTime cleared. Re-enter value.\r\n"));
                             if (xSemaphoreTake(xStateMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
                                 g_SystemState = STATE_TIME_INPUT;
                                 xSemaphoreGive(xStateMutex);
@@ -402,21 +628,24 @@ void vTimeInputTask(void *pvParameters)
                     }
                 }
                 
+                /* Single-button events mean nothing while READY - drop them */
+                while (xQueueReceiveMatching(xButtonQueue, &buttonEvent, MatchOtherButton,
+                                             &combo, 0) == pdTRUE) { }
+                
                 /* Also check button queue for combo events */
-                while (xQueueReceive(xButtonQueue, &buttonEvent, 0) == pdTRUE) {
-                    if (buttonEvent.button == BUTTON_PB2_AND_PB3) {
-                        if (buttonEvent.event == EVENT_CLICK) {
-                            start_triggered = true;
-                            break;
-                        } else if (buttonEvent.event == EVENT_LONG_PRESS) {
-                            SafeDisp2String("\r\nTime cleared. Re-enter value.\r\n");
-                            if (xSemaphoreTake(xStateMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-                                g_SystemState = STATE_TIME_INPUT;
-                                xSemaphoreGive(xStateMutex);
-                            }
-                            repeat_input = true;
-                            break;
+                while (xQueueReceiveMatching(xButtonQueue, &buttonEvent, MatchButton,
+                                             &combo, 0) == pdTRUE) {
+                    if (buttonEvent.event == EVENT_CLICK) {
+                        start_triggered = true;
+                        break;
+                    } else if (buttonEvent.event == EVENT_LONG_PRESS) {
+                        SafeDispStr(UART_STR("\r\nTime cleared. Re-enter value.\r\n"));
+                        if (xSemaphoreTake(xStateMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+                            g_SystemState = STATE_TIME_INPUT;
+                            xSemaphoreGive(xStateMutex);
                         }
+                        repeat_input = true;
+                        break;
                     }
                 }
                 
@@ -459,10 +688,38 @@ static void FormatTime(uint16_t seconds, char *buffer)
     buffer[5] = '\0';
 }
 
+/* RTCC counters at the start of the countdown, for SleepReport() */
+static RtccStats_t sleep_start;
+
+/**
+ * @brief Extended info: time the CPU slept during the countdown just ended
+ * 
+ * Static line buffer - the COUNT task is the only caller.
+ */
+static void SleepReport(void)
+{
+    static char line[80];
+    RtccStats_t now;
+    char *p = line;
+    
+    RTCC_GetStats(&now);
+    memcpy(p, "[SLEEP] ", 8);
+    p = Fmt_AppendU32(p + 8, now.slept_ticks - sleep_start.slept_ticks);
+    memcpy(p, " ms in ", 7);
+    p = Fmt_AppendU32(p + 7, (uint16_t)(now.sleeps - sleep_start.sleeps));
+    memcpy(p, " sleeps, ", 9);
+    p = Fmt_AppendU32(p + 9, (uint16_t)(now.early_wakes - sleep_start.early_wakes));
+    memcpy(p, " early wakes, RTCC div ", 23);
+    p = Fmt_AppendU32(p + 23, now.div);
+    memcpy(p, "\r\n", 3);
+    SafeDisp2String(line);
+}
+
 void vCountdownTask(void *pvParameters)
 {
     (void)pvParameters;
     uint16_t remaining;
+    uint16_t total;
     char time_str[8];
     char display_buffer[32];
     bool led1_on = false;
@@ -480,19 +737,22 @@ void vCountdownTask(void *pvParameters)
         }
         
         if (remaining == 0) {
-            SafeDisp2String("[ERROR: No time set]\r\n");
+            SafeDispStr(UART_STR("[ERROR: No time set]\r\n"));
             if (xSemaphoreTake(xStateMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
                 g_SystemState = STATE_WAITING;
                 xSemaphoreGive(xStateMutex);
             }
+            xTaskNotifyGive(xWaitingTask);
             continue;
         }
         
-        SafeDisp2String("\r\n[COUNTDOWN STARTED]\r\n");
+        SafeDispStr(UART_STR("\r\n[COUNTDOWN STARTED]\r\n"));
         
         /* Read ADC for initial brightness */
         uint16_t initial_adc = do_ADC();
         uint8_t initial_brightness = ADC_ToPercent(initial_adc);
+        total = remaining;
+        TelemEvent(TELEM_COUNTDOWN_START, total, initial_brightness, 3);
         
         /* Initialize LEDs */
         LED1_Off();
@@ -502,9 +762,13 @@ void vCountdownTask(void *pvParameters)
         
         /* Display initial time */
         FormatTime(remaining, time_str);
-        SafeDisp2String("\r\nTime: ");
+        SafeDispStr(UART_STR("\r\nTime: "));
         SafeDisp2String(time_str);
-        SafeDisp2String("   \r");  /* Spaces to clear, then return to start of line */
+        SafeDispStr(UART_STR("   \r"));  /* Spaces to clear, then return to start of line */
+        
+        /* Seconds come from the RTCC, which keeps counting in Sleep */
+        RTCC_GetStats(&sleep_start);
+        RTCC_StartSeconds();
         
         /* Countdown loop */
         bool paused = false;
@@ -512,46 +776,56 @@ void vCountdownTask(void *pvParameters)
         while (remaining > 0) {
             /* Check for PB3 button events */
             ButtonEvent_t buttonEvent;
-            while (xQueueReceive(xButtonQueue, &buttonEvent, 0) == pdTRUE) {
-                if (buttonEvent.button == BUTTON_PB3) {
-                    if (buttonEvent.event == EVENT_CLICK) {
-                        /* Toggle pause/resume */
-                        paused = !paused;
-                        if (paused) {
-                            if (xSemaphoreTake(xStateMutex, pdMS_TO_TICKS(10)) == pdTRUE) {
-                                g_SystemState = STATE_PAUSED;
-                                xSemaphoreGive(xStateMutex);
-                            }
-                            SafeDisp2String("\r\n[PAUSED]\r\n");
-                        } else {
-                            if (xSemaphoreTake(xStateMutex, pdMS_TO_TICKS(10)) == pdTRUE) {
-                                g_SystemState = STATE_COUNTDOWN;
-                                xSemaphoreGive(xStateMutex);
-                            }
-                            SafeDisp2String("\r\n[RESUMED]\r\n");
+            ButtonId_t pb3 = BUTTON_PB3;
+            while (xQueueReceiveMatching(xButtonQueue, &buttonEvent, MatchButton,
+                                         &pb3, 0) == pdTRUE) {
+                if (buttonEvent.event == EVENT_CLICK) {
+                    /* Toggle pause/resume */
+                    paused = !paused;
+                    if (paused) {
+                        RTCC_StopSeconds();
+                        if (xSemaphoreTake(xStateMutex, pdMS_TO_TICKS(10)) == pdTRUE) {
+                            g_SystemState = STATE_PAUSED;
+                            xSemaphoreGive(xStateMutex);
                         }
-                    } else if (buttonEvent.event == EVENT_LONG_PRESS) {
-                        /* Abort countdown - go to FINISHED */
-                        remaining = 0;
-                        SafeDisp2String("\r\n[ABORTED]\r\n");
-                        break;
+                        SafeDispStr(UART_STR("\r\n[PAUSED]\r\n"));
+                        TelemEvent(TELEM_PAUSE, remaining, 0, 2);
+                    } else {
+                        if (xSemaphoreTake(xStateMutex, pdMS_TO_TICKS(10)) == pdTRUE) {
+                            g_SystemState = STATE_COUNTDOWN;
+                            xSemaphoreGive(xStateMutex);
+                        }
+                        SafeDispStr(UART_STR("\r\n[RESUMED]\r\n"));
+                        RTCC_StartSeconds();
+                        TelemEvent(TELEM_RESUME, remaining, 0, 2);
                     }
+                } else if (buttonEvent.event == EVENT_LONG_PRESS) {
+                    /* Abort countdown - go to FINISHED */
+                    TelemEvent(TELEM_ABORT, remaining, 0, 2);
+                    remaining = 0;
+                    SafeDispStr(UART_STR("\r\n[ABORTED]\r\n"));
+                    break;
                 }
             }
             
+            /* Nobody else reads buttons during a countdown - drop the rest
+             * so they cannot fill the queue and crowd out PB3 */
+            while (xQueueReceiveMatching(xButtonQueue, &buttonEvent, MatchOtherButton,
+                                         &pb3, 0) == pdTRUE) { }
+            
             /* Check for UART commands ('i' and 'b' keys) */
             UartCmd_t uartCmd;
             while (xQueueReceive(xUartRxQueue, &uartCmd, 0) == pdTRUE) {
                 if (uartCmd.type == UART_CMD_TOGGLE_INFO) {
                     /* Toggle extended info display */
                     g_DisplaySettings.show_extended_info = !g_DisplaySettings.show_extended_info;
-                    SafeDisp2String(g_DisplaySettings.show_extended_info ? 
-                        "\r\n[INFO MODE ON]\r\n" : "\r\n[INFO MODE OFF]\r\n");
+                    SafeDispStr(g_DisplaySettings.show_extended_info ?
+                        UART_STR("\r\n[INFO MODE ON]\r\n") : UART_STR("\r\n[INFO MODE OFF]\r\n"));
                 } else if (uartCmd.type == UART_CMD_TOGGLE_BLINK) {
                     /* Toggle LED2 solid/blink mode */
                     g_DisplaySettings.led2_solid_mode = !g_DisplaySettings.led2_solid_mode;
-                    SafeDisp2String(g_DisplaySettings.led2_solid_mode ?
-                        "\r\n[LED2 SOLID]\r\n" : "\r\n[LED2 BLINK]\r\n");
+                    SafeDispStr(g_DisplaySettings.led2_solid_mode ?
+                        UART_STR("\r\n[LED2 SOLID]\r\n") : UART_STR("\r\n[LED2 BLINK]\r\n"));
                 }
             }
             
@@ -562,19 +836,14 @@ void vCountdownTask(void *pvParameters)
                 while (xQueueReceive(xUartRxQueue, &uartCmdPaused, 0) == pdTRUE) {
                     if (uartCmdPaused.type == UART_CMD_TOGGLE_INFO) {
                         g_DisplaySettings.show_extended_info = !g_DisplaySettings.show_extended_info;
-                        SafeDisp2String(g_DisplaySettings.show_extended_info ? 
-                            "\r\n[INFO MODE ON]\r\n" : "\r\n[INFO MODE OFF]\r\n");
+                        SafeDispStr(g_DisplaySettings.show_extended_info ?
+                            UART_STR("\r\n[INFO MODE ON]\r\n") : UART_STR("\r\n[INFO MODE OFF]\r\n"));
                     } else if (uartCmdPaused.type == UART_CMD_TOGGLE_BLINK) {
                         g_DisplaySettings.led2_solid_mode = !g_DisplaySettings.led2_solid_mode;
-                        SafeDisp2String(g_DisplaySettings.led2_solid_mode ?
-                            "\r\n[LED2 SOLID]\r\n" : "\r\n[LED2 BLINK]\r\n");
+                        SafeDispStr(g_DisplaySettings.led2_solid_mode ?
+                            UART_STR("\r\n[LED2 SOLID]\r\n") : UART_STR("\r\n[LED2 BLINK]\r\n"));
                     }
                 }
-                /* Read ADC and update brightness while paused */
-                uint16_t adc_paused = do_ADC();
-                uint8_t brightness_paused = ADC_ToPercent(adc_paused);
-                PWM_SetDutyCycle(brightness_paused);
-                
                 /* Control LED2 based on mode while paused */
                 if (g_DisplaySettings.led2_solid_mode) {
                     PWM_SetOutputEnabled(true);
@@ -591,24 +860,27 @@ void vCountdownTask(void *pvParameters)
                 break;
             }
             
-            /* Wait 1 second */
-            vTaskDelay(pdMS_TO_TICKS(1000));
+            /* Wait for the next RTCC second; the CPU may sleep meanwhile.
+             * If the RTCC has stopped, count the timeout instead. */
+            uint16_t elapsed = RTCC_WaitSeconds(pdMS_TO_TICKS(RTCC_FALLBACK_SECONDS * 1000UL));
+            if (elapsed == 0) {
+                elapsed = RTCC_FALLBACK_SECONDS;
+            }
             
             /* Decrement */
-            remaining--;
+            remaining = (elapsed >= remaining) ? 0 : (uint16_t)(remaining - elapsed);
             
-            /* Read ADC and update LED2 brightness */
+            /* LED2 brightness is kept up to date by vAdcTask */
             uint16_t adc_value = do_ADC();
-            uint8_t brightness = ADC_ToPercent(adc_value);
-            PWM_SetDutyCycle(brightness);
+            uint8_t brightness = PWM_GetDutyCycle();
             
             /* Display updated time (overwrite same line) */
             FormatTime(remaining, time_str);
             if (g_DisplaySettings.show_extended_info) {
                 /* Extended display: Time + ADC + Brightness */
-                SafeDisp2String("\rTime: ");
+                SafeDispStr(UART_STR("\rTime: "));
                 SafeDisp2String(time_str);
-                SafeDisp2String(" | ADC:");
+                SafeDispStr(UART_STR(" | ADC:"));
                 /* Format ADC value (0-1023) */
                 char adc_str[6];
                 uint16_t temp_adc = adc_value;
@@ -618,7 +890,7 @@ void vCountdownTask(void *pvParameters)
                 adc_str[3] = '0' + (temp_adc % 10);
                 adc_str[4] = '\0';
                 SafeDisp2String(adc_str);
-                SafeDisp2String(" | Duty:");
+                SafeDispStr(UART_STR(" | Duty:"));
                 /* Format brightness (0-100) */
                 char bright_str[4];
                 bright_str[0] = '0' + (brightness / 100);
@@ -626,20 +898,20 @@ void vCountdownTask(void *pvParameters)
                 bright_str[2] = '0' + (brightness % 10);
                 bright_str[3] = '\0';
                 SafeDisp2String(bright_str);
-                SafeDisp2String("%   ");  /* Spaces to clear any leftover chars */
+                SafeDispStr(UART_STR("%   "));  /* Spaces to clear any leftover chars */
             } else {
                 /* Simple display: Time only */
-                SafeDisp2String("\rTime: ");
+                SafeDispStr(UART_STR("\rTime: "));
                 SafeDisp2String(time_str);
-                SafeDisp2String("                    ");  /* Spaces to clear extended info if it was shown */
+                SafeDispStr(UART_STR("                    "));  /* Spaces to clear extended info if it was shown */
             }
             
             /* Toggle LED1 every second */
             led1_on = !led1_on;
             if (led1_on) {
-                LED1_On();
+                LedFb_Update(LED1_MASK, 0);
             } else {
-                LED1_Off();
+                LedFb_Update(0, LED1_MASK);
             }
             
             /* Control LED2 based on mode */
@@ -650,11 +922,16 @@ void vCountdownTask(void *pvParameters)
                 /* LED2 blinks in sync with LED1 */
                 PWM_SetOutputEnabled(led1_on);
             }
+            
+            /* LED1 and LED2 go out in one LATB write (a no-op if switching
+             * LED2 off above already committed LED1 with it) */
+            LedFb_Commit();
         }
         
+        RTCC_StopSeconds();
+        
         /* Countdown complete - enter FINISHED state */
-        LED1_Off();
-        LED0_Off();
+        LedFb_Write(0, LED0_MASK | LED1_MASK);
         
         /* Set state to COMPLETED */
         if (xSemaphoreTake(xStateMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
@@ -663,11 +940,16 @@ void vCountdownTask(void *pvParameters)
         }
         
         /* Newline to move to next line after overwriting countdown */
-        SafeDisp2String("\r\n\nThe countdown is done.\r\n\n");
+        SafeDispStr(UART_STR("\r\n\nThe countdown is done.\r\n\n"));
+        if (g_DisplaySettings.show_extended_info) {
+            SleepReport();
+        }
         
         /* LED2 solid on */
+        uint8_t final_brightness = ADC_ToPercent(do_ADC());
         PWM_SetOutputEnabled(true);
-        PWM_SetDutyCycle(50);  /* Initial brightness (will be updated from ADC) */
+        PWM_SetDutyCycle(final_brightness);  /* vAdcTask follows the pot from here */
+        TelemEvent(TELEM_COMPLETE, total, final_brightness, 3);
         
         /* LED0 and LED1 alternate rapidly for 5 seconds */
         /* During this time, potentiometer can still control LED2 brightness */
@@ -675,29 +957,14 @@ void vCountdownTask(void *pvParameters)
         const uint8_t blinkCycles = 25;  /* 25 cycles * 200ms = 5 seconds */
         
         for (uint8_t i = 0; i < blinkCycles; i++) {
-            LED0_On();
-            LED1_Off();
-            
-            /* Read ADC and update LED2 brightness */
-            uint16_t adc_value = do_ADC();
-            uint8_t brightness = ADC_ToPercent(adc_value);
-            PWM_SetDutyCycle(brightness);
-            
+            LedFb_Write(LED0_MASK, LED1_MASK);  /* One LATB write per frame */
             vTaskDelay(blinkDelay);
-            LED0_Off();
-            LED1_On();
-            
-            /* Read ADC again */
-            adc_value = do_ADC();
-            brightness = ADC_ToPercent(adc_value);
-            PWM_SetDutyCycle(brightness);
-            
+            LedFb_Write(LED1_MASK, LED0_MASK);
             vTaskDelay(blinkDelay);
         }
         
         /* Turn off all LEDs */
-        LED0_Off();
-        LED1_Off();
+        LedFb_Write(0, LED0_MASK | LED1_MASK);
         PWM_Stop();
         
         /* Return to WAITING */
@@ -705,6 +972,7 @@ void vCountdownTask(void *pvParameters)
             g_SystemState = STATE_WAITING;
             xSemaphoreGive(xStateMutex);
         }
+        xTaskNotifyGive(xWaitingTask);
     }
 }
 
@@ -732,29 +1000,320 @@ void vButtonTask(void *pvParameters)
         /* Send any pending button events to queue */
         Buttons_SendPendingEvents();
         
+        /* Nothing pressed: stop polling until the next press */
+        if (Buttons_Idle() && Buttons_ArmWake(xTaskGetCurrentTaskHandle())) {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            xLastWakeTime = xTaskGetTickCount();
+        }
+        
         /* Wait for next poll cycle */
         vTaskDelayUntil(&xLastWakeTime, xPollPeriod);
     }
 }
 
+/*============================================================================
+ * ADC TASK
+ * 
+ * Brightness pipeline. Sleeps until the end-of-scan ISR reports that the
+ * pot has left its window, then maps it to LED2 duty cycle. A pot that is
+ * not being touched costs no task wake-ups at all.
+ *============================================================================*/
+
+void vAdcTask(void *pvParameters)
+{
+    (void)pvParameters;
+    SystemState_t state;
+    TickType_t last_pot_record = 0;
+    uint8_t percent;
+    
+    /* Lowest priority, so this runs once the prompt is already queued */
+    App_InitDeferred();
+    Boot_Report();
+    HeapStat_Report();
+    
+    for(;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        
+        /* Pot only drives LED2 once a countdown has started; the waiting
+         * state pulses it instead */
+        state = g_SystemState;
+        percent = ADC_ToPercent(do_ADC());
+        if (state == STATE_COUNTDOWN || state == STATE_PAUSED ||
+            state == STATE_COMPLETED) {
+            /* Ramp rather than jump; runs in the PWM ISR */
+            PWM_FadeTo(percent, PWM_POT_FADE_MS);
+        }
+        
+        /* Pot use for the telemetry log, at most one record per interval */
+        if ((TickType_t)(xTaskGetTickCount() - last_pot_record) >=
+            pdMS_TO_TICKS(TELEM_POT_INTERVAL_MS)) {
+            last_pot_record = xTaskGetTickCount();
+            TelemEvent(TELEM_POT, (uint16_t)(percent | ((uint16_t)state << 8)), 0, 2);
+        }
+    }
+}
+
+/*============================================================================
+ * LOG TASK
+ * 
+ * Sole owner of the UART transmitter. Drains committed log records.
+ *============================================================================*/
+
+void vLogTask(void *pvParameters)
+{
+    (void)pvParameters;
+    /* Ping-pong blocks: one is refilled while the DMA sends the other */
+    static uint8_t chunk[2][LOG_TX_CHUNK];
+    uint8_t which = 0;
+    uint16_t count;
+    
+    for(;;) {
+        /* Sleep until a producer commits a record */
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        
+        for (;;) {
+            /* Holding a slot, at most the other buffer is still going out,
+             * so this one may be refilled */
+            UartDma_WaitSlot(portMAX_DELAY);
+            count = LogBuf_Read(chunk[which], LOG_TX_CHUNK);
+            UartDma_Submit(chunk[which], count);    /* 0 returns the slot */
+            if (count == 0) {
+                break;
+            }
+            which ^= 1;
+        }
+    }
+}
+
+
+/*============================================================================
+ * TELEMETRY TASK
+ * 
+ * Owns the flash telemetry log: finds the head at startup, records the
+ * reset cause, new error counts and AVdd drops, and programs the RAM
+ * batches into flash. Each NVM operation stalls the CPU with interrupts
+ * held off, so batches are only written while the system is WAITING,
+ * unless one is close to full or a dump ('t') was asked for.
+ * 
+ * While the 's' stream is on, the ADC scan ISR hands it every scan in
+ * blocks of TELEM_STREAM_BLOCK_SCANS (pingpong.h, notified by
+ * TELEM_REQ_SCANS), and it adds the duty cycle and state to each scan for
+ * telemstream.c to pack and send. Blocks it was too late for are logged
+ * as TELEM_ERR_SCAN_LOST.
+ * 
+ * While 'a' is on, it prints the closed aggregation windows (telemagg.h).
+ *============================================================================*/
+
+/* 's' stream scan blocks: the ADC ISR fills one half while TLOG packs
+ * the other */
+static PingPong_t telem_scans;
+static AdcScanVector_t telem_scan_blocks[2 * TELEM_STREAM_BLOCK_SCANS];
+
+/* One 's' stream sample: a scan vector, the duty cycle and the state */
+static void TelemStreamSample(const AdcScanVector_t *scan)
+{
+    int16_t sample[TELEM_STREAM_FIELDS];
+    
+    sample[0] = (int16_t)scan->timestamp;
+    sample[1] = (int16_t)scan->value[ADC_SCAN_POT_INDEX];
+    sample[2] = (int16_t)scan->value[ADC_SCAN_TEMP_INDEX];
+    sample[3] = (int16_t)scan->value[ADC_SCAN_VBG_INDEX];
+    sample[4] = (int16_t)PWM_GetDutyCycle();
+    sample[5] = (int16_t)g_SystemState;
+    TelemStream_Add(sample);
+}
+
+/* Pack every scan of the block the ADC ISR published, if there is one */
+static void TelemStreamScans(void)
+{
+    const AdcScanVector_t *scan;
+    uint16_t len;
+    
+    scan = (const AdcScanVector_t *)PingPong_Receive(&telem_scans, &len, 0);
+    if (scan == NULL) {
+        return;
+    }
+    for (; len >= sizeof(AdcScanVector_t); len -= sizeof(AdcScanVector_t)) {
+        TelemStreamSample(scan++);
+    }
+    PingPong_Release(&telem_scans);
+}
+
+/* Keep the current 'i' and 'b' settings as the power-on defaults. The
+ * erase and program stall the CPU, so only while WAITING. */
+static void SaveDisplaySettings(void)
+{
+    AppConfig_t cfg = *AppCfg_Get();
+    
+    if (g_SystemState != STATE_WAITING) {
+        SafeDispStr(UART_STR("\r\n[cfg] Save only while waiting\r\n"));
+        return;
+    }
+    
+    cfg.show_extended_info = g_DisplaySettings.show_extended_info ? 1 : 0;
+    cfg.led2_solid_mode = g_DisplaySettings.led2_solid_mode ? 1 : 0;
+    SafeDispStr(AppCfg_Write(&cfg) ? UART_STR("\r\n[cfg] Display settings saved\r\n") :
+                                     UART_STR("\r\n[cfg] Save failed\r\n"));
+}
+
+/* Record the growth of an error counter since the last check */
+static void TelemCount(uint8_t code, uint16_t now, uint16_t *last)
+{
+    if (now != *last) {
+        TelemEvent(TELEM_ERROR, (uint16_t)(now - *last), code, 3);
+        *last = now;
+    }
+}
+
+/* Record AVdd once each time it drops below ADC_LOW_VDD_MV */
+static void TelemSupply(bool *low)
+{
+    AdcScanVector_t scan;
+    uint16_t mv;
+    
+    if (!ADC_GetScan(&scan)) {
+        return;
+    }
+    mv = ADC_SupplyMillivolts(&scan);
+    if (!*low && mv != 0 && mv < ADC_LOW_VDD_MV) {
+        *low = true;
+        TelemEvent(TELEM_ERROR, mv, TELEM_ERR_LOW_VDD, 3);
+    } else if (*low && mv >= ADC_LOW_VDD_MV + ADC_LOW_VDD_HYST_MV) {
+        *low = false;
+    }
+}
+
+void vTelemTask(void *pvParameters)
+{
+    (void)pvParameters;
+    UartRxStats_t rx;
+    TelemLogStats_t stats;
+    uint16_t overruns = 0;
+    uint16_t framing = 0;
+    uint16_t parity = 0;
+    uint16_t log_dropped = 0;
+    uint16_t tlog_dropped = 0;
+    uint16_t scans_lost = 0;
+    bool supply_low = false;
+    TickType_t wait;
+    uint32_t requests;
+    
+    TelemLog_Recover();
+    
+    /* Reset cause, then clear it so the next reset reports its own */
+    TelemEvent(TELEM_BOOT, RCON, 0, 2);
+    RCON &= ~TELEM_RCON_CAUSES;
+    
+    for(;;) {
+        wait = pdMS_TO_TICKS(TELEM_FLUSH_PERIOD_MS);
+        if (TelemAgg_Running() && wait > pdMS_TO_TICKS(AGG_FAST_WINDOW_MS)) {
+            wait = pdMS_TO_TICKS(AGG_FAST_WINDOW_MS);
+        }
+        requests = 0;
+        (void)xTaskNotifyWait(0, 0xFFFFFFFFUL, &requests, wait);
+        
+        if (requests & TELEM_REQ_AGG) {
+            if (TelemAgg_Running()) {
+                TelemAgg_Stop();
+            } else {
+                TelemAgg_Start();
+            }
+        }
+        TelemAgg_Report();
+        
+        if (TelemStream_Running()) {
+            TelemStreamScans();
+        }
+        if (requests & TELEM_REQ_STREAM) {
+            if (TelemStream_Running()) {
+                ADC_ScanBlocks(NULL, 0);
+                TelemStream_Stop();
+            } else {
+                PingPong_Init(&telem_scans, (uint8_t *)telem_scan_blocks,
+                              TELEM_STREAM_BLOCK_SCANS * sizeof(AdcScanVector_t),
+                              xTaskGetCurrentTaskHandle(), TELEM_REQ_SCANS);
+                scans_lost = 0;
+                TelemStream_Start(AppCfg_Get()->adc_scan_period_ms);
+                ADC_ScanBlocks(&telem_scans, TELEM_STREAM_BLOCK_SCANS);
+            }
+        }
+        
+        UART2_GetRxStats(&rx);
+        TelemLog_GetStats(&stats);
+        TelemCount(TELEM_ERR_UART_OVERRUN, rx.overruns, &overruns);
+        TelemCount(TELEM_ERR_UART_FRAMING, rx.framing_errors, &framing);
+        TelemCount(TELEM_ERR_UART_PARITY, rx.parity_errors, &parity);
+        TelemCount(TELEM_ERR_LOG_DROPPED, LogBuf_GetDropped(), &log_dropped);
+        TelemCount(TELEM_ERR_TLOG_DROPPED, stats.dropped, &tlog_dropped);
+        TelemCount(TELEM_ERR_SCAN_LOST, PingPong_GetOverflows(&telem_scans), &scans_lost);
+        TelemSupply(&supply_low);
+        
+        if (TelemLog_Pending() != 0 &&
+            (g_SystemState == STATE_WAITING || (requests & TELEM_REQ_DUMP) ||
+             TelemLog_Pending() >= TELEM_FLUSH_WORDS)) {
+            TelemLog_Flush();
+        }
+        
+        if (requests & TELEM_REQ_DUMP) {
+            TelemLog_Dump();
+        }
+        
+        if (requests & TELEM_REQ_CFG_SAVE) {
+            SaveDisplaySettings();
+        }
+        
+        /* Catalog first, so a reader asking for both can name the records */
+        if (requests & TELEM_REQ_CATALOG) {
+            Inspect_Catalog();
+        }
+        if (requests & TELEM_REQ_SNAPSHOT) {
+            Inspect_Snapshot();
+        }
+    }
+}
 
 /*============================================================================
  * HARDWARE INITIALIZATION
  *============================================================================*/
 
+/* Everything the welcome prompt and the WAITING state need */
 void App_InitHardware(void)
 {
+    /* CRC engine, then the settings image it checks - PWM, ADC, buttons
+     * and queues read it */
+    Crc_Init();
+    Boot_Mark(Crc_HardwareActive() ? "crc-hw" : "crc-sw");
+    AppCfg_Init();
+    g_DisplaySettings.show_extended_info = AppCfg_Get()->show_extended_info != 0;
+    g_DisplaySettings.led2_solid_mode = AppCfg_Get()->led2_solid_mode != 0;
+    Boot_Mark((AppCfg_GetSlot() == 0) ? "cfg-slot0" :
+              (AppCfg_GetSlot() == 1) ? "cfg-slot1" : "cfg-default");
+    
     /* Initialize all GPIO pins */
     HW_InitAllPins();
+    Boot_Mark("gpio");
     
     /* Initialize UART */
     InitUART2();
+    UartDma_Init();
+    Boot_Mark("uart");
     
-    /* Initialize PWM (but don't start yet) */
+    /* Initialize PWM (but don't start yet) - WAITING pulses LED2 at once */
     PWM_Init();
+    Boot_Mark("pwm");
     
-    /* Initialize ADC for potentiometer reading */
+    /* Countdown seconds, and the alarm that ends each sleep */
+    RTCC_Init();
+    Boot_Mark("rtcc");
+}
+
+/* Non-critical init, run by vAdcTask after the scheduler has started so
+ * it never delays the first prompt */
+void App_InitDeferred(void)
+{
+    /* Initialize ADC for potentiometer reading (includes a 2 ms settle) */
     init_ADC();
+    Boot_Mark("adc");
 }
 
 /*============================================================================
@@ -764,17 +1323,31 @@ void App_InitHardware(void)
 void App_InitRTOSObjects(void)
 {
     /* Create queues */
-    xButtonQueue = xQueueCreate(BUTTON_QUEUE_SIZE, sizeof(ButtonEvent_t));
-    xUartRxQueue = xQueueCreate(UART_RX_QUEUE_SIZE, sizeof(UartCmd_t));
+    xButtonQueue = xQueueCreate(AppCfg_Get()->button_queue_size, sizeof(ButtonEvent_t));
+    xUartRxQueue = xQueueCreate(AppCfg_Get()->uart_rx_queue_size, sizeof(UartCmd_t));
+    xUartByteQueue = xQueueCreate(AppCfg_Get()->uart_rx_queue_size, sizeof(char));
     
     /* Create binary semaphores for synchronization */
     xStartInputSem = xSemaphoreCreateBinary();
     xStartCountdownSem = xSemaphoreCreateBinary();
     
     /* Create mutexes for shared resource protection */
-    xUartMutex = xSemaphoreCreateMutex();
     xStateMutex = xSemaphoreCreateMutex();
     xCountdownMutex = xSemaphoreCreateMutex();
+    
+    /* Labels for the heap report */
+    HeapStat_Name(xButtonQueue, "BTNQ");
+    HeapStat_Name(xUartRxQueue, "RXQ");
+    HeapStat_Name(xUartByteQueue, "RXBQ");
+    HeapStat_Name(xStartInputSem, "INSEM");
+    HeapStat_Name(xStartCountdownSem, "CDSEM");
+    HeapStat_Name(xStateMutex, "STATE");
+    HeapStat_Name(xCountdownMutex, "COUNT");
+    
+    /* Windowed statistics - fed from the ADC ISR and the tick hook */
+    TelemAgg_Init();
+    ADC_PotAggregate(TelemAgg_Get(AGG_POT_FAST));
+    ADC_PotAggregate(TelemAgg_Get(AGG_POT_SLOW));
 }
 
 /*============================================================================
@@ -783,6 +1356,9 @@ void App_InitRTOSObjects(void)
 
 int main(void)
 {
+    /* Boot clock first, so every stage below is timed from reset */
+    Boot_Start();
+    
     /*------------------------------------------------------------------------
      * Initialize hardware BEFORE creating FreeRTOS objects
      * This ensures peripherals are ready before tasks start.
@@ -794,18 +1370,29 @@ int main(void)
      * MUST be done BEFORE creating tasks that use them!
      *------------------------------------------------------------------------*/
     App_InitRTOSObjects();
+    Boot_Mark("rtos");
     
     /*------------------------------------------------------------------------
      * Create application tasks
      *------------------------------------------------------------------------*/
     
+    /* Log task - must exist before any task prints */
+    TaskHandle_t xLogTask = NULL;
+    xTaskCreate(vLogTask, "LOG", STACK_SIZE_LOG,
+                NULL, PRIORITY_LOG, &xLogTask);
+    LogBuf_Init(xLogTask);
+    
+    /* UART RX task - sorts the bytes the RX ISR queues */
+    xTaskCreate(vUartRxTask, "RX", STACK_SIZE_UART_RX,
+                NULL, PRIORITY_UART_RX, NULL);
+    
     /* Button polling task */
     xTaskCreate(vButtonTask, "BTN", STACK_SIZE_BUTTON, 
                 NULL, PRIORITY_BUTTON_HANDLER, NULL);
     
     /* Waiting task */
     xTaskCreate(vWaitingTask, "WAIT", STACK_SIZE_WAITING, 
-                NULL, PRIORITY_WAITING, NULL);
+                NULL, PRIORITY_WAITING, &xWaitingTask);
     
     /* Time input task */
     xTaskCreate(vTimeInputTask, "INPUT", STACK_SIZE_TIME_INPUT, 
@@ -815,14 +1402,33 @@ int main(void)
     xTaskCreate(vCountdownTask, "COUNT", STACK_SIZE_COUNTDOWN, 
                 NULL, PRIORITY_COUNTDOWN, NULL);
     
+    /* ADC task - woken by the scan ISR only when the pot moves */
+    TaskHandle_t xAdcTask = NULL;
+    xTaskCreate(vAdcTask, "ADC", STACK_SIZE_ADC,
+                NULL, PRIORITY_ADC, &xAdcTask);
+    ADC_PotWatch(xAdcTask, ADC_POT_WINDOW);
+    
+    /* Telemetry task - writes the flash log in batches */
+    xTaskCreate(vTelemTask, "TLOG", STACK_SIZE_TELEM,
+                NULL, PRIORITY_TELEM, &xTelemTask);
+    
+#if STATEPROF_ENABLE
+    /* Profiling builds only - prints the report when 'p' is received */
+    xTaskCreate(vStateProfTask, "PROF", STACK_SIZE_PROF,
+                NULL, PRIORITY_PROF, NULL);
+#endif
+    Boot_Mark("tasks");
+    
     /*------------------------------------------------------------------------
      * Start the FreeRTOS scheduler
      * This function should never return.
      *------------------------------------------------------------------------*/
+    Boot_SchedulerStarting();
     vTaskStartScheduler();
     
-    /* Should never reach here */
-    for(;;);
+    /* Only returns if the idle task did not fit in the heap */
+    FaultBegin(UART_STR("scheduler did not start"));
+    FaultHalt();
     
     return 0;
 }
@@ -51,17 +51,17 @@ OBJECTDIR=build/${CND_CONF}/${IMAGE_TYPE}
 DISTDIR=dist/${CND_CONF}/${IMAGE_TYPE}
 
 # Source Files Quoted if spaced
-SOURCEFILES_QUOTED_IF_SPACED=FreeRTOS/portable/MPLAB/PIC24_dsPIC/port.c FreeRTOS/portable/MPLAB/PIC24_dsPIC/portasm_PIC24.S FreeRTOS/portable/MemMang/heap_1.c FreeRTOS/croutine.c FreeRTOS/event_groups.c FreeRTOS/list.c FreeRTOS/queue.c FreeRTOS/stream_buffer.c FreeRTOS/tasks.c FreeRTOS/timers.c main.c uart.c FreeRTOS/pwm.c FreeRTOS/buttons.c FreeRTOS/adc.c
+SOURCEFILES_QUOTED_IF_SPACED=FreeRTOS/portable/MPLAB/PIC24_dsPIC/port.c FreeRTOS/portable/MPLAB/PIC24_dsPIC/portasm_PIC24.S FreeRTOS/portable/MemMang/heap_1.c FreeRTOS/croutine.c FreeRTOS/event_groups.c FreeRTOS/list.c FreeRTOS/queue.c FreeRTOS/stream_buffer.c FreeRTOS/tasks.c FreeRTOS/timers.c main.c uart.c FreeRTOS/pwm.c FreeRTOS/buttons.c FreeRTOS/adc.c logbuf.c uart_dma.c ledfb.c boot.c heapstat.c appcfg.c stateprof.c telemlog.c deltapack.c winagg.c crc.c inspect.c rtcc.c fmt.c nvm.c telemstream.c telemagg.c pingpong.c
 
 # Object Files Quoted if spaced
-OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/FreeRTOS/portable/MPLAB/PIC24_dsPIC/port.o ${OBJECTDIR}/FreeRTOS/portable/MPLAB/PIC24_dsPIC/portasm_PIC24.o ${OBJECTDIR}/FreeRTOS/portable/MemMang/heap_1.o ${OBJECTDIR}/FreeRTOS/croutine.o ${OBJECTDIR}/FreeRTOS/event_groups.o ${OBJECTDIR}/FreeRTOS/list.o ${OBJECTDIR}/FreeRTOS/queue.o ${OBJECTDIR}/FreeRTOS/stream_buffer.o ${OBJECTDIR}/FreeRTOS/tasks.o ${OBJECTDIR}/FreeRTOS/timers.o ${OBJECTDIR}/main.o ${OBJECTDIR}/uart.o ${OBJECTDIR}/FreeRTOS/pwm.o ${OBJECTDIR}/FreeRTOS/buttons.o ${OBJECTDIR}/FreeRTOS/adc.o
-POSSIBLE_DEPFILES=${OBJECTDIR}/FreeRTOS/portable/MPLAB/PIC24_dsPIC/port.o.d ${OBJECTDIR}/FreeRTOS/portable/MPLAB/PIC24_dsPIC/portasm_PIC24.o.d ${OBJECTDIR}/FreeRTOS/portable/MemMang/heap_1.o.d ${OBJECTDIR}/FreeRTOS/croutine.o.d ${OBJECTDIR}/FreeRTOS/event_groups.o.d ${OBJECTDIR}/FreeRTOS/list.o.d ${OBJECTDIR}/FreeRTOS/queue.o.d ${OBJECTDIR}/FreeRTOS/stream_buffer.o.d ${OBJECTDIR}/FreeRTOS/tasks.o.d ${OBJECTDIR}/FreeRTOS/timers.o.d ${OBJECTDIR}/main.o.d ${OBJECTDIR}/uart.o.d ${OBJECTDIR}/FreeRTOS/pwm.o.d ${OBJECTDIR}/FreeRTOS/buttons.o.d ${OBJECTDIR}/FreeRTOS/adc.o.d
+OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/FreeRTOS/portable/MPLAB/PIC24_dsPIC/port.o ${OBJECTDIR}/FreeRTOS/portable/MPLAB/PIC24_dsPIC/portasm_PIC24.o ${OBJECTDIR}/FreeRTOS/portable/MemMang/heap_1.o ${OBJECTDIR}/FreeRTOS/croutine.o ${OBJECTDIR}/FreeRTOS/event_groups.o ${OBJECTDIR}/FreeRTOS/list.o ${OBJECTDIR}/FreeRTOS/queue.o ${OBJECTDIR}/FreeRTOS/stream_buffer.o ${OBJECTDIR}/FreeRTOS/tasks.o ${OBJECTDIR}/FreeRTOS/timers.o ${OBJECTDIR}/main.o ${OBJECTDIR}/uart.o ${OBJECTDIR}/FreeRTOS/pwm.o ${OBJECTDIR}/FreeRTOS/buttons.o ${OBJECTDIR}/FreeRTOS/adc.o ${OBJECTDIR}/logbuf.o ${OBJECTDIR}/uart_dma.o ${OBJECTDIR}/ledfb.o ${OBJECTDIR}/boot.o ${OBJECTDIR}/heapstat.o ${OBJECTDIR}/appcfg.o ${OBJECTDIR}/stateprof.o ${OBJECTDIR}/telemlog.o ${OBJECTDIR}/deltapack.o ${OBJECTDIR}/winagg.o ${OBJECTDIR}/crc.o ${OBJECTDIR}/inspect.o ${OBJECTDIR}/rtcc.o ${OBJECTDIR}/fmt.o ${OBJECTDIR}/nvm.o ${OBJECTDIR}/telemstream.o ${OBJECTDIR}/telemagg.o ${OBJECTDIR}/pingpong.o
+POSSIBLE_DEPFILES=${OBJECTDIR}/FreeRTOS/portable/MPLAB/PIC24_dsPIC/port.o.d ${OBJECTDIR}/FreeRTOS/portable/MPLAB/PIC24_dsPIC/portasm_PIC24.o.d ${OBJECTDIR}/FreeRTOS/portable/MemMang/heap_1.o.d ${OBJECTDIR}/FreeRTOS/croutine.o.d ${OBJECTDIR}/FreeRTOS/event_groups.o.d ${OBJECTDIR}/FreeRTOS/list.o.d ${OBJECTDIR}/FreeRTOS/queue.o.d ${OBJECTDIR}/FreeRTOS/stream_buffer.o.d ${OBJECTDIR}/FreeRTOS/tasks.o.d ${OBJECTDIR}/FreeRTOS/timers.o.d ${OBJECTDIR}/main.o.d ${OBJECTDIR}/uart.o.d ${OBJECTDIR}/FreeRTOS/pwm.o.d ${OBJECTDIR}/FreeRTOS/buttons.o.d ${OBJECTDIR}/FreeRTOS/adc.o.d ${OBJECTDIR}/logbuf.o.d ${OBJECTDIR}/uart_dma.o.d ${OBJECTDIR}/ledfb.o.d ${OBJECTDIR}/boot.o.d ${OBJECTDIR}/heapstat.o.d ${OBJECTDIR}/appcfg.o.d ${OBJECTDIR}/stateprof.o.d ${OBJECTDIR}/telemlog.o.d ${OBJECTDIR}/deltapack.o.d ${OBJECTDIR}/winagg.o.d ${OBJECTDIR}/crc.o.d ${OBJECTDIR}/inspect.o.d ${OBJECTDIR}/rtcc.o.d ${OBJECTDIR}/fmt.o.d ${OBJECTDIR}/nvm.o.d ${OBJECTDIR}/telemstream.o.d ${OBJECTDIR}/telemagg.o.d ${OBJECTDIR}/pingpong.o.d
 
 # Object Files
-OBJECTFILES=${OBJECTDIR}/FreeRTOS/portable/MPLAB/PIC24_dsPIC/port.o ${OBJECTDIR}/FreeRTOS/portable/MPLAB/PIC24_dsPIC/portasm_PIC24.o ${OBJECTDIR}/FreeRTOS/portable/MemMang/heap_1.o ${OBJECTDIR}/FreeRTOS/croutine.o ${OBJECTDIR}/FreeRTOS/event_groups.o ${OBJECTDIR}/FreeRTOS/list.o ${OBJECTDIR}/FreeRTOS/queue.o ${OBJECTDIR}/FreeRTOS/stream_buffer.o ${OBJECTDIR}/FreeRTOS/tasks.o ${OBJECTDIR}/FreeRTOS/timers.o ${OBJECTDIR}/main.o ${OBJECTDIR}/uart.o ${OBJECTDIR}/FreeRTOS/pwm.o ${OBJECTDIR}/FreeRTOS/buttons.o ${OBJECTDIR}/FreeRTOS/adc.o
+OBJECTFILES=${OBJECTDIR}/FreeRTOS/portable/MPLAB/PIC24_dsPIC/port.o ${OBJECTDIR}/FreeRTOS/portable/MPLAB/PIC24_dsPIC/portasm_PIC24.o ${OBJECTDIR}/FreeRTOS/portable/MemMang/heap_1.o ${OBJECTDIR}/FreeRTOS/croutine.o ${OBJECTDIR}/FreeRTOS/event_groups.o ${OBJECTDIR}/FreeRTOS/list.o ${OBJECTDIR}/FreeRTOS/queue.o ${OBJECTDIR}/FreeRTOS/stream_buffer.o ${OBJECTDIR}/FreeRTOS/tasks.o ${OBJECTDIR}/FreeRTOS/timers.o ${OBJECTDIR}/main.o ${OBJECTDIR}/uart.o ${OBJECTDIR}/FreeRTOS/pwm.o ${OBJECTDIR}/FreeRTOS/buttons.o ${OBJECTDIR}/FreeRTOS/adc.o ${OBJECTDIR}/logbuf.o ${OBJECTDIR}/uart_dma.o ${OBJECTDIR}/ledfb.o ${OBJECTDIR}/boot.o ${OBJECTDIR}/heapstat.o ${OBJECTDIR}/appcfg.o ${OBJECTDIR}/stateprof.o ${OBJECTDIR}/telemlog.o ${OBJECTDIR}/deltapack.o ${OBJECTDIR}/winagg.o ${OBJECTDIR}/crc.o ${OBJECTDIR}/inspect.o ${OBJECTDIR}/rtcc.o ${OBJECTDIR}/fmt.o ${OBJECTDIR}/nvm.o ${OBJECTDIR}/telemstream.o ${OBJECTDIR}/telemagg.o ${OBJECTDIR}/pingpong.o
 
 # Source Files
-SOURCEFILES=FreeRTOS/portable/MPLAB/PIC24_dsPIC/port.c FreeRTOS/portable/MPLAB/PIC24_dsPIC/portasm_PIC24.S FreeRTOS/portable/MemMang/heap_1.c FreeRTOS/croutine.c FreeRTOS/event_groups.c FreeRTOS/list.c FreeRTOS/queue.c FreeRTOS/stream_buffer.c FreeRTOS/tasks.c FreeRTOS/timers.c main.c uart.c FreeRTOS/pwm.c FreeRTOS/buttons.c FreeRTOS/adc.c
+SOURCEFILES=FreeRTOS/portable/MPLAB/PIC24_dsPIC/port.c FreeRTOS/portable/MPLAB/PIC24_dsPIC/portasm_PIC24.S FreeRTOS/portable/MemMang/heap_1.c FreeRTOS/croutine.c FreeRTOS/event_groups.c FreeRTOS/list.c FreeRTOS/queue.c FreeRTOS/stream_buffer.c FreeRTOS/tasks.c FreeRTOS/timers.c main.c uart.c FreeRTOS/pwm.c FreeRTOS/buttons.c FreeRTOS/adc.c logbuf.c uart_dma.c ledfb.c boot.c heapstat.c appcfg.c stateprof.c telemlog.c deltapack.c winagg.c crc.c inspect.c rtcc.c fmt.c nvm.c telemstream.c telemagg.c pingpong.c
 
 
 
@@ -173,6 +173,114 @@ ${OBJECTDIR}/FreeRTOS/adc.o: FreeRTOS/adc.c  .generated_files/flags/default/2638
 	@${RM} ${OBJECTDIR}/FreeRTOS/adc.o 
 	${MP_CC} $(MP_EXTRA_CC_PRE)  FreeRTOS/adc.c  -o ${OBJECTDIR}/FreeRTOS/adc.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MP -MMD -MF "${OBJECTDIR}/FreeRTOS/adc.o.d"      -g -D__DEBUG   -mno-eds-warn  -omf=elf -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -I"./FreeRTOS/include" -I"./" -I"./FreeRTOS/portable/MPLAB/PIC24_dsPIC" -O0 -msmart-io=1 -Wall -msfr-warn=off    -mdfp="${DFP_DIR}/xc16"
 	
+${OBJECTDIR}/logbuf.o: logbuf.c  .generated_files/flags/default/2d64a3c16cd4f375c761746666bf69d754cb470c .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/logbuf.o.d 
+	@${RM} ${OBJECTDIR}/logbuf.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  logbuf.c  -o ${OBJECTDIR}/logbuf.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MP -MMD -MF "${OBJECTDIR}/logbuf.o.d"      -g -D__DEBUG   -mno-eds-warn  -omf=elf -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -I"./FreeRTOS/include" -I"./" -I"./FreeRTOS/portable/MPLAB/PIC24_dsPIC" -O0 -msmart-io=1 -Wall -msfr-warn=off    -mdfp="${DFP_DIR}/xc16"
+	
+${OBJECTDIR}/uart_dma.o: uart_dma.c  .generated_files/flags/default/fd82df2ae179cf69f06883d6db42a8b5cac66efa .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/uart_dma.o.d 
+	@${RM} ${OBJECTDIR}/uart_dma.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  uart_dma.c  -o ${OBJECTDIR}/uart_dma.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MP -MMD -MF "${OBJECTDIR}/uart_dma.o.d"      -g -D__DEBUG   -mno-eds-warn  -omf=elf -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -I"./FreeRTOS/include" -I"./" -I"./FreeRTOS/portable/MPLAB/PIC24_dsPIC" -O0 -msmart-io=1 -Wall -msfr-warn=off    -mdfp="${DFP_DIR}/xc16"
+	
+${OBJECTDIR}/ledfb.o: ledfb.c  .generated_files/flags/default/36bd0015ff295e89129bf8b29e10088a118d2b19 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/ledfb.o.d 
+	@${RM} ${OBJECTDIR}/ledfb.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  ledfb.c  -o ${OBJECTDIR}/ledfb.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MP -MMD -MF "${OBJECTDIR}/ledfb.o.d"      -g -D__DEBUG   -mno-eds-warn  -omf=elf -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -I"./FreeRTOS/include" -I"./" -I"./FreeRTOS/portable/MPLAB/PIC24_dsPIC" -O0 -msmart-io=1 -Wall -msfr-warn=off    -mdfp="${DFP_DIR}/xc16"
+	
+${OBJECTDIR}/boot.o: boot.c  .generated_files/flags/default/59ef9be7c5116c6c3b35bebe319f5068c8d38237 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/boot.o.d 
+	@${RM} ${OBJECTDIR}/boot.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  boot.c  -o ${OBJECTDIR}/boot.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MP -MMD -MF "${OBJECTDIR}/boot.o.d"      -g -D__DEBUG   -mno-eds-warn  -omf=elf -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -I"./FreeRTOS/include" -I"./" -I"./FreeRTOS/portable/MPLAB/PIC24_dsPIC" -O0 -msmart-io=1 -Wall -msfr-warn=off    -mdfp="${DFP_DIR}/xc16"
+	
+${OBJECTDIR}/heapstat.o: heapstat.c  .generated_files/flags/default/48ec1100ac726783700eac7004ad214dcdab9a8b .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/heapstat.o.d 
+	@${RM} ${OBJECTDIR}/heapstat.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  heapstat.c  -o ${OBJECTDIR}/heapstat.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MP -MMD -MF "${OBJECTDIR}/heapstat.o.d"      -g -D__DEBUG   -mno-eds-warn  -omf=elf -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -I"./FreeRTOS/include" -I"./" -I"./FreeRTOS/portable/MPLAB/PIC24_dsPIC" -O0 -msmart-io=1 -Wall -msfr-warn=off    -mdfp="${DFP_DIR}/xc16"
+	
+${OBJECTDIR}/appcfg.o: appcfg.c  .generated_files/flags/default/d5d133b13f31e6c227b85b199bdaf442d25ef579 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/appcfg.o.d 
+	@${RM} ${OBJECTDIR}/appcfg.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  appcfg.c  -o ${OBJECTDIR}/appcfg.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MP -MMD -MF "${OBJECTDIR}/appcfg.o.d"      -g -D__DEBUG   -mno-eds-warn  -omf=elf -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -I"./FreeRTOS/include" -I"./" -I"./FreeRTOS/portable/MPLAB/PIC24_dsPIC" -O0 -msmart-io=1 -Wall -msfr-warn=off    -mdfp="${DFP_DIR}/xc16"
+	
+${OBJECTDIR}/stateprof.o: stateprof.c  .generated_files/flags/default/d7e340eba9c41d608f5f934e465dcdbb20d02e11 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/stateprof.o.d 
+	@${RM} ${OBJECTDIR}/stateprof.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  stateprof.c  -o ${OBJECTDIR}/stateprof.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MP -MMD -MF "${OBJECTDIR}/stateprof.o.d"      -g -D__DEBUG   -mno-eds-warn  -omf=elf -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -I"./FreeRTOS/include" -I"./" -I"./FreeRTOS/portable/MPLAB/PIC24_dsPIC" -O0 -msmart-io=1 -Wall -msfr-warn=off    -mdfp="${DFP_DIR}/xc16"
+	
+${OBJECTDIR}/telemlog.o: telemlog.c  .generated_files/flags/default/ca4f576ec38d18079f2aa5c8166478270f80809e .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/telemlog.o.d 
+	@${RM} ${OBJECTDIR}/telemlog.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  telemlog.c  -o ${OBJECTDIR}/telemlog.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MP -MMD -MF "${OBJECTDIR}/telemlog.o.d"      -g -D__DEBUG   -mno-eds-warn  -omf=elf -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -I"./FreeRTOS/include" -I"./" -I"./FreeRTOS/portable/MPLAB/PIC24_dsPIC" -O0 -msmart-io=1 -Wall -msfr-warn=off    -mdfp="${DFP_DIR}/xc16"
+	
+${OBJECTDIR}/deltapack.o: deltapack.c  .generated_files/flags/default/de50f2e3453698919ecbc8b0c4a84355d66c74a3 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/deltapack.o.d 
+	@${RM} ${OBJECTDIR}/deltapack.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  deltapack.c  -o ${OBJECTDIR}/deltapack.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MP -MMD -MF "${OBJECTDIR}/deltapack.o.d"      -g -D__DEBUG   -mno-eds-warn  -omf=elf -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -I"./FreeRTOS/include" -I"./" -I"./FreeRTOS/portable/MPLAB/PIC24_dsPIC" -O0 -msmart-io=1 -Wall -msfr-warn=off    -mdfp="${DFP_DIR}/xc16"
+	
+${OBJECTDIR}/winagg.o: winagg.c  .generated_files/flags/default/d9c6640b358b80e26c0e486daf0ff3ef8f1219c7 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/winagg.o.d 
+	@${RM} ${OBJECTDIR}/winagg.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  winagg.c  -o ${OBJECTDIR}/winagg.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MP -MMD -MF "${OBJECTDIR}/winagg.o.d"      -g -D__DEBUG   -mno-eds-warn  -omf=elf -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -I"./FreeRTOS/include" -I"./" -I"./FreeRTOS/portable/MPLAB/PIC24_dsPIC" -O0 -msmart-io=1 -Wall -msfr-warn=off    -mdfp="${DFP_DIR}/xc16"
+	
+${OBJECTDIR}/crc.o: crc.c  .generated_files/flags/default/d4211eb63ce3c73f9d197f6aa65b65354d2c3c58 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/crc.o.d 
+	@${RM} ${OBJECTDIR}/crc.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  crc.c  -o ${OBJECTDIR}/crc.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MP -MMD -MF "${OBJECTDIR}/crc.o.d"      -g -D__DEBUG   -mno-eds-warn  -omf=elf -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -I"./FreeRTOS/include" -I"./" -I"./FreeRTOS/portable/MPLAB/PIC24_dsPIC" -O0 -msmart-io=1 -Wall -msfr-warn=off    -mdfp="${DFP_DIR}/xc16"
+	
+${OBJECTDIR}/inspect.o: inspect.c  .generated_files/flags/default/9c50d7c8c145b7fbde953d833a81838024876dde .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/inspect.o.d 
+	@${RM} ${OBJECTDIR}/inspect.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  inspect.c  -o ${OBJECTDIR}/inspect.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MP -MMD -MF "${OBJECTDIR}/inspect.o.d"      -g -D__DEBUG   -mno-eds-warn  -omf=elf -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -I"./FreeRTOS/include" -I"./" -I"./FreeRTOS/portable/MPLAB/PIC24_dsPIC" -O0 -msmart-io=1 -Wall -msfr-warn=off    -mdfp="${DFP_DIR}/xc16"
+	
+${OBJECTDIR}/rtcc.o: rtcc.c  .generated_files/flags/default/c3c72fdd981920ab901110ad0d8e99ac9ea5e070 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/rtcc.o.d 
+	@${RM} ${OBJECTDIR}/rtcc.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  rtcc.c  -o ${OBJECTDIR}/rtcc.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MP -MMD -MF "${OBJECTDIR}/rtcc.o.d"      -g -D__DEBUG   -mno-eds-warn  -omf=elf -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -I"./FreeRTOS/include" -I"./" -I"./FreeRTOS/portable/MPLAB/PIC24_dsPIC" -O0 -msmart-io=1 -Wall -msfr-warn=off    -mdfp="${DFP_DIR}/xc16"
+	
+${OBJECTDIR}/fmt.o: fmt.c  .generated_files/flags/default/8c313a94644ea7b532457f32724179dcabe2c069 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/fmt.o.d 
+	@${RM} ${OBJECTDIR}/fmt.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  fmt.c  -o ${OBJECTDIR}/fmt.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MP -MMD -MF "${OBJECTDIR}/fmt.o.d"      -g -D__DEBUG   -mno-eds-warn  -omf=elf -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -I"./FreeRTOS/include" -I"./" -I"./FreeRTOS/portable/MPLAB/PIC24_dsPIC" -O0 -msmart-io=1 -Wall -msfr-warn=off    -mdfp="${DFP_DIR}/xc16"
+	
+${OBJECTDIR}/nvm.o: nvm.c  .generated_files/flags/default/e55f129f12fa92d1486b15c368425abd700eab65 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/nvm.o.d 
+	@${RM} ${OBJECTDIR}/nvm.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  nvm.c  -o ${OBJECTDIR}/nvm.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MP -MMD -MF "${OBJECTDIR}/nvm.o.d"      -g -D__DEBUG   -mno-eds-warn  -omf=elf -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -I"./FreeRTOS/include" -I"./" -I"./FreeRTOS/portable/MPLAB/PIC24_dsPIC" -O0 -msmart-io=1 -Wall -msfr-warn=off    -mdfp="${DFP_DIR}/xc16"
+	
+${OBJECTDIR}/telemstream.o: telemstream.c  .generated_files/flags/default/7340389f73f466b516aacdb462ed8fd06473cdf9 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/telemstream.o.d 
+	@${RM} ${OBJECTDIR}/telemstream.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  telemstream.c  -o ${OBJECTDIR}/telemstream.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MP -MMD -MF "${OBJECTDIR}/telemstream.o.d"      -g -D__DEBUG   -mno-eds-warn  -omf=elf -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -I"./FreeRTOS/include" -I"./" -I"./FreeRTOS/portable/MPLAB/PIC24_dsPIC" -O0 -msmart-io=1 -Wall -msfr-warn=off    -mdfp="${DFP_DIR}/xc16"
+	
+${OBJECTDIR}/telemagg.o: telemagg.c  .generated_files/flags/default/f03238ab8d482f0220d18b8b99d1b8b10a3d6a2e .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/telemagg.o.d 
+	@${RM} ${OBJECTDIR}/telemagg.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  telemagg.c  -o ${OBJECTDIR}/telemagg.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MP -MMD -MF "${OBJECTDIR}/telemagg.o.d"      -g -D__DEBUG   -mno-eds-warn  -omf=elf -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -I"./FreeRTOS/include" -I"./" -I"./FreeRTOS/portable/MPLAB/PIC24_dsPIC" -O0 -msmart-io=1 -Wall -msfr-warn=off    -mdfp="${DFP_DIR}/xc16"
+	
+${OBJECTDIR}/pingpong.o: pingpong.c  .generated_files/flags/default/737434f705b58e22de67f26d86ef36e4758ec971 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/pingpong.o.d 
+	@${RM} ${OBJECTDIR}/pingpong.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  pingpong.c  -o ${OBJECTDIR}/pingpong.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MP -MMD -MF "${OBJECTDIR}/pingpong.o.d"      -g -D__DEBUG   -mno-eds-warn  -omf=elf -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -I"./FreeRTOS/include" -I"./" -I"./FreeRTOS/portable/MPLAB/PIC24_dsPIC" -O0 -msmart-io=1 -Wall -msfr-warn=off    -mdfp="${DFP_DIR}/xc16"
+	
 else
 ${OBJECTDIR}/FreeRTOS/portable/MPLAB/PIC24_dsPIC/port.o: FreeRTOS/portable/MPLAB/PIC24_dsPIC/port.c  .generated_files/flags/default/ea6b16b08c6c7de2b2cd622c9339c72acb3ba2cd .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
 	@${MKDIR} "${OBJECTDIR}/FreeRTOS/portable/MPLAB/PIC24_dsPIC" 
@@ -258,6 +366,114 @@ ${OBJECTDIR}/FreeRTOS/adc.o: FreeRTOS/adc.c  .generated_files/flags/default/1773
 	@${RM} ${OBJECTDIR}/FreeRTOS/adc.o 
 	${MP_CC} $(MP_EXTRA_CC_PRE)  FreeRTOS/adc.c  -o ${OBJECTDIR}/FreeRTOS/adc.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MP -MMD -MF "${OBJECTDIR}/FreeRTOS/adc.o.d"      -mno-eds-warn  -g -omf=elf -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -I"./FreeRTOS/include" -I"./" -I"./FreeRTOS/portable/MPLAB/PIC24_dsPIC" -O0 -msmart-io=1 -Wall -msfr-warn=off    -mdfp="${DFP_DIR}/xc16"
 	
+${OBJECTDIR}/logbuf.o: logbuf.c  .generated_files/flags/default/23f3deb75c7338fcdf670e70274625742398c1c0 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/logbuf.o.d 
+	@${RM} ${OBJECTDIR}/logbuf.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  logbuf.c  -o ${OBJECTDIR}/logbuf.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MP -MMD -MF "${OBJECTDIR}/logbuf.o.d"      -mno-eds-warn  -g -omf=elf -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -I"./FreeRTOS/include" -I"./" -I"./FreeRTOS/portable/MPLAB/PIC24_dsPIC" -O0 -msmart-io=1 -Wall -msfr-warn=off    -mdfp="${DFP_DIR}/xc16"
+	
+${OBJECTDIR}/uart_dma.o: uart_dma.c  .generated_files/flags/default/88c9705b051cccbbfa64d14811d08b1aedd0e62a .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/uart_dma.o.d 
+	@${RM} ${OBJECTDIR}/uart_dma.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  uart_dma.c  -o ${OBJECTDIR}/uart_dma.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MP -MMD -MF "${OBJECTDIR}/uart_dma.o.d"      -mno-eds-warn  -g -omf=elf -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -I"./FreeRTOS/include" -I"./" -I"./FreeRTOS/portable/MPLAB/PIC24_dsPIC" -O0 -msmart-io=1 -Wall -msfr-warn=off    -mdfp="${DFP_DIR}/xc16"
+	
+${OBJECTDIR}/ledfb.o: ledfb.c  .generated_files/flags/default/707972425777014bff6ce104fb28d045d275c380 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/ledfb.o.d 
+	@${RM} ${OBJECTDIR}/ledfb.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  ledfb.c  -o ${OBJECTDIR}/ledfb.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MP -MMD -MF "${OBJECTDIR}/ledfb.o.d"      -mno-eds-warn  -g -omf=elf -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -I"./FreeRTOS/include" -I"./" -I"./FreeRTOS/portable/MPLAB/PIC24_dsPIC" -O0 -msmart-io=1 -Wall -msfr-warn=off    -mdfp="${DFP_DIR}/xc16"
+	
+${OBJECTDIR}/boot.o: boot.c  .generated_files/flags/default/4949f92565eabb0870e3ab3a2e9368d65c91249f .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/boot.o.d 
+	@${RM} ${OBJECTDIR}/boot.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  boot.c  -o ${OBJECTDIR}/boot.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MP -MMD -MF "${OBJECTDIR}/boot.o.d"      -mno-eds-warn  -g -omf=elf -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -I"./FreeRTOS/include" -I"./" -I"./FreeRTOS/portable/MPLAB/PIC24_dsPIC" -O0 -msmart-io=1 -Wall -msfr-warn=off    -mdfp="${DFP_DIR}/xc16"
+	
+${OBJECTDIR}/heapstat.o: heapstat.c  .generated_files/flags/default/0f67a9773f88ffdfbb063ef6d8f4edb3b7dfcaeb .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/heapstat.o.d 
+	@${RM} ${OBJECTDIR}/heapstat.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  heapstat.c  -o ${OBJECTDIR}/heapstat.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MP -MMD -MF "${OBJECTDIR}/heapstat.o.d"      -mno-eds-warn  -g -omf=elf -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -I"./FreeRTOS/include" -I"./" -I"./FreeRTOS/portable/MPLAB/PIC24_dsPIC" -O0 -msmart-io=1 -Wall -msfr-warn=off    -mdfp="${DFP_DIR}/xc16"
+	
+${OBJECTDIR}/appcfg.o: appcfg.c  .generated_files/flags/default/8d86e83c8f9c3f7406bdb661d6f48c22d4087f26 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/appcfg.o.d 
+	@${RM} ${OBJECTDIR}/appcfg.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  appcfg.c  -o ${OBJECTDIR}/appcfg.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MP -MMD -MF "${OBJECTDIR}/appcfg.o.d"      -mno-eds-warn  -g -omf=elf -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -I"./FreeRTOS/include" -I"./" -I"./FreeRTOS/portable/MPLAB/PIC24_dsPIC" -O0 -msmart-io=1 -Wall -msfr-warn=off    -mdfp="${DFP_DIR}/xc16"
+	
+${OBJECTDIR}/stateprof.o: stateprof.c  .generated_files/flags/default/7b3a0e170408051c707b2c9fa42c382c196ab5b7 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/stateprof.o.d 
+	@${RM} ${OBJECTDIR}/stateprof.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  stateprof.c  -o ${OBJECTDIR}/stateprof.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MP -MMD -MF "${OBJECTDIR}/stateprof.o.d"      -mno-eds-warn  -g -omf=elf -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -I"./FreeRTOS/include" -I"./" -I"./FreeRTOS/portable/MPLAB/PIC24_dsPIC" -O0 -msmart-io=1 -Wall -msfr-warn=off    -mdfp="${DFP_DIR}/xc16"
+	
+${OBJECTDIR}/telemlog.o: telemlog.c  .generated_files/flags/default/902e685762e71d341169057237edae268091b61f .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/telemlog.o.d 
+	@${RM} ${OBJECTDIR}/telemlog.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  telemlog.c  -o ${OBJECTDIR}/telemlog.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MP -MMD -MF "${OBJECTDIR}/telemlog.o.d"      -mno-eds-warn  -g -omf=elf -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -I"./FreeRTOS/include" -I"./" -I"./FreeRTOS/portable/MPLAB/PIC24_dsPIC" -O0 -msmart-io=1 -Wall -msfr-warn=off    -mdfp="${DFP_DIR}/xc16"
+	
+${OBJECTDIR}/deltapack.o: deltapack.c  .generated_files/flags/default/c8bf9062183b8559ee2c514381a0cbf99b188d7f .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/deltapack.o.d 
+	@${RM} ${OBJECTDIR}/deltapack.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  deltapack.c  -o ${OBJECTDIR}/deltapack.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MP -MMD -MF "${OBJECTDIR}/deltapack.o.d"      -mno-eds-warn  -g -omf=elf -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -I"./FreeRTOS/include" -I"./" -I"./FreeRTOS/portable/MPLAB/PIC24_dsPIC" -O0 -msmart-io=1 -Wall -msfr-warn=off    -mdfp="${DFP_DIR}/xc16"
+	
+${OBJECTDIR}/winagg.o: winagg.c  .generated_files/flags/default/e90a40b9ac7f6a66055399c14ec13173f9a73954 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/winagg.o.d 
+	@${RM} ${OBJECTDIR}/winagg.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  winagg.c  -o ${OBJECTDIR}/winagg.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MP -MMD -MF "${OBJECTDIR}/winagg.o.d"      -mno-eds-warn  -g -omf=elf -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -I"./FreeRTOS/include" -I"./" -I"./FreeRTOS/portable/MPLAB/PIC24_dsPIC" -O0 -msmart-io=1 -Wall -msfr-warn=off    -mdfp="${DFP_DIR}/xc16"
+	
+${OBJECTDIR}/crc.o: crc.c  .generated_files/flags/default/67fab37c86bc4c7254b1e29f313605c08130d945 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/crc.o.d 
+	@${RM} ${OBJECTDIR}/crc.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  crc.c  -o ${OBJECTDIR}/crc.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MP -MMD -MF "${OBJECTDIR}/crc.o.d"      -mno-eds-warn  -g -omf=elf -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -I"./FreeRTOS/include" -I"./" -I"./FreeRTOS/portable/MPLAB/PIC24_dsPIC" -O0 -msmart-io=1 -Wall -msfr-warn=off    -mdfp="${DFP_DIR}/xc16"
+	
+${OBJECTDIR}/inspect.o: inspect.c  .generated_files/flags/default/2b01f5cdc4994c44281ef6c78ed672a012834e6d .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/inspect.o.d 
+	@${RM} ${OBJECTDIR}/inspect.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  inspect.c  -o ${OBJECTDIR}/inspect.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MP -MMD -MF "${OBJECTDIR}/inspect.o.d"      -mno-eds-warn  -g -omf=elf -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -I"./FreeRTOS/include" -I"./" -I"./FreeRTOS/portable/MPLAB/PIC24_dsPIC" -O0 -msmart-io=1 -Wall -msfr-warn=off    -mdfp="${DFP_DIR}/xc16"
+	
+${OBJECTDIR}/rtcc.o: rtcc.c  .generated_files/flags/default/96fa8d318db3d9ec66ecde9e27cfa2daa581ddc6 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/rtcc.o.d 
+	@${RM} ${OBJECTDIR}/rtcc.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  rtcc.c  -o ${OBJECTDIR}/rtcc.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MP -MMD -MF "${OBJECTDIR}/rtcc.o.d"      -mno-eds-warn  -g -omf=elf -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -I"./FreeRTOS/include" -I"./" -I"./FreeRTOS/portable/MPLAB/PIC24_dsPIC" -O0 -msmart-io=1 -Wall -msfr-warn=off    -mdfp="${DFP_DIR}/xc16"
+	
+${OBJECTDIR}/fmt.o: fmt.c  .generated_files/flags/default/892d88a3a03fada39acf95899558cb7d72965e34 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/fmt.o.d 
+	@${RM} ${OBJECTDIR}/fmt.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  fmt.c  -o ${OBJECTDIR}/fmt.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MP -MMD -MF "${OBJECTDIR}/fmt.o.d"      -mno-eds-warn  -g -omf=elf -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -I"./FreeRTOS/include" -I"./" -I"./FreeRTOS/portable/MPLAB/PIC24_dsPIC" -O0 -msmart-io=1 -Wall -msfr-warn=off    -mdfp="${DFP_DIR}/xc16"
+	
+${OBJECTDIR}/nvm.o: nvm.c  .generated_files/flags/default/1ee21dd4c1ad28222ef543e658efdc48acdffca3 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/nvm.o.d 
+	@${RM} ${OBJECTDIR}/nvm.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  nvm.c  -o ${OBJECTDIR}/nvm.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MP -MMD -MF "${OBJECTDIR}/nvm.o.d"      -mno-eds-warn  -g -omf=elf -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -I"./FreeRTOS/include" -I"./" -I"./FreeRTOS/portable/MPLAB/PIC24_dsPIC" -O0 -msmart-io=1 -Wall -msfr-warn=off    -mdfp="${DFP_DIR}/xc16"
+	
+${OBJECTDIR}/telemstream.o: telemstream.c  .generated_files/flags/default/71826bdbd84e235e4d01858d761bec52201d187b .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/telemstream.o.d 
+	@${RM} ${OBJECTDIR}/telemstream.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  telemstream.c  -o ${OBJECTDIR}/telemstream.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MP -MMD -MF "${OBJECTDIR}/telemstream.o.d"      -mno-eds-warn  -g -omf=elf -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -I"./FreeRTOS/include" -I"./" -I"./FreeRTOS/portable/MPLAB/PIC24_dsPIC" -O0 -msmart-io=1 -Wall -msfr-warn=off    -mdfp="${DFP_DIR}/xc16"
+	
+${OBJECTDIR}/telemagg.o: telemagg.c  .generated_files/flags/default/5574311117a1a13eeb6bb4baebe7492aaa913831 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/telemagg.o.d 
+	@${RM} ${OBJECTDIR}/telemagg.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  telemagg.c  -o ${OBJECTDIR}/telemagg.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MP -MMD -MF "${OBJECTDIR}/telemagg.o.d"      -mno-eds-warn  -g -omf=elf -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -I"./FreeRTOS/include" -I"./" -I"./FreeRTOS/portable/MPLAB/PIC24_dsPIC" -O0 -msmart-io=1 -Wall -msfr-warn=off    -mdfp="${DFP_DIR}/xc16"
+	
+${OBJECTDIR}/pingpong.o: pingpong.c  .generated_files/flags/default/cfed15ed254270f003df3d453e92f2be133b6a75 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/pingpong.o.d 
+	@${RM} ${OBJECTDIR}/pingpong.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  pingpong.c  -o ${OBJECTDIR}/pingpong.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MP -MMD -MF "${OBJECTDIR}/pingpong.o.d"      -mno-eds-warn  -g -omf=elf -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -I"./FreeRTOS/include" -I"./" -I"./FreeRTOS/portable/MPLAB/PIC24_dsPIC" -O0 -msmart-io=1 -Wall -msfr-warn=off    -mdfp="${DFP_DIR}/xc16"
+	
 endif
 
 # ------------------------------------------------------------------------------------
@@ -0,0 +1,62 @@
+/*
+ * File:   nvm.c
+ * Author: ENCM 511
+ *
+ * Flash Programming Implementation
+ *
+ * Created on Nov 2025
+ */
+
+#include "nvm.h"
+#include <xc.h>
+
+/*============================================================================
+ * CONFIGURATION CONSTANTS
+ *============================================================================*/
+
+#define NVM_CMD_PAGE_ERASE      0x4003  /* WREN, NVMOP = 0011 */
+#define NVM_CMD_DWORD_PROG      0x4001  /* WREN, NVMOP = 0001 */
+#define NVM_LATCH_PAGE          0xFA
+
+/*============================================================================
+ * STATIC HELPER FUNCTIONS
+ *============================================================================*/
+
+/* Start one NVM operation at a program address, wait for it, lock again */
+static bool NvmCommand(uint16_t nvmcon, const __prog__ uint16_t *addr)
+{
+    NVMADRU = __builtin_tblpage(addr);
+    NVMADR = __builtin_tbloffset(addr);
+    NVMCON = nvmcon;
+    __builtin_write_NVM();
+    while (NVMCONbits.WR) {
+    }
+
+    NVMCONbits.WREN = 0;
+    return !NVMCONbits.WRERR;
+}
+
+/*============================================================================
+ * PUBLIC FUNCTION IMPLEMENTATIONS
+ *============================================================================*/
+
+bool Nvm_ErasePage(const __prog__ uint16_t *addr)
+{
+    return NvmCommand(NVM_CMD_PAGE_ERASE, addr);
+}
+
+bool Nvm_ProgramDword(const __prog__ uint16_t *addr, uint16_t w0, uint16_t w1)
+{
+    uint16_t saved_tblpag = TBLPAG;
+    bool ok;
+
+    TBLPAG = NVM_LATCH_PAGE;
+    __builtin_tblwtl(0, w0);
+    __builtin_tblwth(0, 0);
+    __builtin_tblwtl(2, w1);
+    __builtin_tblwth(2, 0);
+    ok = NvmCommand(NVM_CMD_DWORD_PROG, addr);
+    TBLPAG = saved_tblpag;
+
+    return ok;
+}
@@ -0,0 +1,50 @@
+/*
+ * File:   nvm.h
+ * Author: ENCM 511
+ *
+ * Flash Programming Header
+ *
+ * Description: Page erase and double-word programming on program flash,
+ *              shared by the configuration image (appcfg.c) and the
+ *              telemetry log (telemlog.c).
+ *
+ * NVM sequence (PIC24FJ256GA702):
+ *   - Page erase: NVMOP = 0011 on the page address.
+ *   - Double-word program: two instruction words are loaded into the
+ *     write latches at TBLPAG 0xFA, then NVMOP = 0001 on the target.
+ *     Only the low 16 bits carry data (what PSV sees); the upper byte is
+ *     programmed as 0.
+ *   - __builtin_write_NVM() performs the 0x55/0xAA unlock with interrupts
+ *     held off, and the CPU stalls until the operation finishes, so call
+ *     these from task context when nothing is timing critical.
+ *
+ * Created on Nov 2025
+ */
+
+#ifndef NVM_H
+#define NVM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*============================================================================
+ * FUNCTION PROTOTYPES
+ *============================================================================*/
+
+/**
+ * @brief Erase the flash page starting at addr
+ *
+ * @param addr First word of the page
+ * @return false if the controller reported a write error
+ */
+bool Nvm_ErasePage(const __prog__ uint16_t *addr);
+
+/**
+ * @brief Program two data words into an erased double word
+ *
+ * @param addr First word of the double word (even instruction address)
+ * @return false if the controller reported a write error
+ */
+bool Nvm_ProgramDword(const __prog__ uint16_t *addr, uint16_t w0, uint16_t w1);
+
+#endif /* NVM_H */
@@ -0,0 +1,178 @@
+/*
+ * File:   pingpong.c
+ * Author: ENCM 511
+ *
+ * Ping-Pong Block Buffer Implementation
+ *
+ * Description: The whole handover is the producer index and the state of
+ *              the other half. Both are changed together with the CPU IPL
+ *              raised to PINGPONG_SWAP_IPL, as adc.c guards its scan ring.
+ *              The block contents are never touched here, so the raised
+ *              section is a few instructions whatever the block size.
+ *
+ * Created on Nov 2025
+ */
+
+#include "pingpong.h"
+#include <xc.h>
+#include <stdbool.h>
+
+/*============================================================================
+ * CONFIGURATION CONSTANTS
+ *============================================================================*/
+
+/* IPL used while swapping - above the producer ISR */
+#define PINGPONG_SWAP_IPL       7
+
+/* States of the half the producer does not own */
+#define PP_FREE                 0
+#define PP_READY                1
+#define PP_TAKEN                2
+
+/*============================================================================
+ * STATIC HELPER FUNCTIONS
+ *============================================================================*/
+
+static void CountOverflow(PingPong_t *pp)
+{
+    if (pp->overflows != 0xFFFF) {
+        pp->overflows++;
+    }
+}
+
+/**
+ * @brief Swap halves if the consumer allows it
+ *
+ * @param notify Set to true if the consumer should be notified
+ * @return Half the producer should fill next
+ */
+static uint8_t *SwapHalves(PingPong_t *pp, uint16_t len, bool *notify)
+{
+    uint16_t saved_ipl;
+    uint8_t mine;
+
+    SET_AND_SAVE_CPU_IPL(saved_ipl, PINGPONG_SWAP_IPL);
+    mine = pp->producer;
+    if (pp->state == PP_TAKEN) {
+        /* Consumer is still reading the other half - refill this one */
+        CountOverflow(pp);
+        *notify = false;
+    } else {
+        if (pp->state == PP_READY) {
+            /* Previous block was never received - it becomes ours again */
+            CountOverflow(pp);
+        }
+        if (len > pp->size) {
+            len = pp->size;
+        }
+        pp->len[mine] = len;
+        mine ^= 1;
+        pp->producer = mine;
+        pp->state = PP_READY;
+        *notify = true;
+    }
+    RESTORE_CPU_IPL(saved_ipl);
+
+    return pp->half[mine];
+}
+
+/*============================================================================
+ * PUBLIC FUNCTION IMPLEMENTATIONS
+ *============================================================================*/
+
+void PingPong_Init(PingPong_t *pp, uint8_t *storage, uint16_t half_size,
+                   TaskHandle_t consumer, uint32_t notify_bits)
+{
+    pp->half[0] = storage;
+    pp->half[1] = storage + half_size;
+    pp->len[0] = 0;
+    pp->len[1] = 0;
+    pp->size = half_size;
+    pp->producer = 0;
+    pp->state = PP_FREE;
+    pp->overflows = 0;
+    pp->consumer = consumer;
+    pp->notify_bits = notify_bits;
+}
+
+uint8_t *PingPong_ProducerBlock(PingPong_t *pp)
+{
+    return pp->half[pp->producer];
+}
+
+uint8_t *PingPong_SwapFromISR(PingPong_t *pp, uint16_t len,
+                              BaseType_t *pxHigherPriorityTaskWoken)
+{
+    bool notify;
+    uint8_t *next = SwapHalves(pp, len, &notify);
+
+    if (!notify || pp->consumer == NULL) {
+        /* Nothing to wake */
+    } else if (pp->notify_bits != 0) {
+        (void)xTaskNotifyFromISR(pp->consumer, pp->notify_bits, eSetBits,
+                                 pxHigherPriorityTaskWoken);
+    } else {
+        vTaskNotifyGiveFromISR(pp->consumer, pxHigherPriorityTaskWoken);
+    }
+    return next;
+}
+
+uint8_t *PingPong_Swap(PingPong_t *pp, uint16_t len)
+{
+    bool notify;
+    uint8_t *next = SwapHalves(pp, len, &notify);
+
+    if (!notify || pp->consumer == NULL) {
+        /* Nothing to wake */
+    } else if (pp->notify_bits != 0) {
+        (void)xTaskNotify(pp->consumer, pp->notify_bits, eSetBits);
+    } else {
+        (void)xTaskNotifyGive(pp->consumer);
+    }
+    return next;
+}
+
+const uint8_t *PingPong_Receive(PingPong_t *pp, uint16_t *len,
+                                TickType_t xTicksToWait)
+{
+    TimeOut_t timeout;
+    uint16_t saved_ipl;
+    uint8_t theirs;
+
+    configASSERT(pp->state != PP_TAKEN);
+    /* Waiting here would take the consumer's other request bits */
+    configASSERT(pp->notify_bits == 0 || xTicksToWait == 0);
+
+    vTaskSetTimeOutState(&timeout);
+    for (;;) {
+        SET_AND_SAVE_CPU_IPL(saved_ipl, PINGPONG_SWAP_IPL);
+        if (pp->state == PP_READY) {
+            pp->state = PP_TAKEN;
+            theirs = pp->producer ^ 1;
+            RESTORE_CPU_IPL(saved_ipl);
+
+            *len = pp->len[theirs];
+            return pp->half[theirs];
+        }
+        RESTORE_CPU_IPL(saved_ipl);
+
+        /* Notifications can be left over from a block already taken, so
+         * wake-ups are re-checked against the state. The kernel's time-out
+         * keeps portMAX_DELAY unlimited across them. */
+        if (xTaskCheckForTimeOut(&timeout, &xTicksToWait) != pdFALSE) {
+            return NULL;
+        }
+        (void)ulTaskNotifyTake(pdTRUE, xTicksToWait);
+    }
+}
+
+void PingPong_Release(PingPong_t *pp)
+{
+    /* Single byte store; a swap reading TAKEN just before it is harmless */
+    pp->state = PP_FREE;
+}
+
+uint16_t PingPong_GetOverflows(const PingPong_t *pp)
+{
+    return pp->overflows;
+}
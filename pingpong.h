@@ -0,0 +1,144 @@
+/*
+ * File:   pingpong.h
+ * Author: ENCM 511
+ *
+ * Ping-Pong Block Buffer Header
+ *
+ * Description: Two equal halves of one buffer for producers that fill whole
+ *              blocks (an ADC scan burst, a DMA receive window, a telemetry
+ *              frame). The producer owns one half and the consumer task the
+ *              other, so neither side copies or counts bytes while it works.
+ *              Handing a block over is a single swap that notifies the
+ *              consumer. The ADC scan ISR is the producer of the 's'
+ *              telemetry stream (ADC_ScanBlocks()).
+ *
+ * Producers:
+ *   - The swap notifies the consumer, so PingPong_SwapFromISR() may only
+ *     be called from an ISR at configKERNEL_INTERRUPT_PRIORITY, like any
+ *     other FromISR call. A producer above it (DMA completion at a higher
+ *     IPL) has to defer the swap to such an ISR.
+ *
+ * Ownership of the half that is not the producer's:
+ *   - FREE:  released by the consumer; the next swap publishes into it.
+ *   - READY: published but not yet received. A second swap before the
+ *            consumer receives it replaces it with the newer block and
+ *            counts one overflow (the older block is lost).
+ *   - TAKEN: being read by the consumer. A swap cannot proceed, so the
+ *            producer keeps its half to refill, and one overflow is
+ *            counted (the block it just filled is lost).
+ *
+ * Created on Nov 2025
+ */
+
+#ifndef PINGPONG_H
+#define PINGPONG_H
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stdint.h>
+
+/*============================================================================
+ * TYPE DEFINITIONS
+ *============================================================================*/
+
+/* Contents are private - only the pingpong.c functions touch them */
+typedef struct {
+    uint8_t *half[2];
+    uint16_t len[2];
+    uint16_t size;
+    volatile uint8_t producer;      /* Index of the half being filled */
+    volatile uint8_t state;         /* FREE/READY/TAKEN of the other half */
+    volatile uint16_t overflows;
+    TaskHandle_t consumer;
+    uint32_t notify_bits;           /* 0: notify by give */
+} PingPong_t;
+
+/*============================================================================
+ * FUNCTION PROTOTYPES
+ *============================================================================*/
+
+/**
+ * @brief Initialize a ping-pong buffer over caller-provided storage
+ *
+ * The producer starts out owning the first half.
+ *
+ * @param pp Buffer object (normally a static)
+ * @param storage 2 * half_size bytes, valid for the life of the buffer
+ * @param half_size Size of each half in bytes
+ * @param consumer Task to notify on each swap (NULL to poll)
+ * @param notify_bits 0 to notify by give, for a consumer that waits in
+ *        PingPong_Receive(); otherwise the bits to set in the consumer's
+ *        notification value, for a consumer that waits in xTaskNotifyWait()
+ *        on other requests too and then receives with no wait
+ */
+void PingPong_Init(PingPong_t *pp, uint8_t *storage, uint16_t half_size,
+                   TaskHandle_t consumer, uint32_t notify_bits);
+
+/**
+ * @brief Get the half the producer is currently filling
+ *
+ * Used to program the first DMA transfer; later halves are returned by
+ * the swap calls.
+ *
+ * @param pp Buffer object
+ * @return Producer half (PingPong_t.size bytes)
+ */
+uint8_t *PingPong_ProducerBlock(PingPong_t *pp);
+
+/**
+ * @brief Publish the producer's half from an ISR and take the other one
+ *
+ * Never waits. If the consumer is still reading its half, the producer
+ * keeps the same half and an overflow is counted.
+ *
+ * @param pp Buffer object
+ * @param len Number of valid bytes in the published half
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if the consumer was woken
+ * @return Half the producer should fill next
+ */
+uint8_t *PingPong_SwapFromISR(PingPong_t *pp, uint16_t len,
+                              BaseType_t *pxHigherPriorityTaskWoken);
+
+/**
+ * @brief Publish the producer's half from task context
+ *
+ * Same rules as PingPong_SwapFromISR().
+ *
+ * @param pp Buffer object
+ * @param len Number of valid bytes in the published half
+ * @return Half the producer should fill next
+ */
+uint8_t *PingPong_Swap(PingPong_t *pp, uint16_t len);
+
+/**
+ * @brief Wait for a published block and take ownership of it (consumer only)
+ *
+ * The block stays valid, and the producer keeps out of it, until
+ * PingPong_Release() is called. A consumer notified by bits may only
+ * receive with xTicksToWait 0.
+ *
+ * @param pp Buffer object
+ * @param len Receives the number of valid bytes
+ * @param xTicksToWait Maximum time to wait for a block (portMAX_DELAY:
+ *        no limit)
+ * @return Block, or NULL if none was published in time
+ */
+const uint8_t *PingPong_Receive(PingPong_t *pp, uint16_t *len,
+                                TickType_t xTicksToWait);
+
+/**
+ * @brief Hand the received block back to the producer (consumer only)
+ *
+ * @param pp Buffer object
+ */
+void PingPong_Release(PingPong_t *pp);
+
+/**
+ * @brief Get the number of blocks lost because the consumer fell behind
+ *
+ * @param pp Buffer object
+ * @return uint16_t Overflow count (saturates at 0xFFFF)
+ */
+uint16_t PingPong_GetOverflows(const PingPong_t *pp);
+
+#endif /* PINGPONG_H */
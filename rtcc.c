@@ -0,0 +1,288 @@
+/*
+ * File:   rtcc.c
+ * Author: ENCM 511
+ *
+ * RTCC Time Base Implementation
+ *
+ * Description: Alarm ISR (second delivery, LPRC trim, tick resync) and the
+ *              sleep path called from the idle task. The tick count at the
+ *              last alarm, rtcc_alarm_tick, ties the two clocks together:
+ *              the sleep path works out from it how far away the next
+ *              alarm is.
+ *
+ * Created on Nov 2025
+ */
+
+#include "rtcc.h"
+#include <xc.h>
+
+/*============================================================================
+ * CONFIGURATION CONSTANTS
+ *============================================================================*/
+
+#define RTCC_IPL                configKERNEL_INTERRUPT_PRIORITY  /* Notifies the COUNT task */
+#define RTCC_CLKSEL_LPRC        0b01
+#define RTCC_AMASK_SECOND       0b0001      /* Alarm every second */
+
+#define RTCC_TICKS_PER_SECOND   ((TickType_t)configTICK_RATE_HZ)
+
+/*============================================================================
+ * PRIVATE VARIABLES
+ *============================================================================*/
+
+static uint16_t rtcc_div = RTCC_DIV_NOMINAL;
+
+/* Tick count at the last alarm, valid once the first alarm has fired */
+static volatile TickType_t rtcc_alarm_tick = 0;
+static volatile bool rtcc_phase_known = false;
+
+/* Set by RTCC_Sleep() when it has already stepped the tick to the alarm */
+static volatile bool rtcc_alarm_stamped = false;
+
+/* Early wake: the next alarm measures the lost ticks into rtcc_debt */
+static volatile bool rtcc_resync = false;
+static volatile TickType_t rtcc_debt = 0;
+
+/* Trim measurement over awake seconds */
+static bool rtcc_cal_valid = false;
+static TickType_t rtcc_cal_start = 0;
+static uint8_t rtcc_cal_seconds = 0;
+
+/* Second delivery */
+static TaskHandle_t rtcc_task = NULL;
+static bool rtcc_skip = false;
+
+static RtccStats_t rtcc_stats = {0};
+
+/*============================================================================
+ * STATIC HELPER FUNCTIONS
+ *============================================================================*/
+
+/* Scale the divider by expected / measured ticks - alarm ISR only */
+static void Trim(TickType_t measured)
+{
+    const uint32_t expected = (uint32_t)RTCC_CAL_SECONDS * configTICK_RATE_HZ;
+    uint32_t period;
+    uint16_t div;
+
+    if (measured == 0) {
+        return;
+    }
+
+    period = (((uint32_t)rtcc_div + 1) * expected + measured / 2) / measured;
+    if (period > (uint32_t)RTCC_DIV_NOMINAL + RTCC_DIV_TRIM_LIMIT + 1) {
+        period = (uint32_t)RTCC_DIV_NOMINAL + RTCC_DIV_TRIM_LIMIT + 1;
+    } else if (period < (uint32_t)RTCC_DIV_NOMINAL - RTCC_DIV_TRIM_LIMIT + 1) {
+        period = (uint32_t)RTCC_DIV_NOMINAL - RTCC_DIV_TRIM_LIMIT + 1;
+    }
+    div = (uint16_t)(period - 1);
+    if (div == rtcc_div) {
+        return;
+    }
+
+    rtcc_div = div;
+    __builtin_write_RTCC_WRLOCK();
+    RTCCON2H = div;
+    RTCCON1Lbits.WRLOCK = 1;
+    rtcc_stats.trims++;
+}
+
+/* Hand the ticks lost in an early wake back to the kernel - task context */
+static void CatchUp(void)
+{
+    uint16_t saved_ipl;
+    TickType_t debt;
+
+    SET_AND_SAVE_CPU_IPL(saved_ipl, 7);
+    debt = rtcc_debt;
+    rtcc_debt = 0;
+    RESTORE_CPU_IPL(saved_ipl);
+
+    if (debt != 0) {
+        (void)xTaskCatchUpTicks(debt);
+        rtcc_stats.caught_up_ticks += debt;
+    }
+}
+
+/*============================================================================
+ * RTCC ALARM ISR
+ *
+ * Once a second: stamp the alarm on the tick count, settle any early-wake
+ * debt, feed the trim measurement, then notify the COUNT task.
+ *============================================================================*/
+
+void __attribute__((interrupt, no_auto_psv)) _RTCCInterrupt(void)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    TickType_t now;
+    TickType_t since;
+
+    IFS3bits.RTCIF = 0;
+
+    if (rtcc_alarm_stamped) {
+        /* Woken by this alarm; the last tick is still pending on Timer1 */
+        rtcc_alarm_stamped = false;
+        now = rtcc_alarm_tick;
+    } else {
+        now = xTaskGetTickCountFromISR();
+    }
+
+    if (rtcc_resync) {
+        rtcc_resync = false;
+        since = (TickType_t)(now - rtcc_alarm_tick);
+        if (since < RTCC_TICKS_PER_SECOND) {
+            rtcc_debt += RTCC_TICKS_PER_SECOND - since;
+            now += RTCC_TICKS_PER_SECOND - since;
+        }
+    }
+
+    if (rtcc_cal_valid) {
+        if (++rtcc_cal_seconds >= RTCC_CAL_SECONDS) {
+            Trim((TickType_t)(now - rtcc_cal_start));
+            rtcc_cal_start = now;
+            rtcc_cal_seconds = 0;
+        }
+    } else {
+        rtcc_cal_start = now;
+        rtcc_cal_seconds = 0;
+        rtcc_cal_valid = true;
+    }
+
+    rtcc_alarm_tick = now;
+    rtcc_phase_known = true;
+
+    if (rtcc_task != NULL) {
+        if (rtcc_skip) {
+            rtcc_skip = false;
+        } else {
+            vTaskNotifyGiveFromISR(rtcc_task, &xHigherPriorityTaskWoken);
+        }
+    }
+
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+/*============================================================================
+ * PUBLIC FUNCTION IMPLEMENTATIONS
+ *============================================================================*/
+
+void RTCC_Init(void)
+{
+    rtcc_div = RTCC_DIV_NOMINAL;
+
+    /* Clears WRLOCK; the sequence is timed, so let the builtin do it */
+    __builtin_write_RTCC_WRLOCK();
+    RTCCON1Lbits.RTCEN = 0;
+
+    /* LPRC, 1:1, divided down to a 1 Hz second (2 Hz half-second) */
+    RTCCON2L = 0;
+    RTCCON2Lbits.CLKSEL = RTCC_CLKSEL_LPRC;
+    RTCCON2H = rtcc_div;
+
+    /* Alarm every second, forever; the alarm time itself does not matter */
+    RTCCON1H = 0;
+    RTCCON1Hbits.AMASK = RTCC_AMASK_SECOND;
+    RTCCON1Hbits.CHIME = 1;
+    RTCCON1Hbits.ALRMEN = 1;
+
+    RTCCON1Lbits.RTCEN = 1;
+    RTCCON1Lbits.WRLOCK = 1;
+
+    IPC15bits.RTCIP = RTCC_IPL;
+    IFS3bits.RTCIF = 0;
+    IEC3bits.RTCIE = 1;
+}
+
+void RTCC_StartSeconds(void)
+{
+    uint16_t saved_ipl;
+
+    CatchUp();
+
+    /* Counts from an earlier run or from before the pause */
+    (void)ulTaskNotifyTake(pdTRUE, 0);
+
+    SET_AND_SAVE_CPU_IPL(saved_ipl, 7);
+    rtcc_task = xTaskGetCurrentTaskHandle();
+    rtcc_skip = (TickType_t)(xTaskGetTickCount() - rtcc_alarm_tick) >=
+                RTCC_TICKS_PER_SECOND / 2;
+    RESTORE_CPU_IPL(saved_ipl);
+}
+
+void RTCC_StopSeconds(void)
+{
+    uint16_t saved_ipl;
+
+    SET_AND_SAVE_CPU_IPL(saved_ipl, 7);
+    rtcc_task = NULL;
+    RESTORE_CPU_IPL(saved_ipl);
+}
+
+uint16_t RTCC_WaitSeconds(TickType_t xTicksToWait)
+{
+    uint16_t seconds = (uint16_t)ulTaskNotifyTake(pdTRUE, xTicksToWait);
+
+    CatchUp();
+    return seconds;
+}
+
+TickType_t RTCC_Sleep(TickType_t xExpectedIdleTime)
+{
+    uint16_t saved_ipl;
+    TickType_t start;
+    TickType_t to_alarm;
+
+    /* Nothing may run between the checks and Sleep(). Interrupts still
+     * wake the CPU at IPL 7; they are serviced once the IPL is restored. */
+    SET_AND_SAVE_CPU_IPL(saved_ipl, 7);
+
+    /* Wraps past RTCC_TICKS_PER_SECOND when the alarm is overdue */
+    start = xTaskGetTickCount();
+    to_alarm = RTCC_TICKS_PER_SECOND - (TickType_t)(start - rtcc_alarm_tick);
+
+    if (!rtcc_phase_known || rtcc_resync || rtcc_debt != 0 ||
+        to_alarm > RTCC_TICKS_PER_SECOND || to_alarm < RTCC_SLEEP_MIN_TICKS ||
+        to_alarm > xExpectedIdleTime || IFS3bits.RTCIF || IFS0bits.T1IF ||
+        eTaskConfirmSleepModeStatus() == eAbortSleep) {
+        RESTORE_CPU_IPL(saved_ipl);
+        return 0;
+    }
+
+    T1CONbits.TON = 0;
+    Sleep();
+
+    /* Any interval containing a sleep is useless for the trim */
+    rtcc_cal_valid = false;
+
+    if (IFS3bits.RTCIF) {
+        /* The alarm is the tick at start + to_alarm: step all but the last
+         * tick, which is left pending on Timer1 so the kernel processes it
+         * (and anything due then) the normal way. */
+        vTaskStepTick(to_alarm - 1);
+        rtcc_alarm_tick = (TickType_t)(start + to_alarm);
+        rtcc_alarm_stamped = true;
+        TMR1 = 0;
+        IFS0bits.T1IF = 1;
+        rtcc_stats.sleeps++;
+        rtcc_stats.slept_ticks += to_alarm;
+    } else {
+        /* Button or UART: time slept unknown, settle at the next alarm */
+        rtcc_resync = true;
+        rtcc_stats.early_wakes++;
+        to_alarm = 0;
+    }
+    T1CONbits.TON = 1;
+
+    RESTORE_CPU_IPL(saved_ipl);
+    return to_alarm;
+}
+
+void RTCC_GetStats(RtccStats_t *out)
+{
+    uint16_t saved_ipl;
+
+    SET_AND_SAVE_CPU_IPL(saved_ipl, 7);
+    *out = rtcc_stats;
+    out->div = rtcc_div;
+    RESTORE_CPU_IPL(saved_ipl);
+}
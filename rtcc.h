@@ -0,0 +1,127 @@
+/*
+ * File:   rtcc.h
+ * Author: ENCM 511
+ *
+ * RTCC Time Base Header
+ *
+ * Description: One-second time base for the countdown that keeps counting
+ *              while the CPU is in Sleep. The RTCC raises an alarm every
+ *              second; the COUNT task waits on it instead of on the 1 kHz
+ *              tick, and between alarms the idle task may stop Timer1 and
+ *              sleep (tickless idle, vApplicationSleep() in main.c).
+ *
+ * Clock:
+ *   - The board has no 32 kHz crystal: SOSCSEL is off and PB3 sits on
+ *     RA4, the SOSCO pin. The RTCC therefore runs from the LPRC, which is
+ *     only good to a few percent.
+ *   - The alarm ISR trims the divider against the FRC-derived tick:
+ *     every RTCC_CAL_SECONDS alarms without a sleep in between, the
+ *     divider is scaled by expected / measured ticks. A trimmed second is
+ *     as good as the FRC (about 1%) and stays so across Sleep.
+ *
+ * Sleep (RTCC_Sleep(), scheduler suspended):
+ *   - Sleeps only if the next alarm is the first thing the kernel is
+ *     waiting for, at least RTCC_SLEEP_MIN_TICKS away.
+ *   - Woken by the alarm: the tick count is stepped to the alarm and
+ *     Timer1 restarts in phase with it.
+ *   - Woken early (a button or a UART start bit): nothing is known about
+ *     the time slept, so no ticks are stepped. The next alarm measures the
+ *     shortfall and RTCC_WaitSeconds() catches the kernel up; no further
+ *     sleep is allowed until then.
+ *
+ * Created on Nov 2025
+ */
+
+#ifndef RTCC_H
+#define RTCC_H
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/*============================================================================
+ * CONFIGURATION
+ *============================================================================*/
+
+/* LPRC nominal frequency and the divider for one alarm per second
+ * (second = LPRC / (2 * (DIV + 1))) */
+#define RTCC_LPRC_HZ            31000UL
+#define RTCC_DIV_NOMINAL        ((uint16_t)(RTCC_LPRC_HZ / 2 - 1))
+
+/* Trim never moves the divider further than this from nominal */
+#define RTCC_DIV_TRIM_LIMIT     (RTCC_DIV_NOMINAL / 4)
+
+/* Awake seconds per trim measurement */
+#define RTCC_CAL_SECONDS        8
+
+/* Shorter gaps are not worth stopping Timer1 for */
+#define RTCC_SLEEP_MIN_TICKS    20
+
+/* RTCC_WaitSeconds() gives up after this many seconds without an alarm */
+#define RTCC_FALLBACK_SECONDS   2
+
+/*============================================================================
+ * TYPE DEFINITIONS
+ *============================================================================*/
+
+typedef struct {
+    uint16_t div;                   /* Divider in use (RTCCON2H) */
+    uint16_t trims;                 /* Divider updates since boot */
+    uint16_t sleeps;                /* Sleeps ended by the alarm */
+    uint16_t early_wakes;           /* Sleeps ended by a button or the UART */
+    uint32_t slept_ticks;           /* Ticks stepped over by alarm wakes */
+    uint32_t caught_up_ticks;       /* Ticks recovered after early wakes */
+} RtccStats_t;
+
+/*============================================================================
+ * FUNCTION PROTOTYPES
+ *============================================================================*/
+
+/**
+ * @brief Start the RTCC on the LPRC with an alarm every second
+ *
+ * Call once before the scheduler starts.
+ */
+void RTCC_Init(void);
+
+/**
+ * @brief Notify the calling task on every RTCC second from now on
+ *
+ * Drops counts left from an earlier run. If the next alarm is less than
+ * half a second away it is skipped, so the first second is never short.
+ */
+void RTCC_StartSeconds(void);
+
+/**
+ * @brief Stop the notifications started by RTCC_StartSeconds()
+ */
+void RTCC_StopSeconds(void);
+
+/**
+ * @brief Wait for the next RTCC second (task that called RTCC_StartSeconds())
+ *
+ * Also catches the tick count up after an early wake from Sleep.
+ *
+ * @param xTicksToWait Maximum time to wait
+ * @return Seconds since the last call (usually 1), 0 on timeout
+ */
+uint16_t RTCC_WaitSeconds(TickType_t xTicksToWait);
+
+/**
+ * @brief Sleep until the next alarm if the kernel allows it
+ *
+ * For portSUPPRESS_TICKS_AND_SLEEP() only: scheduler suspended, after the
+ * caller has checked that the peripherals can stop.
+ *
+ * @param xExpectedIdleTime Ticks until the kernel next needs to run
+ * @return Ticks stepped over, 0 if it did not sleep or woke early
+ */
+TickType_t RTCC_Sleep(TickType_t xExpectedIdleTime);
+
+/**
+ * @brief Copy the trim and sleep counters
+ */
+void RTCC_GetStats(RtccStats_t *out);
+
+#endif /* RTCC_H */
@@ -0,0 +1,324 @@
+/*
+ * File:   stateprof.c
+ * Author: ENCM 511
+ *
+ * State Profiler Implementation
+ *
+ * Description: One statistics block per phase. Every counter is charged to
+ *              the phase current at the time, so a phase visited several
+ *              times (PAUSED, COUNTDOWN after a resume) adds up across
+ *              visits. The report is formatted by hand (no printf), one
+ *              log record per line so other output cannot split a line.
+ *
+ * Created on Nov 2025
+ */
+
+#include "stateprof.h"
+#include "app.h"
+#include "logbuf.h"
+#include "fmt.h"
+#include <stdbool.h>
+
+#if STATEPROF_ENABLE
+
+/*============================================================================
+ * CONFIGURATION CONSTANTS
+ *============================================================================*/
+
+/* Must match portTIMER_PRESCALE in port.c, as in boot.c */
+#define PROF_TIMER_PRESCALE     8UL
+#define PROF_COUNTS_PER_TICK    (configCPU_CLOCK_HZ / PROF_TIMER_PRESCALE / configTICK_RATE_HZ)
+#define PROF_COUNTS_PER_MS      (PROF_COUNTS_PER_TICK * configTICK_RATE_HZ / 1000UL)
+
+#define PROF_NO_TASK            0xFF
+
+/* Phases: the six system states plus COUNTDOWN with the 'i' display */
+typedef enum {
+    PHASE_WAITING = 0,
+    PHASE_TIME_INPUT,
+    PHASE_READY,
+    PHASE_COUNTDOWN,
+    PHASE_COUNTDOWN_I,
+    PHASE_PAUSED,
+    PHASE_COMPLETED,
+    PHASE_COUNT
+} ProfPhase_t;
+
+static const char * const phase_names[PHASE_COUNT] = {
+    "WAITING", "TIME_INPUT", "READY", "COUNTDOWN", "COUNTDOWN_I",
+    "PAUSED", "COMPLETED"
+};
+
+static const char * const isr_names[STATEPROF_ISR_COUNT] = {
+    "T2", "U2RX", "ADC1", "DMA0"
+};
+
+/*============================================================================
+ * STATIC VARIABLES
+ *============================================================================*/
+
+typedef struct {
+    uint32_t ms;
+    uint32_t task[STATEPROF_MAX_TASKS];     /* Timer1 counts */
+    uint32_t isr[STATEPROF_ISR_COUNT];      /* Timer1 counts */
+    uint32_t switches;
+    uint32_t wakeups;
+    uint32_t uart_bytes;
+} ProfPhaseStats_t;
+
+static ProfPhaseStats_t prof_phases[PHASE_COUNT];
+
+static TaskHandle_t prof_tasks[STATEPROF_MAX_TASKS];
+static uint8_t prof_task_count = 0;
+static uint8_t prof_current = PROF_NO_TASK;
+static uint8_t prof_idle = PROF_NO_TASK;
+
+static uint32_t prof_ticks = 0;
+static uint32_t prof_last = 0;             /* Time of the last task charge */
+static volatile uint8_t prof_phase = PHASE_WAITING;
+
+static TaskHandle_t prof_reporter = NULL;
+
+/* Report line - static so the PROF task stack stays small. A phase line
+ * with every counter at its maximum is ~270 bytes; LogBuf_Write() splits
+ * anything over LOGBUF_MAX_RECORD into two records, and other output can
+ * land between them. */
+#define PROF_LINE_SIZE          288
+static char prof_line[PROF_LINE_SIZE];
+
+/*============================================================================
+ * STATIC HELPER FUNCTIONS
+ *============================================================================*/
+
+static uint32_t Now(void)
+{
+    return prof_ticks * PROF_COUNTS_PER_TICK + TMR1;
+}
+
+static ProfPhase_t CurrentPhase(void)
+{
+    switch (g_SystemState) {
+    case STATE_TIME_INPUT:
+        return PHASE_TIME_INPUT;
+    case STATE_READY:
+        return PHASE_READY;
+    case STATE_COUNTDOWN:
+        return g_DisplaySettings.show_extended_info ? PHASE_COUNTDOWN_I : PHASE_COUNTDOWN;
+    case STATE_PAUSED:
+        return PHASE_PAUSED;
+    case STATE_COMPLETED:
+        return PHASE_COMPLETED;
+    default:
+        return PHASE_WAITING;
+    }
+}
+
+/**
+ * @brief Charge the time since the last charge to the running task
+ *
+ * Called from the tick hook or the switch hook, both with the kernel
+ * critical IPL or higher, so they never interleave.
+ */
+static void Charge(uint32_t now)
+{
+    uint32_t delta = now - prof_last;
+
+    /* A tick pending behind a higher-priority ISR can make Now() step
+     * back by one tick; drop that interval rather than charge ~2^32 */
+    if (delta & 0x80000000UL) {
+        delta = 0;
+    }
+    if (prof_current != PROF_NO_TASK) {
+        prof_phases[prof_phase].task[prof_current] += delta;
+    }
+    prof_last = now;
+}
+
+static uint8_t TaskIndex(void *tcb)
+{
+    uint8_t i;
+
+    for (i = 0; i < prof_task_count; i++) {
+        if (prof_tasks[i] == (TaskHandle_t)tcb) {
+            return i;
+        }
+    }
+    if (prof_task_count < STATEPROF_MAX_TASKS) {
+        prof_tasks[prof_task_count] = (TaskHandle_t)tcb;
+        return prof_task_count++;
+    }
+    return PROF_NO_TASK;
+}
+
+/* "name":value, */
+static char *AppendField(char *out, const char *name, uint32_t value)
+{
+    out = Fmt_AppendStr(out, "\"");
+    out = Fmt_AppendStr(out, name);
+    out = Fmt_AppendStr(out, "\":");
+    out = Fmt_AppendU32(out, value);
+    return Fmt_AppendStr(out, ",");
+}
+
+/* "name":[a,b,c] */
+static char *AppendArray(char *out, const char *name, const uint32_t *values, uint8_t count)
+{
+    uint8_t i;
+
+    out = Fmt_AppendStr(out, "\"");
+    out = Fmt_AppendStr(out, name);
+    out = Fmt_AppendStr(out, "\":[");
+    for (i = 0; i < count; i++) {
+        if (i != 0) {
+            out = Fmt_AppendStr(out, ",");
+        }
+        out = Fmt_AppendU32(out, values[i]);
+    }
+    return Fmt_AppendStr(out, "]");
+}
+
+static void EmitLine(char *end)
+{
+    end = Fmt_AppendStr(end, "}\r\n");
+    LogBuf_Write(prof_line, (uint16_t)(end - prof_line), portMAX_DELAY);
+}
+
+static void Report(void)
+{
+    ProfPhaseStats_t stats;
+    uint32_t free_words[STATEPROF_MAX_TASKS];
+    uint8_t count = prof_task_count;
+    uint8_t i;
+    char *p;
+
+    /* Header: units and the order of the task and ISR columns */
+    p = Fmt_AppendStr(prof_line, "@prof {");
+    p = AppendField(p, "counts_per_ms", PROF_COUNTS_PER_MS);
+    p = Fmt_AppendStr(p, "\"tasks\":[");
+    for (i = 0; i < count; i++) {
+        p = Fmt_AppendStr(p, (i != 0) ? ",\"" : "\"");
+        p = Fmt_AppendStr(p, pcTaskGetName(prof_tasks[i]));
+        p = Fmt_AppendStr(p, "\"");
+    }
+    p = Fmt_AppendStr(p, "],\"isrs\":[");
+    for (i = 0; i < STATEPROF_ISR_COUNT; i++) {
+        p = Fmt_AppendStr(p, (i != 0) ? ",\"" : "\"");
+        p = Fmt_AppendStr(p, isr_names[i]);
+        p = Fmt_AppendStr(p, "\"");
+    }
+    p = Fmt_AppendStr(p, "]");
+    EmitLine(p);
+
+    for (i = 0; i < PHASE_COUNT; i++) {
+        uint16_t saved_ipl;
+
+        /* Consistent copy of one phase; ISRs at any IPL update it */
+        SET_AND_SAVE_CPU_IPL(saved_ipl, 7);
+        stats = prof_phases[i];
+        RESTORE_CPU_IPL(saved_ipl);
+
+        p = Fmt_AppendStr(prof_line, "@prof {\"phase\":\"");
+        p = Fmt_AppendStr(p, phase_names[i]);
+        p = Fmt_AppendStr(p, "\",");
+        p = AppendField(p, "ms", stats.ms);
+        p = AppendField(p, "switches", stats.switches);
+        p = AppendField(p, "wakeups", stats.wakeups);
+        p = AppendField(p, "uart_bytes", stats.uart_bytes);
+        p = AppendArray(p, "task", stats.task, count);
+        p = Fmt_AppendStr(p, ",");
+        p = AppendArray(p, "isr", stats.isr, STATEPROF_ISR_COUNT);
+        EmitLine(p);
+    }
+
+    for (i = 0; i < count; i++) {
+        free_words[i] = uxTaskGetStackHighWaterMark(prof_tasks[i]);
+    }
+    p = Fmt_AppendStr(prof_line, "@prof {");
+    p = AppendField(p, "stack_word_bytes", sizeof(StackType_t));
+    p = AppendArray(p, "stack_free_words", free_words, count);
+    EmitLine(p);
+
+    LogBuf_Write("@prof end\r\n", 11, portMAX_DELAY);
+}
+
+/*============================================================================
+ * PUBLIC FUNCTION IMPLEMENTATIONS
+ *============================================================================*/
+
+void StateProf_Tick(void)
+{
+    ProfPhase_t phase;
+
+    prof_ticks++;
+    prof_phases[prof_phase].ms++;
+
+    if (prof_idle == PROF_NO_TASK) {
+        prof_idle = TaskIndex(xTaskGetIdleTaskHandle());
+    }
+
+    phase = CurrentPhase();
+    if (phase != prof_phase) {
+        /* Close the running task's interval in the old phase */
+        Charge(Now());
+        prof_phase = phase;
+    }
+}
+
+void StateProf_SwitchedIn(void *tcb)
+{
+    uint8_t next;
+
+    Charge(Now());
+    next = TaskIndex(tcb);
+    if (next != prof_current) {
+        prof_phases[prof_phase].switches++;
+        if (prof_current == prof_idle && prof_idle != PROF_NO_TASK) {
+            prof_phases[prof_phase].wakeups++;
+        }
+        prof_current = next;
+    }
+}
+
+void StateProf_IsrExit(StateProfIsr_t isr, uint16_t start)
+{
+    uint16_t end = TMR1;
+    uint16_t counts;
+
+    /* TMR1 resets at PR1 each tick */
+    if (end >= start) {
+        counts = end - start;
+    } else {
+        counts = (uint16_t)(end + PROF_COUNTS_PER_TICK - start);
+    }
+    prof_phases[prof_phase].isr[isr] += counts;
+}
+
+void StateProf_UartBytes(uint16_t n)
+{
+    uint16_t saved_ipl;
+
+    SET_AND_SAVE_CPU_IPL(saved_ipl, 7);
+    prof_phases[prof_phase].uart_bytes += n;
+    RESTORE_CPU_IPL(saved_ipl);
+}
+
+void StateProf_RequestReport(void)
+{
+    if (prof_reporter != NULL) {
+        xTaskNotifyGive(prof_reporter);
+    }
+}
+
+void vStateProfTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    prof_reporter = xTaskGetCurrentTaskHandle();
+
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        Report();
+    }
+}
+
+#endif /* STATEPROF_ENABLE */
@@ -0,0 +1,106 @@
+/*
+ * File:   stateprof.h
+ * Author: ENCM 511
+ *
+ * State Profiler Header
+ *
+ * Description: Splits CPU time, wake-ups, context switches and UART output
+ *              by application phase (g_SystemState, with COUNTDOWN split by
+ *              the 'i' display mode), so a change can be compared state by
+ *              state. Enabled with STATEPROF_ENABLE in FreeRTOSConfig.h;
+ *              when it is 0 the hooks below compile to nothing.
+ *
+ * Measurements:
+ *   - Time base: Timer1 (the tick timer, 2 us per count) plus a 32-bit
+ *     tick count, read at every context switch and ISR entry/exit.
+ *   - Task time runs from one switch to the next, so it includes any ISR
+ *     that interrupted the task. ISR rows show each ISR's own time; a
+ *     nested ISR is also counted in the ISR it interrupted.
+ *   - A wake-up is a switch from the idle task to any other task.
+ *   - UART bytes are counted as blocks are handed to the DMA engine.
+ *   - Stack figures are the high-water marks at report time.
+ *
+ * Report:
+ *   Pressing 'p' on the terminal makes the PROF task print "@prof ..."
+ *   lines, one JSON object each. tools/stateprof.py drives the board
+ *   through every state and turns the lines into one JSON report.
+ *
+ * Created on Nov 2025
+ */
+
+#ifndef STATEPROF_H
+#define STATEPROF_H
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stdint.h>
+#include <xc.h>
+
+/*============================================================================
+ * CONFIGURATION
+ *============================================================================*/
+
+/* Tasks tracked (including IDLE); later tasks are not profiled */
+#define STATEPROF_MAX_TASKS     10
+
+/* Instrumented ISRs - order matches the names in the report */
+typedef enum {
+    STATEPROF_ISR_T2 = 0,
+    STATEPROF_ISR_U2RX,
+    STATEPROF_ISR_ADC1,
+    STATEPROF_ISR_DMA0,
+    STATEPROF_ISR_COUNT
+} StateProfIsr_t;
+
+#if STATEPROF_ENABLE
+#define STATEPROF_ISR_ENTER()       uint16_t prof_isr_start = TMR1
+#define STATEPROF_ISR_EXIT(isr)     StateProf_IsrExit((isr), prof_isr_start)
+#define STATEPROF_UART_BYTES(n)     StateProf_UartBytes(n)
+#else
+#define STATEPROF_ISR_ENTER()
+#define STATEPROF_ISR_EXIT(isr)
+#define STATEPROF_UART_BYTES(n)
+#endif
+
+/*============================================================================
+ * FUNCTION PROTOTYPES
+ *============================================================================*/
+
+/**
+ * @brief Advance the time base and track phase changes - tick hook only
+ */
+void StateProf_Tick(void);
+
+/**
+ * @brief Charge time to the task switched out - traceTASK_SWITCHED_IN only
+ *
+ * @param tcb Task being switched in
+ */
+void StateProf_SwitchedIn(void *tcb);
+
+/**
+ * @brief Charge one ISR run - use STATEPROF_ISR_EXIT()
+ *
+ * @param isr Which ISR
+ * @param start TMR1 at ISR entry
+ */
+void StateProf_IsrExit(StateProfIsr_t isr, uint16_t start);
+
+/**
+ * @brief Count bytes handed to the UART - use STATEPROF_UART_BYTES()
+ *
+ * @param n Number of bytes
+ */
+void StateProf_UartBytes(uint16_t n);
+
+/**
+ * @brief Ask the PROF task for a report (from the UART RX task)
+ */
+void StateProf_RequestReport(void);
+
+/**
+ * @brief PROF task: prints the report each time one is requested
+ */
+void vStateProfTask(void *pvParameters);
+
+#endif /* STATEPROF_H */
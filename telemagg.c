@@ -0,0 +1,119 @@
+/*
+ * File:   telemagg.c
+ * Author: ENCM 511
+ *
+ * Windowed Statistics Report Implementation
+ *
+ * Description: Metric table and "@agg" lines for telemagg.h. Only the TLOG
+ *              task reports, so the line buffer needs no lock.
+ *
+ * Created on Nov 2025
+ */
+
+#include "telemagg.h"
+#include "app.h"
+#include "logbuf.h"
+#include "fmt.h"
+#include <string.h>
+
+/*============================================================================
+ * STATIC VARIABLES
+ *============================================================================*/
+
+static WinAgg_t telem_aggs[AGG_COUNT];
+
+static const char * const agg_names[AGG_COUNT] = {
+    "pot", "pot", "tick_lat_us", "rxq", "btnq"
+};
+
+static const uint16_t agg_windows_ms[AGG_COUNT] = {
+    AGG_FAST_WINDOW_MS, AGG_SLOW_WINDOW_MS, AGG_SLOW_WINDOW_MS,
+    AGG_SLOW_WINDOW_MS, AGG_SLOW_WINDOW_MS
+};
+
+static bool agg_running = false;
+
+/* "@agg tick_lat_us " + window, count, min, max, mean, variance + CRLF */
+static char agg_line[80];
+
+/*============================================================================
+ * STATIC HELPER FUNCTIONS
+ *============================================================================*/
+
+static void AggLine(char *end)
+{
+    *end++ = '\r';
+    *end++ = '\n';
+    LogBuf_Write(agg_line, (uint16_t)(end - agg_line), portMAX_DELAY);
+}
+
+/*============================================================================
+ * PUBLIC FUNCTION IMPLEMENTATIONS
+ *============================================================================*/
+
+void TelemAgg_Init(void)
+{
+    uint8_t i;
+
+    for (i = 0; i < AGG_COUNT; i++) {
+        WinAgg_Init(&telem_aggs[i], agg_windows_ms[i]);
+    }
+}
+
+WinAgg_t *TelemAgg_Get(AggMetric_t metric)
+{
+    return &telem_aggs[metric];
+}
+
+void TelemAgg_Start(void)
+{
+    WinAggSummary_t discard;
+    uint8_t i;
+
+    for (i = 0; i < AGG_COUNT; i++) {
+        (void)WinAgg_Take(&telem_aggs[i], &discard);
+    }
+    agg_running = true;
+}
+
+void TelemAgg_Stop(void)
+{
+    agg_running = false;
+}
+
+bool TelemAgg_Running(void)
+{
+    return agg_running;
+}
+
+void TelemAgg_Report(void)
+{
+    WinAggSummary_t sum;
+    char *p;
+    uint8_t i;
+
+    if (!agg_running) {
+        return;
+    }
+    for (i = 0; i < AGG_COUNT; i++) {
+        if (!WinAgg_Take(&telem_aggs[i], &sum)) {
+            continue;
+        }
+        p = agg_line;
+        memcpy(p, "@agg ", 5);
+        p = Fmt_AppendStr(p + 5, agg_names[i]);
+        *p++ = ' ';
+        p = Fmt_AppendU32(p, sum.window_ms);
+        *p++ = ' ';
+        p = Fmt_AppendU32(p, sum.count);
+        *p++ = ' ';
+        p = Fmt_AppendI16(p, sum.min);
+        *p++ = ' ';
+        p = Fmt_AppendI16(p, sum.max);
+        *p++ = ' ';
+        p = Fmt_AppendI16(p, sum.mean);
+        *p++ = ' ';
+        p = Fmt_AppendU32(p, sum.variance);
+        AggLine(p);
+    }
+}
@@ -0,0 +1,72 @@
+/*
+ * File:   telemagg.h
+ * Author: ENCM 511
+ *
+ * Windowed Statistics Report Header
+ *
+ * Description: The metrics behind the 'a' command. Each one is a winagg.h
+ *              aggregator fed by an ISR or the tick hook; while the report
+ *              is on, the TLOG task prints every closed window as
+ *                @agg <name> <window ms> <count> <min> <max> <mean> <variance>
+ *
+ * Created on Nov 2025
+ */
+
+#ifndef TELEMAGG_H
+#define TELEMAGG_H
+
+#include "FreeRTOS.h"
+#include "winagg.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/*============================================================================
+ * TYPE DEFINITIONS
+ *============================================================================*/
+
+typedef enum {
+    AGG_POT_FAST = 0,       /* Every ADC scan, AGG_FAST_WINDOW_MS windows */
+    AGG_POT_SLOW,
+    AGG_TICK_LATENCY,       /* Tick hook samples, every AGG_SAMPLE_TICKS */
+    AGG_RX_QUEUE,
+    AGG_BUTTON_QUEUE,
+    AGG_COUNT
+} AggMetric_t;
+
+/*============================================================================
+ * FUNCTION PROTOTYPES
+ *============================================================================*/
+
+/**
+ * @brief Set the window length of every metric (before the producers run)
+ */
+void TelemAgg_Init(void);
+
+/**
+ * @brief The aggregator behind a metric, for its producer to WinAgg_Add() to
+ */
+WinAgg_t *TelemAgg_Get(AggMetric_t metric);
+
+/**
+ * @brief Turn the report on; windows that closed while it was off are dropped
+ */
+void TelemAgg_Start(void);
+
+/**
+ * @brief Turn the report off
+ */
+void TelemAgg_Stop(void);
+
+/**
+ * @brief True between TelemAgg_Start() and TelemAgg_Stop()
+ */
+bool TelemAgg_Running(void);
+
+/**
+ * @brief Print one "@agg" line per window closed since the last call
+ *
+ * Nothing is printed while the report is off.
+ */
+void TelemAgg_Report(void);
+
+#endif /* TELEMAGG_H */
@@ -0,0 +1,406 @@
+/*
+ * File:   telemlog.c
+ * Author: ENCM 511
+ *
+ * Flash Telemetry Log Implementation
+ *
+ * Description: Records are encoded into their flash format (CRC included)
+ *              as they are appended, into one of two RAM batches. A flush
+ *              swaps the batches and programs the full one, so appends are
+ *              never held up by the NVM stall. The pages are reserved with a
+ *              noload array, as in appcfg.c.
+ *
+ * Write order:
+ *   - Opening a page is erase, then the header double word. Until the
+ *     header is in, the page is not a candidate for the head.
+ *   - A record is programmed first double word first, so a record cut
+ *     short has its length word but not a matching CRC.
+ *
+ * Created on Nov 2025
+ */
+
+#include "telemlog.h"
+#include "appcfg.h"
+#include "crc.h"
+#include "logbuf.h"
+#include "fmt.h"
+#include "nvm.h"
+#include "task.h"
+#include <xc.h>
+#include <string.h>
+
+/*============================================================================
+ * CONFIGURATION CONSTANTS
+ *============================================================================*/
+
+#define TELEMLOG_PAGE_WORDS     ((uint16_t)(APPCFG_PAGE_SIZE / 2))
+#define TELEMLOG_HDR_WORDS      2
+#define TELEMLOG_ERASED         0xFFFF
+
+/* type/len word + seconds + CRC, plus the padding to a double word */
+#define TELEMLOG_MAX_RECORD     ((4 + (TELEMLOG_MAX_PAYLOAD + 1) / 2) & ~1)
+
+/* Fails to compile if the log would run into the configuration slots */
+typedef char telemlog_region_check[(TELEMLOG_FLASH_ADDR +
+    TELEMLOG_PAGES * APPCFG_PAGE_SIZE <= APPCFG_FLASH_ADDR) ? 1 : -1];
+
+/*============================================================================
+ * STATIC VARIABLES
+ *============================================================================*/
+
+/* Erased flash reads 0xFFFF, so an unused page fails the magic check */
+static __prog__ const uint16_t tlog_pages[TELEMLOG_PAGES][TELEMLOG_PAGE_WORDS]
+    __attribute__((space(prog), address(TELEMLOG_FLASH_ADDR), noload));
+
+/* Two RAM batches: appends fill one while a flush programs the other */
+static uint16_t tlog_batch[2][TELEMLOG_BATCH_WORDS];
+static uint16_t tlog_batch_len[2] = { 0, 0 };
+static uint8_t tlog_fill = 0;
+
+/* Head page, its sequence and the next free word in it. The start values
+ * make the first flush on a blank region open page 0 with sequence 0. */
+static uint8_t tlog_head_page = TELEMLOG_PAGES - 1;
+static uint16_t tlog_head_seq = 0xFFFF;
+static uint16_t tlog_head_off = TELEMLOG_PAGE_WORDS;
+
+static uint16_t tlog_ticks = 0;
+static TickType_t tlog_last_tick = 0;
+static volatile uint16_t tlog_seconds = 0;
+
+static uint16_t tlog_records_written = 0;
+static uint16_t tlog_pages_opened = 0;
+static uint16_t tlog_dropped = 0;
+
+/* One "@tlm ..." line */
+static char tlog_line[48];
+
+/*============================================================================
+ * STATIC HELPER FUNCTIONS
+ *============================================================================*/
+
+/* Words a record takes in flash, padding included */
+static uint16_t RecordWords(uint8_t len)
+{
+    return (uint16_t)((4 + (len + 1) / 2) & ~1);
+}
+
+static uint16_t ReadWord(uint8_t page, uint16_t off)
+{
+    return tlog_pages[page][off];
+}
+
+static bool HeaderValid(uint8_t page)
+{
+    return ReadWord(page, 0) == TELEMLOG_MAGIC;
+}
+
+/**
+ * @brief Check the record at a word offset
+ *
+ * @return Its size in words, or 0 if it is erased, damaged or cut short
+ */
+static uint16_t RecordAt(uint8_t page, uint16_t off, bool check_crc)
+{
+    uint16_t w0 = ReadWord(page, off);
+    uint8_t len = (uint8_t)w0;
+    uint16_t words = RecordWords(len);
+    uint16_t data_words = (uint16_t)(2 + (len + 1) / 2);
+    Crc16_t crc;
+
+    if (w0 == TELEMLOG_ERASED || len > TELEMLOG_MAX_PAYLOAD ||
+        off + words > TELEMLOG_PAGE_WORDS) {
+        return 0;
+    }
+    if (check_crc) {
+        /* Words are little-endian through PSV, as in RAM */
+        Crc16_Init(&crc);
+        Crc16_UpdateProg(&crc, &tlog_pages[page][off], data_words * 2);
+        if (Crc16_Final(&crc) != ReadWord(page, off + data_words)) {
+            return 0;
+        }
+    }
+    return words;
+}
+
+/* Program two words into the (erased) double word at page/off */
+static bool ProgramDword(uint8_t page, uint16_t off, uint16_t w0, uint16_t w1)
+{
+    return Nvm_ProgramDword(&tlog_pages[page][off], w0, w1);
+}
+
+/**
+ * @brief Erase the page after the head and make it the head
+ *
+ * On a failed erase or header write the page is left full, so the next
+ * record moves on to the page after it.
+ */
+static void OpenNextPage(void)
+{
+    uint8_t page = (uint8_t)((tlog_head_page + 1) % TELEMLOG_PAGES);
+    uint16_t seq = tlog_head_seq + 1;
+
+    tlog_head_page = page;
+    tlog_head_seq = seq;
+    tlog_head_off = TELEMLOG_PAGE_WORDS;
+    tlog_pages_opened++;
+
+    if (Nvm_ErasePage(&tlog_pages[page][0]) &&
+        ProgramDword(page, 0, TELEMLOG_MAGIC, seq)) {
+        tlog_head_off = TELEMLOG_HDR_WORDS;
+    }
+}
+
+static void WriteLine(char *end)
+{
+    *end++ = '\r';
+    *end++ = '\n';
+    LogBuf_Write(tlog_line, (uint16_t)(end - tlog_line), portMAX_DELAY);
+}
+
+/*============================================================================
+ * PUBLIC FUNCTION IMPLEMENTATIONS
+ *============================================================================*/
+
+void TelemLog_Recover(void)
+{
+    uint8_t page;
+    uint8_t head = TELEMLOG_PAGES;
+    uint16_t head_seq = 0;
+    uint16_t off;
+    uint16_t last = 0;
+    uint16_t words;
+
+    for (page = 0; page < TELEMLOG_PAGES; page++) {
+        uint16_t seq = ReadWord(page, 1);
+
+        if (!HeaderValid(page)) {
+            continue;
+        }
+        /* Sequence numbers wrap, so compare by signed distance */
+        if (head == TELEMLOG_PAGES || (int16_t)(seq - head_seq) > 0) {
+            head = page;
+            head_seq = seq;
+        }
+    }
+    if (head == TELEMLOG_PAGES) {
+        return;                     /* Blank region - keep the start values */
+    }
+
+    /* Walk by length; only the last record can have been cut short */
+    off = TELEMLOG_HDR_WORDS;
+    while (off < TELEMLOG_PAGE_WORDS &&
+           (words = RecordAt(head, off, false)) != 0) {
+        last = off;
+        off += words;
+    }
+
+    tlog_head_page = head;
+    tlog_head_seq = head_seq;
+    tlog_head_off = off;
+
+    if ((last != 0 && RecordAt(head, last, true) == 0) ||
+        (off < TELEMLOG_PAGE_WORDS &&
+         (ReadWord(head, off) != TELEMLOG_ERASED ||
+          ReadWord(head, off + 1) != TELEMLOG_ERASED))) {
+        /* Damaged tail - close the page; the next flush opens a new one */
+        tlog_head_off = TELEMLOG_PAGE_WORDS;
+    }
+}
+
+void TelemLog_Tick(void)
+{
+    /* From the tick count, not the call count: ticks stepped over in
+     * tickless sleep run no tick hook */
+    TickType_t now = xTaskGetTickCountFromISR();
+
+    tlog_ticks += (TickType_t)(now - tlog_last_tick);
+    tlog_last_tick = now;
+    while (tlog_ticks >= configTICK_RATE_HZ) {
+        tlog_ticks -= configTICK_RATE_HZ;
+        tlog_seconds++;
+    }
+}
+
+bool TelemLog_Append(uint8_t type, const void *data, uint8_t len)
+{
+    uint16_t rec[TELEMLOG_MAX_RECORD];
+    uint16_t words;
+    uint16_t data_words;
+    uint16_t *dst;
+    bool ok = false;
+
+    if (len > TELEMLOG_MAX_PAYLOAD || type == 0xFF) {
+        return false;
+    }
+
+    /* Encode outside the critical section */
+    words = RecordWords(len);
+    data_words = (uint16_t)(2 + (len + 1) / 2);
+    memset(rec, 0, sizeof(rec));
+    rec[0] = (uint16_t)((uint16_t)type << 8 | len);
+    rec[1] = tlog_seconds;
+    memcpy(&rec[2], data, len);
+    rec[data_words] = Crc16_Compute(rec, data_words * 2);
+
+    taskENTER_CRITICAL();
+    if (tlog_batch_len[tlog_fill] + words <= TELEMLOG_BATCH_WORDS) {
+        dst = &tlog_batch[tlog_fill][tlog_batch_len[tlog_fill]];
+        memcpy(dst, rec, words * sizeof(uint16_t));
+        tlog_batch_len[tlog_fill] += words;
+        ok = true;
+    } else {
+        tlog_dropped++;
+    }
+    taskEXIT_CRITICAL();
+
+    return ok;
+}
+
+void TelemLog_Flush(void)
+{
+    const uint16_t *w;
+    uint16_t len;
+    uint16_t pos = 0;
+    uint16_t words;
+    uint16_t i;
+    uint16_t lost = 0;
+    uint8_t opens = 0;
+    uint8_t b;
+
+    /* Take the filled batch; appends continue into the empty one */
+    taskENTER_CRITICAL();
+    b = tlog_fill;
+    tlog_fill ^= 1;
+    taskEXIT_CRITICAL();
+
+    w = tlog_batch[b];
+    len = tlog_batch_len[b];
+
+    while (pos < len) {
+        words = RecordWords((uint8_t)w[pos]);
+
+        if (tlog_head_off + words > TELEMLOG_PAGE_WORDS) {
+            /* Every page failed - flash is worn out; drop the rest */
+            if (opens++ == TELEMLOG_PAGES) {
+                for (; pos < len; pos += RecordWords((uint8_t)w[pos])) {
+                    lost++;
+                }
+                break;
+            }
+            OpenNextPage();
+            continue;
+        }
+        for (i = 0; i < words; i += 2) {
+            if (!ProgramDword(tlog_head_page, tlog_head_off + i,
+                              w[pos + i], w[pos + i + 1])) {
+                break;
+            }
+        }
+        if (i < words) {
+            /* Write error - leave the rest of this page alone */
+            tlog_head_off = TELEMLOG_PAGE_WORDS;
+            continue;
+        }
+        tlog_head_off += words;
+        tlog_records_written++;
+        pos += words;
+    }
+
+    tlog_batch_len[b] = 0;
+
+    /* Appends count their drops too */
+    taskENTER_CRITICAL();
+    tlog_dropped += lost;
+    taskEXIT_CRITICAL();
+}
+
+uint16_t TelemLog_Pending(void)
+{
+    return tlog_batch_len[tlog_fill];
+}
+
+void TelemLog_IterBegin(TelemLogIter_t *it)
+{
+    it->page = (uint8_t)((tlog_head_page + 1) % TELEMLOG_PAGES);
+    it->pages_left = TELEMLOG_PAGES;
+    it->offset = 0;
+}
+
+bool TelemLog_IterNext(TelemLogIter_t *it, TelemLogRecord_t *rec)
+{
+    uint16_t words;
+    uint16_t w0;
+    uint8_t i;
+
+    while (it->pages_left > 0) {
+        if (it->offset == 0) {
+            it->offset = HeaderValid(it->page) ? TELEMLOG_HDR_WORDS : TELEMLOG_PAGE_WORDS;
+        }
+        if (it->offset < TELEMLOG_PAGE_WORDS &&
+            (words = RecordAt(it->page, it->offset, true)) != 0) {
+            w0 = ReadWord(it->page, it->offset);
+            rec->page_sequence = ReadWord(it->page, 1);
+            rec->seconds = ReadWord(it->page, it->offset + 1);
+            rec->type = (uint8_t)(w0 >> 8);
+            rec->len = (uint8_t)w0;
+            for (i = 0; i < rec->len; i += 2) {
+                uint16_t d = ReadWord(it->page, it->offset + 2 + i / 2);
+                rec->data[i] = (uint8_t)d;
+                if (i + 1 < rec->len) {
+                    rec->data[i + 1] = (uint8_t)(d >> 8);
+                }
+            }
+            it->offset += words;
+            return true;
+        }
+
+        /* End of this page (or first damaged record) - on to the next */
+        it->page = (uint8_t)((it->page + 1) % TELEMLOG_PAGES);
+        it->pages_left--;
+        it->offset = 0;
+    }
+    return false;
+}
+
+void TelemLog_Dump(void)
+{
+    TelemLogIter_t it;
+    TelemLogRecord_t rec;
+    uint16_t count = 0;
+    uint8_t i;
+    char *p;
+
+    TelemLog_IterBegin(&it);
+    while (TelemLog_IterNext(&it, &rec)) {
+        /* @tlm <page seq> <seconds> <type> <payload hex> */
+        p = tlog_line;
+        memcpy(p, "@tlm ", 5);
+        p = Fmt_AppendU32(p + 5, rec.page_sequence);
+        *p++ = ' ';
+        p = Fmt_AppendU32(p, rec.seconds);
+        *p++ = ' ';
+        p = Fmt_AppendHex8(p, rec.type);
+        *p++ = ' ';
+        for (i = 0; i < rec.len; i++) {
+            p = Fmt_AppendHex8(p, rec.data[i]);
+        }
+        WriteLine(p);
+        count++;
+    }
+
+    p = tlog_line;
+    memcpy(p, "@tlm end ", 9);
+    p = Fmt_AppendU32(p + 9, count);
+    WriteLine(p);
+}
+
+void TelemLog_GetStats(TelemLogStats_t *out)
+{
+    out->head_page = tlog_head_page;
+    out->head_sequence = tlog_head_seq;
+    out->head_free_words = TELEMLOG_PAGE_WORDS - tlog_head_off;
+    out->pending_words = TelemLog_Pending();
+    out->records_written = tlog_records_written;
+    out->pages_opened = tlog_pages_opened;
+    out->dropped = tlog_dropped;
+}
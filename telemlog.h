@@ -0,0 +1,183 @@
+/*
+ * File:   telemlog.h
+ * Author: ENCM 511
+ *
+ * Flash Telemetry Log Header
+ *
+ * Description: Append-only record store in program flash, so countdown runs,
+ *              aborts, pot use and errors survive a reset. Records are
+ *              collected in RAM and written out in batches by the TLOG task,
+ *              then read back in order with an iterator (the 't' key dumps
+ *              them on the terminal).
+ *
+ * Flash layout:
+ *   - TELEMLOG_PAGES erase pages directly below the configuration image
+ *     slots (appcfg.h). One data word per instruction word, as in appcfg.
+ *   - Each page starts with a header double word: TELEMLOG_MAGIC and a
+ *     page sequence number that goes up by one every time a page is opened.
+ *   - Pages are used in rotation. When the head page is full, the next one
+ *     (the oldest) is erased and opened, so every page wears at the same
+ *     rate and only the oldest page of history is lost.
+ *   - Records never span pages. Each one is:
+ *         word 0    type << 8 | payload length in bytes
+ *         word 1    seconds since boot
+ *         payload   padded to whole words
+ *         CRC       CRC-16/CCITT-FALSE over everything before it
+ *     padded with a 0x0000 word to a whole double word.
+ *
+ * Recovery (TelemLog_Recover):
+ *   - The valid page header with the newest sequence number is the head.
+ *     Its records are walked by length only; the last one is CRC-checked.
+ *   - Power loss can only damage the last thing being programmed. A torn
+ *     header fails the magic check or leaves that page as the head. A torn
+ *     record, or anything but erased flash after the last record, closes
+ *     the head page so the next batch opens a fresh one.
+ *
+ * Created on Nov 2025
+ */
+
+#ifndef TELEMLOG_H
+#define TELEMLOG_H
+
+#include "FreeRTOS.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/*============================================================================
+ * CONFIGURATION
+ *============================================================================*/
+
+#define TELEMLOG_MAGIC          0x7E1E
+
+/* Page 0 program address (eight pages up to the appcfg slots) */
+#define TELEMLOG_FLASH_ADDR     0x25800UL
+#define TELEMLOG_PAGES          8
+
+/* Largest payload per record, in bytes */
+#define TELEMLOG_MAX_PAYLOAD    8
+
+/* Size of each of the two RAM batches, in flash words */
+#define TELEMLOG_BATCH_WORDS    64
+
+/*============================================================================
+ * RECORD TYPES
+ *============================================================================*/
+
+#define TELEM_BOOT              0x01    /* u16 RCON */
+#define TELEM_COUNTDOWN_START   0x02    /* u16 seconds, u8 brightness % */
+#define TELEM_PAUSE             0x03    /* u16 seconds remaining */
+#define TELEM_RESUME            0x04    /* u16 seconds remaining */
+#define TELEM_ABORT             0x05    /* u16 seconds remaining */
+#define TELEM_COMPLETE          0x06    /* u16 seconds, u8 brightness % */
+#define TELEM_POT               0x07    /* u8 pot %, u8 system state */
+#define TELEM_ERROR             0x08    /* u16 new events, u8 TELEM_ERR_* */
+
+/* TELEM_ERROR codes */
+#define TELEM_ERR_UART_OVERRUN  1
+#define TELEM_ERR_UART_FRAMING  2
+#define TELEM_ERR_UART_PARITY   3
+#define TELEM_ERR_LOG_DROPPED   4
+#define TELEM_ERR_TLOG_DROPPED  5
+#define TELEM_ERR_LOW_VDD       6       /* u16 is AVdd in mV, not a count */
+#define TELEM_ERR_SCAN_LOST     7       /* 's' stream scan blocks overwritten */
+
+/*============================================================================
+ * TYPE DEFINITIONS
+ *============================================================================*/
+
+/* One record as returned by the iterator */
+typedef struct {
+    uint16_t page_sequence;         /* Sequence of the page holding it */
+    uint16_t seconds;               /* Seconds since the boot that wrote it */
+    uint8_t type;
+    uint8_t len;
+    uint8_t data[TELEMLOG_MAX_PAYLOAD];
+} TelemLogRecord_t;
+
+/* Iterator position - oldest page first */
+typedef struct {
+    uint8_t page;
+    uint8_t pages_left;
+    uint16_t offset;                /* Word offset in page, 0 = header */
+} TelemLogIter_t;
+
+typedef struct {
+    uint16_t head_page;
+    uint16_t head_sequence;
+    uint16_t head_free_words;       /* Space left in the head page */
+    uint16_t pending_words;         /* Appended but not yet in flash */
+    uint16_t records_written;       /* Since boot */
+    uint16_t pages_opened;          /* Erases since boot */
+    uint16_t dropped;               /* Records lost: full batch, or no page
+                                       would open */
+} TelemLogStats_t;
+
+/*============================================================================
+ * FUNCTION PROTOTYPES
+ *============================================================================*/
+
+/**
+ * @brief Find the head page and the end of its records
+ *
+ * Must run before the first TelemLog_Flush(). Appends made before it are
+ * kept in RAM.
+ */
+void TelemLog_Recover(void);
+
+/**
+ * @brief Advance the seconds-since-boot time base - tick hook only
+ *
+ * Catches up ticks stepped over while the tick was suppressed.
+ */
+void TelemLog_Tick(void);
+
+/**
+ * @brief Queue a record for the next flush (task context)
+ *
+ * @param type TELEM_* record type (0x00-0xFE)
+ * @param data Payload
+ * @param len Payload length, at most TELEMLOG_MAX_PAYLOAD
+ * @return false if the batch was full and the record was dropped
+ */
+bool TelemLog_Append(uint8_t type, const void *data, uint8_t len);
+
+/**
+ * @brief Program the queued records into flash
+ *
+ * The CPU stalls during each NVM operation (longest for the page erase
+ * when a new page is opened), so call it when nothing is timing critical.
+ * TLOG task only.
+ */
+void TelemLog_Flush(void);
+
+/**
+ * @brief Words appended but not yet flushed
+ */
+uint16_t TelemLog_Pending(void);
+
+/**
+ * @brief Start an iteration at the oldest record
+ */
+void TelemLog_IterBegin(TelemLogIter_t *it);
+
+/**
+ * @brief Read the next record
+ *
+ * Stops at the first damaged record in a page and moves on to the next
+ * page. Do not interleave with TelemLog_Flush().
+ *
+ * @return false when there are no more records
+ */
+bool TelemLog_IterNext(TelemLogIter_t *it, TelemLogRecord_t *rec);
+
+/**
+ * @brief Print every stored record as "@tlm ..." lines through the log buffer
+ */
+void TelemLog_Dump(void);
+
+/**
+ * @brief Get a snapshot of the store counters
+ */
+void TelemLog_GetStats(TelemLogStats_t *out);
+
+#endif /* TELEMLOG_H */
@@ -0,0 +1,140 @@
+/*
+ * File:   telemstream.c
+ * Author: ENCM 511
+ *
+ * Packed Telemetry Stream Implementation
+ *
+ * Description: Block framing for telemstream.h. Only the TLOG task calls
+ *              in, so the stream state and the line buffer need no lock.
+ *
+ * Created on Nov 2025
+ */
+
+#include "telemstream.h"
+#include "app.h"
+#include "task.h"
+#include "deltapack.h"
+#include "logbuf.h"
+#include "fmt.h"
+#include <xc.h>
+#include <string.h>
+
+/*============================================================================
+ * STATIC VARIABLES
+ *============================================================================*/
+
+typedef struct {
+    DeltaPack_t pack;
+    uint8_t block[TELEM_STREAM_BLOCK];
+    uint8_t len;
+    uint8_t blocks;                 /* Since the last 'k' block */
+    bool running;
+    uint32_t samples;
+    uint32_t packed_bytes;
+    uint32_t encode_counts;
+} TelemStream_t;
+
+static TelemStream_t telem_stream;
+
+/* "@tz k " + base64 of one block + CRLF */
+static char telem_line[6 + 4 * ((TELEM_STREAM_BLOCK + 2) / 3) + 2];
+
+/*============================================================================
+ * STATIC HELPER FUNCTIONS
+ *============================================================================*/
+
+static void TelemLine(char *end)
+{
+    *end++ = '\r';
+    *end++ = '\n';
+    LogBuf_Write(telem_line, (uint16_t)(end - telem_line), portMAX_DELAY);
+}
+
+/* Send the packed block as one line; every TELEM_STREAM_KEY_BLOCKS-th
+ * block restarts from zero so a decoder that joins late can sync */
+static void SendBlock(TelemStream_t *ts)
+{
+    char *p = telem_line;
+
+    ts->len += DeltaPack_Flush(&ts->pack, &ts->block[ts->len]);
+    if (ts->len == 0) {
+        return;
+    }
+    memcpy(p, (ts->blocks == 0) ? "@tz k " : "@tz c ", 6);
+    p += 6;
+    p += DeltaPack_Base64(ts->block, ts->len, p);
+    TelemLine(p);
+
+    ts->packed_bytes += ts->len;
+    ts->len = 0;
+    if (++ts->blocks == TELEM_STREAM_KEY_BLOCKS) {
+        ts->blocks = 0;
+        DeltaPack_Reset(&ts->pack);
+    }
+}
+
+/*============================================================================
+ * PUBLIC FUNCTION IMPLEMENTATIONS
+ *============================================================================*/
+
+void TelemStream_Start(uint16_t period_ms)
+{
+    TelemStream_t *ts = &telem_stream;
+    char *p = telem_line;
+
+    DeltaPack_Init(&ts->pack, TELEM_STREAM_FIELDS);
+    ts->len = 0;
+    ts->blocks = 0;
+    ts->samples = 0;
+    ts->packed_bytes = 0;
+    ts->encode_counts = 0;
+    ts->running = true;
+
+    memcpy(p, "@tz start " TELEM_STREAM_NAMES " ", sizeof("@tz start " TELEM_STREAM_NAMES " ") - 1);
+    p += sizeof("@tz start " TELEM_STREAM_NAMES " ") - 1;
+    p = Fmt_AppendU32(p, period_ms);
+    TelemLine(p);
+}
+
+void TelemStream_Stop(void)
+{
+    TelemStream_t *ts = &telem_stream;
+    char *p = telem_line;
+
+    SendBlock(ts);
+    memcpy(p, "@tz end ", 8);
+    p = Fmt_AppendU32(p + 8, ts->samples);
+    *p++ = ' ';
+    p = Fmt_AppendU32(p, ts->packed_bytes);
+    *p++ = ' ';
+    p = Fmt_AppendU32(p, ts->encode_counts * TELEM_TIMER_PRESCALE);
+    TelemLine(p);
+    ts->running = false;
+}
+
+bool TelemStream_Running(void)
+{
+    return telem_stream.running;
+}
+
+void TelemStream_Add(const int16_t *sample)
+{
+    TelemStream_t *ts = &telem_stream;
+    uint16_t start;
+    uint16_t end;
+
+    if (ts->len + DELTAPACK_MAX_SAMPLE_BYTES(TELEM_STREAM_FIELDS) + 3 > TELEM_STREAM_BLOCK) {
+        SendBlock(ts);
+    }
+
+    taskENTER_CRITICAL();
+    start = TMR1;
+    ts->len += DeltaPack_Encode(&ts->pack, sample, &ts->block[ts->len]);
+    end = TMR1;
+    taskEXIT_CRITICAL();
+
+    /* TMR1 resets at PR1 each tick */
+    ts->encode_counts += (end >= start) ? (uint16_t)(end - start) :
+                         (uint16_t)(end + TELEM_COUNTS_PER_TICK - start);
+    ts->samples++;
+}
@@ -0,0 +1,70 @@
+/*
+ * File:   telemstream.h
+ * Author: ENCM 511
+ *
+ * Packed Telemetry Stream Header
+ *
+ * Description: The 's' stream. The TLOG task hands in one sample per ADC
+ *              scan, received in blocks from the scan ISR; samples are
+ *              delta-packed (deltapack.h) into TELEM_STREAM_BLOCK-byte
+ *              blocks and each block goes to the log buffer as one base64
+ *              line:
+ *                @tz start <field names> <period ms>
+ *                @tz k <base64>     block that decodes on its own
+ *                @tz c <base64>     block that continues from the line before
+ *                @tz end <samples> <packed bytes> <encode cycles>
+ *              Every TELEM_STREAM_KEY_BLOCKS-th block restarts from zero so
+ *              a decoder that joins late can sync. tools/deltapack.py
+ *              decodes a capture.
+ *
+ * Encode cycles:
+ *   - Timer1 counts times the prescaler, taken around each
+ *     DeltaPack_Encode() with the tick held off (higher ISRs still count).
+ *
+ * Created on Nov 2025
+ */
+
+#ifndef TELEMSTREAM_H
+#define TELEMSTREAM_H
+
+#include "FreeRTOS.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/*============================================================================
+ * CONFIGURATION
+ *============================================================================*/
+
+/* Sample layout; the names are sent in the start line */
+#define TELEM_STREAM_FIELDS     6
+#define TELEM_STREAM_NAMES      "ticks,pot,temp,vbg,duty,state"
+
+/*============================================================================
+ * FUNCTION PROTOTYPES
+ *============================================================================*/
+
+/**
+ * @brief Send the start line and begin packing
+ *
+ * @param period_ms Sample period sent in the start line (the scan period)
+ */
+void TelemStream_Start(uint16_t period_ms);
+
+/**
+ * @brief Send the last block and the end line
+ */
+void TelemStream_Stop(void);
+
+/**
+ * @brief True between TelemStream_Start() and TelemStream_Stop()
+ */
+bool TelemStream_Running(void);
+
+/**
+ * @brief Pack one sample, sending the block first if it could overflow
+ *
+ * @param sample TELEM_STREAM_FIELDS values, in TELEM_STREAM_NAMES order
+ */
+void TelemStream_Add(const int16_t *sample);
+
+#endif /* TELEMSTREAM_H */
@@ -0,0 +1,95 @@
+/*
+ * File:   FreeRTOSConfig.h
+ * Author: ENCM 511
+ *
+ * Host Test Kernel Configuration
+ *
+ * Description: The target's kernel options that change queue behaviour
+ *              (tick width, priorities, mutexes, the queue extensions) with
+ *              the hardware hooks taken out: no heap ledger, no stack
+ *              checking, and no tickless idle except in test_rtcc. Keep the
+ *              queue options in step with ../FreeRTOSConfig.h.
+ *
+ * Created on Nov 2025
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+#include <stdint.h>
+
+#define configUSE_PREEMPTION            1
+#define configUSE_IDLE_HOOK             1       /* Drives the tick (port/port.c) */
+#define configUSE_TICK_HOOK             0
+#define configTICK_RATE_HZ              ( ( TickType_t ) 1000 )
+#define configCPU_CLOCK_HZ              ( ( unsigned long ) 4000000 )
+#define configMAX_PRIORITIES            ( 4 )
+#define configMINIMAL_STACK_SIZE        ( 16 )  /* Real stacks are host memory */
+#define configTOTAL_HEAP_SIZE           ( ( size_t ) ( 64 * 1024 ) )
+#define configMAX_TASK_NAME_LEN         ( 8 )
+#define configUSE_TRACE_FACILITY        0
+#define configUSE_16_BIT_TICKS          1
+#define configIDLE_SHOULD_YIELD         1
+#define configCHECK_FOR_STACK_OVERFLOW  0
+#define configSUPPORT_DYNAMIC_ALLOCATION 1
+#define configUSE_QUEUE_SETS            0
+#define configUSE_COUNTING_SEMAPHORES   1
+#define configUSE_MUTEXES               1
+#define configUSE_QUEUE_RECEIVE_MATCHING 1
+/* test_queue_bench_off builds with these two set to 0 as its baseline */
+#ifndef configUSE_QUEUE_FAST_PATH
+#define configUSE_QUEUE_FAST_PATH       1
+#endif
+#ifndef configUSE_QUEUE_DIRECT_HANDOFF
+#define configUSE_QUEUE_DIRECT_HANDOFF  1
+#endif
+/* test_list_index8 builds with the 8-bit index lists; the tables hold the
+ * test owners as well as the tasks */
+#ifndef configUSE_LIST_INDEX8
+#define configUSE_LIST_INDEX8           0
+#endif
+#define configLIST_INDEX8_MAX_OWNERS    64
+#define configLIST_INDEX8_MAX_LISTS     32
+#define configUSE_CO_ROUTINES           0
+#define configMAX_CO_ROUTINE_PRIORITIES ( 2 )
+
+#define INCLUDE_vTaskPrioritySet        1
+#define INCLUDE_uxTaskPriorityGet       1
+#define INCLUDE_vTaskDelete             0       /* heap_1, as on the target */
+#define INCLUDE_vTaskSuspend            1
+#define INCLUDE_xTaskDelayUntil         1
+#define INCLUDE_vTaskDelay              1
+#define INCLUDE_eTaskGetState           1
+#define INCLUDE_xTaskGetCurrentTaskHandle 1
+#define INCLUDE_xTaskGetSchedulerState  1       /* Simulated interrupts (port/port.c) */
+
+#define configKERNEL_INTERRUPT_PRIORITY 0x01
+
+/* test_queue_matching.c counts the xQueueReceiveMatching() trace points */
+#ifdef TEST_TRACE_RECEIVE_MATCHING
+    extern volatile unsigned long ulTraceMatchingEnters;
+    extern volatile long lTraceMatchingReturn;
+    #define traceENTER_xQueueReceiveMatching( xQueue, pvBuffer, pxMatch, pvContext, xTicksToWait ) \
+        ( ulTraceMatchingEnters++ )
+    #define traceRETURN_xQueueReceiveMatching( xReturn )    ( lTraceMatchingReturn = ( xReturn ) )
+#endif
+
+/* test_queue_bench.c counts the bytes the kernel copies */
+#ifdef TEST_COUNT_COPIES
+    #include <string.h>
+    extern volatile unsigned long ulTestBytesCopied;
+    #define memcpy( pvDest, pvSrc, xLen ) \
+        ( ulTestBytesCopied += ( xLen ), __builtin_memcpy( ( pvDest ), ( pvSrc ), ( xLen ) ) )
+#endif
+
+/* test_rtcc.c sleeps from the idle task through RTCC_Sleep(), as main.c does */
+#ifdef TEST_TICKLESS
+    #define configUSE_TICKLESS_IDLE     2
+    void vApplicationSleep( uint16_t xExpectedIdleTime );
+    #define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime )   vApplicationSleep( xExpectedIdleTime )
+#endif
+
+void Test_AssertFailed( const char *file, int line );
+#define configASSERT( x )   do { if( !( x ) ) { Test_AssertFailed( __FILE__, __LINE__ ); } } while( 0 )
+
+#endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,128 @@
+/*
+ * File:   adc_model.c
+ * Author: ENCM 511
+ *
+ * Host Test ADC Model Implementation
+ *
+ * Description: Results land in hw_ADC1BUF as the sequencer reaches them.
+ *              A flag set while the previous one is still pending is just
+ *              set again, as on the target: the scan before is overwritten.
+ *
+ * Created on Nov 2025
+ */
+
+#include "xc.h"
+#include "adc_model.h"
+#include "FreeRTOS.h"
+#include <string.h>
+
+#define ADC_CHANNELS        32
+#define ADC_SSRC_TMR3       0b0010
+
+volatile HW_AD1CON1_t hw_AD1CON1;
+volatile HW_AD1CON2_t hw_AD1CON2;
+volatile AD1CON3BITS hw_AD1CON3bits;
+volatile AD1CHSBITS hw_AD1CHSbits;
+volatile uint16_t hw_AD1CSSL, hw_AD1CSSH;
+volatile uint16_t hw_ADC1BUF[HW_ADC_BUFFERS];
+volatile CTMUCON1LBITS hw_CTMUCON1Lbits;
+
+static uint16_t inputs[ADC_CHANNELS];
+static uint8_t scan_channel;        /* Next channel the sequencer looks at */
+static uint8_t buffer_index;        /* Next ADC1BUFn */
+static uint32_t conversions;
+
+static bool ScanSelected(uint8_t channel)
+{
+    uint16_t mask = channel < 16 ? hw_AD1CSSL : hw_AD1CSSH;
+
+    return (mask & (1U << (channel & 15))) != 0;
+}
+
+static bool Triggered(void)
+{
+    return hw_AD1CON1.bits.ADON && hw_AD1CON1.bits.ASAM &&
+           hw_AD1CON1.bits.SSRC == ADC_SSRC_TMR3 && hw_T3CON.bits.TON &&
+           hw_AD1CON2.bits.CSCNA && (hw_AD1CSSL | hw_AD1CSSH) != 0;
+}
+
+void HwAdc_Reset(void)
+{
+    hw_AD1CON1.w = 0;
+    hw_AD1CON2.w = 0;
+    memset((void *)&hw_AD1CON3bits, 0, sizeof(hw_AD1CON3bits));
+    memset((void *)&hw_AD1CHSbits, 0, sizeof(hw_AD1CHSbits));
+    memset((void *)&hw_CTMUCON1Lbits, 0, sizeof(hw_CTMUCON1Lbits));
+    hw_AD1CSSL = 0;
+    hw_AD1CSSH = 0;
+    memset((void *)hw_ADC1BUF, 0, sizeof(hw_ADC1BUF));
+    hw_IFS0bits.AD1IF = 0;
+    hw_IEC0bits.AD1IE = 0;
+    hw_IPC3bits.AD1IP = 0;
+    hw_T3CON.w = 0;
+    hw_TMR3 = 0;
+    hw_PR3 = 0xFFFF;
+
+    memset(inputs, 0, sizeof(inputs));
+    scan_channel = 0;
+    buffer_index = 0;
+    conversions = 0;
+}
+
+void HwAdc_SetInput(uint8_t channel, uint16_t counts)
+{
+    configASSERT(channel < ADC_CHANNELS);
+    inputs[channel] = counts;
+}
+
+void HwAdc_TimerMatch(void)
+{
+    uint16_t full = hw_AD1CON1.bits.MODE12 ? 4095 : 1023;
+
+    if (!Triggered()) {
+        return;
+    }
+    while (!ScanSelected(scan_channel)) {
+        scan_channel = (uint8_t)((scan_channel + 1) % ADC_CHANNELS);
+    }
+    hw_ADC1BUF[buffer_index] = inputs[scan_channel] > full ? full : inputs[scan_channel];
+    conversions++;
+    scan_channel = (uint8_t)((scan_channel + 1) % ADC_CHANNELS);
+    buffer_index++;
+
+    /* End of the sample group: flag, both pointers back to the start */
+    if (buffer_index > hw_AD1CON2.bits.SMPI || buffer_index == HW_ADC_BUFFERS) {
+        hw_IFS0bits.AD1IF = 1;
+        buffer_index = 0;
+        scan_channel = 0;
+    }
+}
+
+bool HwAdc_Scan(void)
+{
+    if (!Triggered()) {
+        return false;
+    }
+    do {
+        HwAdc_TimerMatch();
+    } while (buffer_index != 0);
+    return true;
+}
+
+bool HwAdc_Pending(void)
+{
+    return hw_IFS0bits.AD1IF && hw_IEC0bits.AD1IE;
+}
+
+double HwAdc_ConversionsPerSecond(void)
+{
+    static const uint16_t prescale[4] = { 1, 8, 64, 256 };
+
+    return (double)configCPU_CLOCK_HZ / prescale[hw_T3CON.bits.TCKPS] /
+           ((double)hw_PR3 + 1.0);
+}
+
+uint32_t HwAdc_Conversions(void)
+{
+    return conversions;
+}
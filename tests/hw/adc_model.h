@@ -0,0 +1,61 @@
+/*
+ * File:   adc_model.h
+ * Author: ENCM 511
+ *
+ * Host Test ADC Model
+ *
+ * Description: The PIC24 A/D converter as adc.c drives it: Timer3 match
+ *              triggered conversions (SSRC = TMR3, ASAM = 1) walking the
+ *              AD1CSSL/AD1CSSH channel list from the lowest channel up,
+ *              one result per ADC1BUFn, and AD1IF after SMPI + 1 results,
+ *              when the buffer and scan pointers wrap together. Timer3 is
+ *              not counted bus cycle by bus cycle; a test calls
+ *              HwAdc_TimerMatch() once per period instead.
+ *
+ * Created on Nov 2025
+ */
+
+#ifndef ADC_MODEL_H
+#define ADC_MODEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Power-on reset of the registers, inputs and counters
+ */
+void HwAdc_Reset(void);
+
+/**
+ * @brief Level on an input channel, in counts (clipped to the result width)
+ */
+void HwAdc_SetInput(uint8_t channel, uint16_t counts);
+
+/**
+ * @brief One Timer3 period match: one conversion if the module is set up
+ *        for Timer3 triggered scanning and both ADON and TON are set
+ */
+void HwAdc_TimerMatch(void);
+
+/**
+ * @brief Timer3 matches until the next interrupt flag; false if the module
+ *        would never raise it as configured
+ */
+bool HwAdc_Scan(void);
+
+/**
+ * @brief AD1IF set and enabled: the CPU would vector to _ADC1Interrupt
+ */
+bool HwAdc_Pending(void);
+
+/**
+ * @brief Conversions per second at the current Timer3 settings
+ */
+double HwAdc_ConversionsPerSecond(void);
+
+/**
+ * @brief Conversions made since the last reset
+ */
+uint32_t HwAdc_Conversions(void);
+
+#endif /* ADC_MODEL_H */
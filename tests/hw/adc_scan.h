@@ -0,0 +1,42 @@
+/*
+ * File:   adc_scan.h
+ * Author: ENCM 511
+ *
+ * Host Test ADC Scan Lists
+ *
+ * Description: Scan lists of other lengths for test_adc.c, picked by
+ *              TEST_ADC_CHANNELS (1, 4 or 8). tests/Makefile includes this
+ *              ahead of the sources, so hw_config.h keeps the list defined
+ *              here instead of its own. Lists are in ascending channel
+ *              order, the order the sequencer converts them in.
+ *
+ * Created on Nov 2025
+ */
+
+#ifndef HW_ADC_SCAN_H
+#define HW_ADC_SCAN_H
+
+#if TEST_ADC_CHANNELS == 1
+/* Pot only: the temperature and band gap indices alias it */
+#define ADC_SCAN_LIST       { ADC_POT_CHANNEL }
+#define ADC_SCAN_COUNT      1
+#define ADC_SCAN_POT_INDEX  0
+#define ADC_SCAN_TEMP_INDEX 0
+#define ADC_SCAN_VBG_INDEX  0
+#elif TEST_ADC_CHANNELS == 4
+#define ADC_SCAN_LIST       { 0, ADC_POT_CHANNEL, ADC_CH_TEMP_DIODE, ADC_CH_VBG }
+#define ADC_SCAN_COUNT      4
+#define ADC_SCAN_POT_INDEX  1
+#define ADC_SCAN_TEMP_INDEX 2
+#define ADC_SCAN_VBG_INDEX  3
+#elif TEST_ADC_CHANNELS == 8
+#define ADC_SCAN_LIST       { 0, 1, 2, 3, 4, ADC_POT_CHANNEL, ADC_CH_TEMP_DIODE, ADC_CH_VBG }
+#define ADC_SCAN_COUNT      8
+#define ADC_SCAN_POT_INDEX  5
+#define ADC_SCAN_TEMP_INDEX 6
+#define ADC_SCAN_VBG_INDEX  7
+#else
+#error "TEST_ADC_CHANNELS must be 1, 4 or 8"
+#endif
+
+#endif /* HW_ADC_SCAN_H */
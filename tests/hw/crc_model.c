@@ -0,0 +1,166 @@
+/*
+ * File:   crc_model.c
+ * Author: ENCM 511
+ *
+ * Host Test CRC Module Model Implementation
+ *
+ * Description: A FIFO write only hands out a slot (CRCDATL is written
+ *              through the pointer HwCrc_FifoWrite() returns); the value is
+ *              taken into the FIFO on the next bus cycle, before the engine
+ *              shifts.
+ *
+ * Created on Nov 2025
+ */
+
+#include "xc.h"
+#include "crc_model.h"
+#include <string.h>
+
+#define CRC_FIFO_BYTES  16
+
+typedef struct {
+    uint16_t value;
+    uint8_t bits;
+} CrcEntry_t;
+
+volatile HW_CRCCON1_t hw_CRCCON1;
+volatile HW_CRCCON2_t hw_CRCCON2;
+volatile uint16_t hw_CRCXORL, hw_CRCXORH;
+volatile uint16_t hw_CRCWDATL, hw_CRCWDATH;
+
+static CrcEntry_t fifo[CRC_FIFO_BYTES];
+static uint8_t fifo_head;
+static uint8_t fifo_count;
+static uint8_t fifo_depth;
+
+static volatile uint16_t write_slot;
+static uint8_t write_bits;          /* 0: no write waiting for the next cycle */
+
+static CrcEntry_t shifting;         /* bits = 0: idle */
+static bool busy;
+
+static uint8_t shift_rate;
+static uint32_t full_cycles;
+static uint32_t overruns;
+static uint32_t bits_shifted;
+
+static void ShiftBit(uint8_t bit)
+{
+    uint16_t w = hw_CRCWDATL;
+    uint16_t msb = w & 0x8000;
+
+    /* Augmented form: the data bit enters at the bottom */
+    w = (uint16_t)((w << 1) | bit);
+    if (msb) {
+        w ^= hw_CRCXORL | 1;        /* Bit 0 of the polynomial is implied */
+    }
+    hw_CRCWDATL = w;
+    bits_shifted++;
+}
+
+static void UpdateStatus(void)
+{
+    hw_CRCCON1.bits.CRCFUL = fifo_count == fifo_depth;
+    hw_CRCCON1.bits.CRCMPT = fifo_count == 0;
+    hw_CRCCON1.bits.VWORD = fifo_count;
+}
+
+static void CrcStep(void)
+{
+    if (write_bits != 0) {
+        if (fifo_count == fifo_depth) {
+            overruns++;
+        } else {
+            CrcEntry_t *e = &fifo[(fifo_head + fifo_count) % CRC_FIFO_BYTES];
+
+            e->value = write_slot;
+            e->bits = write_bits;
+            fifo_count++;
+        }
+        write_bits = 0;
+    }
+
+    if (hw_CRCCON1.bits.CRCEN && hw_CRCCON1.bits.CRCGO) {
+        for (uint8_t n = 0; n < shift_rate; n++) {
+            if (shifting.bits == 0) {
+                if (fifo_count == 0) {
+                    break;
+                }
+                shifting = fifo[fifo_head];
+                fifo_head = (uint8_t)((fifo_head + 1) % CRC_FIFO_BYTES);
+                fifo_count--;
+                busy = true;
+                if (fifo_count == 0 && hw_CRCCON1.bits.CRCISEL) {
+                    hw_IFS4bits.CRCIF = 1;
+                }
+            }
+            shifting.bits--;
+            if (hw_CRCCON1.bits.LENDIAN) {
+                ShiftBit((uint8_t)((shifting.value >> (uint8_t)(hw_CRCCON2.bits.DWIDTH - shifting.bits)) & 1));
+            } else {
+                ShiftBit((uint8_t)((shifting.value >> shifting.bits) & 1));
+            }
+        }
+        if (busy && shifting.bits == 0 && fifo_count == 0) {
+            busy = false;
+            if (!hw_CRCCON1.bits.CRCISEL) {
+                hw_IFS4bits.CRCIF = 1;
+            }
+        }
+    }
+
+    UpdateStatus();
+    if (hw_CRCCON1.bits.CRCFUL) {
+        full_cycles++;
+    }
+}
+
+volatile uint16_t *HwCrc_FifoWrite(void)
+{
+    /* Each entry is as wide as DWIDTH says at the time of the write */
+    fifo_depth = hw_CRCCON2.bits.DWIDTH < 8 ? CRC_FIFO_BYTES : CRC_FIFO_BYTES / 2;
+    write_slot = 0;
+    write_bits = (uint8_t)(hw_CRCCON2.bits.DWIDTH + 1);
+    return &write_slot;
+}
+
+void HwCrc_Reset(void)
+{
+    hw_CRCCON1.w = 0;
+    hw_CRCCON2.w = 0;
+    hw_CRCXORL = hw_CRCXORH = 0;
+    hw_CRCWDATL = hw_CRCWDATH = 0;
+    hw_IFS4bits.CRCIF = 0;
+    hw_IEC4bits.CRCIE = 0;
+
+    memset(&shifting, 0, sizeof(shifting));
+    fifo_head = fifo_count = 0;
+    fifo_depth = CRC_FIFO_BYTES;
+    write_bits = 0;
+    busy = false;
+    shift_rate = 1;
+    full_cycles = overruns = bits_shifted = 0;
+    UpdateStatus();
+
+    Hw_Attach(CrcStep);
+}
+
+void HwCrc_SetShiftRate(uint8_t bits_per_cycle)
+{
+    shift_rate = bits_per_cycle;
+}
+
+uint32_t HwCrc_FullCycles(void)
+{
+    return full_cycles;
+}
+
+uint32_t HwCrc_Overruns(void)
+{
+    return overruns;
+}
+
+uint32_t HwCrc_BitsShifted(void)
+{
+    return bits_shifted;
+}
@@ -0,0 +1,49 @@
+/*
+ * File:   crc_model.h
+ * Author: ENCM 511
+ *
+ * Host Test CRC Module Model
+ *
+ * Description: The PIC24 programmable CRC engine as crc.c drives it: a
+ *              data FIFO (16 bytes deep, 8 words at DWIDTH 15), a shift
+ *              register in CRCWDATL fed MSB first, CRCFUL/CRCMPT status
+ *              and CRCIF on shift complete (CRCISEL = 0) or FIFO empty
+ *              (CRCISEL = 1). The engine shifts a set number of bits per
+ *              bus cycle while CRCEN and CRCGO are set, so software that
+ *              feeds it faster than that sees the FIFO fill.
+ *
+ * Created on Nov 2025
+ */
+
+#ifndef CRC_MODEL_H
+#define CRC_MODEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Power-on reset of the registers and the engine; attaches the model
+ */
+void HwCrc_Reset(void);
+
+/**
+ * @brief Bits shifted per bus cycle (default 1); 0 stops the engine
+ */
+void HwCrc_SetShiftRate(uint8_t bits_per_cycle);
+
+/**
+ * @brief Bus cycles so far in which the CPU found the FIFO full
+ */
+uint32_t HwCrc_FullCycles(void);
+
+/**
+ * @brief FIFO writes made while the FIFO was full (lost on the target)
+ */
+uint32_t HwCrc_Overruns(void);
+
+/**
+ * @brief Data bits the engine has shifted since the last reset
+ */
+uint32_t HwCrc_BitsShifted(void);
+
+#endif /* CRC_MODEL_H */
@@ -0,0 +1,121 @@
+/*
+ * File:   dma_model.c
+ * Author: ENCM 511
+ *
+ * Host Test DMA Controller Model Implementation
+ *
+ * Description: The channel latches DMASRC0 and DMACNT0 when it sees CHEN
+ *              set, so software may load the next block's registers while
+ *              it is disabled, as the completion ISR does.
+ *
+ * Created on Nov 2025
+ */
+
+#include "xc.h"
+#include "dma_model.h"
+#include "uart_model.h"
+#include "FreeRTOS.h"
+#include <string.h>
+
+#define DMA_TRIG_U2TX       0x0C
+#define DMA_DATA_SPACE      (HWDMA_RAM_END + 1)
+
+volatile DMACONBITS hw_DMACONbits;
+volatile uint16_t hw_DMAL, hw_DMAH;
+volatile HW_DMACHn_t hw_DMACH0;
+volatile HW_DMAINTn_t hw_DMAINT0;
+volatile uint16_t hw_DMASRC0, hw_DMADST0, hw_DMACNT0;
+
+static uint8_t data_space[0x10000] __attribute__((aligned(0x10000)));
+
+static bool running;                /* CHEN seen and the block latched */
+static uint16_t src;
+static uint16_t left;
+static uint32_t transfers;
+
+static void Stop(void)
+{
+    hw_DMACH0.bits.CHEN = 0;
+    running = false;
+}
+
+static void DmaStep(void)
+{
+    bool trigger;
+
+    if (!hw_DMACONbits.DMAEN || !hw_DMACH0.bits.CHEN) {
+        running = false;
+        (void)HwUart_TakeTxTrigger();
+        return;
+    }
+    if (!running) {
+        running = true;
+        src = hw_DMASRC0;
+        left = hw_DMACNT0;
+    }
+
+    trigger = hw_DMACH0.bits.CHREQ;
+    hw_DMACH0.bits.CHREQ = 0;
+    if (hw_DMAINT0.bits.CHSEL == DMA_TRIG_U2TX && HwUart_TakeTxTrigger()) {
+        trigger = true;
+    }
+    if (!trigger || left == 0) {
+        return;
+    }
+
+    if (src < hw_DMAL) {
+        hw_DMAINT0.bits.LOWIF = 1;
+        Stop();
+        return;
+    }
+    if (src > hw_DMAH || src >= DMA_DATA_SPACE) {
+        hw_DMAINT0.bits.HIGHIF = 1;
+        Stop();
+        return;
+    }
+
+    /* Byte transfers into a fixed destination; only U2TXREG is modelled */
+    configASSERT(hw_DMACH0.bits.SIZE == 1 && hw_DMACH0.bits.DAMODE == 0);
+    configASSERT(hw_DMADST0 == HwUart_TxAddress());
+    HwUart_DmaWrite(data_space[src]);
+    transfers++;
+    if (hw_DMACH0.bits.SAMODE == 0b01) {
+        src++;
+    }
+
+    if (--left == 0 && hw_DMACH0.bits.TRMODE == 0b00) {
+        Stop();
+        hw_DMAINT0.bits.DONEIF = 1;
+        hw_IFS0bits.DMA0IF = 1;
+    }
+}
+
+void HwDma_Reset(void)
+{
+    memset((void *)&hw_DMACONbits, 0, sizeof(hw_DMACONbits));
+    hw_DMAL = 0;
+    hw_DMAH = 0;
+    hw_DMACH0.w = 0;
+    hw_DMAINT0.w = 0;
+    hw_DMASRC0 = 0;
+    hw_DMADST0 = 0;
+    hw_DMACNT0 = 0;
+    hw_IFS0bits.DMA0IF = 0;
+    hw_IEC0bits.DMA0IE = 0;
+    hw_IPC1bits.DMA0IP = 0;
+
+    running = false;
+    transfers = 0;
+    Hw_Attach(DmaStep);
+}
+
+uint8_t *HwDma_Ram(uint16_t addr)
+{
+    configASSERT(addr < DMA_DATA_SPACE);
+    return &data_space[addr];
+}
+
+uint32_t HwDma_Transfers(void)
+{
+    return transfers;
+}
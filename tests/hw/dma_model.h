@@ -0,0 +1,48 @@
+/*
+ * File:   dma_model.h
+ * Author: ENCM 511
+ *
+ * Host Test DMA Controller Model
+ *
+ * Description: Channel 0 of the PIC24 DMA controller as uart_dma.c drives
+ *              it: one-shot, byte sized, source incrementing into a fixed
+ *              destination, one transfer per trigger (CHREQ or a UART2 TX
+ *              event, hw/uart_model.c). After the last transfer the channel
+ *              disables itself and sets DONEIF and DMA0IF. A source outside
+ *              DMAL..DMAH sets LOWIF or HIGHIF and stops the channel with
+ *              nothing moved.
+ *
+ * Data space:
+ *   - DMASRC0 holds a 16-bit data space address, which on the host is the
+ *     low half of a pointer. The model's data space is a 64 KB aligned
+ *     array laid out as the target's (RAM from 0x0800), so a buffer taken
+ *     from HwDma_Ram() has the address it would have on the target.
+ *
+ * Created on Nov 2025
+ */
+
+#ifndef DMA_MODEL_H
+#define DMA_MODEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define HWDMA_RAM_START     0x0800
+#define HWDMA_RAM_END       0x47FF      /* Last byte of the 16 KB RAM */
+
+/**
+ * @brief Power-on reset of the registers and the channel; attaches the model
+ */
+void HwDma_Reset(void);
+
+/**
+ * @brief Host pointer to data space address addr (RAM or the SFR area below it)
+ */
+uint8_t *HwDma_Ram(uint16_t addr);
+
+/**
+ * @brief Bytes channel 0 has moved since the last reset
+ */
+uint32_t HwDma_Transfers(void);
+
+#endif /* DMA_MODEL_H */
@@ -0,0 +1,118 @@
+/*
+ * File:   hw.c
+ * Author: ENCM 511
+ *
+ * Host Test Register Model Implementation
+ *
+ * Created on Nov 2025
+ */
+
+#include "xc.h"
+#include "FreeRTOS.h"
+
+#define HW_MAX_MODELS   8
+
+volatile SRBITS SRbits;
+volatile IFS0BITS hw_IFS0bits;
+volatile IEC0BITS hw_IEC0bits;
+volatile IFS1BITS hw_IFS1bits;
+volatile IEC1BITS hw_IEC1bits;
+volatile IPC1BITS hw_IPC1bits;
+volatile IPC3BITS hw_IPC3bits;
+volatile IPC7BITS hw_IPC7bits;
+volatile IFS3BITS hw_IFS3bits;
+volatile IEC3BITS hw_IEC3bits;
+volatile IFS4BITS hw_IFS4bits;
+volatile IEC4BITS hw_IEC4bits;
+volatile IPC15BITS hw_IPC15bits;
+volatile HW_TxCON_t hw_T1CON;
+volatile uint16_t hw_TMR1;
+volatile HW_TxCON_t hw_T3CON;
+volatile uint16_t hw_TMR3, hw_PR3;
+volatile ANSABITS hw_ANSAbits;
+volatile TRISABITS hw_TRISAbits;
+volatile uint16_t hw_LATB;
+volatile ANSELBBITS hw_ANSELBbits;
+volatile TRISBBITS hw_TRISBbits;
+volatile CNPDBBITS hw_CNPDBbits;
+volatile RPINR19BITS hw_RPINR19bits;
+volatile uint8_t hw_RPnR[32];
+
+static HwModelStep_t hw_models[HW_MAX_MODELS];
+static uint8_t hw_model_count = 0;
+static HwModelStep_t hw_sleep = NULL;
+static uint32_t hw_cycles = 0;
+static uint32_t hw_run_cycles = 0;
+static uint32_t hw_latb_accesses = 0;
+
+void Hw_Step(void)
+{
+    hw_cycles++;
+    for (uint8_t i = 0; i < hw_model_count; i++) {
+        hw_models[i]();
+    }
+}
+
+void Hw_Attach(HwModelStep_t step)
+{
+    for (uint8_t i = 0; i < hw_model_count; i++) {
+        if (hw_models[i] == step) {
+            return;
+        }
+    }
+    configASSERT(hw_model_count < HW_MAX_MODELS);
+    hw_models[hw_model_count++] = step;
+}
+
+uint32_t Hw_Cycles(void)
+{
+    return hw_cycles;
+}
+
+void Hw_Run(uint32_t cycles)
+{
+    while (cycles-- > 0) {
+        Hw_Step();
+        hw_run_cycles++;
+        if (SRbits.IPL == 0) {
+            vPortInterruptPoint(portINTERRUPT_AT_BUS_CYCLE);
+        }
+    }
+}
+
+uint32_t Hw_RunCycles(void)
+{
+    return hw_run_cycles;
+}
+
+void Hw_AttachSleep(HwModelStep_t sleep)
+{
+    hw_sleep = sleep;
+}
+
+void Hw_Sleep(void)
+{
+    /* Nothing attached could ever wake the CPU */
+    configASSERT(hw_sleep != NULL);
+    hw_sleep();
+}
+
+void Hw_SetIpl(unsigned int ipl)
+{
+    SRbits.IPL = ipl;
+
+    if (ipl == 0) {
+        vPortInterruptPoint(portINTERRUPT_AT_IPL_RESTORE);
+    }
+}
+
+volatile uint16_t *HwPort_LatB(void)
+{
+    hw_latb_accesses++;
+    return &hw_LATB;
+}
+
+uint32_t HwPort_LatBAccesses(void)
+{
+    return hw_latb_accesses;
+}
@@ -0,0 +1,19 @@
+/*
+ * File:   libpic30.h
+ * Author: ENCM 511
+ *
+ * Host Test XC16 Library Stub
+ *
+ * Description: The busy-wait delays take no time on the host; nothing
+ *              modelled depends on them.
+ *
+ * Created on Nov 2025
+ */
+
+#ifndef HW_LIBPIC30_H
+#define HW_LIBPIC30_H
+
+#define __delay_ms(d)   ((void)(d))
+#define __delay_us(d)   ((void)(d))
+
+#endif /* HW_LIBPIC30_H */
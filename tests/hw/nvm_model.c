@@ -0,0 +1,178 @@
+/*
+ * File:   nvm_model.c
+ * Author: ENCM 511
+ *
+ * Host Test Flash Model Implementation
+ *
+ * Created on Nov 2025
+ */
+
+#include "nvm_model.h"
+#include "nvm.h"
+#include "FreeRTOS.h"
+#include <string.h>
+#include <sys/mman.h>
+
+#define HWNVM_LOG_SIZE      4096
+
+/* Every array placed with address(); the linker provides the bounds */
+extern volatile uint16_t __start_hw_flash[];
+extern volatile uint16_t __stop_hw_flash[];
+
+typedef struct {
+    uint32_t reprograms;
+    uint16_t words[];               /* What the flash holds */
+} HwNvmShared_t;
+
+static HwNvmShared_t *nvm_shared = NULL;
+
+static uint32_t nvm_cut_after = HWNVM_NEVER;
+static uint32_t nvm_fail_after = HWNVM_NEVER;
+static bool nvm_power_lost = false;
+
+static HwNvmOp_t nvm_log[HWNVM_LOG_SIZE];
+static uint16_t nvm_log_count = 0;
+
+/*============================================================================
+ * STATIC HELPER FUNCTIONS
+ *============================================================================*/
+
+static uint32_t Words(void)
+{
+    return (uint32_t)(__stop_hw_flash - __start_hw_flash);
+}
+
+/* Word offset of addr; the operation must fit in the flash */
+static uint32_t Offset(const volatile uint16_t *addr, uint32_t words)
+{
+    uint32_t off = (uint32_t)(addr - __start_hw_flash);
+
+    configASSERT(addr >= __start_hw_flash && off + words <= Words());
+    return off;
+}
+
+/* Decide whether an operation happens; false if it must change nothing */
+static bool Operate(bool erase, uint32_t off, bool *ok)
+{
+    *ok = true;
+    if (nvm_power_lost) {
+        return false;
+    }
+    if (nvm_fail_after == 0) {
+        *ok = false;
+        return false;
+    }
+    if (nvm_fail_after != HWNVM_NEVER) {
+        nvm_fail_after--;
+    }
+    configASSERT(nvm_log_count < HWNVM_LOG_SIZE);
+    nvm_log[nvm_log_count].erase = erase;
+    nvm_log[nvm_log_count].word = off;
+    nvm_log_count++;
+    return true;
+}
+
+static void Store(uint32_t off, uint16_t value)
+{
+    __start_hw_flash[off] = value;
+    nvm_shared->words[off] = value;
+}
+
+/*============================================================================
+ * NVM.H ON THE MODEL
+ *============================================================================*/
+
+bool Nvm_ErasePage(const __prog__ uint16_t *addr)
+{
+    uint32_t off = Offset(addr, HWNVM_PAGE_WORDS);
+    bool ok;
+
+    if (Operate(true, off, &ok)) {
+        for (uint32_t i = 0; i < HWNVM_PAGE_WORDS; i++) {
+            Store(off + i, 0xFFFF);
+        }
+    }
+    return ok;
+}
+
+bool Nvm_ProgramDword(const __prog__ uint16_t *addr, uint16_t w0, uint16_t w1)
+{
+    uint32_t off = Offset(addr, 2);
+    bool ok;
+
+    if (Operate(false, off, &ok)) {
+        if (__start_hw_flash[off] != 0xFFFF || __start_hw_flash[off + 1] != 0xFFFF) {
+            nvm_shared->reprograms++;
+        }
+        Store(off, __start_hw_flash[off] & w0);
+        Store(off + 1, __start_hw_flash[off + 1] & w1);
+        if (nvm_cut_after != HWNVM_NEVER && --nvm_cut_after == 0) {
+            nvm_power_lost = true;
+        }
+    }
+    return ok;
+}
+
+/*============================================================================
+ * MODEL CONTROL
+ *============================================================================*/
+
+void HwNvm_Reset(void)
+{
+    if (nvm_shared == NULL) {
+        nvm_shared = mmap(NULL, sizeof(HwNvmShared_t) + Words() * sizeof(uint16_t),
+                          PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        configASSERT(nvm_shared != MAP_FAILED);
+    }
+    nvm_shared->reprograms = 0;
+    memset(nvm_shared->words, 0xFF, Words() * sizeof(uint16_t));
+    HwNvm_PowerOn();
+}
+
+void HwNvm_PowerOn(void)
+{
+    for (uint32_t i = 0; i < Words(); i++) {
+        __start_hw_flash[i] = nvm_shared->words[i];
+    }
+    nvm_cut_after = HWNVM_NEVER;
+    nvm_fail_after = HWNVM_NEVER;
+    nvm_power_lost = false;
+    nvm_log_count = 0;
+}
+
+void HwNvm_CutPowerAfter(uint32_t dwords)
+{
+    nvm_cut_after = dwords;
+    nvm_power_lost = (dwords == 0);
+}
+
+void HwNvm_FailAfter(uint32_t ops)
+{
+    nvm_fail_after = ops;
+}
+
+bool HwNvm_PowerLost(void)
+{
+    return nvm_power_lost;
+}
+
+const volatile uint16_t *HwNvm_Base(void)
+{
+    return __start_hw_flash;
+}
+
+uint32_t HwNvm_Words(void)
+{
+    return Words();
+}
+
+const HwNvmOp_t *HwNvm_Log(uint16_t *count)
+{
+    *count = nvm_log_count;
+    return nvm_log;
+}
+
+uint32_t HwNvm_Reprograms(void)
+{
+    return nvm_shared->reprograms;
+}
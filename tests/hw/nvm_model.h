@@ -0,0 +1,91 @@
+/*
+ * File:   nvm_model.h
+ * Author: ENCM 511
+ *
+ * Host Test Flash Model
+ *
+ * Description: Nvm_ErasePage() and Nvm_ProgramDword() (nvm.h) over the
+ *              host's program-space arrays, in place of nvm.c. All arrays
+ *              placed with address() (see hw/xc16.h) are the flash; it
+ *              erases to 0xFFFF a page of HWNVM_PAGE_WORDS at a time and
+ *              programming can only clear bits, as on the target.
+ *
+ * Power:
+ *   - The flash contents live in shared memory, so they survive from one
+ *     Test_RunInChild() boot to the next. HwNvm_PowerOn() loads them into
+ *     the arrays at the start of a boot.
+ *   - HwNvm_CutPowerAfter(n) lets n more double words program, then the
+ *     power is gone: later operations change nothing. The code under test
+ *     keeps running, but on the target it would not have.
+ *   - HwNvm_FailAfter(n) lets n more operations succeed, then every one
+ *     reports a write error (worn-out flash) and changes nothing.
+ *
+ * Created on Nov 2025
+ */
+
+#ifndef NVM_MODEL_H
+#define NVM_MODEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* One erase page: 0x800 program addresses, one data word per instruction */
+#define HWNVM_PAGE_WORDS    1024
+
+#define HWNVM_NEVER         0xFFFFFFFFUL
+
+/* One flash operation since power-on */
+typedef struct {
+    bool erase;
+    uint32_t word;                  /* Offset from the start of the flash */
+} HwNvmOp_t;
+
+/**
+ * @brief Erase the whole flash, in the arrays and in the shared copy
+ *
+ * Call from the parent before the first boot; the shared copy is
+ * created here.
+ */
+void HwNvm_Reset(void);
+
+/**
+ * @brief Start a boot: load the arrays from the shared copy, clear the
+ *        operation log, restore power and clear HwNvm_FailAfter()
+ */
+void HwNvm_PowerOn(void);
+
+/**
+ * @brief Cut the power once n more double words are programmed
+ */
+void HwNvm_CutPowerAfter(uint32_t dwords);
+
+/**
+ * @brief Fail every operation after n more successful ones
+ */
+void HwNvm_FailAfter(uint32_t ops);
+
+/**
+ * @brief True once HwNvm_CutPowerAfter() has cut the power
+ */
+bool HwNvm_PowerLost(void);
+
+/**
+ * @brief Start of the flash and its size in words
+ */
+const volatile uint16_t *HwNvm_Base(void);
+uint32_t HwNvm_Words(void);
+
+/**
+ * @brief Operations carried out since power-on
+ *
+ * @param count Set to the number of entries
+ */
+const HwNvmOp_t *HwNvm_Log(uint16_t *count);
+
+/**
+ * @brief Double words programmed over bits that were not erased
+ *        (not allowed on the target) since HwNvm_Reset()
+ */
+uint32_t HwNvm_Reprograms(void);
+
+#endif /* NVM_MODEL_H */
@@ -0,0 +1,181 @@
+/*
+ * File:   rtcc_model.c
+ * Author: ENCM 511
+ *
+ * Host Test RTCC and Sleep Model Implementation
+ *
+ * Description: The bus step only watches the registers: RTCEN starting and
+ *              stopping the second, and DIV, which is latched when written
+ *              unlocked and put back when written locked. Time moves in
+ *              HwRtcc_Tick() and in Sleep().
+ *
+ * Created on Nov 2025
+ */
+
+#include "xc.h"
+#include "rtcc_model.h"
+#include "FreeRTOS.h"
+#include <stdbool.h>
+
+#define RTCC_CLKSEL_LPRC    0b01
+#define RTCC_AMASK_SECOND   0b0001
+
+volatile RTCCON1LBITS hw_RTCCON1Lbits;
+volatile HW_RTCCON1H_t hw_RTCCON1H;
+volatile HW_RTCCON2L_t hw_RTCCON2L;
+volatile uint16_t hw_RTCCON2H;
+
+static double lprc;
+static bool enabled;
+static uint16_t div;                /* DIV as the prescaler has it */
+static uint64_t now;
+static uint64_t next_alarm;
+static uint64_t last_alarm;
+static uint64_t wake_at;
+static uint32_t alarms;
+static uint32_t wakes;
+static uint64_t awake;
+static uint64_t asleep;
+static uint32_t locked_writes;
+
+static uint64_t Second(void)
+{
+    return (uint64_t)(2.0 * (div + 1) / lprc * 1e9 + 0.5);
+}
+
+static void RtccStep(void)
+{
+    if (hw_RTCCON2H != div) {
+        if (hw_RTCCON1Lbits.WRLOCK) {
+            locked_writes++;
+            hw_RTCCON2H = div;
+        } else {
+            div = hw_RTCCON2H;
+        }
+    }
+
+    if (hw_RTCCON1Lbits.RTCEN && !enabled) {
+        /* Only the LPRC is modelled */
+        configASSERT(hw_RTCCON2L.bits.CLKSEL == RTCC_CLKSEL_LPRC);
+        next_alarm = now + Second();
+    }
+    enabled = hw_RTCCON1Lbits.RTCEN;
+}
+
+/* Every alarm due by now, each a second after the last at the DIV in use */
+static void Alarms(void)
+{
+    while (enabled && now >= next_alarm) {
+        last_alarm = next_alarm;
+        next_alarm += Second();
+        if (hw_RTCCON1H.bits.ALRMEN && hw_RTCCON1H.bits.AMASK == RTCC_AMASK_SECOND) {
+            hw_IFS3bits.RTCIF = 1;
+            alarms++;
+            if (!hw_RTCCON1H.bits.CHIME) {
+                hw_RTCCON1H.bits.ALRMEN = 0;
+            }
+        }
+    }
+}
+
+static void RtccSleep(void)
+{
+    uint64_t until = UINT64_MAX;
+
+    if (enabled && hw_RTCCON1H.bits.ALRMEN) {
+        until = next_alarm;
+    }
+    if (wake_at != 0 && wake_at < until) {
+        until = wake_at;
+        wakes++;
+    }
+    wake_at = 0;
+
+    /* Nothing left that could wake the CPU */
+    configASSERT(until != UINT64_MAX);
+    if (until > now) {
+        asleep += until - now;
+        now = until;
+    }
+    Alarms();
+}
+
+void HwRtcc_Reset(double lprc_hz)
+{
+    hw_RTCCON1Lbits = (RTCCON1LBITS){0};
+    hw_RTCCON1H.w = 0;
+    hw_RTCCON2L.w = 0;
+    hw_RTCCON2H = 0;
+    hw_IFS3bits.RTCIF = 0;
+    hw_IEC3bits.RTCIE = 0;
+
+    lprc = lprc_hz;
+    enabled = false;
+    div = 0;
+    now = 0;
+    next_alarm = 0;
+    last_alarm = 0;
+    wake_at = 0;
+    alarms = 0;
+    wakes = 0;
+    awake = 0;
+    asleep = 0;
+    locked_writes = 0;
+
+    Hw_Attach(RtccStep);
+    Hw_AttachSleep(RtccSleep);
+}
+
+void HwRtcc_Tick(void)
+{
+    /* The port ticks whenever the idle task runs; Timer1 must be running */
+    configASSERT(hw_T1CON.bits.TON);
+    now += HWRTCC_TICK_NS;
+    awake += HWRTCC_TICK_NS;
+    Alarms();
+
+    /* A wake-up source that fires while awake is just an interrupt */
+    if (wake_at != 0 && wake_at <= now) {
+        wake_at = 0;
+    }
+}
+
+void HwRtcc_WakeAt(uint64_t ns)
+{
+    wake_at = ns;
+}
+
+uint64_t HwRtcc_Now(void)
+{
+    return now;
+}
+
+uint64_t HwRtcc_LastAlarm(void)
+{
+    return last_alarm;
+}
+
+uint32_t HwRtcc_Alarms(void)
+{
+    return alarms;
+}
+
+uint32_t HwRtcc_Wakes(void)
+{
+    return wakes;
+}
+
+uint64_t HwRtcc_AwakeNs(void)
+{
+    return awake;
+}
+
+uint64_t HwRtcc_AsleepNs(void)
+{
+    return asleep;
+}
+
+uint32_t HwRtcc_LockedWrites(void)
+{
+    return locked_writes;
+}
@@ -0,0 +1,83 @@
+/*
+ * File:   rtcc_model.h
+ * Author: ENCM 511
+ *
+ * Host Test RTCC and Sleep Model
+ *
+ * Description: The RTCC as rtcc.c drives it: clocked from an LPRC whose
+ *              frequency the test chooses, divided by 2 * (DIV + 1) into
+ *              seconds, with a chime alarm (AMASK = every second) that sets
+ *              RTCIF. A new DIV takes effect from the next alarm.
+ *
+ * Time:
+ *   - The model keeps simulated real time in nanoseconds. Awake, it only
+ *     moves by HwRtcc_Tick(), one 1 ms Timer1 period, which the test calls
+ *     on every kernel tick the port makes; the tick that RTCC_Sleep()
+ *     forces with T1IF after an alarm wake is not a period of its own.
+ *   - Sleep() jumps to the next alarm or to the wake-up the test set with
+ *     HwRtcc_WakeAt() (a button or a UART start bit), whichever is first.
+ *     Only the alarm sets a flag. A wake-up time that passes while the CPU
+ *     is awake is dropped: it was an interrupt like any other. Time awake
+ *     and asleep is kept apart for the energy figures.
+ *
+ * Created on Nov 2025
+ */
+
+#ifndef RTCC_MODEL_H
+#define RTCC_MODEL_H
+
+#include <stdint.h>
+
+#define HWRTCC_TICK_NS      1000000ULL
+
+/**
+ * @brief Power-on reset of the registers and the clock; attaches the model
+ *        and Sleep()
+ *
+ * @param lprc_hz Actual LPRC frequency (nominal 31 kHz)
+ */
+void HwRtcc_Reset(double lprc_hz);
+
+/**
+ * @brief One Timer1 period awake; raises RTCIF for an alarm it passes
+ */
+void HwRtcc_Tick(void);
+
+/**
+ * @brief Wake the next Sleep() at time ns unless the alarm comes first;
+ *        0 cancels
+ */
+void HwRtcc_WakeAt(uint64_t ns);
+
+/**
+ * @brief Simulated time since the reset (ns)
+ */
+uint64_t HwRtcc_Now(void);
+
+/**
+ * @brief Time of the last alarm (ns), 0 before the first
+ */
+uint64_t HwRtcc_LastAlarm(void);
+
+/**
+ * @brief Alarms since the reset
+ */
+uint32_t HwRtcc_Alarms(void);
+
+/**
+ * @brief Sleeps ended by the HwRtcc_WakeAt() time rather than an alarm
+ */
+uint32_t HwRtcc_Wakes(void);
+
+/**
+ * @brief Time spent awake and in Sleep() since the reset (ns)
+ */
+uint64_t HwRtcc_AwakeNs(void);
+uint64_t HwRtcc_AsleepNs(void);
+
+/**
+ * @brief Writes to RTCCON2H while WRLOCK was set; the RTCC ignored them
+ */
+uint32_t HwRtcc_LockedWrites(void);
+
+#endif /* RTCC_MODEL_H */
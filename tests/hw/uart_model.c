@@ -0,0 +1,172 @@
+/*
+ * File:   uart_model.c
+ * Author: ENCM 511
+ *
+ * Host Test UART2 Transmitter Model Implementation
+ *
+ * Description: A CPU write to U2TXREG is taken into the FIFO on the next
+ *              bus cycle, which then puts TX_IDLE back in the register. A
+ *              DMA write goes into the FIFO at once.
+ *
+ * Created on Nov 2025
+ */
+
+#include "xc.h"
+#include "uart_model.h"
+#include "FreeRTOS.h"
+#include <string.h>
+
+#define UART_FIFO_DEPTH     4
+#define UART_BITS_PER_BYTE  10
+#define UART_LINE_SIZE      16384
+#define TX_IDLE             0x7FFF      /* Not a 9-bit or sign-extended char write */
+
+volatile HW_UxMODE_t hw_U2MODE;
+volatile UxSTABITS hw_U2STAbits;
+volatile uint16_t hw_U2BRG;
+volatile uint16_t hw_U2RXREG;
+volatile uint16_t hw_U2TXREG = TX_IDLE;
+
+static uint8_t fifo[UART_FIFO_DEPTH];
+static uint8_t fifo_head;
+static uint8_t fifo_count;
+
+static uint8_t shifting;
+static uint32_t shift_left;         /* Bus cycles; 0: shift register empty */
+static bool tx_trigger;
+static bool line_started;
+
+static uint8_t line[UART_LINE_SIZE];
+static uint16_t line_head;
+static uint16_t line_count;
+
+static uint32_t overruns;
+static uint32_t gap_cycles;
+static uint32_t gap_pending;        /* Empty cycles not yet known to be a gap */
+
+static void Push(uint8_t byte)
+{
+    if (fifo_count == UART_FIFO_DEPTH) {
+        overruns++;
+        return;
+    }
+    fifo[(fifo_head + fifo_count) % UART_FIFO_DEPTH] = byte;
+    fifo_count++;
+}
+
+static void UpdateStatus(void)
+{
+    hw_U2STAbits.UTXBF = fifo_count == UART_FIFO_DEPTH;
+    hw_U2STAbits.TRMT = fifo_count == 0 && shift_left == 0;
+}
+
+static void UartStep(void)
+{
+    if (hw_U2TXREG != TX_IDLE) {
+        Push((uint8_t)hw_U2TXREG);
+        hw_U2TXREG = TX_IDLE;
+    }
+
+    if (shift_left > 0 && --shift_left == 0) {
+        configASSERT(line_count < UART_LINE_SIZE);
+        line[(line_head + line_count) % UART_LINE_SIZE] = shifting;
+        line_count++;
+    }
+
+    if (shift_left == 0 && fifo_count > 0 &&
+        hw_U2MODE.bits.UARTEN && hw_U2STAbits.UTXEN) {
+        shifting = fifo[fifo_head];
+        fifo_head = (uint8_t)((fifo_head + 1) % UART_FIFO_DEPTH);
+        fifo_count--;
+        shift_left = HwUart_ByteCycles();
+
+        /* UTXISEL = 00: a byte moved into the shift register */
+        if (!hw_U2STAbits.UTXISEL0 && !hw_U2STAbits.UTXISEL1) {
+            hw_IFS1bits.U2TXIF = 1;
+            tx_trigger = true;
+        }
+        if (line_started) {
+            gap_cycles += gap_pending;
+        }
+        gap_pending = 0;
+        line_started = true;
+    } else if (shift_left == 0) {
+        gap_pending++;
+    }
+    UpdateStatus();
+}
+
+void HwUart_Reset(void)
+{
+    hw_U2MODE.w = 0;
+    memset((void *)&hw_U2STAbits, 0, sizeof(hw_U2STAbits));
+    hw_U2BRG = 0;
+    hw_U2RXREG = 0;
+    hw_U2TXREG = TX_IDLE;
+    hw_IFS1bits.U2TXIF = 0;
+    hw_IFS1bits.U2RXIF = 0;
+
+    fifo_head = 0;
+    fifo_count = 0;
+    shift_left = 0;
+    tx_trigger = false;
+    line_started = false;
+    line_head = 0;
+    line_count = 0;
+    overruns = 0;
+    gap_cycles = 0;
+    gap_pending = 0;
+    UpdateStatus();
+    Hw_Attach(UartStep);
+}
+
+uint32_t HwUart_ByteCycles(void)
+{
+    uint32_t per_bit = (hw_U2MODE.bits.BRGH ? 4UL : 16UL) * ((uint32_t)hw_U2BRG + 1);
+
+    return UART_BITS_PER_BYTE * per_bit;
+}
+
+uint16_t HwUart_TakeLine(uint8_t *out, uint16_t max)
+{
+    uint16_t n = 0;
+
+    while (n < max && line_count > 0) {
+        out[n++] = line[line_head];
+        line_head = (uint16_t)((line_head + 1) % UART_LINE_SIZE);
+        line_count--;
+    }
+    if (line_count == 0 && shift_left == 0 && fifo_count == 0) {
+        line_started = false;       /* The next byte starts a new message */
+    }
+    return n;
+}
+
+bool HwUart_TakeTxTrigger(void)
+{
+    bool t = tx_trigger;
+
+    tx_trigger = false;
+    return t;
+}
+
+uint16_t HwUart_TxAddress(void)
+{
+    return (uint16_t)(uintptr_t)&hw_U2TXREG;
+}
+
+void HwUart_DmaWrite(uint8_t byte)
+{
+    Push(byte);
+    UpdateStatus();
+}
+
+uint32_t HwUart_Overruns(void)
+{
+    return overruns;
+}
+
+uint32_t HwUart_GapCycles(void)
+{
+    return gap_cycles;
+}
@@ -0,0 +1,69 @@
+/*
+ * File:   uart_model.h
+ * Author: ENCM 511
+ *
+ * Host Test UART2 Transmitter Model
+ *
+ * Description: The transmit half of UART2: a 4-deep TX FIFO in front of a
+ *              shift register that holds each byte for ten bit times at the
+ *              U2BRG/BRGH rate. With UTXISEL = 00 moving a byte from the
+ *              FIFO into the shift register is the TX event: it sets
+ *              U2TXIF and is the DMA trigger for CHSEL "UART2 transmit".
+ *              CTS is always asserted. Every byte that leaves the shift
+ *              register is captured as "the line".
+ *
+ * Created on Nov 2025
+ */
+
+#ifndef UART_MODEL_H
+#define UART_MODEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Power-on reset of the registers and the transmitter; attaches the model
+ */
+void HwUart_Reset(void);
+
+/**
+ * @brief Bus cycles one byte (start, 8 data, stop) takes at the current
+ *        baud rate
+ */
+uint32_t HwUart_ByteCycles(void);
+
+/**
+ * @brief Bytes sent on the line since the last call, oldest first
+ *
+ * @return Number copied to out (at most max); the rest stay for the next call
+ */
+uint16_t HwUart_TakeLine(uint8_t *out, uint16_t max);
+
+/**
+ * @brief Take a TX event for the DMA model (true once per event)
+ */
+bool HwUart_TakeTxTrigger(void);
+
+/**
+ * @brief Low 16 bits of the U2TXREG address, as DMADST0 holds it
+ */
+uint16_t HwUart_TxAddress(void);
+
+/**
+ * @brief Push one byte into the TX FIFO from the bus (DMA)
+ */
+void HwUart_DmaWrite(uint8_t byte);
+
+/**
+ * @brief Writes made while the TX FIFO was full (lost on the target)
+ */
+uint32_t HwUart_Overruns(void);
+
+/**
+ * @brief Bus cycles the shift register sat empty between two bytes of a
+ *        message; a message ends when HwUart_TakeLine() has taken all of
+ *        it and the transmitter is idle
+ */
+uint32_t HwUart_GapCycles(void);
+
+#endif /* UART_MODEL_H */
@@ -0,0 +1,631 @@
+/*
+ * File:   xc.h
+ * Author: ENCM 511
+ *
+ * Host Test Register Model
+ *
+ * Description: Stands in for the XC16 device header when application
+ *              modules are built on the host (tests/Makefile puts hw/
+ *              ahead of the system include path). Only the registers and
+ *              intrinsics the tested modules touch are modelled; anything
+ *              else fails to compile, which is the point.
+ *
+ * Peripherals:
+ *   - Registers are variables named hw_<REG>, reached through the usual
+ *     names by HW_REG(). Every access is one bus cycle: Hw_Step() first
+ *     advances each attached peripheral model (hw/<name>_model.c), so a polling
+ *     loop sees the hardware make progress, or not, as it would on the
+ *     target.
+ *
+ * CPU priority:
+ *   - SRbits.IPL is a plain variable. SET_AND_SAVE_CPU_IPL() and
+ *     RESTORE_CPU_IPL() behave as on the target, and lowering the IPL to 0
+ *     is an interrupt point: the test's interrupt hook runs there (see
+ *     tests/port/portmacro.h), just as a pending interrupt would be taken
+ *     the moment the CPU priority drops.
+ *
+ * Created on Nov 2025
+ */
+
+#ifndef HW_XC_H
+#define HW_XC_H
+
+#include <stdint.h>
+
+/*============================================================================
+ * CPU
+ *============================================================================*/
+
+typedef struct {
+    unsigned C:1;
+    unsigned Z:1;
+    unsigned OV:1;
+    unsigned N:1;
+    unsigned RA:1;
+    unsigned IPL:3;
+    unsigned DC:1;
+} SRBITS;
+
+extern volatile SRBITS SRbits;
+
+/**
+ * @brief Set the CPU priority; dropping it to 0 is an interrupt point
+ */
+void Hw_SetIpl(unsigned int ipl);
+
+#define SET_AND_SAVE_CPU_IPL(save_to, ipl) \
+    do { (save_to) = SRbits.IPL; SRbits.IPL = (ipl); } while (0)
+#define RESTORE_CPU_IPL(saved_to)   Hw_SetIpl(saved_to)
+#define SET_CPU_IPL(ipl)            Hw_SetIpl(ipl)
+
+#define Nop()
+#define ClrWdt()
+
+/*============================================================================
+ * BUS
+ *============================================================================*/
+
+typedef void (*HwModelStep_t)(void);
+
+/**
+ * @brief Advance every attached peripheral model by one bus cycle
+ */
+void Hw_Step(void);
+
+/**
+ * @brief Attach a peripheral model's step function (idempotent)
+ */
+void Hw_Attach(HwModelStep_t step);
+
+/**
+ * @brief Bus cycles so far
+ */
+uint32_t Hw_Cycles(void);
+
+/**
+ * @brief Let the bus run for a number of cycles while the CPU does nothing
+ *        modelled; pending interrupts are taken between cycles
+ */
+void Hw_Run(uint32_t cycles);
+
+/**
+ * @brief Cycles so far that were Hw_Run() cycles, not CPU accesses
+ */
+uint32_t Hw_RunCycles(void);
+
+/**
+ * @brief Attach the model that plays out Sleep(): it moves time on to the
+ *        first wake-up source and raises that source's flag
+ */
+void Hw_AttachSleep(HwModelStep_t sleep);
+
+/**
+ * @brief Sleep(); fails the test when no attached model can wake the CPU
+ */
+void Hw_Sleep(void);
+
+#define Sleep()         Hw_Sleep()
+
+#define HW_REG(reg)     (*(Hw_Step(), &(reg)))
+
+/*============================================================================
+ * INTERRUPT FLAGS
+ *============================================================================*/
+
+typedef struct {
+    unsigned :3;
+    unsigned T1IF:1;
+    unsigned DMA0IF:1;
+    unsigned :8;
+    unsigned AD1IF:1;
+    unsigned :2;
+} IFS0BITS;
+
+typedef struct {
+    unsigned :3;
+    unsigned T1IE:1;
+    unsigned DMA0IE:1;
+    unsigned :8;
+    unsigned AD1IE:1;
+    unsigned :2;
+} IEC0BITS;
+
+typedef struct {
+    unsigned :14;
+    unsigned U2RXIF:1;
+    unsigned U2TXIF:1;
+} IFS1BITS;
+
+typedef struct {
+    unsigned :14;
+    unsigned U2RXIE:1;
+    unsigned U2TXIE:1;
+} IEC1BITS;
+
+typedef struct {
+    unsigned :8;
+    unsigned DMA0IP:3;
+    unsigned :5;
+} IPC1BITS;
+
+typedef struct {
+    unsigned :4;
+    unsigned AD1IP:3;
+    unsigned :9;
+} IPC3BITS;
+
+typedef struct {
+    unsigned :8;
+    unsigned U2RXIP:3;
+    unsigned :1;
+    unsigned U2TXIP:3;
+    unsigned :1;
+} IPC7BITS;
+
+typedef struct {
+    unsigned :14;
+    unsigned RTCIF:1;
+    unsigned :1;
+} IFS3BITS;
+
+typedef struct {
+    unsigned :14;
+    unsigned RTCIE:1;
+    unsigned :1;
+} IEC3BITS;
+
+typedef struct {
+    unsigned :3;
+    unsigned CRCIF:1;
+    unsigned :12;
+} IFS4BITS;
+
+typedef struct {
+    unsigned :3;
+    unsigned CRCIE:1;
+    unsigned :12;
+} IEC4BITS;
+
+typedef struct {
+    unsigned :8;
+    unsigned RTCIP:3;
+    unsigned :5;
+} IPC15BITS;
+
+extern volatile IFS0BITS hw_IFS0bits;
+extern volatile IEC0BITS hw_IEC0bits;
+extern volatile IFS1BITS hw_IFS1bits;
+extern volatile IEC1BITS hw_IEC1bits;
+extern volatile IPC1BITS hw_IPC1bits;
+extern volatile IPC3BITS hw_IPC3bits;
+extern volatile IPC7BITS hw_IPC7bits;
+extern volatile IFS3BITS hw_IFS3bits;
+extern volatile IEC3BITS hw_IEC3bits;
+extern volatile IFS4BITS hw_IFS4bits;
+extern volatile IEC4BITS hw_IEC4bits;
+extern volatile IPC15BITS hw_IPC15bits;
+
+#define IFS0bits        HW_REG(hw_IFS0bits)
+#define IEC0bits        HW_REG(hw_IEC0bits)
+#define IFS1bits        HW_REG(hw_IFS1bits)
+#define IEC1bits        HW_REG(hw_IEC1bits)
+#define IPC1bits        HW_REG(hw_IPC1bits)
+#define IPC3bits        HW_REG(hw_IPC3bits)
+#define IPC7bits        HW_REG(hw_IPC7bits)
+#define IFS3bits        HW_REG(hw_IFS3bits)
+#define IEC3bits        HW_REG(hw_IEC3bits)
+#define IFS4bits        HW_REG(hw_IFS4bits)
+#define IEC4bits        HW_REG(hw_IEC4bits)
+#define IPC15bits       HW_REG(hw_IPC15bits)
+
+/*============================================================================
+ * TIMERS
+ *============================================================================*/
+
+typedef union {
+    uint16_t w;
+    struct {
+        unsigned :1;
+        unsigned TCS:1;
+        unsigned :1;
+        unsigned T32:1;
+        unsigned TCKPS:2;
+        unsigned TGATE:1;
+        unsigned :8;
+        unsigned TON:1;
+    } bits;
+} HW_TxCON_t;
+
+extern volatile HW_TxCON_t hw_T1CON;
+extern volatile uint16_t hw_TMR1;
+extern volatile HW_TxCON_t hw_T3CON;
+extern volatile uint16_t hw_TMR3, hw_PR3;
+
+#define T1CON           HW_REG(hw_T1CON.w)
+#define T1CONbits       HW_REG(hw_T1CON.bits)
+#define TMR1            HW_REG(hw_TMR1)
+#define T3CON           HW_REG(hw_T3CON.w)
+#define T3CONbits       HW_REG(hw_T3CON.bits)
+#define TMR3            HW_REG(hw_TMR3)
+#define PR3             HW_REG(hw_PR3)
+
+/*============================================================================
+ * PORTA
+ *============================================================================*/
+
+typedef struct {
+    unsigned ANSA0:1;
+    unsigned ANSA1:1;
+    unsigned ANSA2:1;
+    unsigned ANSA3:1;
+    unsigned ANSA4:1;
+    unsigned :11;
+} ANSABITS;
+
+typedef struct {
+    unsigned TRISA0:1;
+    unsigned TRISA1:1;
+    unsigned TRISA2:1;
+    unsigned TRISA3:1;
+    unsigned TRISA4:1;
+    unsigned :11;
+} TRISABITS;
+
+extern volatile ANSABITS hw_ANSAbits;
+extern volatile TRISABITS hw_TRISAbits;
+
+#define ANSAbits        HW_REG(hw_ANSAbits)
+#define TRISAbits       HW_REG(hw_TRISAbits)
+
+/*============================================================================
+ * PORTB
+ *============================================================================*/
+
+extern volatile uint16_t hw_LATB;
+
+/* Each use of LATB is counted: a masked word update is a read and a write */
+volatile uint16_t *HwPort_LatB(void);
+
+/**
+ * @brief LATB accesses so far
+ */
+uint32_t HwPort_LatBAccesses(void);
+
+#define LATB            (*(Hw_Step(), HwPort_LatB()))
+
+/* Pin configuration, for the UART's RTS and CTS pins */
+typedef struct {
+    unsigned :12;
+    unsigned ANSB12:1;
+    unsigned ANSB13:1;
+    unsigned :2;
+} ANSELBBITS;
+
+typedef struct {
+    unsigned :12;
+    unsigned TRISB12:1;
+    unsigned TRISB13:1;
+    unsigned :2;
+} TRISBBITS;
+
+typedef struct {
+    unsigned :13;
+    unsigned CNPDB13:1;
+    unsigned :2;
+} CNPDBBITS;
+
+extern volatile ANSELBBITS hw_ANSELBbits;
+extern volatile TRISBBITS hw_TRISBbits;
+extern volatile CNPDBBITS hw_CNPDBbits;
+
+#define ANSELBbits      HW_REG(hw_ANSELBbits)
+#define TRISBbits       HW_REG(hw_TRISBbits)
+#define CNPDBbits       HW_REG(hw_CNPDBbits)
+
+/*============================================================================
+ * PERIPHERAL PIN SELECT
+ *============================================================================*/
+
+typedef struct {
+    unsigned U2RXR:6;
+    unsigned :2;
+    unsigned U2CTSR:6;
+    unsigned :2;
+} RPINR19BITS;
+
+extern volatile RPINR19BITS hw_RPINR19bits;
+extern volatile uint8_t hw_RPnR[32];        /* RPORx fields by pin */
+
+#define RPINR19bits     HW_REG(hw_RPINR19bits)
+#define _RP10R          HW_REG(hw_RPnR[10])
+#define _RP12R          HW_REG(hw_RPnR[12])
+
+/*============================================================================
+ * ADC AND CTMU (hw/adc_model.c)
+ *============================================================================*/
+
+#define HW_ADC_BUFFERS  26
+
+typedef union {
+    uint16_t w;
+    struct {
+        unsigned DONE:1;
+        unsigned SAMP:1;
+        unsigned ASAM:1;
+        unsigned :1;
+        unsigned SSRC:4;
+        unsigned FORM:2;
+        unsigned MODE12:1;
+        unsigned :2;
+        unsigned ADSIDL:1;
+        unsigned :1;
+        unsigned ADON:1;
+    } bits;
+} HW_AD1CON1_t;
+
+typedef union {
+    uint16_t w;
+    struct {
+        unsigned ALTS:1;
+        unsigned BUFM:1;
+        unsigned SMPI:5;
+        unsigned BUFS:1;
+        unsigned :2;
+        unsigned CSCNA:1;
+        unsigned BUFREGEN:1;
+        unsigned :1;
+        unsigned PVCFG:2;
+        unsigned NVCFG0:1;
+    } bits;
+} HW_AD1CON2_t;
+
+typedef struct {
+    unsigned ADCS:8;
+    unsigned SAMC:5;
+    unsigned :2;
+    unsigned ADRC:1;
+} AD1CON3BITS;
+
+typedef struct {
+    unsigned CH0SA:5;
+    unsigned CH0NA:3;
+    unsigned :8;
+} AD1CHSBITS;
+
+typedef struct {
+    unsigned IRNG:2;
+    unsigned :13;
+    unsigned CTMUEN:1;
+} CTMUCON1LBITS;
+
+extern volatile HW_AD1CON1_t hw_AD1CON1;
+extern volatile HW_AD1CON2_t hw_AD1CON2;
+extern volatile AD1CON3BITS hw_AD1CON3bits;
+extern volatile AD1CHSBITS hw_AD1CHSbits;
+extern volatile uint16_t hw_AD1CSSL, hw_AD1CSSH;
+extern volatile uint16_t hw_ADC1BUF[HW_ADC_BUFFERS];
+extern volatile CTMUCON1LBITS hw_CTMUCON1Lbits;
+
+#define AD1CON1         HW_REG(hw_AD1CON1.w)
+#define AD1CON1bits     HW_REG(hw_AD1CON1.bits)
+#define AD1CON2         HW_REG(hw_AD1CON2.w)
+#define AD1CON2bits     HW_REG(hw_AD1CON2.bits)
+#define AD1CON3bits     HW_REG(hw_AD1CON3bits)
+#define AD1CHSbits      HW_REG(hw_AD1CHSbits)
+#define AD1CSSL         HW_REG(hw_AD1CSSL)
+#define AD1CSSH         HW_REG(hw_AD1CSSH)
+#define ADC1BUF0        HW_REG(hw_ADC1BUF[0])
+#define CTMUCON1Lbits   HW_REG(hw_CTMUCON1Lbits)
+
+/*============================================================================
+ * UART2 (hw/uart_model.c)
+ *============================================================================*/
+
+typedef union {
+    uint16_t w;
+    struct {
+        unsigned STSEL:1;
+        unsigned PDSEL:2;
+        unsigned BRGH:1;
+        unsigned URXINV:1;
+        unsigned ABAUD:1;
+        unsigned LPBACK:1;
+        unsigned WAKE:1;
+        unsigned UEN:2;
+        unsigned :1;
+        unsigned RTSMD:1;
+        unsigned IREN:1;
+        unsigned USIDL:1;
+        unsigned :1;
+        unsigned UARTEN:1;
+    } bits;
+} HW_UxMODE_t;
+
+typedef struct {
+    unsigned URXDA:1;
+    unsigned OERR:1;
+    unsigned FERR:1;
+    unsigned PERR:1;
+    unsigned RIDLE:1;
+    unsigned ADDEN:1;
+    unsigned URXISEL:2;
+    unsigned TRMT:1;
+    unsigned UTXBF:1;
+    unsigned UTXEN:1;
+    unsigned UTXBRK:1;
+    unsigned URXEN:1;
+    unsigned UTXISEL0:1;
+    unsigned UTXINV:1;
+    unsigned UTXISEL1:1;
+} UxSTABITS;
+
+extern volatile HW_UxMODE_t hw_U2MODE;
+extern volatile UxSTABITS hw_U2STAbits;
+extern volatile uint16_t hw_U2BRG;
+extern volatile uint16_t hw_U2RXREG;
+
+/* Between writes the model keeps a value no byte write can leave in
+ * U2TXREG, so taking its address (for DMADST0) is not a write */
+extern volatile uint16_t hw_U2TXREG;
+
+#define U2MODE          HW_REG(hw_U2MODE.w)
+#define U2MODEbits      HW_REG(hw_U2MODE.bits)
+#define U2STAbits       HW_REG(hw_U2STAbits)
+#define U2BRG           HW_REG(hw_U2BRG)
+#define U2RXREG         HW_REG(hw_U2RXREG)
+#define U2TXREG         HW_REG(hw_U2TXREG)
+
+/*============================================================================
+ * DMA (hw/dma_model.c)
+ *============================================================================*/
+
+typedef struct {
+    unsigned PRSSEL:1;
+    unsigned :14;
+    unsigned DMAEN:1;
+} DMACONBITS;
+
+typedef union {
+    uint16_t w;
+    struct {
+        unsigned CHEN:1;
+        unsigned SIZE:1;
+        unsigned TRMODE:2;
+        unsigned DAMODE:2;
+        unsigned SAMODE:2;
+        unsigned CHREQ:1;
+        unsigned RELOAD:1;
+        unsigned NULLW:1;
+        unsigned :5;
+    } bits;
+} HW_DMACHn_t;
+
+typedef union {
+    uint16_t w;
+    struct {
+        unsigned HALFEN:1;
+        unsigned :1;
+        unsigned DONEIF:1;
+        unsigned HALFIF:1;
+        unsigned LOWIF:1;
+        unsigned HIGHIF:1;
+        unsigned OVRUNIF:1;
+        unsigned DBUFWF:1;
+        unsigned CHSEL:7;
+        unsigned :1;
+    } bits;
+} HW_DMAINTn_t;
+
+extern volatile DMACONBITS hw_DMACONbits;
+extern volatile uint16_t hw_DMAL, hw_DMAH;
+extern volatile HW_DMACHn_t hw_DMACH0;
+extern volatile HW_DMAINTn_t hw_DMAINT0;
+extern volatile uint16_t hw_DMASRC0, hw_DMADST0, hw_DMACNT0;
+
+#define DMACONbits      HW_REG(hw_DMACONbits)
+#define DMAL            HW_REG(hw_DMAL)
+#define DMAH            HW_REG(hw_DMAH)
+#define DMACH0          HW_REG(hw_DMACH0.w)
+#define DMACH0bits      HW_REG(hw_DMACH0.bits)
+#define DMAINT0         HW_REG(hw_DMAINT0.w)
+#define DMAINT0bits     HW_REG(hw_DMAINT0.bits)
+#define DMASRC0         HW_REG(hw_DMASRC0)
+#define DMADST0         HW_REG(hw_DMADST0)
+#define DMACNT0         HW_REG(hw_DMACNT0)
+
+/*============================================================================
+ * CRC (hw/crc_model.c)
+ *============================================================================*/
+
+typedef union {
+    uint16_t w;
+    struct {
+        unsigned :3;
+        unsigned LENDIAN:1;
+        unsigned CRCGO:1;
+        unsigned CRCISEL:1;
+        unsigned CRCMPT:1;
+        unsigned CRCFUL:1;
+        unsigned VWORD:5;
+        unsigned CRCSIDL:1;
+        unsigned :1;
+        unsigned CRCEN:1;
+    } bits;
+} HW_CRCCON1_t;
+
+typedef union {
+    uint16_t w;
+    struct {
+        unsigned PLEN:5;
+        unsigned :3;
+        unsigned DWIDTH:5;
+        unsigned :3;
+    } bits;
+} HW_CRCCON2_t;
+
+extern volatile HW_CRCCON1_t hw_CRCCON1;
+extern volatile HW_CRCCON2_t hw_CRCCON2;
+extern volatile uint16_t hw_CRCXORL, hw_CRCXORH;
+extern volatile uint16_t hw_CRCWDATL, hw_CRCWDATH;
+
+/* Each access to CRCDATL is a FIFO write of CRCCON2bits.DWIDTH + 1 bits */
+volatile uint16_t *HwCrc_FifoWrite(void);
+
+#define CRCCON1         HW_REG(hw_CRCCON1.w)
+#define CRCCON1bits     HW_REG(hw_CRCCON1.bits)
+#define CRCCON2         HW_REG(hw_CRCCON2.w)
+#define CRCCON2bits     HW_REG(hw_CRCCON2.bits)
+#define CRCXORL         HW_REG(hw_CRCXORL)
+#define CRCXORH         HW_REG(hw_CRCXORH)
+#define CRCWDATL        HW_REG(hw_CRCWDATL)
+#define CRCWDATH        HW_REG(hw_CRCWDATH)
+#define CRCDATL         (*(Hw_Step(), HwCrc_FifoWrite()))
+
+/*============================================================================
+ * RTCC (hw/rtcc_model.c)
+ *============================================================================*/
+
+typedef struct {
+    unsigned :11;
+    unsigned WRLOCK:1;
+    unsigned :3;
+    unsigned RTCEN:1;
+} RTCCON1LBITS;
+
+typedef union {
+    uint16_t w;
+    struct {
+        unsigned ALMRPT:8;
+        unsigned AMASK:4;
+        unsigned :2;
+        unsigned CHIME:1;
+        unsigned ALRMEN:1;
+    } bits;
+} HW_RTCCON1H_t;
+
+typedef union {
+    uint16_t w;
+    struct {
+        unsigned CLKSEL:2;
+        unsigned :2;
+        unsigned PS:2;
+        unsigned :10;
+    } bits;
+} HW_RTCCON2L_t;
+
+extern volatile RTCCON1LBITS hw_RTCCON1Lbits;
+extern volatile HW_RTCCON1H_t hw_RTCCON1H;
+extern volatile HW_RTCCON2L_t hw_RTCCON2L;
+extern volatile uint16_t hw_RTCCON2H;
+
+#define RTCCON1Lbits    HW_REG(hw_RTCCON1Lbits)
+#define RTCCON1H        HW_REG(hw_RTCCON1H.w)
+#define RTCCON1Hbits    HW_REG(hw_RTCCON1H.bits)
+#define RTCCON2L        HW_REG(hw_RTCCON2L.w)
+#define RTCCON2Lbits    HW_REG(hw_RTCCON2L.bits)
+#define RTCCON2H        HW_REG(hw_RTCCON2H)
+
+/* The unlock sequence; on the host it only clears WRLOCK */
+#define __builtin_write_RTCC_WRLOCK()   (RTCCON1Lbits.WRLOCK = 0)
+
+#endif /* HW_XC_H */
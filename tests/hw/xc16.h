@@ -0,0 +1,39 @@
+/*
+ * File:   xc16.h
+ * Author: ENCM 511
+ *
+ * Host Test XC16 Language Extensions
+ *
+ * Description: Gives the XC16 keywords and attributes the application
+ *              uses a meaning on the host. tests/Makefile includes it
+ *              ahead of every source, as the compiler provides them.
+ *
+ * Program space:
+ *   - __prog__ data is ordinary memory. It is volatile because flash can
+ *     change under the code (hw/nvm_model.c programs it), so a read must
+ *     not be folded into the zeros of a noload array.
+ *   - Arrays placed with address() land in the "hw_flash" section; the
+ *     NVM model finds all of them through __start_hw_flash and
+ *     __stop_hw_flash, in whatever order the linker put them.
+ *
+ * Interrupts:
+ *   - ISRs keep their _<name>Interrupt names and become ordinary
+ *     functions; a test calls one where the target would vector to it,
+ *     usually from the interrupt hook.
+ *
+ * Created on Nov 2025
+ */
+
+#ifndef HW_XC16_H
+#define HW_XC16_H
+
+#define __prog__        volatile
+
+#define space(s)        aligned(2)
+#define address(a)      section("hw_flash")
+#define noload          used
+
+#define interrupt       used
+#define no_auto_psv     used
+
+#endif /* HW_XC16_H */
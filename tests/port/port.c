@@ -0,0 +1,195 @@
+/*
+ * File:   port.c
+ * Author: ENCM 511
+ *
+ * Host Test Port - Implementation
+ *
+ * Description: Each task gets a ucontext and its own host stack; the
+ *              pointer to them is the only thing kept on the FreeRTOS
+ *              stack, so the TCB's pxTopOfStack leads straight to it.
+ *              The tick is driven by the idle hook: whenever every test
+ *              task is blocked, one tick passes. A run that stays idle
+ *              for PORT_IDLE_TICK_LIMIT ticks without a task switch is a
+ *              deadlock and fails.
+ *
+ * Created on Nov 2025
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <ucontext.h>
+
+#define PORT_TASK_STACK_BYTES   ( 64U * 1024U )
+#define PORT_IDLE_TICK_LIMIT    60000UL
+
+typedef struct {
+    ucontext_t ctx;
+    TaskFunction_t code;
+    void *params;
+    unsigned long critical_nesting;     /* Saved across a switch, as on the PIC24 */
+} PortTask_t;
+
+volatile unsigned long ulPortYieldCount = 0;
+volatile unsigned long ulPortCriticalNesting = 0;
+
+static ucontext_t port_main_ctx;
+static unsigned long port_idle_ticks = 0;
+static PortInterruptHook_t port_interrupt_hook = NULL;
+static BaseType_t port_in_isr = pdFALSE;
+static BaseType_t port_yield_pending = pdFALSE;   /* portYIELD_FROM_ISR() in a hook */
+
+/*============================================================================
+ * STATIC HELPER FUNCTIONS
+ *============================================================================*/
+
+static PortTask_t *CurrentTask(void)
+{
+    TaskHandle_t handle = xTaskGetCurrentTaskHandle();
+
+    /* pxTopOfStack is the first TCB member */
+    return (PortTask_t *)**(StackType_t **)handle;
+}
+
+static void TaskEntry(void)
+{
+    PortTask_t *task = CurrentTask();
+
+    task->code(task->params);
+
+    fprintf(stderr, "port: task function returned\n");
+    exit(1);
+}
+
+/*============================================================================
+ * PORT LAYER
+ *============================================================================*/
+
+StackType_t *pxPortInitialiseStack(StackType_t *pxTopOfStack,
+                                   TaskFunction_t pxCode,
+                                   void *pvParameters)
+{
+    PortTask_t *task = calloc(1, sizeof(*task));
+    void *stack = malloc(PORT_TASK_STACK_BYTES);
+
+    if (task == NULL || stack == NULL) {
+        fprintf(stderr, "port: out of host memory\n");
+        exit(1);
+    }
+
+    getcontext(&task->ctx);
+    task->ctx.uc_stack.ss_sp = stack;
+    task->ctx.uc_stack.ss_size = PORT_TASK_STACK_BYTES;
+    task->ctx.uc_link = NULL;
+    task->code = pxCode;
+    task->params = pvParameters;
+    makecontext(&task->ctx, TaskEntry, 0);
+
+    *pxTopOfStack = (StackType_t)task;
+    return pxTopOfStack;
+}
+
+BaseType_t xPortStartScheduler(void)
+{
+    /* vTaskStartScheduler() disabled interrupts; the first task starts enabled */
+    ulPortCriticalNesting = 0;
+    swapcontext(&port_main_ctx, &CurrentTask()->ctx);
+    return pdFALSE;
+}
+
+void vPortEndScheduler(void)
+{
+    swapcontext(&CurrentTask()->ctx, &port_main_ctx);
+}
+
+void vPortYield(void)
+{
+    PortTask_t *from = CurrentTask();
+    PortTask_t *to;
+
+    ulPortYieldCount++;
+    vTaskSwitchContext();
+    to = CurrentTask();
+    if (to != from) {
+        port_idle_ticks = 0;
+        from->critical_nesting = ulPortCriticalNesting;
+        ulPortCriticalNesting = to->critical_nesting;
+        swapcontext(&from->ctx, &to->ctx);
+    }
+}
+
+void vPortEnterCritical(void)
+{
+    ulPortCriticalNesting++;
+}
+
+void vPortExitCritical(void)
+{
+    if (--ulPortCriticalNesting == 0) {
+        vPortInterruptPoint(portINTERRUPT_AT_CRITICAL_EXIT);
+    }
+}
+
+/*============================================================================
+ * SIMULATED INTERRUPTS
+ *============================================================================*/
+
+void vPortSetInterruptHook(PortInterruptHook_t hook)
+{
+    port_interrupt_hook = hook;
+}
+
+void vPortInterruptPoint(PortInterruptPoint_t where)
+{
+    BaseType_t switch_task;
+
+    if (port_interrupt_hook == NULL || port_in_isr != pdFALSE ||
+        ulPortCriticalNesting != 0 ||
+        xTaskGetSchedulerState() != taskSCHEDULER_RUNNING) {
+        return;
+    }
+
+    port_in_isr = pdTRUE;
+    switch_task = port_interrupt_hook(where);
+    port_in_isr = pdFALSE;
+
+    if (switch_task != pdFALSE || port_yield_pending != pdFALSE) {
+        port_yield_pending = pdFALSE;
+        vPortYield();
+    }
+}
+
+BaseType_t xPortInIsr(void)
+{
+    return port_in_isr;
+}
+
+void vPortYieldFromIsr(void)
+{
+    if (port_in_isr != pdFALSE) {
+        port_yield_pending = pdTRUE;
+    } else {
+        vPortYield();
+    }
+}
+
+/*============================================================================
+ * TICK SOURCE
+ *============================================================================*/
+
+void vApplicationIdleHook(void)
+{
+    BaseType_t switch_task;
+
+    if (++port_idle_ticks > PORT_IDLE_TICK_LIMIT) {
+        fprintf(stderr, "port: every task blocked for %lu ticks\n", PORT_IDLE_TICK_LIMIT);
+        exit(1);
+    }
+
+    switch_task = xTaskIncrementTick();
+    vPortInterruptPoint(portINTERRUPT_AT_TICK);
+    if (switch_task != pdFALSE) {
+        vPortYield();
+    }
+}
@@ -0,0 +1,95 @@
+/*
+ * File:   portmacro.h
+ * Author: ENCM 511
+ *
+ * Host Test Port - Definitions
+ *
+ * Description: Runs the kernel on the build machine for the tests in
+ *              tests/. One simulated core: every task is a ucontext and a
+ *              context switch is a swapcontext() in vPortYield(). Time only
+ *              moves when the idle task runs (see port.c).
+ *
+ * Interrupts: nothing is asynchronous. A test installs an interrupt hook
+ *              (vPortSetInterruptHook()) and the port calls it at the
+ *              points where a real interrupt could be taken: when code
+ *              under test lowers the IPL back to 0 (tests/hw/xc.h), when
+ *              the last critical section is left, between the bus
+ *              cycles of Hw_Run() and right after each tick, where a test
+ *              can move its models on by one tick period. The hook runs
+ *              as an ISR;
+ *              if it returns pdTRUE the interrupted task is switched out,
+ *              as by portYIELD_FROM_ISR() or a tick preemption. An
+ *              application ISR the hook calls may use portYIELD_FROM_ISR()
+ *              itself; the switch then waits until the hook has returned.
+ *
+ * Created on Nov 2025
+ */
+
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#include <stdint.h>
+
+/* Same widths as the PIC24 port, except the stack slot: it holds a pointer */
+#define portCHAR        char
+#define portFLOAT       float
+#define portDOUBLE      double
+#define portLONG        long
+#define portSHORT       short
+#define portSTACK_TYPE  uintptr_t
+#define portBASE_TYPE   short
+#define portPOINTER_SIZE_TYPE uintptr_t
+
+typedef portSTACK_TYPE StackType_t;
+typedef short BaseType_t;
+typedef unsigned short UBaseType_t;
+
+#if ( configTICK_TYPE_WIDTH_IN_BITS == TICK_TYPE_WIDTH_16_BITS )
+    typedef uint16_t TickType_t;
+    #define portMAX_DELAY ( TickType_t ) 0xffff
+    #define portTICK_TYPE_IS_ATOMIC 1
+#else
+    #error The host port mirrors the target: 16-bit ticks only.
+#endif
+
+#define portBYTE_ALIGNMENT          8
+#define portSTACK_GROWTH            ( -1 )
+#define portTICK_PERIOD_MS          ( ( TickType_t ) 1000 / configTICK_RATE_HZ )
+
+/* Interrupts are only taken at vPortInterruptPoint(), which checks these */
+extern volatile unsigned long ulPortCriticalNesting;
+extern void vPortEnterCritical( void );
+extern void vPortExitCritical( void );
+#define portDISABLE_INTERRUPTS()    ( ulPortCriticalNesting++ )
+#define portENABLE_INTERRUPTS()     ( ulPortCriticalNesting = 0 )
+#define portENTER_CRITICAL()        vPortEnterCritical()
+#define portEXIT_CRITICAL()         vPortExitCritical()
+
+extern void vPortYield( void );
+#define portYIELD()                 vPortYield()
+#define portYIELD_FROM_ISR( x )     do { if( ( x ) != pdFALSE ) { vPortYieldFromIsr(); } } while( 0 )
+#define portEND_SWITCHING_ISR( x )  portYIELD_FROM_ISR( x )
+
+#define portTASK_FUNCTION_PROTO( vFunction, pvParameters ) void vFunction( void *pvParameters )
+#define portTASK_FUNCTION( vFunction, pvParameters ) void vFunction( void *pvParameters )
+
+#define portNOP()
+
+/* portYIELD() calls so far, whether or not they switched (port.c) */
+extern volatile unsigned long ulPortYieldCount;
+
+/* Simulated interrupts (see the description above) */
+typedef enum {
+    portINTERRUPT_AT_CRITICAL_EXIT,     /* Last taskEXIT_CRITICAL() */
+    portINTERRUPT_AT_IPL_RESTORE,       /* IPL lowered to 0 (hw/xc.h) */
+    portINTERRUPT_AT_BUS_CYCLE,         /* Between Hw_Run() cycles (hw/xc.h) */
+    portINTERRUPT_AT_TICK               /* After a tick (port.c) */
+} PortInterruptPoint_t;
+
+typedef BaseType_t ( *PortInterruptHook_t )( PortInterruptPoint_t where );
+extern void vPortSetInterruptHook( PortInterruptHook_t hook );
+extern void vPortInterruptPoint( PortInterruptPoint_t where );
+extern BaseType_t xPortInIsr( void );
+extern void vPortYieldFromIsr( void );
+
+#endif /* PORTMACRO_H */
@@ -0,0 +1,508 @@
+/*
+ * File:   test_adc.c
+ * Author: ENCM 511
+ *
+ * ADC Background Scan Tests (adc.c)
+ *
+ * Description: init_ADC() and _ADC1Interrupt() against the ADC model in
+ *              hw/adc_model.c. The test plays Timer3 (HwAdc_Scan()) and
+ *              the CPU: the interrupt hook vectors to the ISR when AD1IF
+ *              is pending and the IPL drops. Checked: the registers
+ *              init_ADC() sets up, that slot i of a vector holds list
+ *              entry i, the sequence numbers and timestamps, a scan taken
+ *              during ADC_GetScan() not tearing the copy, the pot
+ *              aggregators, the pot window's interrupts and task wakes per
+ *              second for a still, noisy, turning and sweeping pot, the
+ *              AVdd conversion, the scan blocks handed to a consumer
+ *              through a ping-pong buffer, and the ISR cost per scan and
+ *              per sample.
+ *
+ *              The Makefile builds this file four times: test_adc with the
+ *              scan list of hw_config.h, and test_adc_1ch, test_adc_4ch
+ *              and test_adc_8ch with the lists in hw/adc_scan.h.
+ *
+ * Created on Nov 2025
+ */
+
+#include "testing.h"
+#include "adc.h"
+#include "appcfg.h"
+#include "hw/adc_model.h"
+#include "hw/nvm_model.h"
+#include <string.h>
+#include <math.h>
+
+#define COST_SCANS      2000
+#define T3_PRESCALE     64
+#define SCANS_PER_SEC   (1000 / ADC_SCAN_PERIOD_MS)
+#define BLOCK_SCANS     4
+#define BLOCK_BIT       0x40UL
+
+void _ADC1Interrupt(void);
+
+static const uint8_t scan_list[ADC_SCAN_COUNT] = ADC_SCAN_LIST;
+
+static uint32_t isr_calls;
+static uint64_t isr_cycles;
+static uint32_t pot_wakes;
+
+/*============================================================================
+ * HELPERS
+ *============================================================================*/
+
+/* CPU: take the ADC interrupt if it is pending and above the IPL */
+static BaseType_t AdcVector(PortInterruptPoint_t where)
+{
+    uint64_t t0;
+
+    (void)where;
+    if (!HwAdc_Pending() || hw_IPC3bits.AD1IP <= SRbits.IPL) {
+        return pdFALSE;
+    }
+    t0 = Test_Cycles();
+    _ADC1Interrupt();
+    isr_cycles += Test_Cycles() - t0;
+    isr_calls++;
+    return pdFALSE;
+}
+
+/* Above the test task, as vAdcTask: counts the times it is woken */
+static void PotWatcher(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for (;;) {
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        pot_wakes++;
+    }
+}
+
+/* Input level for list entry i in a given round, distinct per entry */
+static uint16_t Level(uint8_t i, uint16_t round)
+{
+    return (uint16_t)((100 + 50 * i + round) % (ADC_MAX_VALUE + 1));
+}
+
+static void SetInputs(uint16_t round)
+{
+    for (uint8_t i = 0; i < ADC_SCAN_COUNT; i++) {
+        HwAdc_SetInput(scan_list[i], Level(i, round));
+    }
+}
+
+/* One full scan, then the IPL drops as it would after any task's critical
+ * section, so the interrupt is taken */
+static void Scan(void)
+{
+    TEST_CHECK(HwAdc_Scan());
+    SET_CPU_IPL(0);
+}
+
+static bool VectorIs(const AdcScanVector_t *scan, uint16_t round)
+{
+    for (uint8_t i = 0; i < ADC_SCAN_COUNT; i++) {
+        if (scan->value[i] != Level(i, round)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*============================================================================
+ * TEST CASES
+ *============================================================================*/
+
+static void TestSetup(void)
+{
+    uint16_t cssl = 0;
+    uint16_t cssh = 0;
+    double conversions;
+
+    Test_Case("init_ADC: scan list, one interrupt per scan, Timer3 period");
+
+    for (uint8_t i = 0; i < ADC_SCAN_COUNT; i++) {
+        if (scan_list[i] < 16) {
+            cssl |= (uint16_t)(1U << scan_list[i]);
+        } else {
+            cssh |= (uint16_t)(1U << (scan_list[i] - 16));
+        }
+        /* The sequencer converts in channel order; slot i must be entry i */
+        TEST_CHECK(i == 0 || scan_list[i] > scan_list[i - 1]);
+    }
+    TEST_CHECK(ADC_SCAN_POT_INDEX < ADC_SCAN_COUNT && scan_list[ADC_SCAN_POT_INDEX] == ADC_POT_CHANNEL);
+    TEST_CHECK(ADC_SCAN_VBG_INDEX < ADC_SCAN_COUNT && ADC_SCAN_TEMP_INDEX < ADC_SCAN_COUNT);
+
+    TEST_CHECK(hw_AD1CSSL == cssl && hw_AD1CSSH == cssh);
+    TEST_CHECK(hw_AD1CON2.bits.CSCNA == 1);
+    TEST_CHECK(hw_AD1CON2.bits.SMPI == ADC_SCAN_COUNT - 1);
+    TEST_CHECK(hw_AD1CON1.bits.ADON == 1 && hw_AD1CON1.bits.ASAM == 1);
+    TEST_CHECK(hw_AD1CON1.bits.MODE12 == 0);
+    TEST_CHECK(hw_IEC0bits.AD1IE == 1 && hw_IFS0bits.AD1IF == 0);
+    TEST_CHECK(hw_IPC3bits.AD1IP == configKERNEL_INTERRUPT_PRIORITY);
+    TEST_CHECK(hw_T3CON.bits.TON == 1 && hw_T3CON.bits.TCKPS == 0b10);
+    TEST_CHECK(hw_CTMUCON1Lbits.CTMUEN == 1);
+
+    /* One Timer3 period per conversion, ADC_SCAN_COUNT per scan period */
+    conversions = HwAdc_ConversionsPerSecond();
+    TEST_CHECK(conversions == (double)configCPU_CLOCK_HZ / T3_PRESCALE / (hw_PR3 + 1));
+    TEST_CHECK(fabs(ADC_SCAN_COUNT * 1000.0 / conversions - ADC_SCAN_PERIOD_MS) <
+               ADC_SCAN_PERIOD_MS * 0.02);
+    Test_Note("%u-channel scan: PR3 %u, %.0f conversions/s, %.1f scans (interrupts)/s",
+              ADC_SCAN_COUNT, hw_PR3, conversions, conversions / ADC_SCAN_COUNT);
+}
+
+static void TestBeforeFirstScan(void)
+{
+    AdcScanVector_t scan;
+
+    Test_Case("no scan yet: ADC_GetScan false, do_ADC 0");
+
+    memset(&scan, 0xA5, sizeof(scan));
+    TEST_CHECK(!ADC_GetScan(&scan));
+    TEST_CHECK(scan.sequence == 0xA5A5);        /* Left alone */
+    TEST_CHECK(do_ADC() == 0);
+
+    /* Less than a scan: no interrupt */
+    SetInputs(0);
+    HwAdc_TimerMatch();
+    SET_CPU_IPL(0);
+    TEST_CHECK(ADC_SCAN_COUNT == 1 || !ADC_GetScan(&scan));
+    TEST_CHECK(ADC_SCAN_COUNT == 1 || isr_calls == 0);
+}
+
+static void TestVectors(void)
+{
+    AdcScanVector_t scan;
+    uint16_t first;
+
+    Test_Case("each scan: one interrupt, list order, sequence, timestamp");
+
+    Scan();                         /* Finishes the partial scan above */
+    TEST_CHECK(ADC_GetScan(&scan));
+    first = scan.sequence + 1;
+
+    for (uint16_t round = 1; round <= 20; round++) {
+        uint32_t calls = isr_calls;
+        uint32_t conversions = HwAdc_Conversions();
+
+        vTaskDelay(pdMS_TO_TICKS(ADC_SCAN_PERIOD_MS));
+        SetInputs(round);
+        Scan();
+        TEST_CHECK(isr_calls == calls + 1);
+        TEST_CHECK(HwAdc_Conversions() - conversions == ADC_SCAN_COUNT);
+
+        TEST_CHECK(ADC_GetScan(&scan));
+        TEST_CHECK(VectorIs(&scan, round));
+        TEST_CHECK(scan.sequence == (uint16_t)(first + round - 1));
+        TEST_CHECK(scan.timestamp == xTaskGetTickCount());
+        TEST_CHECK(do_ADC() == Level(ADC_SCAN_POT_INDEX, round));
+    }
+}
+
+static void TestMissedInterrupt(void)
+{
+    AdcScanVector_t before;
+    AdcScanVector_t scan;
+    uint16_t saved_ipl;
+    uint32_t calls = isr_calls;
+
+    Test_Case("interrupt held off for two scans: the newer one is kept");
+
+    TEST_CHECK(ADC_GetScan(&before));
+    SET_AND_SAVE_CPU_IPL(saved_ipl, 7);
+    SetInputs(30);
+    TEST_CHECK(HwAdc_Scan());
+    SetInputs(31);
+    TEST_CHECK(HwAdc_Scan());
+    RESTORE_CPU_IPL(saved_ipl);
+
+    TEST_CHECK(isr_calls == calls + 1);
+    TEST_CHECK(ADC_GetScan(&scan));
+    TEST_CHECK(VectorIs(&scan, 31));
+    TEST_CHECK(scan.sequence == (uint16_t)(before.sequence + 1));
+}
+
+static void TestCopyNotTorn(void)
+{
+    AdcScanVector_t before;
+    AdcScanVector_t scan;
+
+    Test_Case("scan finishing during ADC_GetScan: copy is whole, then the new one");
+
+    TEST_CHECK(ADC_GetScan(&before));
+    SetInputs(40);
+    TEST_CHECK(HwAdc_Scan());        /* Pending; taken at the IPL restore */
+
+    TEST_CHECK(ADC_GetScan(&scan));
+    TEST_CHECK(memcmp(&scan, &before, sizeof(scan)) == 0);
+    TEST_CHECK(!HwAdc_Pending());
+    TEST_CHECK(ADC_GetScan(&scan));
+    TEST_CHECK(VectorIs(&scan, 40));
+    TEST_CHECK(scan.sequence == (uint16_t)(before.sequence + 1));
+}
+
+static void TestAggregators(void)
+{
+    static WinAgg_t aggs[3];
+    WinAggSummary_t summary;
+    uint16_t round;
+
+    Test_Case("pot aggregators: two accepted, fed every scan");
+
+    for (uint8_t i = 0; i < 3; i++) {
+        WinAgg_Init(&aggs[i], 100);
+    }
+    TEST_CHECK(ADC_PotAggregate(&aggs[0]));
+    TEST_CHECK(ADC_PotAggregate(&aggs[1]));
+    TEST_CHECK(!ADC_PotAggregate(&aggs[2]));
+
+    SetInputs(50);
+    for (round = 0; round < 25 && !WinAgg_Take(&aggs[0], &summary); round++) {
+        vTaskDelay(pdMS_TO_TICKS(ADC_SCAN_PERIOD_MS));
+        Scan();
+    }
+    TEST_CHECK(round < 25);
+    TEST_CHECK(summary.count == 100 / ADC_SCAN_PERIOD_MS);
+    TEST_CHECK(summary.mean == (int16_t)Level(ADC_SCAN_POT_INDEX, 50));
+    TEST_CHECK(summary.min == summary.max && summary.variance == 0);
+    TEST_CHECK(WinAgg_Take(&aggs[1], &summary));
+    TEST_CHECK(!WinAgg_Take(&aggs[2], &summary));
+}
+
+static void TestPotWatch(void)
+{
+    static const struct {
+        const char *name;
+        uint16_t start;
+        int16_t step;           /* Counts per scan */
+        uint8_t noise;          /* +/- counts */
+        uint32_t max_wakes;     /* Per second */
+    } motions[] = {
+        { "still",                512,  0, 0,                  0 },
+        { "still, noise +/-w/2",  512,  0, ADC_POT_WINDOW / 2, 0 },
+        { "slow turn",            200,  1, 1,                  SCANS_PER_SEC / ADC_POT_WINDOW },
+        { "full sweep in 1 s",      0, 10, 0,                  SCANS_PER_SEC }
+    };
+    TaskHandle_t watcher;
+    uint32_t seed = 1;
+
+    Test_Case("pot window: interrupts and task wakes per second");
+    Test_Note("window +/-%u counts, %u scans/s", ADC_POT_WINDOW, SCANS_PER_SEC);
+
+    TEST_CHECK(xTaskCreate(PotWatcher, "POT", configMINIMAL_STACK_SIZE, NULL,
+                           TEST_PRIO_HIGH, &watcher) == pdPASS);
+
+    for (uint8_t m = 0; m < sizeof(motions) / sizeof(motions[0]); m++) {
+        uint32_t calls;
+        uint32_t wakes;
+        int32_t level = motions[m].start;
+
+        /* The first scan after ADC_PotWatch() always reports */
+        HwAdc_SetInput(ADC_POT_CHANNEL, (uint16_t)level);
+        ADC_PotWatch(watcher, ADC_POT_WINDOW);
+        wakes = pot_wakes;
+        Scan();
+        TEST_CHECK(pot_wakes == wakes + 1);
+
+        calls = isr_calls;
+        wakes = pot_wakes;
+        for (uint16_t n = 0; n < SCANS_PER_SEC; n++) {
+            int32_t in = level;
+
+            if (motions[m].noise > 0) {
+                seed = seed * 1103515245UL + 12345UL;
+                in += (int32_t)((seed >> 16) % (2U * motions[m].noise + 1)) - motions[m].noise;
+            }
+            HwAdc_SetInput(ADC_POT_CHANNEL, (uint16_t)(in < 0 ? 0 : in));
+            Scan();
+            level += motions[m].step;
+        }
+        calls = isr_calls - calls;
+        wakes = pot_wakes - wakes;
+
+        /* The scan interrupt runs regardless; the window only saves wakes */
+        TEST_CHECK(calls == SCANS_PER_SEC);
+        TEST_CHECK(wakes <= motions[m].max_wakes);
+        TEST_CHECK(motions[m].step == 0 || wakes > 0);
+        Test_Note("%-20s %3lu interrupts/s, %3lu task wakes/s",
+                  motions[m].name, (unsigned long)calls, (unsigned long)wakes);
+    }
+
+    ADC_PotWatch(NULL, 0);
+    vTaskSuspend(watcher);          /* heap_1 cannot free a deleted task */
+}
+
+static void TestSupply(void)
+{
+    static const struct {
+        uint16_t vbg;
+        uint16_t mv;
+    } cases[] = {
+        { 372, 3300 }, { 409, 3001 }, { 491, 2500 }, { 1023, 1200 }, { 0, 0 }
+    };
+    AdcScanVector_t scan;
+
+    Test_Case("AVdd from the band gap reading");
+
+    memset(&scan, 0, sizeof(scan));
+    for (uint8_t k = 0; k < sizeof(cases) / sizeof(cases[0]); k++) {
+        scan.value[ADC_SCAN_VBG_INDEX] = cases[k].vbg;
+        TEST_CHECK(ADC_SupplyMillivolts(&scan) == cases[k].mv);
+    }
+    TEST_CHECK(ADC_SupplyMillivolts(&scan) < ADC_LOW_VDD_MV);
+
+#if ADC_SCAN_COUNT > 1
+    /* Through the converter: band gap at 3.3 V */
+    HwAdc_SetInput(ADC_CH_VBG, 372);
+    Scan();
+    TEST_CHECK(ADC_GetScan(&scan));
+    TEST_CHECK(ADC_SupplyMillivolts(&scan) == 3300);
+#endif
+}
+
+/* Scan rounds base + n for n in [from, from + BLOCK_SCANS), sequence
+ * numbers following first */
+static bool BlockIs(const AdcScanVector_t *block, uint16_t base, uint16_t from,
+                    uint16_t first)
+{
+    for (uint16_t i = 0; i < BLOCK_SCANS; i++) {
+        if (!VectorIs(&block[i], base + from + i) ||
+            block[i].sequence != (uint16_t)(first + from + i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void TestScanBlocks(void)
+{
+    static AdcScanVector_t storage[2 * BLOCK_SCANS];
+    static PingPong_t pp;
+    const AdcScanVector_t *block;
+    AdcScanVector_t scan;
+    uint32_t bits;
+    uint16_t first;
+    uint16_t len;
+    uint16_t n = 0;
+
+    Test_Case("scan blocks: every scan in order, one wake per block; "
+              "a held block costs whole blocks");
+
+    /* As the TLOG task: notified by a bit, receives without waiting */
+    PingPong_Init(&pp, (uint8_t *)storage, BLOCK_SCANS * sizeof(AdcScanVector_t),
+                  xTaskGetCurrentTaskHandle(), BLOCK_BIT);
+    (void)xTaskNotifyWait(0, 0xFFFFFFFFUL, &bits, 0);
+    TEST_CHECK(ADC_GetScan(&scan));
+    first = scan.sequence + 1;
+    ADC_ScanBlocks(&pp, BLOCK_SCANS);
+
+    for (; n < 3 * BLOCK_SCANS; n++) {
+        bool woken;
+
+        SetInputs(100 + n);
+        Scan();
+        bits = 0;
+        woken = xTaskNotifyWait(0, 0xFFFFFFFFUL, &bits, 0) == pdTRUE;
+        TEST_CHECK(woken == ((n + 1) % BLOCK_SCANS == 0));
+        block = (const AdcScanVector_t *)PingPong_Receive(&pp, &len, 0);
+        if (!woken) {
+            TEST_CHECK(block == NULL);
+            continue;
+        }
+        TEST_CHECK(bits == BLOCK_BIT);
+        TEST_CHECK(block != NULL && len == BLOCK_SCANS * sizeof(AdcScanVector_t));
+        TEST_CHECK(BlockIs(block, 100, n + 1 - BLOCK_SCANS, first));
+        PingPong_Release(&pp);
+    }
+    TEST_CHECK(PingPong_GetOverflows(&pp) == 0);
+
+    /* Held across two more blocks: the ISR refills its own half */
+    for (; n < 4 * BLOCK_SCANS; n++) {
+        SetInputs(100 + n);
+        Scan();
+    }
+    block = (const AdcScanVector_t *)PingPong_Receive(&pp, &len, 0);
+    TEST_CHECK(block != NULL);
+    for (; n < 6 * BLOCK_SCANS; n++) {
+        SetInputs(100 + n);
+        Scan();
+    }
+    TEST_CHECK(PingPong_GetOverflows(&pp) == 2);
+    TEST_CHECK(BlockIs(block, 100, 3 * BLOCK_SCANS, first));
+    PingPong_Release(&pp);
+    for (; n < 7 * BLOCK_SCANS; n++) {
+        SetInputs(100 + n);
+        Scan();
+    }
+    block = (const AdcScanVector_t *)PingPong_Receive(&pp, &len, 0);
+    TEST_CHECK(block != NULL && BlockIs(block, 100, 6 * BLOCK_SCANS, first));
+    PingPong_Release(&pp);
+
+    /* Stopped: no more blocks or wakes */
+    ADC_ScanBlocks(NULL, 0);
+    (void)xTaskNotifyWait(0, 0xFFFFFFFFUL, &bits, 0);
+    for (; n < 8 * BLOCK_SCANS; n++) {
+        SetInputs(100 + n);
+        Scan();
+    }
+    TEST_CHECK(xTaskNotifyWait(0, 0xFFFFFFFFUL, &bits, 0) == pdFALSE);
+    TEST_CHECK(PingPong_Receive(&pp, &len, 0) == NULL);
+}
+
+static void TestCost(void)
+{
+    uint32_t calls = isr_calls;
+    uint64_t cycles = isr_cycles;
+    uint32_t bus_isr = 0;
+
+    Test_Case("ISR cost per scan and per sample");
+
+    for (uint16_t n = 0; n < COST_SCANS; n++) {
+        uint32_t b;
+
+        SetInputs(n);
+        TEST_CHECK(HwAdc_Scan());
+        b = Hw_Cycles();
+        SET_CPU_IPL(0);
+        bus_isr += Hw_Cycles() - b;
+    }
+    calls = isr_calls - calls;
+    cycles = isr_cycles - cycles;
+
+    TEST_CHECK(calls == COST_SCANS);
+    Test_Note("%u-channel scan: %.0f host cycles per scan, %.0f per sample, "
+              "%.1f named register accesses per ISR",
+              ADC_SCAN_COUNT, (double)cycles / calls,
+              (double)cycles / calls / ADC_SCAN_COUNT, (double)bus_isr / calls);
+}
+
+static void RunTests(void *pvParameters)
+{
+    (void)pvParameters;
+
+    HwNvm_Reset();
+    HwNvm_PowerOn();
+    AppCfg_Init();
+    HwAdc_Reset();
+    init_ADC();
+    vPortSetInterruptHook(AdcVector);
+
+    TestSetup();
+    TestBeforeFirstScan();
+    TestVectors();
+    TestMissedInterrupt();
+    TestCopyNotTorn();
+    TestAggregators();
+    TestPotWatch();
+    TestSupply();
+    TestScanBlocks();
+    TestCost();
+
+    vPortSetInterruptHook(NULL);
+}
+
+int main(void)
+{
+    Test_Run(RunTests);
+    return 1;
+}
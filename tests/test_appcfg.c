@@ -0,0 +1,322 @@
+/*
+ * File:   test_appcfg.c
+ * Author: ENCM 511
+ *
+ * Flash Configuration Image Tests (appcfg.c)
+ *
+ * Description: appcfg.c runs against the flash model in hw/nvm_model.c,
+ *              whose flash is the two slot pages. Images are put into the
+ *              slots directly, then AppCfg_Init() must pick the valid one
+ *              with the newest sequence number. It must reject any image
+ *              with a bad bit or a setting out of range, and fall back to
+ *              the compiled-in defaults when neither slot is usable.
+ *              AppCfg_Write() is checked across slot alternation, a power
+ *              cut after every double word and worn-out flash.
+ *
+ * Created on Nov 2025
+ */
+
+#include "testing.h"
+#include "appcfg.h"
+#include "app.h"
+#include "hw_config.h"
+#include "crc.h"
+#include "nvm.h"
+#include "hw/nvm_model.h"
+#include <string.h>
+
+#define IMAGE_WORDS     (sizeof(AppConfigImage_t) / 2)
+
+static const AppConfig_t settings_a = { 50, 1000, 200, 20, 10, 16, 1, 0 };
+static const AppConfig_t settings_b = { 30, 800, 120, 50, 8, 32, 0, 1 };
+
+/*============================================================================
+ * HELPERS
+ *============================================================================*/
+
+static void MakeImage(AppConfigImage_t *img, const AppConfig_t *cfg, uint16_t seq)
+{
+    memset(img, 0, sizeof(*img));
+    img->magic = APPCFG_MAGIC;
+    img->version = APPCFG_VERSION;
+    img->length = sizeof(AppConfigImage_t);
+    img->sequence = seq;
+    img->cfg = *cfg;
+    img->crc = Crc16_Compute(img, sizeof(AppConfigImage_t) - 2);
+}
+
+/* Erase a slot and program an image into it, as tools/cfgimage.py would */
+static void PutSlot(uint8_t slot, const AppConfigImage_t *img)
+{
+    const volatile uint16_t *base = HwNvm_Base() + (uint32_t)slot * HWNVM_PAGE_WORDS;
+    const uint16_t *w = (const uint16_t *)img;
+
+    TEST_CHECK(Nvm_ErasePage(base));
+    for (uint16_t i = 0; i < IMAGE_WORDS; i += 2) {
+        TEST_CHECK(Nvm_ProgramDword(base + i, w[i], w[i + 1]));
+    }
+}
+
+static void PutSettings(uint8_t slot, const AppConfig_t *cfg, uint16_t seq)
+{
+    AppConfigImage_t img;
+
+    MakeImage(&img, cfg, seq);
+    PutSlot(slot, &img);
+}
+
+static bool SameSettings(const __prog__ AppConfig_t *active, const AppConfig_t *cfg)
+{
+    AppConfig_t copy = *active;
+
+    return memcmp(&copy, cfg, sizeof(copy)) == 0;
+}
+
+/* Reset: flash as it is, statics from AppCfg_Init() */
+static void Boot(void)
+{
+    HwNvm_PowerOn();
+    AppCfg_Init();
+}
+
+static bool UsesDefaults(void)
+{
+    const __prog__ AppConfig_t *cfg = AppCfg_Get();
+
+    return AppCfg_GetSlot() == APPCFG_SLOT_DEFAULTS &&
+           cfg->button_debounce_ms == BUTTON_DEBOUNCE_MS &&
+           cfg->button_long_press_ms == BUTTON_LONG_PRESS_MS &&
+           cfg->pwm_frequency_hz == PWM_FREQUENCY_HZ &&
+           cfg->adc_scan_period_ms == ADC_SCAN_PERIOD_MS &&
+           cfg->button_queue_size == BUTTON_QUEUE_SIZE &&
+           cfg->uart_rx_queue_size == UART_RX_QUEUE_SIZE &&
+           cfg->show_extended_info == DISPLAY_EXTENDED_INFO_DEFAULT &&
+           cfg->led2_solid_mode == DISPLAY_LED2_SOLID_DEFAULT;
+}
+
+/*============================================================================
+ * TEST CASES
+ *============================================================================*/
+
+static void TestBlank(void)
+{
+    Test_Case("blank slots: compiled-in defaults");
+
+    TEST_CHECK(HwNvm_Words() == (uint32_t)APPCFG_SLOTS * HWNVM_PAGE_WORDS);
+    TEST_CHECK(HWNVM_PAGE_WORDS == APPCFG_PAGE_SIZE / 2);
+    TEST_CHECK(IMAGE_WORDS % 2 == 0);
+
+    HwNvm_Reset();
+    Boot();
+    TEST_CHECK(UsesDefaults());
+}
+
+static void TestSlotSelection(void)
+{
+    static const struct {
+        uint16_t seq0;
+        uint16_t seq1;
+        uint8_t slot;
+    } pairs[] = {
+        { 5, 6, 1 }, { 6, 5, 0 },
+        { 0xFFFF, 0x0000, 1 },          /* Sequence wrap */
+        { 0x0001, 0xFFFE, 0 },
+        { 7, 7, 0 }                     /* Tie: slot 0 */
+    };
+
+    Test_Case("both slots valid: the newer sequence wins, across the wrap");
+
+    for (uint8_t k = 0; k < sizeof(pairs) / sizeof(pairs[0]); k++) {
+        HwNvm_Reset();
+        PutSettings(0, &settings_a, pairs[k].seq0);
+        PutSettings(1, &settings_b, pairs[k].seq1);
+        Boot();
+        TEST_CHECK(AppCfg_GetSlot() == pairs[k].slot);
+        TEST_CHECK(SameSettings(AppCfg_Get(), pairs[k].slot == 0 ? &settings_a : &settings_b));
+    }
+
+    /* One slot only */
+    HwNvm_Reset();
+    PutSettings(1, &settings_b, 3);
+    Boot();
+    TEST_CHECK(AppCfg_GetSlot() == 1 && SameSettings(AppCfg_Get(), &settings_b));
+    HwNvm_Reset();
+    PutSettings(0, &settings_a, 3);
+    Boot();
+    TEST_CHECK(AppCfg_GetSlot() == 0 && SameSettings(AppCfg_Get(), &settings_a));
+}
+
+static void TestCorruptImage(void)
+{
+    AppConfigImage_t good;
+    uint16_t rejected = 0;
+
+    Test_Case("any cleared bit in the newer image: the older slot is used");
+
+    MakeImage(&good, &settings_b, 9);
+    for (uint16_t i = 0; i < IMAGE_WORDS; i++) {
+        for (uint8_t bit = 0; bit < 16; bit++) {
+            AppConfigImage_t bad = good;
+            uint16_t *w = (uint16_t *)&bad;
+
+            /* Programming can only clear bits, so that is the damage */
+            if (!(w[i] & (1U << bit))) {
+                continue;
+            }
+            w[i] &= (uint16_t)~(1U << bit);
+
+            HwNvm_Reset();
+            PutSettings(0, &settings_a, 8);
+            PutSlot(1, &bad);
+            Boot();
+            TEST_CHECK(AppCfg_GetSlot() == 0);
+            TEST_CHECK(SameSettings(AppCfg_Get(), &settings_a));
+            rejected++;
+        }
+    }
+    Test_Note("%u damaged images rejected", rejected);
+}
+
+static void TestOutOfRange(void)
+{
+    AppConfig_t cfg;
+
+    Test_Case("valid CRC but a setting out of range: rejected");
+
+    for (uint8_t field = 0; field < 9; field++) {
+        cfg = settings_b;
+        switch (field) {
+        case 0: cfg.button_debounce_ms = APPCFG_DEBOUNCE_MAX + 1; break;
+        case 1: cfg.button_long_press_ms = APPCFG_LONG_PRESS_MIN - 1; break;
+        case 2: cfg.button_long_press_ms = cfg.button_debounce_ms; break;
+        case 3: cfg.pwm_frequency_hz = APPCFG_PWM_HZ_MIN - 1; break;
+        case 4: cfg.adc_scan_period_ms = APPCFG_ADC_MS_MAX + 1; break;
+        case 5: cfg.button_queue_size = APPCFG_BTN_QUEUE_MAX + 1; break;
+        case 6: cfg.uart_rx_queue_size = APPCFG_RX_QUEUE_MIN - 1; break;
+        case 7: cfg.show_extended_info = 2; break;
+        default: cfg.led2_solid_mode = 2; break;
+        }
+        HwNvm_Reset();
+        PutSettings(0, &settings_a, 1);
+        PutSettings(1, &cfg, 2);
+        Boot();
+        TEST_CHECK(AppCfg_GetSlot() == 0);
+    }
+}
+
+static void TestFallback(void)
+{
+    AppConfigImage_t img;
+
+    Test_Case("neither slot usable: compiled-in defaults");
+
+    HwNvm_Reset();
+    MakeImage(&img, &settings_a, 1);
+    img.crc &= 0xFFFE;
+    if (img.crc == Crc16_Compute(&img, sizeof(img) - 2)) {
+        img.crc &= 0xFFFD;
+    }
+    PutSlot(0, &img);
+    MakeImage(&img, &settings_b, 2);
+    img.version = APPCFG_VERSION + 1;
+    img.crc = Crc16_Compute(&img, sizeof(img) - 2);
+    PutSlot(1, &img);
+    Boot();
+    TEST_CHECK(UsesDefaults());
+}
+
+static void TestWrite(void)
+{
+    AppConfig_t bad = settings_b;
+    uint16_t ops;
+
+    Test_Case("AppCfg_Write alternates slots; the next boot agrees");
+
+    HwNvm_Reset();
+    Boot();
+    TEST_CHECK(AppCfg_Write(&settings_a));
+    TEST_CHECK(AppCfg_GetSlot() == 0 && SameSettings(AppCfg_Get(), &settings_a));
+    TEST_CHECK(AppCfg_Write(&settings_b));
+    TEST_CHECK(AppCfg_GetSlot() == 1 && SameSettings(AppCfg_Get(), &settings_b));
+    TEST_CHECK(AppCfg_Write(&settings_a));
+    TEST_CHECK(AppCfg_GetSlot() == 0 && SameSettings(AppCfg_Get(), &settings_a));
+
+    Boot();
+    TEST_CHECK(AppCfg_GetSlot() == 0 && SameSettings(AppCfg_Get(), &settings_a));
+    TEST_CHECK(HwNvm_Base()[3] == 3);                   /* Sequence */
+
+    /* Out of range: refused before the flash is touched */
+    bad.pwm_frequency_hz = APPCFG_PWM_HZ_MAX + 1;
+    HwNvm_PowerOn();
+    TEST_CHECK(!AppCfg_Write(&bad));
+    (void)HwNvm_Log(&ops);
+    TEST_CHECK(ops == 0);
+    TEST_CHECK(AppCfg_GetSlot() == 0);
+    TEST_CHECK(HwNvm_Reprograms() == 0);
+}
+
+static void TestWritePowerCut(void)
+{
+    uint32_t cut;
+
+    Test_Case("power cut after every double word of an update");
+
+    for (cut = 0; cut <= IMAGE_WORDS / 2; cut++) {
+        HwNvm_Reset();
+        PutSettings(0, &settings_a, 7);
+        PutSettings(1, &settings_a, 6);
+        Boot();
+        TEST_CHECK(AppCfg_GetSlot() == 0);
+
+        HwNvm_CutPowerAfter(cut);
+        (void)AppCfg_Write(&settings_b);
+
+        /* The old image stays in charge until the new one is complete */
+        Boot();
+        if (cut < IMAGE_WORDS / 2) {
+            TEST_CHECK(AppCfg_GetSlot() == 0 && SameSettings(AppCfg_Get(), &settings_a));
+        } else {
+            TEST_CHECK(AppCfg_GetSlot() == 1 && SameSettings(AppCfg_Get(), &settings_b));
+        }
+    }
+    Test_Note("%lu cut points", (unsigned long)cut);
+}
+
+static void TestWriteFails(void)
+{
+    Test_Case("write error: AppCfg_Write fails, the old settings stay");
+
+    for (uint32_t good_ops = 0; good_ops <= 1 + IMAGE_WORDS / 2; good_ops++) {
+        HwNvm_Reset();
+        PutSettings(0, &settings_a, 7);
+        Boot();
+
+        HwNvm_FailAfter(good_ops);
+        TEST_CHECK(AppCfg_Write(&settings_b) == (good_ops > IMAGE_WORDS / 2));
+        if (good_ops <= IMAGE_WORDS / 2) {
+            TEST_CHECK(AppCfg_GetSlot() == 0 && SameSettings(AppCfg_Get(), &settings_a));
+            Boot();
+            TEST_CHECK(AppCfg_GetSlot() == 0 && SameSettings(AppCfg_Get(), &settings_a));
+        }
+    }
+}
+
+static void RunTests(void *pvParameters)
+{
+    (void)pvParameters;
+
+    TestBlank();
+    TestSlotSelection();
+    TestCorruptImage();
+    TestOutOfRange();
+    TestFallback();
+    TestWrite();
+    TestWritePowerCut();
+    TestWriteFails();
+}
+
+int main(void)
+{
+    Test_Run(RunTests);
+    return 1;
+}
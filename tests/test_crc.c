@@ -0,0 +1,155 @@
+/*
+ * File:   test_crc.c
+ * Author: ENCM 511
+ *
+ * CRC-16 Table Path Tests (crc.c, CRC_USE_HARDWARE 0)
+ *
+ * Description: Check values, every way of splitting a stream into
+ *              updates, and agreement with a bit-at-a-time reference. The
+ *              benchmark compares the slice-by-2 tables with that
+ *              reference. The engine path is in test_crc_hw.c.
+ *
+ * Created on Nov 2025
+ */
+
+#include "testing.h"
+#include "crc.h"
+#include <string.h>
+
+#define BENCH_BYTES     1024
+#define BENCH_ROUNDS    200
+
+static uint8_t data[BENCH_BYTES];
+
+/* CRC-16/CCITT-FALSE one bit at a time, straight from the definition */
+static uint16_t Reference(const uint8_t *p, uint16_t len, uint16_t crc)
+{
+    while (len--) {
+        crc ^= (uint16_t)(*p++) << 8;
+        for (uint8_t i = 0; i < 8; i++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+static void FillData(void)
+{
+    uint32_t seed = 12345;
+
+    for (uint16_t i = 0; i < BENCH_BYTES; i++) {
+        seed = seed * 1103515245UL + 12345UL;
+        data[i] = (uint8_t)(seed >> 16);
+    }
+}
+
+static void TestCheckValues(void)
+{
+    uint8_t zeros[256] = { 0 };
+    uint8_t ramp[256];
+
+    Test_Case("check values");
+
+    for (uint16_t i = 0; i < sizeof(ramp); i++) {
+        ramp[i] = (uint8_t)i;
+    }
+    TEST_CHECK(Crc16_Compute("123456789", 9) == 0x29B1);
+    TEST_CHECK(Crc16_Compute("", 0) == CRC16_INIT);
+    TEST_CHECK(Crc16_Compute("A", 1) == 0xB915);
+    TEST_CHECK(Crc16_Compute(zeros, sizeof(zeros)) == 0x41E8);
+    TEST_CHECK(Crc16_Compute(ramp, sizeof(ramp)) == 0x3FBD);
+
+    Crc_Init();
+    TEST_CHECK(!Crc_HardwareActive());
+}
+
+static void TestSplits(void)
+{
+    const uint16_t len = 64;
+    const uint16_t whole = Crc16_Compute(data, len);
+
+    Test_Case("any split into updates gives the one-shot CRC");
+
+    for (uint16_t a = 0; a <= len; a++) {
+        for (uint16_t b = a; b <= len; b++) {
+            Crc16_t c;
+
+            Crc16_Init(&c);
+            Crc16_Update(&c, data, a);
+            Crc16_UpdateProg(&c, &data[a], (uint16_t)(b - a));
+            Crc16_Update(&c, &data[b], (uint16_t)(len - b));
+            if (Crc16_Final(&c) != whole) {
+                TEST_CHECK(Crc16_Final(&c) == whole);
+            }
+        }
+    }
+
+    /* A second Final returns the same value */
+    {
+        Crc16_t c;
+
+        Crc16_Init(&c);
+        Crc16_Update(&c, data, len);
+        TEST_CHECK(Crc16_Final(&c) == whole);
+        TEST_CHECK(Crc16_Final(&c) == whole);
+    }
+}
+
+static void TestAgainstReference(void)
+{
+    Test_Case("every length and alignment up to 300 bytes matches the reference");
+
+    for (uint16_t offset = 0; offset < 2; offset++) {
+        for (uint16_t len = 0; len <= 300; len++) {
+            if (Crc16_Compute(&data[offset], len) != Reference(&data[offset], len, CRC16_INIT)) {
+                TEST_CHECK(Crc16_Compute(&data[offset], len) ==
+                           Reference(&data[offset], len, CRC16_INIT));
+            }
+        }
+    }
+}
+
+static void BenchThroughput(void)
+{
+    uint64_t table = 0;
+    uint64_t bitwise = 0;
+    volatile uint16_t sink = 0;
+
+    Test_Case("benchmark: table path against the bitwise reference");
+
+    for (uint16_t r = 0; r < BENCH_ROUNDS; r++) {
+        uint64_t t0 = Test_Cycles();
+
+        sink ^= Crc16_Compute(data, BENCH_BYTES);
+        table += Test_Cycles() - t0;
+
+        t0 = Test_Cycles();
+        sink ^= Reference(data, BENCH_BYTES, CRC16_INIT);
+        bitwise += Test_Cycles() - t0;
+    }
+    TEST_CHECK(sink == 0);
+
+    Test_Note("slice-by-2: %.2f bytes/cycle (%.2f cycles/byte)",
+              (double)BENCH_BYTES * BENCH_ROUNDS / (double)table,
+              (double)table / ((double)BENCH_BYTES * BENCH_ROUNDS));
+    Test_Note("bitwise:    %.2f bytes/cycle (%.2f cycles/byte)",
+              (double)BENCH_BYTES * BENCH_ROUNDS / (double)bitwise,
+              (double)bitwise / ((double)BENCH_BYTES * BENCH_ROUNDS));
+}
+
+static void RunTests(void *pvParameters)
+{
+    (void)pvParameters;
+
+    FillData();
+    TestCheckValues();
+    TestSplits();
+    TestAgainstReference();
+    BenchThroughput();
+}
+
+int main(void)
+{
+    Test_Run(RunTests);
+    return 1;
+}
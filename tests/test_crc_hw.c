@@ -0,0 +1,242 @@
+/*
+ * File:   test_crc_hw.c
+ * Author: ENCM 511
+ *
+ * CRC-16 Engine Path Tests (crc.c against hw/crc_model.c)
+ *
+ * Description: The engine shifts one bit per bus cycle unless a case sets
+ *              another rate, so a long update outruns it and has to wait
+ *              on CRCFUL, as on the target. A rate of 0 is a stalled
+ *              engine: every wait must give up after CRC_HW_SPIN_LIMIT
+ *              polls and later streams must fall back to the tables.
+ *
+ * Created on Nov 2025
+ */
+
+#include "testing.h"
+#include "crc.h"
+#include "crc_model.h"
+#include <xc.h>
+#include <string.h>
+
+#define STREAM_BYTES    1024
+#define SPIN_LIMIT      1000        /* CRC_HW_SPIN_LIMIT in crc.c */
+
+static uint8_t data[STREAM_BYTES];
+
+static uint16_t Reference(const uint8_t *p, uint16_t len)
+{
+    uint16_t crc = CRC16_INIT;
+
+    while (len--) {
+        crc ^= (uint16_t)(*p++) << 8;
+        for (uint8_t i = 0; i < 8; i++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+static void FillData(void)
+{
+    uint32_t seed = 777;
+
+    for (uint16_t i = 0; i < STREAM_BYTES; i++) {
+        seed = seed * 1103515245UL + 12345UL;
+        data[i] = (uint8_t)(seed >> 16);
+    }
+}
+
+/* Fresh engine, configured and self-tested by Crc_Init() */
+static void BootEngine(void)
+{
+    HwCrc_Reset();
+    Crc_Init();
+    TEST_CHECK(Crc_HardwareActive());
+}
+
+static void TestSelfTest(void)
+{
+    Test_Case("Crc_Init() self-test passes on a working engine, fails on a stalled one");
+
+    BootEngine();
+    TEST_CHECK(HwCrc_BitsShifted() == 9 * 8 + 16);
+    TEST_CHECK(CRCCON1bits.CRCEN == 1);
+    TEST_CHECK(CRCCON2bits.PLEN == 15);
+
+    HwCrc_Reset();
+    HwCrc_SetShiftRate(0);
+    Crc_Init();
+    TEST_CHECK(!Crc_HardwareActive());
+    TEST_CHECK(CRCCON1bits.CRCEN == 0);
+
+    /* Streams still work, in software */
+    TEST_CHECK(Crc16_Compute(data, STREAM_BYTES) == Reference(data, STREAM_BYTES));
+}
+
+static void TestLongStream(void)
+{
+    uint32_t bits;
+
+    Test_Case("long stream waits on CRCFUL and matches the reference");
+
+    BootEngine();
+    bits = HwCrc_BitsShifted();
+    TEST_CHECK(Crc16_Compute(data, STREAM_BYTES) == Reference(data, STREAM_BYTES));
+    TEST_CHECK(HwCrc_BitsShifted() - bits == STREAM_BYTES * 8UL + 16);
+    TEST_CHECK(HwCrc_FullCycles() > 0);
+    TEST_CHECK(HwCrc_Overruns() == 0);
+    TEST_CHECK(Crc_HardwareActive());
+}
+
+static void TestChunkedStream(void)
+{
+    static const uint16_t chunks[] = { 16, 1, 7, 200, 2, 33, 15, 64 };
+    Crc16_t c;
+    uint16_t pos = 0;
+    uint32_t bits;
+
+    Test_Case("stream of mixed-size updates, last byte of each tracked by CRCIF");
+
+    BootEngine();
+    bits = HwCrc_BitsShifted();
+    Crc16_Init(&c);
+    for (uint8_t i = 0; i < sizeof(chunks) / sizeof(chunks[0]); i++) {
+        if (i % 2) {
+            Crc16_UpdateProg(&c, &data[pos], chunks[i]);
+        } else {
+            Crc16_Update(&c, &data[pos], chunks[i]);
+        }
+        pos = (uint16_t)(pos + chunks[i]);
+    }
+    TEST_CHECK(Crc16_Final(&c) == Reference(data, pos));
+    TEST_CHECK(HwCrc_BitsShifted() - bits == pos * 8UL + 16);
+    TEST_CHECK(HwCrc_Overruns() == 0);
+
+    /* Faster engines, including one that outruns the CPU */
+    for (uint8_t rate = 2; rate <= 16; rate *= 2) {
+        HwCrc_SetShiftRate(rate);
+        TEST_CHECK(Crc16_Compute(data, 500) == Reference(data, 500));
+    }
+}
+
+static void TestSoftwareFallbacks(void)
+{
+    Crc16_t a, b;
+    uint32_t bits;
+
+    Test_Case("short first update and a busy engine run in software");
+
+    BootEngine();
+    bits = HwCrc_BitsShifted();
+    TEST_CHECK(Crc16_Compute(data, CRC_HW_MIN_BYTES - 1) == Reference(data, CRC_HW_MIN_BYTES - 1));
+    TEST_CHECK(HwCrc_BitsShifted() == bits);
+
+    /* a owns the engine until its Final; b finds it busy */
+    Crc16_Init(&a);
+    Crc16_Init(&b);
+    Crc16_Update(&a, data, 100);
+    Crc16_Update(&b, &data[200], 100);
+    Crc16_Update(&a, &data[100], 50);
+    Crc16_Update(&b, &data[300], 50);
+    TEST_CHECK(Crc16_Final(&b) == Reference(&data[200], 150));
+    TEST_CHECK(Crc16_Final(&a) == Reference(data, 150));
+    TEST_CHECK(HwCrc_BitsShifted() - bits == 150 * 8UL + 16);
+
+    /* Released by a's Final: the next long stream gets the engine */
+    bits = HwCrc_BitsShifted();
+    TEST_CHECK(Crc16_Compute(data, 40) == Reference(data, 40));
+    TEST_CHECK(HwCrc_BitsShifted() - bits == 40 * 8UL + 16);
+}
+
+static void TestStallInUpdate(void)
+{
+    Crc16_t c;
+    uint32_t cycles;
+
+    Test_Case("engine stalls mid-update: bounded wait, stream lost, tables take over");
+
+    BootEngine();
+    Crc16_Init(&c);
+    Crc16_Update(&c, data, 32);
+    HwCrc_SetShiftRate(0);
+
+    cycles = Hw_Cycles();
+    Crc16_Update(&c, &data[32], 200);
+    cycles = Hw_Cycles() - cycles;
+
+    /* The FIFO fills, then one CRCFUL poll per spin until the limit */
+    TEST_CHECK(cycles >= SPIN_LIMIT);
+    TEST_CHECK(cycles < SPIN_LIMIT + 3 * 32);
+    TEST_CHECK(!Crc_HardwareActive());
+    TEST_CHECK(CRCCON1bits.CRCEN == 0);
+
+    /* Further updates are ignored and the CRC will not verify */
+    Crc16_Update(&c, &data[232], 10);
+    TEST_CHECK(Crc16_Final(&c) == CRC16_INIT);
+
+    /* Later streams are correct, and never touch the engine */
+    cycles = Hw_Cycles();
+    TEST_CHECK(Crc16_Compute(data, STREAM_BYTES) == Reference(data, STREAM_BYTES));
+    TEST_CHECK(Hw_Cycles() == cycles);
+}
+
+static void TestStallInFinal(void)
+{
+    Crc16_t c;
+    uint32_t cycles;
+
+    Test_Case("engine stalls before the result: Final gives up after the spin limit");
+
+    BootEngine();
+    Crc16_Init(&c);
+    Crc16_Update(&c, data, 64);
+    HwCrc_SetShiftRate(0);
+
+    cycles = Hw_Cycles();
+    TEST_CHECK(Crc16_Final(&c) == CRC16_INIT);
+    cycles = Hw_Cycles() - cycles;
+    TEST_CHECK(cycles >= SPIN_LIMIT);
+    TEST_CHECK(cycles < 3 * SPIN_LIMIT);
+    TEST_CHECK(!Crc_HardwareActive());
+
+    /* The engine is released: nothing is left claimed */
+    TEST_CHECK(Crc16_Compute(data, 100) == Reference(data, 100));
+}
+
+static void BenchBusCycles(void)
+{
+    Test_Case("benchmark: bus cycles per byte on the engine path");
+
+    for (uint8_t rate = 1; rate <= 16; rate *= 2) {
+        uint32_t cycles;
+
+        BootEngine();
+        HwCrc_SetShiftRate(rate);
+        cycles = Hw_Cycles();
+        (void)Crc16_Compute(data, STREAM_BYTES);
+        cycles = Hw_Cycles() - cycles;
+        Test_Note("engine %2u bit/cycle: %.2f register accesses per byte, %lu cycles on CRCFUL",
+                  rate, (double)cycles / STREAM_BYTES, (unsigned long)HwCrc_FullCycles());
+    }
+}
+
+static void RunTests(void *pvParameters)
+{
+    (void)pvParameters;
+
+    FillData();
+    TestSelfTest();
+    TestLongStream();
+    TestChunkedStream();
+    TestSoftwareFallbacks();
+    TestStallInUpdate();
+    TestStallInFinal();
+    BenchBusCycles();
+}
+
+int main(void)
+{
+    Test_Run(RunTests);
+    return 1;
+}
@@ -0,0 +1,611 @@
+/*
+ * File:   test_deltapack.c
+ * Author: ENCM 511
+ *
+ * Delta/Varint Packer and Telemetry Stream Tests (deltapack.c,
+ * telemstream.c)
+ *
+ * Description: Synthetic pot and countdown traces in the 's' stream
+ *              layout (ticks, pot, temp, vbg, duty, state) are packed and
+ *              decoded again by a C mirror of tools/deltapack.py; the
+ *              samples must come back exactly. The same traces go through
+ *              telemstream.c as "@tz" lines, which are decoded by the C
+ *              mirror and, if python3 is available, by tools/deltapack.py
+ *              itself.
+ *
+ * Created on Nov 2025
+ */
+
+#include "testing.h"
+#include "deltapack.h"
+#include "telemstream.h"
+#include "logbuf.h"
+#include "app.h"
+#include "hw_config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FIELDS          TELEM_STREAM_FIELDS
+#define TRACE_SAMPLES   2000
+#define LINE_OVERHEAD   8           /* "@tz k " prefix and CRLF per block line */
+#define CAPTURE_BYTES   (64 * 1024)
+
+typedef struct {
+    const char *name;
+    int16_t s[TRACE_SAMPLES][FIELDS];
+} Trace_t;
+
+/* Mirror of tools/deltapack.py Unpacker */
+typedef struct {
+    int16_t prev[DELTAPACK_MAX_FIELDS];
+    uint8_t fields;
+    uint32_t values;                /* Decoded so far, across blocks */
+} Unpacker_t;
+
+static Trace_t pot_trace;
+static Trace_t countdown_trace;
+static int16_t decoded[TRACE_SAMPLES + 1][FIELDS];
+
+static char capture[CAPTURE_BYTES];
+static volatile uint32_t capture_len = 0;
+
+static uint32_t seed = 1;
+
+/*============================================================================
+ * HELPERS
+ *============================================================================*/
+
+static int32_t Random(int32_t span)
+{
+    seed = seed * 1103515245UL + 12345UL;
+    return (int32_t)((seed >> 16) % (uint32_t)span);
+}
+
+/* Pot turned now and then during a countdown: long still stretches, slow
+ * ramps with a count of ADC noise, duty following the pot */
+static void MakePotTrace(Trace_t *t)
+{
+    int16_t pot = 512;
+    int16_t target = 512;
+
+    t->name = "pot";
+    for (uint16_t i = 0; i < TRACE_SAMPLES; i++) {
+        int16_t *s = t->s[i];
+
+        if (Random(200) == 0) {
+            target = (int16_t)Random(1024);
+        }
+        if (pot < target) {
+            pot = (int16_t)(pot + 1 + Random(12));
+        } else if (pot > target) {
+            pot = (int16_t)(pot - 1 - Random(12));
+        }
+        s[0] = (int16_t)(i * 50 + 12000);               /* Wraps past 32767 */
+        s[1] = (int16_t)(pot + ((pot != target) ? Random(3) - 1 : 0));
+        s[2] = (int16_t)(610 + (Random(40) == 0));
+        s[3] = (int16_t)(372 - (Random(25) == 0));
+        s[4] = (int16_t)((int32_t)s[1] * 100 / 1023);
+        s[5] = STATE_COUNTDOWN;
+    }
+}
+
+/* A full run: waiting, time entry, a countdown with a pause, completion */
+static void MakeCountdownTrace(Trace_t *t)
+{
+    t->name = "countdown";
+
+    for (uint16_t i = 0; i < TRACE_SAMPLES; i++) {
+        int16_t *s = t->s[i];
+        int16_t state;
+
+        if (i < 200) {
+            state = STATE_WAITING;
+        } else if (i < 400) {
+            state = STATE_TIME_INPUT;
+        } else if (i < 450) {
+            state = STATE_READY;
+        } else if (i >= 1100 && i < 1300) {
+            state = STATE_PAUSED;
+        } else if (i < 1900) {
+            state = STATE_COUNTDOWN;
+        } else {
+            state = STATE_COMPLETED;
+        }
+        s[0] = (int16_t)(i * 50);
+        s[1] = 300;
+        s[2] = (int16_t)(600 + i / 400);
+        s[3] = 372;
+        s[4] = (state == STATE_WAITING) ? (int16_t)((i * 5) % 100) : 29;
+        s[5] = state;
+    }
+}
+
+static void UnpackerReset(Unpacker_t *u)
+{
+    memset(u->prev, 0, sizeof(u->prev));
+}
+
+static void UnpackerInit(Unpacker_t *u, uint8_t fields)
+{
+    u->fields = fields;
+    u->values = 0;
+    UnpackerReset(u);
+}
+
+static void Emit(Unpacker_t *u, int16_t value, int16_t (*out)[FIELDS], uint32_t max)
+{
+    uint32_t n = u->values++;
+
+    TEST_CHECK(n / u->fields < max);
+    out[n / u->fields][n % u->fields] = value;
+}
+
+/* Decode one block; the block must end on a sample boundary */
+static void UnpackerDecode(Unpacker_t *u, const uint8_t *data, uint16_t len,
+                           int16_t (*out)[FIELDS], uint32_t max)
+{
+    uint16_t pos = 0;
+
+    while (pos < len) {
+        uint32_t token = 0;
+        uint8_t shift = 0;
+        uint8_t byte;
+
+        do {
+            TEST_CHECK(pos < len);
+            TEST_CHECK(shift <= 14);                /* At most 3 bytes */
+            byte = data[pos++];
+            token |= (uint32_t)(byte & 0x7F) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+
+        if (token & 1) {
+            for (uint32_t r = token >> 1; r > 0; r--) {
+                Emit(u, u->prev[u->values % u->fields], out, max);
+            }
+        } else {
+            uint16_t zigzag = (uint16_t)(token >> 1);
+            int16_t delta = (int16_t)((zigzag >> 1) ^ (uint16_t)-(int16_t)(zigzag & 1));
+            uint8_t i = (uint8_t)(u->values % u->fields);
+
+            u->prev[i] = (int16_t)((uint16_t)u->prev[i] + (uint16_t)delta);
+            Emit(u, u->prev[i], out, max);
+        }
+    }
+    TEST_CHECK(u->values % u->fields == 0);
+}
+
+static int Base64Value(char c)
+{
+    const char *alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    const char *p = strchr(alphabet, c);
+
+    return (c != '\0' && p != NULL) ? (int)(p - alphabet) : -1;
+}
+
+static uint16_t Base64Decode(const char *in, uint16_t len, uint8_t *out)
+{
+    uint16_t n = 0;
+
+    TEST_CHECK(len % 4 == 0);
+    for (uint16_t i = 0; i < len; i += 4) {
+        uint32_t group = 0;
+        uint8_t pad = 0;
+
+        for (uint8_t k = 0; k < 4; k++) {
+            int v = Base64Value(in[i + k]);
+
+            if (in[i + k] == '=') {
+                pad++;
+                v = 0;
+            }
+            TEST_CHECK(v >= 0);
+            group = group << 6 | (uint32_t)v;
+        }
+        out[n++] = (uint8_t)(group >> 16);
+        if (pad < 2) {
+            out[n++] = (uint8_t)(group >> 8);
+        }
+        if (pad < 1) {
+            out[n++] = (uint8_t)group;
+        }
+    }
+    return n;
+}
+
+/* Log consumer: keeps every line the stream sends */
+static void CaptureTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for (;;) {
+        uint16_t n;
+
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        while ((n = LogBuf_Read((uint8_t *)&capture[capture_len],
+                                (uint16_t)(CAPTURE_BYTES - 1 - capture_len))) > 0) {
+            capture_len += n;
+        }
+    }
+}
+
+static bool SameSamples(const int16_t (*a)[FIELDS], const int16_t (*b)[FIELDS], uint32_t count)
+{
+    return memcmp(a, b, count * sizeof(a[0])) == 0;
+}
+
+/*============================================================================
+ * TEST CASES
+ *============================================================================*/
+
+static void TestBase64(void)
+{
+    static const struct { const char *in; const char *out; } vectors[] = {
+        { "", "" }, { "f", "Zg==" }, { "fo", "Zm8=" }, { "foo", "Zm9v" },
+        { "foob", "Zm9vYg==" }, { "fooba", "Zm9vYmE=" }, { "foobar", "Zm9vYmFy" }
+    };
+    char out[16];
+
+    Test_Case("base64 matches the RFC 4648 test vectors");
+
+    for (uint8_t i = 0; i < sizeof(vectors) / sizeof(vectors[0]); i++) {
+        uint16_t n = DeltaPack_Base64((const uint8_t *)vectors[i].in,
+                                      (uint16_t)strlen(vectors[i].in), out);
+
+        TEST_CHECK(n == strlen(vectors[i].out));
+        TEST_CHECK(memcmp(out, vectors[i].out, n) == 0);
+    }
+}
+
+static void TestTokens(void)
+{
+    DeltaPack_t s;
+    Unpacker_t u;
+    uint8_t out[DELTAPACK_MAX_SAMPLE_BYTES(DELTAPACK_MAX_FIELDS)];
+    int16_t sample[1];
+    int16_t back[4][FIELDS];
+    uint8_t n;
+
+    Test_Case("token encoding: small deltas, +/-32768, runs");
+
+    DeltaPack_Init(&s, 1);
+
+    /* -32..+31 is one byte */
+    sample[0] = 31;
+    TEST_CHECK(DeltaPack_Encode(&s, sample, out) == 1 && out[0] == (62 << 1));
+    sample[0] = -1;
+    TEST_CHECK(DeltaPack_Encode(&s, sample, out) == 1 && out[0] == (63 << 1));
+    sample[0] = 31;
+    TEST_CHECK(DeltaPack_Encode(&s, sample, out) == 2);         /* +32 */
+
+    /* -32768 from 0, then +32768 wraps to -32768 again: 3 bytes each */
+    DeltaPack_Reset(&s);
+    sample[0] = -32768;
+    TEST_CHECK(DeltaPack_Encode(&s, sample, out) == 3);
+    TEST_CHECK(out[0] == 0xFE && out[1] == 0xFF && out[2] == 0x07);     /* zigzag 0xFFFF << 1 */
+    sample[0] = 0;
+    TEST_CHECK(DeltaPack_Encode(&s, sample, out) == 3);
+    sample[0] = 32767;
+    n = DeltaPack_Encode(&s, sample, out);
+    TEST_CHECK(n == 3 && out[0] == 0xFC && out[1] == 0xFF && out[2] == 0x07);
+
+    /* Round trip of the extremes, one field */
+    {
+        static const int16_t seq[4] = { -32768, 32767, -32768, 0 };
+        uint8_t block[4 * 3 + 3];
+        uint16_t len = 0;
+
+        DeltaPack_Reset(&s);
+        UnpackerInit(&u, 1);
+        for (uint8_t i = 0; i < 4; i++) {
+            sample[0] = seq[i];
+            len += DeltaPack_Encode(&s, sample, &block[len]);
+        }
+        len += DeltaPack_Flush(&s, &block[len]);
+        UnpackerDecode(&u, block, len, back, 4);
+        TEST_CHECK(u.values == 4);
+        for (uint8_t i = 0; i < 4; i++) {
+            TEST_CHECK(back[i][0] == seq[i]);
+        }
+    }
+
+    /* Unchanged samples write nothing until the flush */
+    DeltaPack_Reset(&s);
+    sample[0] = 0;
+    TEST_CHECK(DeltaPack_Encode(&s, sample, out) == 0);
+    TEST_CHECK(DeltaPack_Encode(&s, sample, out) == 0);
+    TEST_CHECK(DeltaPack_Flush(&s, out) == 1 && out[0] == (2 << 1 | 1));
+    TEST_CHECK(DeltaPack_Flush(&s, out) == 0);
+}
+
+static void TestMaxRun(void)
+{
+    static int16_t back[40000][FIELDS];
+    DeltaPack_t s;
+    Unpacker_t u;
+    uint8_t block[16];
+    uint16_t len = 0;
+    int16_t sample[1] = { 0 };
+
+    Test_Case("a run of DELTAPACK_MAX_RUN unchanged fields is split");
+
+    /* 0x7FFF zeros from the reset state, then 7233 more, then a change */
+    DeltaPack_Init(&s, 1);
+    for (uint32_t i = 0; i < 40000; i++) {
+        uint8_t n = DeltaPack_Encode(&s, sample, &block[len]);
+
+        if (i == 0x7FFE) {
+            TEST_CHECK(n == 3);
+            TEST_CHECK(block[len] == 0xFF && block[len + 1] == 0xFF && block[len + 2] == 0x03);
+        } else if (n != 0) {
+            TEST_CHECK(n == 0);
+        }
+        len += n;
+    }
+    sample[0] = 5;
+    len += DeltaPack_Encode(&s, sample, &block[len]);
+    len += DeltaPack_Flush(&s, &block[len]);
+    TEST_CHECK(len == 3 + 2 + 1);          /* Max run, run of 7233, delta */
+
+    UnpackerInit(&u, 1);
+    UnpackerDecode(&u, block, len, back, 40001);
+    TEST_CHECK(u.values == 40001);
+    TEST_CHECK(back[39999][0] == 0);
+}
+
+static void TestWorstCaseBytes(void)
+{
+    int16_t sample[DELTAPACK_MAX_FIELDS];
+    uint8_t out[DELTAPACK_MAX_SAMPLE_BYTES(DELTAPACK_MAX_FIELDS) + 8];
+    uint8_t most = 0;
+
+    Test_Case("DELTAPACK_MAX_SAMPLE_BYTES bounds every sample and is reached");
+
+    for (uint8_t fields = 1; fields <= DELTAPACK_MAX_FIELDS; fields++) {
+        DeltaPack_t s;
+        uint8_t n;
+
+        /* A pending run long enough for a 3-byte token, then every field
+         * jumps by -32768: the worst case exactly */
+        DeltaPack_Init(&s, fields);
+        memset(sample, 0, sizeof(sample));
+        for (uint16_t i = 0; i < 8192 / fields + 1; i++) {
+            TEST_CHECK(DeltaPack_Encode(&s, sample, out) == 0);
+        }
+        for (uint8_t f = 0; f < fields; f++) {
+            sample[f] = -32768;
+        }
+        n = DeltaPack_Encode(&s, sample, out);
+        TEST_CHECK(n == DELTAPACK_MAX_SAMPLE_BYTES(fields));
+
+        /* Random mixes of runs and big deltas never go past it */
+        for (uint16_t i = 0; i < 20000; i++) {
+            for (uint8_t f = 0; f < fields; f++) {
+                if (Random(3) == 0) {
+                    sample[f] = (int16_t)(sample[f] + (Random(2) ? 32768 : Random(65536)));
+                }
+            }
+            n = DeltaPack_Encode(&s, sample, out);
+            if (n > most) {
+                most = n;
+            }
+            if (n > DELTAPACK_MAX_SAMPLE_BYTES(fields)) {
+                TEST_CHECK(n <= DELTAPACK_MAX_SAMPLE_BYTES(fields));
+            }
+        }
+    }
+    Test_Note("largest random sample: %u bytes for %u fields", most, DELTAPACK_MAX_FIELDS);
+}
+
+/* Pack a trace in firmware-sized blocks, decode it, report the ratio */
+static void RoundTrip(const Trace_t *t)
+{
+    DeltaPack_t s;
+    Unpacker_t u;
+    uint8_t block[TELEM_STREAM_BLOCK];
+    uint8_t blocks = 0;
+    uint16_t len = 0;
+    uint32_t packed = 0;
+    uint32_t wire = 0;
+    uint64_t cycles = 0;
+    char text[4 * ((TELEM_STREAM_BLOCK + 2) / 3)];
+    uint8_t back[TELEM_STREAM_BLOCK];
+
+    DeltaPack_Init(&s, FIELDS);
+    UnpackerInit(&u, FIELDS);
+
+    for (uint32_t i = 0; i <= TRACE_SAMPLES; i++) {
+        /* Send when the next sample might not fit, and at the end */
+        if (i == TRACE_SAMPLES ||
+            len + DELTAPACK_MAX_SAMPLE_BYTES(FIELDS) + 3 > TELEM_STREAM_BLOCK) {
+            uint16_t chars;
+
+            len += DeltaPack_Flush(&s, &block[len]);
+            TEST_CHECK(len <= TELEM_STREAM_BLOCK);
+            chars = DeltaPack_Base64(block, len, text);
+            TEST_CHECK(Base64Decode(text, chars, back) == len);
+            TEST_CHECK(memcmp(back, block, len) == 0);
+            if (blocks == 0) {
+                UnpackerReset(&u);
+            }
+            UnpackerDecode(&u, back, len, decoded, TRACE_SAMPLES);
+            packed += len;
+            wire += chars + LINE_OVERHEAD;
+            len = 0;
+            if (++blocks == TELEM_STREAM_KEY_BLOCKS) {
+                blocks = 0;
+                DeltaPack_Reset(&s);
+            }
+        }
+        if (i < TRACE_SAMPLES) {
+            uint64_t t0 = Test_Cycles();
+
+            len += DeltaPack_Encode(&s, t->s[i], &block[len]);
+            cycles += Test_Cycles() - t0;
+        }
+    }
+
+    TEST_CHECK(u.values == (uint32_t)TRACE_SAMPLES * FIELDS);
+    TEST_CHECK(SameSamples(decoded, (const int16_t (*)[FIELDS])t->s, TRACE_SAMPLES));
+
+    Test_Note("%-9s %u samples, raw %lu B, packed %lu B (%.2f:1, %.2f B/sample), "
+              "wire %lu B (%.2f:1), %.0f cycles/sample",
+              t->name, TRACE_SAMPLES, (unsigned long)TRACE_SAMPLES * FIELDS * 2,
+              (unsigned long)packed, (double)TRACE_SAMPLES * FIELDS * 2 / packed,
+              (double)packed / TRACE_SAMPLES, (unsigned long)wire,
+              (double)TRACE_SAMPLES * FIELDS * 2 / wire, (double)cycles / TRACE_SAMPLES);
+}
+
+static void TestTraceRoundTrip(void)
+{
+    Test_Case("pot and countdown traces decode back exactly; ratio and cycles");
+
+    RoundTrip(&pot_trace);
+    RoundTrip(&countdown_trace);
+}
+
+/* Decode a capture's "@tz" lines with the C mirror */
+static uint32_t DecodeCapture(const char *text, uint32_t *end_samples, uint32_t *end_packed)
+{
+    Unpacker_t u;
+    uint8_t block[TELEM_STREAM_BLOCK];
+    const char *line = text;
+    bool started = false;
+    uint8_t since_key = 0;
+
+    UnpackerInit(&u, FIELDS);
+    while (*line != '\0') {
+        const char *eol = strstr(line, "\r\n");
+
+        TEST_CHECK(eol != NULL);
+        if (strncmp(line, "@tz start ", 10) == 0) {
+            TEST_CHECK(strncmp(line + 10, TELEM_STREAM_NAMES " ", sizeof(TELEM_STREAM_NAMES)) == 0);
+            TEST_CHECK(atoi(line + 10 + sizeof(TELEM_STREAM_NAMES)) == ADC_SCAN_PERIOD_MS);
+            started = true;
+        } else if (strncmp(line, "@tz k ", 6) == 0 || strncmp(line, "@tz c ", 6) == 0) {
+            uint16_t len;
+
+            TEST_CHECK(started);
+            if (line[4] == 'k') {
+                TEST_CHECK(since_key == 0 || since_key == TELEM_STREAM_KEY_BLOCKS);
+                since_key = 0;
+                UnpackerReset(&u);
+            }
+            since_key++;
+            len = Base64Decode(line + 6, (uint16_t)(eol - line - 6), block);
+            TEST_CHECK(len <= TELEM_STREAM_BLOCK);
+            UnpackerDecode(&u, block, len, decoded, TRACE_SAMPLES);
+        } else if (strncmp(line, "@tz end ", 8) == 0) {
+            TEST_CHECK(sscanf(line + 8, "%lu %lu", (unsigned long *)end_samples,
+                              (unsigned long *)end_packed) == 2);
+        } else {
+            TEST_CHECK(!"unexpected line");
+        }
+        line = eol + 2;
+    }
+    return u.values / FIELDS;
+}
+
+/* Decode the capture with the real tool and compare its CSV */
+static void CheckWithTool(const Trace_t *t)
+{
+    FILE *f;
+    char row[128];
+    uint32_t n = 0;
+
+    if (system("python3 -c '' >/dev/null 2>&1") != 0) {
+        Test_Note("python3 not found: tools/deltapack.py check skipped");
+        return;
+    }
+
+    f = fopen("build/tz_capture.log", "w");
+    TEST_CHECK(f != NULL);
+    fputs(capture, f);
+    fclose(f);
+    TEST_CHECK(system("python3 ../tools/deltapack.py decode build/tz_capture.log "
+                      "-o build/tz_decoded.csv > /dev/null") == 0);
+
+    f = fopen("build/tz_decoded.csv", "r");
+    TEST_CHECK(f != NULL);
+    TEST_CHECK(fgets(row, sizeof(row), f) != NULL);
+    TEST_CHECK(strncmp(row, TELEM_STREAM_NAMES, sizeof(TELEM_STREAM_NAMES) - 1) == 0);
+    while (fgets(row, sizeof(row), f) != NULL) {
+        int v[FIELDS];
+
+        TEST_CHECK(n < TRACE_SAMPLES);
+        TEST_CHECK(sscanf(row, "%d,%d,%d,%d,%d,%d", &v[0], &v[1], &v[2], &v[3], &v[4], &v[5]) == FIELDS);
+        for (uint8_t k = 0; k < FIELDS; k++) {
+            if (v[k] != t->s[n][k]) {
+                TEST_CHECK(v[k] == t->s[n][k]);
+            }
+        }
+        n++;
+    }
+    fclose(f);
+    TEST_CHECK(n == TRACE_SAMPLES);
+    Test_Note("tools/deltapack.py decoded %lu samples, identical", (unsigned long)n);
+}
+
+static void TestStreamLines(void)
+{
+    static const Trace_t *traces[] = { &pot_trace, &countdown_trace };
+    TaskHandle_t capture_task;
+
+    Test_Case("telemstream.c lines decode back exactly (C mirror and deltapack.py)");
+
+    TEST_CHECK(xTaskCreate(CaptureTask, "CAP", configMINIMAL_STACK_SIZE, NULL,
+                           TEST_PRIO_HIGH, &capture_task) == pdPASS);
+    LogBuf_Init(capture_task);
+
+    for (uint8_t k = 0; k < 2; k++) {
+        const Trace_t *t = traces[k];
+        uint32_t end_samples = 0;
+        uint32_t end_packed = 0;
+        uint32_t lines = 0;
+
+        capture_len = 0;
+        TEST_CHECK(!TelemStream_Running());
+        TelemStream_Start(ADC_SCAN_PERIOD_MS);
+        TEST_CHECK(TelemStream_Running());
+        for (uint32_t i = 0; i < TRACE_SAMPLES; i++) {
+            TelemStream_Add(t->s[i]);
+        }
+        TelemStream_Stop();
+        TEST_CHECK(!TelemStream_Running());
+        capture[capture_len] = '\0';
+
+        memset(decoded, 0, sizeof(decoded));
+        TEST_CHECK(DecodeCapture(capture, &end_samples, &end_packed) == TRACE_SAMPLES);
+        TEST_CHECK(SameSamples(decoded, (const int16_t (*)[FIELDS])t->s, TRACE_SAMPLES));
+        TEST_CHECK(end_samples == TRACE_SAMPLES);
+        for (uint32_t i = 0; i < capture_len; i++) {
+            lines += capture[i] == '\n';
+        }
+        Test_Note("%-9s %lu lines, %lu packed bytes", t->name,
+                  (unsigned long)lines, (unsigned long)end_packed);
+        CheckWithTool(t);
+    }
+    TEST_CHECK(LogBuf_GetDropped() == 0);
+}
+
+static void RunTests(void *pvParameters)
+{
+    (void)pvParameters;
+
+    MakePotTrace(&pot_trace);
+    MakeCountdownTrace(&countdown_trace);
+
+    TestBase64();
+    TestTokens();
+    TestMaxRun();
+    TestWorstCaseBytes();
+    TestTraceRoundTrip();
+    TestStreamLines();
+}
+
+int main(void)
+{
+    Test_Run(RunTests);
+    return 1;
+}
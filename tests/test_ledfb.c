@@ -0,0 +1,258 @@
+/*
+ * File:   test_ledfb.c
+ * Author: ENCM 511
+ *
+ * LED Framebuffer Tests (ledfb.c)
+ *
+ * Description: Pin states and port traffic of the LED framebuffer against
+ *              the LATB model in hw/xc.h, which counts every LATB access.
+ *              A commit is one masked read-modify-write of the word, two
+ *              accesses, so a frame must cost two accesses or none. The
+ *              frames are the ones main.c and pwm.c produce: the
+ *              countdown's LED1 step with LED2 following it, the finished
+ *              animation, and the PWM ISR switching LED2 inside a task's
+ *              frame.
+ *
+ * Created on Nov 2025
+ */
+
+#include "testing.h"
+#include "ledfb.h"
+
+/* Port bits that are not LEDs; a commit must leave them alone */
+#define OTHER_PINS      ((uint16_t)(0xFFFFu & ~LEDFB_MASK))
+
+/* One commit: LATB read once and written once */
+#define COMMIT_ACCESSES 2
+
+static volatile bool isr_led2_on;
+static volatile uint16_t isr_calls;
+
+/*============================================================================
+ * HELPERS
+ *============================================================================*/
+
+static uint16_t Leds(void)
+{
+    return hw_LATB & LEDFB_MASK;
+}
+
+/* Countdown frame as main.c builds it: LED1 in the shadow, LED2 follows
+ * through PWM_SetOutputEnabled() (which switches it off at once), one
+ * commit to close */
+static void CountdownFrame(bool led1_on, bool led2_blinks)
+{
+    if (led1_on) {
+        LedFb_Update(LED1_MASK, 0);
+    } else {
+        LedFb_Update(0, LED1_MASK);
+    }
+    if (led2_blinks && !led1_on) {
+        LED2_Off();
+    }
+    LedFb_Commit();
+}
+
+/* The same frame with one bitfield write per LED, as before ledfb.c */
+static void CountdownFramePerLed(bool led1_on, bool led2_blinks)
+{
+    if (led1_on) {
+        LATB |= LED1_MASK;
+    } else {
+        LATB &= ~LED1_MASK;
+    }
+    if (led2_blinks && !led1_on) {
+        LATB &= ~LED2_MASK;
+    }
+}
+
+/* Timer2 ISR: LED2 to the level the PWM counter wants */
+static BaseType_t Timer2Isr(PortInterruptPoint_t where)
+{
+    (void)where;
+
+    isr_calls++;
+    if (isr_led2_on && !LED2_IsOn()) {
+        LED2_On();
+    } else if (!isr_led2_on && LED2_IsOn()) {
+        LED2_Off();
+    }
+    return pdFALSE;
+}
+
+/*============================================================================
+ * TEST CASES
+ *============================================================================*/
+
+static void TestPinStates(void)
+{
+    Test_Case("pin states follow the shadow; other PORTB pins are kept");
+
+    hw_LATB = OTHER_PINS;
+    LedFb_Write(0, LEDFB_MASK);
+    TEST_CHECK(hw_LATB == OTHER_PINS);
+
+    LED0_On();
+    TEST_CHECK(Leds() == LED0_MASK);
+    LED2_On();
+    TEST_CHECK(Leds() == (LED0_MASK | LED2_MASK));
+    TEST_CHECK(LED2_IsOn());
+    LED0_Toggle();
+    TEST_CHECK(Leds() == LED2_MASK);
+    LedFb_Toggle(LED0_MASK | LED1_MASK);
+    TEST_CHECK(Leds() == LEDFB_MASK);
+
+    /* In both masks: off */
+    LedFb_Write(LED1_MASK, LED1_MASK);
+    TEST_CHECK(Leds() == (LED0_MASK | LED2_MASK));
+
+    /* Bits that are not LEDs never reach the port */
+    LedFb_Write(OTHER_PINS, 0);
+    LedFb_Write(0, OTHER_PINS);
+    TEST_CHECK((hw_LATB & OTHER_PINS) == OTHER_PINS);
+    TEST_CHECK(LedFb_Get() == (LED0_MASK | LED2_MASK));
+
+    /* Updates stay in the shadow until the commit */
+    LedFb_Update(LED1_MASK, LED2_MASK);
+    TEST_CHECK(Leds() == (LED0_MASK | LED2_MASK));
+    TEST_CHECK(LedFb_Get() == (LED0_MASK | LED1_MASK));
+    LedFb_Commit();
+    TEST_CHECK(Leds() == (LED0_MASK | LED1_MASK));
+    TEST_CHECK(hw_LATB == (OTHER_PINS | LED0_MASK | LED1_MASK));
+
+    LedFb_Write(0, LEDFB_MASK);
+    hw_LATB = 0;
+}
+
+static void TestWritesPerFrame(void)
+{
+    uint32_t before;
+
+    Test_Case("one frame, at most one LATB write");
+
+    LedFb_Write(0, LEDFB_MASK);
+
+    /* Three LEDs in one frame */
+    before = HwPort_LatBAccesses();
+    LedFb_Update(LED0_MASK, 0);
+    LedFb_Update(LED1_MASK, 0);
+    LedFb_Update(LED2_MASK, 0);
+    LedFb_Commit();
+    TEST_CHECK(HwPort_LatBAccesses() - before == COMMIT_ACCESSES);
+    TEST_CHECK(Leds() == LEDFB_MASK);
+
+    /* Finished animation: LED0 and LED1 swap in one write */
+    before = HwPort_LatBAccesses();
+    LedFb_Write(LED0_MASK, LED1_MASK);
+    TEST_CHECK(HwPort_LatBAccesses() - before == COMMIT_ACCESSES);
+    TEST_CHECK(Leds() == (LED0_MASK | LED2_MASK));
+
+    /* Nothing new: no write at all */
+    before = HwPort_LatBAccesses();
+    LedFb_Commit();
+    LedFb_Write(LED0_MASK, 0);
+    LedFb_Update(0, 0);
+    LedFb_Commit();
+    LED2_On();
+    TEST_CHECK(HwPort_LatBAccesses() == before);
+
+    /* A change undone before the commit costs nothing either */
+    LedFb_Update(LED1_MASK, 0);
+    LedFb_Update(0, LED1_MASK);
+    LedFb_Commit();
+    TEST_CHECK(HwPort_LatBAccesses() == before);
+
+    /* Countdown frames, both LED2 modes */
+    LedFb_Write(0, LEDFB_MASK);
+    for (uint8_t mode = 0; mode < 2; mode++) {
+        for (uint8_t second = 0; second < 4; second++) {
+            bool led1_on = (second & 1) == 0;
+
+            before = HwPort_LatBAccesses();
+            CountdownFrame(led1_on, mode == 1);
+            TEST_CHECK(HwPort_LatBAccesses() - before == COMMIT_ACCESSES);
+            TEST_CHECK(((Leds() & LED1_MASK) != 0) == led1_on);
+        }
+    }
+    LedFb_Write(0, LEDFB_MASK);
+}
+
+static void TestIsrInsideFrame(void)
+{
+    uint32_t before;
+
+    Test_Case("PWM ISR commits inside a task frame: bits kept, no extra write");
+
+    LedFb_Write(0, LEDFB_MASK);
+    isr_led2_on = true;
+    isr_calls = 0;
+    vPortSetInterruptHook(Timer2Isr);
+
+    /* The ISR runs as LedFb_Update() drops the IPL, LED1 still pending */
+    before = HwPort_LatBAccesses();
+    LedFb_Update(LED1_MASK, 0);
+    vPortSetInterruptHook(NULL);
+    TEST_CHECK(isr_calls == 1);
+    TEST_CHECK(Leds() == (LED1_MASK | LED2_MASK));
+    LedFb_Commit();
+    TEST_CHECK(HwPort_LatBAccesses() - before == COMMIT_ACCESSES);
+    TEST_CHECK(Leds() == (LED1_MASK | LED2_MASK));
+
+    /* The ISR switches LED2 off between two updates of the same frame */
+    isr_led2_on = false;
+    before = HwPort_LatBAccesses();
+    LedFb_Update(0, LED1_MASK);
+    vPortSetInterruptHook(Timer2Isr);
+    LedFb_Update(LED0_MASK, 0);
+    vPortSetInterruptHook(NULL);
+    LedFb_Commit();
+    TEST_CHECK(Leds() == LED0_MASK);
+    TEST_CHECK(LedFb_Get() == LED0_MASK);
+    TEST_CHECK(HwPort_LatBAccesses() - before == COMMIT_ACCESSES);
+
+    LedFb_Write(0, LEDFB_MASK);
+}
+
+static void TestCountdownTraffic(void)
+{
+    uint32_t fb = 0;
+    uint32_t per_led = 0;
+    uint32_t before;
+
+    Test_Case("countdown minute, LED2 blinking: LATB writes");
+
+    LedFb_Write(0, LEDFB_MASK);
+    hw_LATB = 0;
+    for (uint8_t second = 0; second < 60; second++) {
+        before = HwPort_LatBAccesses();
+        CountdownFrame((second & 1) == 0, true);
+        fb += (HwPort_LatBAccesses() - before) / COMMIT_ACCESSES;
+    }
+
+    /* Each compound bitfield assignment is one read-modify-write */
+    for (uint8_t second = 0; second < 60; second++) {
+        before = HwPort_LatBAccesses();
+        CountdownFramePerLed((second & 1) == 0, true);
+        per_led += HwPort_LatBAccesses() - before;
+    }
+    TEST_CHECK(fb == 60);
+    TEST_CHECK(per_led == 90);
+    Test_Note("framebuffer %lu writes, per-LED bitfields %lu",
+              (unsigned long)fb, (unsigned long)per_led);
+}
+
+static void RunTests(void *pvParameters)
+{
+    (void)pvParameters;
+
+    TestPinStates();
+    TestWritesPerFrame();
+    TestIsrInsideFrame();
+    TestCountdownTraffic();
+}
+
+int main(void)
+{
+    Test_Run(RunTests);
+    return 1;
+}
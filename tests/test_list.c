@@ -0,0 +1,524 @@
+/*
+ * File:   test_list.c
+ * Author: ENCM 511
+ *
+ * Kernel List Tests and Benchmarks (configUSE_LIST_INDEX8)
+ *
+ * Description: The list calls the kernel makes, on lists of test owners
+ *              shaped like a TCB (two adjacent list items): insert at the
+ *              end and round robin, sorted insert, removal around the walk
+ *              index, and an owner in two lists at once. Then the same
+ *              through the kernel: delayed tasks waking in order, queue
+ *              waiters, and two tasks yielding to each other. Every check
+ *              is the behaviour of the pointer lists, so both builds must
+ *              pass the same cases.
+ *
+ *              The Makefile builds this file twice, as test_list with the
+ *              pointer lists of the target and as test_list_index8 with
+ *              configUSE_LIST_INDEX8 1, which adds the table-full cases.
+ *              Both print host cycles for the list operations and the RAM
+ *              each kind of list costs on the PIC24.
+ *
+ * Created on Nov 2025
+ */
+
+#include "testing.h"
+#include "queue.h"
+#include <stdbool.h>
+#include <stdio.h>
+
+#define OWNERS          40
+#define BENCH_ROUNDS    2000        /* Operations per timed run */
+#define BENCH_RUNS      15          /* Best run is reported */
+#define RR_ROUNDS       8           /* Yields per round-robin task */
+
+#define PIC24_PTR       2           /* Bytes in a PIC24 data pointer */
+
+#if ( configUSE_LIST_INDEX8 == 1 )
+#define LIST_NAME       "8-bit index lists"
+#else
+#define LIST_NAME       "pointer lists"
+#endif
+
+/* A TCB's list items: adjacent, after something else */
+typedef struct {
+    uint16_t id;
+    ListItem_t xStateItem;
+    ListItem_t xEventItem;
+} Owner_t;
+
+static Owner_t owners[OWNERS];
+static volatile uint16_t sink;
+
+/* Kernel cases: what each helper task saw, in order */
+static volatile uint8_t wake_log[2 * RR_ROUNDS];
+static volatile uint8_t wake_count;
+static volatile uint8_t tasks_done;
+static QueueHandle_t xQueue;
+
+/*============================================================================
+ * HELPERS
+ *============================================================================*/
+
+static void InitOwners(void)
+{
+    for (uint8_t i = 0; i < OWNERS; i++) {
+        owners[i].id = i;
+        vListInitialiseItem(&owners[i].xStateItem);
+        vListInitialiseItem(&owners[i].xEventItem);
+        listSET_LIST_ITEM_OWNER(&owners[i].xStateItem, &owners[i]);
+        listSET_LIST_ITEM_OWNER(&owners[i].xEventItem, &owners[i]);
+    }
+}
+
+static uint16_t IdOf(ListItem_t *item)
+{
+    return ((Owner_t *)listGET_LIST_ITEM_OWNER(item))->id;
+}
+
+/* The list from head to end marker is ids[0..n-1], and its length is n */
+static bool Order(List_t *list, const uint8_t *ids, uint8_t n)
+{
+    const ListItem_t *end = listGET_END_MARKER(list);
+    ListItem_t *item;
+    uint8_t i = 0;
+
+    for (item = listGET_HEAD_ENTRY(list); item != end; item = listGET_NEXT(item)) {
+        if (i == n || IdOf(item) != ids[i]) {
+            return false;
+        }
+        i++;
+    }
+    return i == n && listCURRENT_LIST_LENGTH(list) == n;
+}
+
+/* listGET_OWNER_OF_NEXT_ENTRY() gives ids[0..n-1] */
+static bool Walk(List_t *list, const uint8_t *ids, uint8_t n)
+{
+    Owner_t *owner;
+
+    for (uint8_t i = 0; i < n; i++) {
+        listGET_OWNER_OF_NEXT_ENTRY(owner, list);
+        if (owner->id != ids[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void InsertEnd(List_t *list, uint8_t first, uint8_t count)
+{
+    for (uint8_t i = first; i < first + count; i++) {
+        listINSERT_END(list, &owners[i].xStateItem);
+    }
+}
+
+static void Empty(List_t *list)
+{
+    while (!listLIST_IS_EMPTY(list)) {
+        /* listREMOVE_ITEM() reads its argument more than once */
+        ListItem_t *head = listGET_HEAD_ENTRY(list);
+
+        listREMOVE_ITEM(head);
+    }
+}
+
+/*============================================================================
+ * TEST CASES
+ *============================================================================*/
+
+static void TestInsertEnd(void)
+{
+    static List_t list;
+
+    Test_Case(LIST_NAME ": insert at the end, round robin");
+
+    vListInitialise(&list);
+    TEST_CHECK(listLIST_IS_EMPTY(&list));
+    TEST_CHECK(listGET_HEAD_ENTRY(&list) == listGET_END_MARKER(&list));
+
+    InsertEnd(&list, 0, 5);
+    TEST_CHECK(Order(&list, (const uint8_t[]){ 0, 1, 2, 3, 4 }, 5));
+    TEST_CHECK(Walk(&list, (const uint8_t[]){ 0, 1, 2, 3, 4, 0, 1 }, 7));
+
+    /* In just before the index, so every other item comes first */
+    listINSERT_END(&list, &owners[5].xStateItem);
+    TEST_CHECK(Order(&list, (const uint8_t[]){ 0, 5, 1, 2, 3, 4 }, 6));
+    TEST_CHECK(Walk(&list, (const uint8_t[]){ 2, 3, 4, 0, 5, 1 }, 6));
+    Empty(&list);
+
+    /* Before an index on the head: the new item is the head */
+    InsertEnd(&list, 0, 3);
+    TEST_CHECK(Walk(&list, (const uint8_t[]){ 0 }, 1));
+    vListInsertEnd(&list, &owners[3].xStateItem);
+    TEST_CHECK(Order(&list, (const uint8_t[]){ 3, 0, 1, 2 }, 4));
+    TEST_CHECK(Walk(&list, (const uint8_t[]){ 1, 2, 3, 0, 1 }, 5));
+    Empty(&list);
+}
+
+static void TestInsertSorted(void)
+{
+    static const TickType_t values[8] = { 5, 3, 5, 1, portMAX_DELAY, 3, 9, portMAX_DELAY };
+    static List_t list;
+
+    Test_Case(LIST_NAME ": sorted insert, equal values in arrival order");
+
+    vListInitialise(&list);
+    TEST_CHECK(listGET_ITEM_VALUE_OF_HEAD_ENTRY(&list) == portMAX_DELAY);
+
+    for (uint8_t i = 0; i < 8; i++) {
+        listSET_LIST_ITEM_VALUE(&owners[i].xStateItem, values[i]);
+        vListInsert(&list, &owners[i].xStateItem);
+    }
+    TEST_CHECK(Order(&list, (const uint8_t[]){ 3, 1, 5, 0, 2, 6, 4, 7 }, 8));
+    TEST_CHECK(listGET_ITEM_VALUE_OF_HEAD_ENTRY(&list) == 1);
+    TEST_CHECK(((Owner_t *)listGET_OWNER_OF_HEAD_ENTRY(&list))->id == 3);
+
+    Empty(&list);
+    TEST_CHECK(listGET_ITEM_VALUE_OF_HEAD_ENTRY(&list) == portMAX_DELAY);
+}
+
+static void TestRemove(void)
+{
+    static List_t list;
+
+    Test_Case(LIST_NAME ": remove the index, head and tail items");
+
+    vListInitialise(&list);
+    InsertEnd(&list, 0, 6);
+    TEST_CHECK(Walk(&list, (const uint8_t[]){ 0, 1, 2 }, 3));
+
+    /* The index moves back to the item before */
+    TEST_CHECK(uxListRemove(&owners[2].xStateItem) == 5);
+    TEST_CHECK(Walk(&list, (const uint8_t[]){ 3 }, 1));
+
+    TEST_CHECK(uxListRemove(&owners[0].xStateItem) == 4);
+    TEST_CHECK(Order(&list, (const uint8_t[]){ 1, 3, 4, 5 }, 4));
+    TEST_CHECK(Walk(&list, (const uint8_t[]){ 4, 5, 1 }, 3));
+
+    /* The index on the head: back to the end marker, then the new head */
+    TEST_CHECK(uxListRemove(&owners[1].xStateItem) == 3);
+    TEST_CHECK(Walk(&list, (const uint8_t[]){ 3 }, 1));
+    TEST_CHECK(Order(&list, (const uint8_t[]){ 3, 4, 5 }, 3));
+
+    listREMOVE_ITEM(&owners[5].xStateItem);
+    TEST_CHECK(Order(&list, (const uint8_t[]){ 3, 4 }, 2));
+    TEST_CHECK(listLIST_ITEM_CONTAINER(&owners[5].xStateItem) == NULL);
+    TEST_CHECK(listLIST_ITEM_CONTAINER(&owners[3].xStateItem) == &list);
+    TEST_CHECK(listIS_CONTAINED_WITHIN(&list, &owners[5].xStateItem) == pdFALSE);
+    TEST_CHECK(listIS_CONTAINED_WITHIN(&list, &owners[4].xStateItem) == pdTRUE);
+    TEST_CHECK(Walk(&list, (const uint8_t[]){ 4, 3 }, 2));
+
+    TEST_CHECK(uxListRemove(&owners[3].xStateItem) == 1);
+    TEST_CHECK(uxListRemove(&owners[4].xStateItem) == 0);
+    TEST_CHECK(listLIST_IS_EMPTY(&list));
+    TEST_CHECK(listGET_HEAD_ENTRY(&list) == listGET_END_MARKER(&list));
+
+    listINSERT_END(&list, &owners[5].xStateItem);
+    TEST_CHECK(Order(&list, (const uint8_t[]){ 5 }, 1));
+    TEST_CHECK(Walk(&list, (const uint8_t[]){ 5, 5 }, 2));
+    Empty(&list);
+}
+
+static void TestTwoLists(void)
+{
+    static List_t state;
+    static List_t event;
+
+    Test_Case(LIST_NAME ": an owner in two lists through its two items");
+
+    vListInitialise(&state);
+    vListInitialise(&event);
+    for (uint8_t i = 0; i < 4; i++) {
+        listINSERT_END(&state, &owners[i].xStateItem);
+        listSET_LIST_ITEM_VALUE(&owners[i].xEventItem, 4 - i);
+        vListInsert(&event, &owners[i].xEventItem);
+    }
+    TEST_CHECK(Order(&state, (const uint8_t[]){ 0, 1, 2, 3 }, 4));
+    TEST_CHECK(Order(&event, (const uint8_t[]){ 3, 2, 1, 0 }, 4));
+
+    listREMOVE_ITEM(&owners[1].xStateItem);
+    TEST_CHECK(Order(&state, (const uint8_t[]){ 0, 2, 3 }, 3));
+    TEST_CHECK(Order(&event, (const uint8_t[]){ 3, 2, 1, 0 }, 4));
+    TEST_CHECK(listLIST_ITEM_CONTAINER(&owners[1].xEventItem) == &event);
+    TEST_CHECK(listGET_LIST_ITEM_OWNER(&owners[1].xEventItem) ==
+               listGET_LIST_ITEM_OWNER(&owners[1].xStateItem));
+
+    Empty(&state);
+    Empty(&event);
+}
+
+static void DelayTask(void *pvParameters)
+{
+    static const TickType_t delays[3] = { 5, 2, 4 };
+    uint8_t id = (uint8_t)(uintptr_t)pvParameters;
+
+    vTaskDelay(delays[id]);
+    wake_log[wake_count++] = id;
+    vTaskSuspend(NULL);     /* heap_1 cannot free a deleted task */
+}
+
+static void ReceiveTask(void *pvParameters)
+{
+    uint8_t id = (uint8_t)(uintptr_t)pvParameters;
+    uint8_t value;
+
+    TEST_CHECK(xQueueReceive(xQueue, &value, portMAX_DELAY) == pdPASS);
+    wake_log[wake_count++] = (uint8_t)(id * 16 + value);
+    vTaskSuspend(NULL);
+}
+
+static void YieldTask(void *pvParameters)
+{
+    uint8_t id = (uint8_t)(uintptr_t)pvParameters;
+
+    for (uint8_t i = 0; i < RR_ROUNDS; i++) {
+        wake_log[wake_count++] = id;
+        taskYIELD();
+    }
+    tasks_done++;
+    vTaskSuspend(NULL);
+}
+
+static void TestKernel(void)
+{
+    uint8_t count[2] = { 0, 0 };
+    bool alternate = true;
+
+    Test_Case(LIST_NAME ": delayed, queue and ready lists through the kernel");
+
+    /* Delayed list: woken by wake time, not by creation */
+    wake_count = 0;
+    for (uintptr_t i = 0; i < 3; i++) {
+        TEST_CHECK(xTaskCreate(DelayTask, "DLY", configMINIMAL_STACK_SIZE,
+                               (void *)i, TEST_PRIO_HIGH, NULL) == pdPASS);
+    }
+    vTaskDelay(10);
+    TEST_CHECK(wake_count == 3);
+    TEST_CHECK(wake_log[0] == 1 && wake_log[1] == 2 && wake_log[2] == 0);
+
+    /* Event list: equal-priority waiters in the order they blocked */
+    wake_count = 0;
+    for (uintptr_t i = 0; i < 2; i++) {
+        TEST_CHECK(xTaskCreate(ReceiveTask, "RECV", configMINIMAL_STACK_SIZE,
+                               (void *)i, TEST_PRIO_HIGH, NULL) == pdPASS);
+    }
+    for (uint8_t value = 1; value <= 2; value++) {
+        TEST_CHECK(xQueueSend(xQueue, &value, 0) == pdPASS);
+    }
+    TEST_CHECK(wake_count == 2);
+    TEST_CHECK(wake_log[0] == 0 * 16 + 1 && wake_log[1] == 1 * 16 + 2);
+
+    /* Ready list: each yield hands over to the other task */
+    wake_count = 0;
+    tasks_done = 0;
+    for (uintptr_t i = 0; i < 2; i++) {
+        TEST_CHECK(xTaskCreate(YieldTask, "RR", configMINIMAL_STACK_SIZE,
+                               (void *)i, TEST_PRIO_LOW, NULL) == pdPASS);
+    }
+    while (tasks_done < 2) {
+        vTaskDelay(1);
+    }
+    TEST_CHECK(wake_count == 2 * RR_ROUNDS);
+    for (uint8_t i = 0; i < wake_count; i++) {
+        count[wake_log[i]]++;
+        if (i > 0 && wake_log[i] == wake_log[i - 1]) {
+            alternate = false;
+        }
+    }
+    TEST_CHECK(alternate);
+    TEST_CHECK(count[0] == RR_ROUNDS && count[1] == RR_ROUNDS);
+}
+
+/* Host cycles per call of op, best of BENCH_RUNS */
+static double Measure(void (*op)(List_t *, ListItem_t *), List_t *list, ListItem_t *item)
+{
+    uint64_t best = UINT64_MAX;
+
+    for (uint8_t run = 0; run < BENCH_RUNS; run++) {
+        uint64_t t0 = Test_Cycles();
+
+        for (uint16_t i = 0; i < BENCH_ROUNDS; i++) {
+            op(list, item);
+        }
+        t0 = Test_Cycles() - t0;
+        if (t0 < best) {
+            best = t0;
+        }
+    }
+    return (double)best / BENCH_ROUNDS;
+}
+
+static void InsertEndRemove(List_t *list, ListItem_t *item)
+{
+    listINSERT_END(list, item);
+    listREMOVE_ITEM(item);
+}
+
+static void InsertRemove(List_t *list, ListItem_t *item)
+{
+    vListInsert(list, item);
+    (void)uxListRemove(item);
+}
+
+static void NextEntry(List_t *list, ListItem_t *item)
+{
+    Owner_t *owner;
+
+    listGET_OWNER_OF_NEXT_ENTRY(owner, list);
+    sink += owner->id;
+}
+
+static void TestBench(void)
+{
+    static const uint8_t depths[3] = { 1, 8, 32 };
+    static List_t list;
+    ListItem_t *item = &owners[OWNERS - 1].xStateItem;
+
+    Test_Case(LIST_NAME ": host cycles per operation");
+
+    /* A ready list with four tasks */
+    vListInitialise(&list);
+    InsertEnd(&list, 0, 4);
+    Test_Note("%-34s %6.1f cycles", "listINSERT_END + listREMOVE_ITEM",
+              Measure(InsertEndRemove, &list, item));
+    Test_Note("%-34s %6.1f cycles", "listGET_OWNER_OF_NEXT_ENTRY",
+              Measure(NextEntry, &list, NULL));
+    TEST_CHECK(Order(&list, (const uint8_t[]){ 0, 1, 2, 3 }, 4));
+    Empty(&list);
+
+    /* A delayed list, the new item going in behind all of it */
+    for (uint8_t d = 0; d < 3; d++) {
+        char name[40];
+
+        for (uint8_t i = 0; i < depths[d]; i++) {
+            listSET_LIST_ITEM_VALUE(&owners[i].xStateItem, i);
+            vListInsert(&list, &owners[i].xStateItem);
+        }
+        listSET_LIST_ITEM_VALUE(item, depths[d]);
+        snprintf(name, sizeof(name), "vListInsert + uxListRemove, %u deep", depths[d]);
+        Test_Note("%-34s %6.1f cycles", name, Measure(InsertRemove, &list, item));
+        TEST_CHECK(listCURRENT_LIST_LENGTH(&list) == depths[d]);
+        Empty(&list);
+    }
+}
+
+static void TestRam(void)
+{
+    /* Field by field at PIC24 widths: TickType_t and UBaseType_t are 16 bits */
+    const unsigned tick = sizeof(TickType_t);
+    const unsigned ptr_item = tick + 4 * PIC24_PTR;
+    const unsigned ptr_list = sizeof(UBaseType_t) + PIC24_PTR + (tick + 2 * PIC24_PTR);
+    const unsigned idx_item = tick + 4;
+    const unsigned idx_list = 4;
+    const unsigned idx_tcb = 2 * idx_item + PIC24_PTR + 1;     /* Owner entry and offset */
+    const unsigned idx_list_total = idx_list + PIC24_PTR;      /* List entry */
+
+    Test_Case(LIST_NAME ": RAM per TCB and per list on the PIC24");
+
+    /* The index lists hold no pointers, so the host has them at target size */
+#if ( configUSE_LIST_INDEX8 == 1 )
+    TEST_CHECK(sizeof(ListItem_t) == idx_item);
+    TEST_CHECK(sizeof(List_t) == idx_list);
+#endif
+
+    Test_Note("TCB list items: pointer %u bytes, index %u with its table entry, %u saved",
+              2 * ptr_item, idx_tcb, 2 * ptr_item - idx_tcb);
+    Test_Note("List_t:         pointer %u bytes, index %u with its table entry, %u saved",
+              ptr_list, idx_list_total, ptr_list - idx_list_total);
+}
+
+#if ( configUSE_LIST_INDEX8 == 1 )
+
+static void FillLists(void *arg)
+{
+    static List_t spare[configLIST_INDEX8_MAX_LISTS];
+
+    for (uint16_t i = 0; i < configLIST_INDEX8_MAX_LISTS; i++) {
+        vListInitialise(&spare[i]);
+    }
+}
+
+static void FillOwners(void *arg)
+{
+    static Owner_t spare[configLIST_INDEX8_MAX_OWNERS];
+
+    for (uint16_t i = 0; i < configLIST_INDEX8_MAX_OWNERS; i++) {
+        vListInitialiseItem(&spare[i].xStateItem);
+        listSET_LIST_ITEM_OWNER(&spare[i].xStateItem, &spare[i]);
+    }
+}
+
+static void ThirdItem(void *arg)
+{
+    static struct {
+        ListItem_t items[3];
+    } owner;
+
+    listSET_LIST_ITEM_OWNER(&owner.items[0], &owner);
+    listSET_LIST_ITEM_OWNER(&owner.items[2], &owner);
+}
+
+static void NoOwner(void *arg)
+{
+    static List_t list;
+    static ListItem_t item;
+
+    vListInitialise(&list);
+    vListInitialiseItem(&item);
+    listINSERT_END(&list, &item);
+}
+
+static void TestTables(void)
+{
+    static List_t list;
+    uint8_t number;
+
+    Test_Case(LIST_NAME ": list and owner numbers");
+
+    /* A queue reset initialises its lists again: same number */
+    vListInitialise(&list);
+    TEST_CHECK(listLIST_IS_INITIALISED(&list));
+    number = list.ucSelf;
+    vListInitialise(&list);
+    TEST_CHECK(list.ucSelf == number);
+
+    /* An owner set again (a timer restarting) keeps its numbers */
+    number = owners[0].xEventItem.ucSelf;
+    listSET_LIST_ITEM_OWNER(&owners[0].xEventItem, &owners[0]);
+    TEST_CHECK(owners[0].xEventItem.ucSelf == number);
+    TEST_CHECK(owners[0].xStateItem.ucSelf == (number & ~1U));
+
+    Test_ExpectAssert(FillLists, NULL);
+    Test_ExpectAssert(FillOwners, NULL);
+    Test_ExpectAssert(ThirdItem, NULL);
+    Test_ExpectAssert(NoOwner, NULL);
+}
+
+#endif /* configUSE_LIST_INDEX8 */
+
+static void RunTests(void *pvParameters)
+{
+    (void)pvParameters;
+
+    xQueue = xQueueCreate(2, sizeof(uint8_t));
+    TEST_CHECK(xQueue != NULL);
+    InitOwners();
+
+    TestInsertEnd();
+    TestInsertSorted();
+    TestRemove();
+    TestTwoLists();
+    TestKernel();
+    TestBench();
+    TestRam();
+#if ( configUSE_LIST_INDEX8 == 1 )
+    TestTables();
+#endif
+}
+
+int main(void)
+{
+    Test_Run(RunTests);
+    return 1;
+}
@@ -0,0 +1,436 @@
+/*
+ * File:   test_logbuf.c
+ * Author: ENCM 511
+ *
+ * Log Buffer Tests (logbuf.c)
+ *
+ * Description: Eight producer tasks share one priority below the test
+ *              task, which plays vLogTask. An interrupt hook preempts the
+ *              running producer at pseudo-random interrupt points, most
+ *              usefully right after Reserve() lowers the IPL, so records
+ *              are committed out of reservation order. Every record is
+ *              self-describing (producer, sequence, length, fill byte) and
+ *              the consumer checks each one as it reads the stream.
+ *
+ * Record format: '<' producer seq(4 hex) len(2 hex) fill... '>'
+ *
+ * Created on Nov 2025
+ */
+
+#include "testing.h"
+#include "semphr.h"
+#include "logbuf.h"
+#include <stdio.h>
+#include <string.h>
+
+#define PRODUCERS           8
+#define RECORDS_EACH        300
+#define RECORD_OVERHEAD     9           /* '<' id seq len '>' */
+#define MAX_FILL            40
+#define READ_CHUNK          48
+#define BENCH_RECORDS       2000
+#define BENCH_PAYLOAD       32
+
+typedef bool (*WriteFn_t)(const char *data, uint16_t len, TickType_t wait);
+
+typedef struct {
+    uint8_t id;
+    uint16_t records;
+    TickType_t wait;
+    WriteFn_t write;
+    volatile uint16_t written;
+    volatile uint16_t failed;
+    volatile bool done;
+} Producer_t;
+
+typedef struct {
+    uint8_t rec[RECORD_OVERHEAD + MAX_FILL];
+    uint8_t have;
+    uint8_t want;                   /* Record length, once the header is in */
+    uint16_t next_seq[PRODUCERS];
+    uint32_t records;
+} Parser_t;
+
+static Producer_t producers[PRODUCERS];
+static Parser_t parser;
+
+/* Interrupt hook state */
+static uint32_t hook_seed = 1;
+static uint32_t hook_preempt_every = 0;     /* 0 = hook never preempts */
+static uint32_t preempt_after_reserve = 0;
+
+/* Mutex-protected ring for the benchmark (the old xUartMutex path) */
+static SemaphoreHandle_t xRingMutex;
+static uint8_t ring[LOGBUF_SIZE];
+static uint16_t ring_head = 0;
+
+/*============================================================================
+ * HELPERS
+ *============================================================================*/
+
+static uint32_t NextRandom(void)
+{
+    hook_seed = hook_seed * 1103515245UL + 12345UL;
+    return (hook_seed >> 16) & 0x7FFF;
+}
+
+static BaseType_t InterruptHook(PortInterruptPoint_t where)
+{
+    if (hook_preempt_every == 0 || NextRandom() % hook_preempt_every != 0) {
+        return pdFALSE;
+    }
+    if (where == portINTERRUPT_AT_IPL_RESTORE) {
+        preempt_after_reserve++;
+    }
+    return pdTRUE;      /* Tick preemption: round-robin to the next producer */
+}
+
+static uint8_t BuildRecord(char *out, uint8_t id, uint16_t seq)
+{
+    uint8_t fill = (uint8_t)((seq * 7U + id * 3U) % (MAX_FILL + 1));
+    uint8_t len = (uint8_t)(RECORD_OVERHEAD + fill);
+
+    snprintf(out, 9, "<%c%04X%02X", '0' + id, seq, fill);
+    memset(&out[8], 'a' + id, fill);
+    out[8 + fill] = '>';
+    return len;
+}
+
+static void ProducerTask(void *pvParameters)
+{
+    Producer_t *p = pvParameters;
+    char rec[RECORD_OVERHEAD + MAX_FILL];
+    uint16_t seq = 0;
+
+    while (seq < p->records) {
+        uint8_t len = BuildRecord(rec, p->id, seq);
+
+        if (p->write(rec, len, p->wait)) {
+            p->written++;
+            seq++;
+        } else {
+            p->failed++;
+            seq++;              /* Dropped; the next record keeps its own seq */
+        }
+    }
+    p->done = true;
+    vTaskSuspend(NULL);         /* heap_1 cannot free a deleted task */
+}
+
+static void StartProducers(uint16_t records, TickType_t wait, WriteFn_t write)
+{
+    for (uint8_t i = 0; i < PRODUCERS; i++) {
+        Producer_t *p = &producers[i];
+
+        p->id = i;
+        p->records = records;
+        p->wait = wait;
+        p->write = write;
+        p->written = 0;
+        p->failed = 0;
+        p->done = false;
+        TEST_CHECK(xTaskCreate(ProducerTask, "PROD", configMINIMAL_STACK_SIZE,
+                               p, TEST_PRIO_LOW, NULL) == pdPASS);
+    }
+}
+
+static bool AllDone(void)
+{
+    for (uint8_t i = 0; i < PRODUCERS; i++) {
+        if (!producers[i].done) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void ParserReset(void)
+{
+    memset(&parser, 0, sizeof(parser));
+}
+
+/* Check one complete record; seq_gaps allows dropped records */
+static void ParserCheckRecord(bool seq_gaps)
+{
+    unsigned int id, seq, fill;
+    uint8_t *r = parser.rec;
+
+    TEST_CHECK(sscanf((const char *)&r[2], "%4X%2X", &seq, &fill) == 2);
+    id = (unsigned int)(r[1] - '0');
+    TEST_CHECK(id < PRODUCERS);
+    TEST_CHECK(fill <= MAX_FILL);
+    TEST_CHECK(parser.have == RECORD_OVERHEAD + fill);
+    TEST_CHECK(r[8 + fill] == '>');
+    for (unsigned int i = 0; i < fill; i++) {
+        if (r[8 + i] != 'a' + id) {
+            TEST_CHECK(r[8 + i] == 'a' + id);      /* Torn or interleaved */
+        }
+    }
+
+    if (seq_gaps) {
+        TEST_CHECK(seq >= parser.next_seq[id]);
+    } else {
+        TEST_CHECK(seq == parser.next_seq[id]);
+    }
+    parser.next_seq[id] = (uint16_t)(seq + 1);
+    parser.records++;
+}
+
+static void ParserFeed(const uint8_t *data, uint16_t len, bool seq_gaps)
+{
+    for (uint16_t i = 0; i < len; i++) {
+        if (parser.have == 0) {
+            TEST_CHECK(data[i] == '<');
+        }
+        TEST_CHECK(parser.have < sizeof(parser.rec));
+        parser.rec[parser.have++] = data[i];
+
+        /* The header carries the length, so the end is known exactly */
+        if (parser.have == 8) {
+            unsigned int fill;
+
+            TEST_CHECK(sscanf((const char *)&parser.rec[6], "%2X", &fill) == 1);
+            TEST_CHECK(fill <= MAX_FILL);
+            parser.want = (uint8_t)(RECORD_OVERHEAD + fill);
+        }
+        if (parser.have >= 8 && parser.have == parser.want) {
+            ParserCheckRecord(seq_gaps);
+            parser.have = 0;
+        }
+    }
+}
+
+/* vLogTask's loop: wait for a commit (or a tick), read, check */
+static uint32_t Consume(bool seq_gaps)
+{
+    uint8_t chunk[READ_CHUNK];
+    uint32_t stalled = 0;
+
+    for (;;) {
+        uint16_t n;
+        bool finished = AllDone();
+
+        while ((n = LogBuf_Read(chunk, sizeof(chunk))) > 0) {
+            ParserFeed(chunk, n, seq_gaps);
+        }
+        if (finished) {
+            break;
+        }
+        /* The consumer outranks the producers, so it runs straight after
+         * every commit; nothing to read then means an older record is BUSY */
+        if (ulTaskNotifyTake(pdTRUE, 1) != 0) {
+            n = LogBuf_Read(chunk, sizeof(chunk));
+            if (n == 0) {
+                stalled++;
+            }
+            ParserFeed(chunk, n, seq_gaps);
+        }
+    }
+
+    TEST_CHECK(parser.have == 0);
+    return stalled;
+}
+
+static bool MutexRingWrite(const char *data, uint16_t len, TickType_t wait)
+{
+    if (xSemaphoreTake(xRingMutex, wait) != pdPASS) {
+        return false;
+    }
+    for (uint16_t i = 0; i < len; i++) {
+        ring[ring_head++ & (LOGBUF_SIZE - 1)] = (uint8_t)data[i];
+    }
+    xSemaphoreGive(xRingMutex);
+    return true;
+}
+
+/*============================================================================
+ * TEST CASES
+ *============================================================================*/
+
+static void TestSingleRecord(void)
+{
+    uint8_t out[16];
+
+    Test_Case("one record round trip");
+
+    LogBuf_Init(xTaskGetCurrentTaskHandle());
+    TEST_CHECK(LogBuf_Read(out, sizeof(out)) == 0);
+    TEST_CHECK(LogBuf_Write("hello", 5, 0));
+    TEST_CHECK(ulTaskNotifyTake(pdTRUE, 0) == 1);
+    TEST_CHECK(LogBuf_Read(out, 3) == 3);
+    TEST_CHECK(LogBuf_Read(&out[3], sizeof(out) - 3) == 2);
+    TEST_CHECK(memcmp(out, "hello", 5) == 0);
+    TEST_CHECK(LogBuf_GetDropped() == 0);
+}
+
+static void TestSplitRecord(void)
+{
+    char in[LOGBUF_MAX_RECORD + 60];
+    uint8_t out[sizeof(in)];
+    uint16_t got = 0;
+
+    Test_Case("payload longer than LOGBUF_MAX_RECORD is split and arrives whole");
+
+    LogBuf_Init(NULL);
+    for (uint16_t i = 0; i < sizeof(in); i++) {
+        in[i] = (char)('A' + i % 26);
+    }
+
+    /* Start part way round so the first piece wraps the ring */
+    TEST_CHECK(LogBuf_Write(in, 100, 0));
+    TEST_CHECK(LogBuf_Read(out, sizeof(out)) == 100);
+
+    /* The first piece fills the ring; the second has no room until a read */
+    TEST_CHECK(LogBuf_Write(in, sizeof(in), 0) == false);
+    TEST_CHECK(LogBuf_GetDropped() == 1);
+    got = LogBuf_Read(out, sizeof(out));
+    TEST_CHECK(got == LOGBUF_MAX_RECORD);
+    TEST_CHECK(memcmp(out, in, LOGBUF_MAX_RECORD) == 0);
+
+    TEST_CHECK(LogBuf_Write(&in[LOGBUF_MAX_RECORD], sizeof(in) - LOGBUF_MAX_RECORD, 0));
+    got = LogBuf_Read(out, sizeof(out));
+    TEST_CHECK(got == sizeof(in) - LOGBUF_MAX_RECORD);
+    TEST_CHECK(memcmp(out, &in[LOGBUF_MAX_RECORD], got) == 0);
+}
+
+static void TestConcurrentProducers(void)
+{
+    uint32_t stalled;
+
+    Test_Case("8 preempted producers: no torn or interleaved records");
+
+    LogBuf_Init(xTaskGetCurrentTaskHandle());
+    ParserReset();
+    preempt_after_reserve = 0;
+    hook_preempt_every = 3;
+
+    StartProducers(RECORDS_EACH, portMAX_DELAY, LogBuf_Write);
+    stalled = Consume(false);
+    hook_preempt_every = 0;
+
+    TEST_CHECK(parser.records == (uint32_t)PRODUCERS * RECORDS_EACH);
+    for (uint8_t i = 0; i < PRODUCERS; i++) {
+        TEST_CHECK(producers[i].written == RECORDS_EACH);
+        TEST_CHECK(producers[i].failed == 0);
+        TEST_CHECK(parser.next_seq[i] == RECORDS_EACH);
+    }
+    TEST_CHECK(LogBuf_GetDropped() == 0);
+
+    /* Otherwise the out-of-order commit path was never exercised */
+    TEST_CHECK(preempt_after_reserve > 0);
+    Test_Note("%lu preemptions between reserve and commit, consumer held back %lu times",
+              (unsigned long)preempt_after_reserve, (unsigned long)stalled);
+}
+
+static void TestDroppedCount(void)
+{
+    uint32_t failed = 0;
+    uint32_t written = 0;
+
+    Test_Case("dropped count matches the failed writes");
+
+    LogBuf_Init(xTaskGetCurrentTaskHandle());
+    ParserReset();
+    hook_preempt_every = 3;
+
+    /* No waiting: producers outrun the consumer, which reads once per tick */
+    StartProducers(RECORDS_EACH, 0, LogBuf_Write);
+    (void)Consume(true);
+    hook_preempt_every = 0;
+
+    for (uint8_t i = 0; i < PRODUCERS; i++) {
+        failed += producers[i].failed;
+        written += producers[i].written;
+    }
+    TEST_CHECK(failed > 0);
+    TEST_CHECK(written + failed == (uint32_t)PRODUCERS * RECORDS_EACH);
+    TEST_CHECK(parser.records == written);
+    TEST_CHECK(LogBuf_GetDropped() == failed);
+    Test_Note("%lu of %u records dropped", (unsigned long)failed,
+              PRODUCERS * RECORDS_EACH);
+
+    /* A timed write that never finds space is one more drop */
+    LogBuf_Init(NULL);
+    while (LogBuf_Write("0123456789", 10, 0)) {
+    }
+    TEST_CHECK(LogBuf_GetDropped() == 1);
+    TEST_CHECK(LogBuf_Write("0123456789", 10, 3) == false);
+    TEST_CHECK(LogBuf_GetDropped() == 2);
+}
+
+static uint64_t BenchUncontended(WriteFn_t write)
+{
+    char payload[BENCH_PAYLOAD];
+    uint8_t out[BENCH_PAYLOAD];
+    uint64_t cycles = 0;
+
+    memset(payload, 'x', sizeof(payload));
+    for (uint16_t i = 0; i < BENCH_RECORDS; i++) {
+        uint64_t t0 = Test_Cycles();
+
+        (void)write(payload, sizeof(payload), 0);
+        cycles += Test_Cycles() - t0;
+        (void)LogBuf_Read(out, sizeof(out));
+    }
+    return cycles / BENCH_RECORDS;
+}
+
+static void BenchContended(const char *name, WriteFn_t write)
+{
+    unsigned long yields = ulPortYieldCount;
+    uint64_t t0;
+
+    LogBuf_Init(NULL);
+    ParserReset();
+    hook_seed = 1;
+    hook_preempt_every = 3;
+
+    t0 = Test_Cycles();
+    StartProducers(RECORDS_EACH, portMAX_DELAY, write);
+    while (!AllDone()) {
+        uint8_t chunk[READ_CHUNK];
+
+        while (LogBuf_Read(chunk, sizeof(chunk)) > 0) {
+        }
+        vTaskDelay(1);
+    }
+    hook_preempt_every = 0;
+
+    Test_Note("%-6s contended:   %llu cycles/record, %lu context switches",
+              name, (unsigned long long)((Test_Cycles() - t0) / (PRODUCERS * RECORDS_EACH)),
+              ulPortYieldCount - yields);
+}
+
+static void BenchVersusMutex(void)
+{
+    Test_Case("benchmark: LogBuf_Write against a mutex-protected ring");
+
+    xRingMutex = xSemaphoreCreateMutex();
+    TEST_CHECK(xRingMutex != NULL);
+
+    LogBuf_Init(NULL);
+    Test_Note("logbuf uncontended: %llu cycles per %u-byte record",
+              (unsigned long long)BenchUncontended(LogBuf_Write), BENCH_PAYLOAD);
+    Test_Note("mutex  uncontended: %llu cycles per %u-byte record",
+              (unsigned long long)BenchUncontended(MutexRingWrite), BENCH_PAYLOAD);
+
+    BenchContended("logbuf", LogBuf_Write);
+    BenchContended("mutex", MutexRingWrite);
+}
+
+static void TestBody(void *pvParameters)
+{
+    vPortSetInterruptHook(InterruptHook);
+
+    TestSingleRecord();
+    TestSplitRecord();
+    TestConcurrentProducers();
+    TestDroppedCount();
+    BenchVersusMutex();
+}
+
+int main(void)
+{
+    Test_Run(TestBody);
+    return 0;
+}
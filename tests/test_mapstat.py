@@ -0,0 +1,199 @@
+#!/usr/bin/env python3
+"""
+File:   test_mapstat.py
+Author: ENCM 511
+
+Linker Map Analyzer Tests (tools/mapstat.py)
+
+Description: Runs tools/mapstat.py on the production and debug maps under
+             dist/default/ and checks the report against memoryfile.xml,
+             which MPLAB X writes from the same link: the per-module flash
+             and RAM bytes must add up to its "used" figures exactly, each
+             module's sections to its own totals, and the debugger's RAM
+             reservation (debug build only) must be charged somewhere.
+             Then a map with one output section taken out of the layout must
+             fail the tool's own cross-check against the linker summary, and
+             --diff of the two reports must run.
+
+             Same output and exit status as the C tests (testing.c).
+
+Created on Nov 2025
+"""
+
+import json
+import os
+import subprocess
+import sys
+import tempfile
+import xml.etree.ElementTree as ET
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+REPO = os.path.dirname(HERE)
+MAPSTAT = os.path.join(REPO, "tools", "mapstat.py")
+DIST = os.path.join(REPO, "dist", "default")
+CONFIGS = ("production", "debug")
+
+cases = 0
+checks = 0
+
+
+def test_case(name):
+    global cases
+    cases += 1
+    print("  %s" % name)
+
+
+def test_note(text):
+    print("    %s" % text)
+
+
+def test_check(ok, expr):
+    global checks
+    if not ok:
+        line = sys._getframe(1).f_lineno
+        sys.stderr.write("%s:%d: check failed: %s\n" % (os.path.basename(__file__), line, expr))
+        sys.exit(1)
+    checks += 1
+
+
+#=============================================================================
+# HELPERS
+#=============================================================================
+
+def map_path(config):
+    return os.path.join(DIST, config, "freertos-start.X 2.%s.map" % config)
+
+
+def memory_used(config):
+    """{"program": bytes, "data": bytes} from memoryfile.xml"""
+    root = ET.parse(os.path.join(DIST, config, "memoryfile.xml")).getroot()
+    used = {}
+    for mem in root.iter("memory"):
+        test_check(mem.findtext("units") == "bytes", "memoryfile units are bytes")
+        used[mem.get("name")] = int(mem.findtext("used"))
+    return used
+
+
+def run_mapstat(args):
+    """(exit status, stderr) of one mapstat.py run"""
+    proc = subprocess.run([sys.executable, MAPSTAT] + args,
+                          stdout=subprocess.DEVNULL, stderr=subprocess.PIPE,
+                          universal_newlines=True)
+    return proc.returncode, proc.stderr
+
+
+def report(config, out_dir, extra=()):
+    out = os.path.join(out_dir, "%s.json" % config)
+    status, err = run_mapstat([map_path(config), "-o", out] + list(extra))
+    test_check(status == 0, "mapstat exit status 0 (%s): %s" % (config, err.strip()))
+    with open(out) as f:
+        return json.load(f), out
+
+
+#=============================================================================
+# TEST CASES
+#=============================================================================
+
+def test_against_memoryfile(out_dir):
+    test_case("per-module totals add up to memoryfile.xml")
+
+    for config in CONFIGS:
+        rep, _ = report(config, out_dir, ["--no-elf"])
+        used = memory_used(config)
+        modules = rep["modules"]
+        flash = sum(m["flash_bytes"] for m in modules.values())
+        ram = sum(m["ram_bytes"] for m in modules.values())
+
+        test_check(flash == used["program"], "%s: module flash %d == program used %d"
+                   % (config, flash, used["program"]))
+        test_check(ram == used["data"], "%s: module RAM %d == data used %d"
+                   % (config, ram, used["data"]))
+        test_check(rep["totals"]["flash_bytes"] == used["program"], "totals.flash_bytes")
+        test_check(rep["totals"]["ram_bytes"] == used["data"], "totals.ram_bytes")
+        test_check(rep["linker_summary"] == {"flash_bytes": used["program"],
+                                             "ram_bytes": used["data"]}, "linker_summary")
+        test_check(sum(m["vector_bytes"] for m in modules.values()) ==
+                   rep["totals"]["vector_bytes"], "module vector bytes add up")
+
+        for name, m in modules.items():
+            own = m["flash_bytes"] + m["ram_bytes"] + m["vector_bytes"]
+            test_check(min(m["flash_bytes"], m["ram_bytes"], m["vector_bytes"]) >= 0,
+                       "%s: no negative totals" % name)
+            test_check(sum(m["sections"].values()) == own,
+                       "%s: sections add up to the module" % name)
+
+        for src in ("main.c", "uart.c", "FreeRTOS/tasks.c", "FreeRTOS/queue.c"):
+            test_check(src in modules and modules[src]["flash_bytes"] > 0,
+                       "%s: %s has flash" % (config, src))
+
+        reserved = modules.get("<reserved>", {}).get("ram_bytes", 0)
+        test_check((reserved > 0) == (config == "debug"),
+                   "%s: debugger RAM reservation only in the debug build" % config)
+        test_note("%-10s flash %5d = program used, RAM %4d = data used, %2d modules, "
+                  "%d bytes reserved" % (config, flash, ram, len(modules), reserved))
+
+
+def test_elf_symbols(out_dir):
+    test_case("with the ELF: same module totals, symbols placed in modules")
+
+    elf = [n for n in os.listdir(os.path.join(DIST, "production")) if n.endswith(".elf")]
+    if not elf:
+        test_note("no production ELF: skipped")
+        return
+    plain, _ = report("production", out_dir, ["--no-elf"])
+    rep, _ = report("production", out_dir, ["--top", "10"])
+
+    test_check(rep["symbol_source"] == "elf", "symbol_source is elf")
+    test_check(rep["modules"] == plain["modules"], "module totals do not depend on the ELF")
+    test_check(len(rep["largest_symbols"]) == 10, "--top 10")
+    for sym in rep["largest_symbols"]:
+        test_check(sym["module"] in rep["modules"], "%s is in a known module" % sym["name"])
+        test_check(0 < sym["bytes"] <= rep["modules"][sym["module"]][
+            {"flash": "flash_bytes", "ram": "ram_bytes", "vectors": "vector_bytes"}[sym["region"]]],
+            "%s fits in its module" % sym["name"])
+    test_note("largest: %s, %d bytes (%s)" % (rep["largest_symbols"][0]["name"],
+                                              rep["largest_symbols"][0]["bytes"],
+                                              rep["largest_symbols"][0]["module"]))
+
+
+def test_regression_caught(out_dir):
+    test_case("layout missing an output section: exit status 1")
+
+    with open(map_path("production"), errors="replace") as f:
+        lines = f.readlines()
+    start = next(i for i, l in enumerate(lines) if l.startswith("Linker script and memory map"))
+    drop = next(i for i in range(start, len(lines)) if lines[i].startswith(".nbss"))
+    broken = os.path.join(out_dir, "broken.map")
+    with open(broken, "w") as f:
+        f.writelines(lines[:drop] + lines[drop + 1:])
+
+    status, err = run_mapstat([broken, "--no-elf", "-o", os.path.join(out_dir, "broken.json")])
+    test_check(status == 1, "exit status 1")
+    test_check(err.startswith("mapstat: ram: attributed"), "RAM against the linker summary")
+    test_note(err.strip().splitlines()[0])
+
+
+def test_diff(out_dir):
+    test_case("--diff production debug")
+
+    _, prod = report("production", out_dir, ["--no-elf"])
+    _, debug = report("debug", out_dir, ["--no-elf"])
+    proc = subprocess.run([sys.executable, MAPSTAT, "--diff", prod, debug],
+                          stdout=subprocess.PIPE, universal_newlines=True)
+    test_check(proc.returncode == 0, "exit status 0")
+    test_check("ram_bytes" in proc.stdout and "<reserved> ram" in proc.stdout,
+               "RAM change and the reservation listed")
+
+
+def main():
+    with tempfile.TemporaryDirectory() as out_dir:
+        test_against_memoryfile(out_dir)
+        test_elf_symbols(out_dir)
+        test_regression_caught(out_dir)
+        test_diff(out_dir)
+    print("  %u cases, %u checks passed" % (cases, checks))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,421 @@
+/*
+ * File:   test_pingpong.c
+ * Author: ENCM 511
+ *
+ * Ping-Pong Block Buffer Tests (pingpong.c)
+ *
+ * Description: The handover rules first, from task context: a swap
+ *              publishes a block, a second one before it is received
+ *              replaces it, a swap while the consumer holds its block keeps
+ *              the producer on its own half, and the overflow count
+ *              saturates. Then PingPong_Receive() waits: portMAX_DELAY past
+ *              a stale notification and the 16-bit tick wrap, a finite wait
+ *              that still ends on time, and a consumer notified by bits.
+ *
+ *              Rate mismatch: an ISR producer on the tick interrupt point
+ *              writes one word per tick and swaps every BLOCK_WORDS ticks,
+ *              while the test task consumes. A consumer faster than the
+ *              producer gets every block in order; a slower one loses whole
+ *              blocks, exactly as many as the overflow count says, and
+ *              never sees a block change while it holds it.
+ *
+ *              Last, host cycles for one block handed over and read back,
+ *              against xStreamBufferSendFromISR() and xStreamBufferReceive()
+ *              for the same bytes.
+ *
+ * Created on Nov 2025
+ */
+
+#include "testing.h"
+#include "pingpong.h"
+#include "stream_buffer.h"
+#include <stdbool.h>
+#include <string.h>
+
+#define BLOCK_WORDS     8           /* Producer block: one word per tick */
+#define RATE_BLOCKS     200         /* Blocks received per rate run */
+#define NOTIFY_BIT      0x40UL
+
+#define BENCH_ROUNDS    2000        /* Handovers per timed run */
+#define BENCH_RUNS      15          /* Best run is reported */
+#define BENCH_MAX       256
+
+static PingPong_t pp;
+static uint16_t storage[2 * BLOCK_WORDS];
+static TaskHandle_t test_task;
+
+/* Tick producer (Producer()) */
+static volatile bool producing;
+static uint16_t *fill_block;
+static uint8_t fill;
+static uint16_t next_word;
+static uint32_t swaps;              /* Blocks the producer finished */
+static uint32_t kept;               /* Swaps refused: consumer held its half */
+
+/*============================================================================
+ * HELPERS
+ *============================================================================*/
+
+/* ISR at the kernel IPL, as the ADC scan: one word per tick, swap when full */
+static BaseType_t Producer(PortInterruptPoint_t where)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    uint16_t *next;
+
+    if (where != portINTERRUPT_AT_TICK || !producing) {
+        return pdFALSE;
+    }
+    fill_block[fill++] = next_word++;
+    if (fill == BLOCK_WORDS) {
+        next = (uint16_t *)PingPong_SwapFromISR(&pp, sizeof(uint16_t) * BLOCK_WORDS,
+                                                &xHigherPriorityTaskWoken);
+        if (next == fill_block) {
+            kept++;
+        }
+        fill_block = next;
+        fill = 0;
+        swaps++;
+    }
+    return xHigherPriorityTaskWoken;
+}
+
+static void InitBuffer(TaskHandle_t consumer, uint32_t notify_bits)
+{
+    memset(storage, 0, sizeof(storage));
+    PingPong_Init(&pp, (uint8_t *)storage, sizeof(uint16_t) * BLOCK_WORDS,
+                  consumer, notify_bits);
+}
+
+/* Above the test task: a stale notification, then a block swap_after ticks
+ * later (never if 0), delaying in steps so the port sees switches */
+static void LateProducer(void *pvParameters)
+{
+    uint32_t swap_after = *(const uint32_t *)pvParameters;
+    uint16_t *block = (uint16_t *)PingPong_ProducerBlock(&pp);
+
+    vTaskDelay(10);
+    (void)xTaskNotifyGive(test_task);
+    while (swap_after > 10) {
+        TickType_t step = (swap_after - 10 > 10000) ? 10000 : (TickType_t)(swap_after - 10);
+
+        vTaskDelay(step);
+        swap_after -= step;
+    }
+    if (swap_after != 0) {
+        block[0] = 0xBEEF;
+        (void)PingPong_Swap(&pp, sizeof(uint16_t));
+    }
+    vTaskSuspend(NULL);
+}
+
+static void WaitWithBits(void *arg)
+{
+    uint16_t len;
+
+    (void)arg;
+    InitBuffer(xTaskGetCurrentTaskHandle(), NOTIFY_BIT);
+    (void)PingPong_Receive(&pp, &len, 1);
+}
+
+typedef struct {
+    uint32_t received;
+    uint32_t pending;               /* Published, not received at the end */
+} RateResult_t;
+
+/* Receive RATE_BLOCKS blocks from the tick producer. in_place: the block
+ * is held for hold ticks before it is released; otherwise it is copied
+ * out, released, and the copy takes the hold ticks. */
+static void RunRate(TickType_t hold, bool in_place, RateResult_t *r)
+{
+    uint16_t copy[BLOCK_WORDS];
+    int32_t last_first = -1;
+    uint16_t len;
+
+    InitBuffer(test_task, 0);
+    fill_block = (uint16_t *)PingPong_ProducerBlock(&pp);
+    fill = 0;
+    next_word = 0;
+    swaps = 0;
+    kept = 0;
+    producing = true;
+
+    for (r->received = 0; r->received < RATE_BLOCKS; r->received++) {
+        const uint16_t *block = (const uint16_t *)PingPong_Receive(&pp, &len, portMAX_DELAY);
+        bool whole = true;
+
+        TEST_CHECK(block != NULL);
+        TEST_CHECK(len == sizeof(copy));
+        memcpy(copy, block, sizeof(copy));
+
+        /* Whole blocks only, newer than the last */
+        for (uint8_t i = 1; i < BLOCK_WORDS; i++) {
+            whole = whole && copy[i] == copy[0] + i;
+        }
+        TEST_CHECK(whole);
+        TEST_CHECK(copy[0] % BLOCK_WORDS == 0);
+        TEST_CHECK((int32_t)copy[0] > last_first);
+        last_first = copy[0];
+
+        if (in_place) {
+            vTaskDelay(hold);
+            TEST_CHECK(memcmp(copy, block, sizeof(copy)) == 0);
+            PingPong_Release(&pp);
+        } else {
+            PingPong_Release(&pp);
+            vTaskDelay(hold);
+        }
+    }
+    producing = false;
+
+    r->pending = 0;
+    if (PingPong_Receive(&pp, &len, 0) != NULL) {
+        PingPong_Release(&pp);
+        r->pending = 1;
+    }
+}
+
+/*============================================================================
+ * TEST CASES
+ *============================================================================*/
+
+static void TestSwapReceive(void)
+{
+    uint16_t *mine;
+    const uint8_t *block;
+    uint16_t len;
+
+    Test_Case("swap publishes, receive takes, release frees; length clamped");
+
+    InitBuffer(NULL, 0);
+    mine = (uint16_t *)PingPong_ProducerBlock(&pp);
+    TEST_CHECK(mine == &storage[0]);
+    TEST_CHECK(PingPong_Receive(&pp, &len, 0) == NULL);
+
+    mine[0] = 11;
+    mine = (uint16_t *)PingPong_Swap(&pp, 3);
+    TEST_CHECK(mine == &storage[BLOCK_WORDS]);
+    block = PingPong_Receive(&pp, &len, 0);
+    TEST_CHECK(block == (const uint8_t *)&storage[0] && len == 3);
+    TEST_CHECK(((const uint16_t *)block)[0] == 11);
+    PingPong_Release(&pp);
+    TEST_CHECK(PingPong_Receive(&pp, &len, 0) == NULL);
+
+    mine = (uint16_t *)PingPong_Swap(&pp, 0xFFFF);
+    TEST_CHECK(mine == &storage[0]);
+    block = PingPong_Receive(&pp, &len, 0);
+    TEST_CHECK(block == (const uint8_t *)&storage[BLOCK_WORDS]);
+    TEST_CHECK(len == sizeof(uint16_t) * BLOCK_WORDS);
+    PingPong_Release(&pp);
+    TEST_CHECK(PingPong_GetOverflows(&pp) == 0);
+}
+
+static void TestOverflows(void)
+{
+    uint16_t *mine;
+    const uint16_t *block;
+    uint16_t len;
+
+    Test_Case("overflows: READY replaced, TAKEN kept, count saturates");
+
+    InitBuffer(NULL, 0);
+    mine = (uint16_t *)PingPong_ProducerBlock(&pp);
+    mine[0] = 1;
+    mine = (uint16_t *)PingPong_Swap(&pp, 2);
+    mine[0] = 2;
+    mine = (uint16_t *)PingPong_Swap(&pp, 2);      /* Block 1 never received */
+    TEST_CHECK(PingPong_GetOverflows(&pp) == 1);
+    TEST_CHECK(mine == &storage[0]);
+
+    block = (const uint16_t *)PingPong_Receive(&pp, &len, 0);
+    TEST_CHECK(block != NULL && block[0] == 2);
+    mine[0] = 3;
+    TEST_CHECK((uint16_t *)PingPong_Swap(&pp, 2) == mine);  /* Consumer holds 2 */
+    TEST_CHECK(PingPong_GetOverflows(&pp) == 2);
+    TEST_CHECK(block[0] == 2);
+    PingPong_Release(&pp);
+
+    mine[0] = 4;
+    (void)PingPong_Swap(&pp, 2);
+    block = (const uint16_t *)PingPong_Receive(&pp, &len, 0);
+    TEST_CHECK(block != NULL && block[0] == 4);
+    PingPong_Release(&pp);
+
+    for (uint32_t i = 0; i < 70000; i++) {
+        (void)PingPong_Swap(&pp, 2);
+    }
+    TEST_CHECK(PingPong_GetOverflows(&pp) == 0xFFFF);
+}
+
+static void TestWaits(void)
+{
+    static uint32_t never = 0;
+    static uint32_t late = 70000;   /* Past the 16-bit tick wrap */
+    const uint16_t *block;
+    uint32_t bits = 0;
+    TickType_t start;
+    uint16_t len;
+
+    Test_Case("waits: portMAX_DELAY across a stale wake and the tick wrap, "
+              "finite wait, notify by bits");
+
+    /* Finite: the stale wake at 10 ticks must not cut the wait short */
+    InitBuffer(test_task, 0);
+    TEST_CHECK(xTaskCreate(LateProducer, "LATE1", configMINIMAL_STACK_SIZE, &never,
+                           TEST_PRIO_HIGH, NULL) == pdPASS);
+    start = xTaskGetTickCount();
+    TEST_CHECK(PingPong_Receive(&pp, &len, 50) == NULL);
+    TEST_CHECK((TickType_t)(xTaskGetTickCount() - start) == 50);
+
+    /* portMAX_DELAY: the block comes 70000 ticks later */
+    InitBuffer(test_task, 0);
+    TEST_CHECK(xTaskCreate(LateProducer, "LATE2", configMINIMAL_STACK_SIZE, &late,
+                           TEST_PRIO_HIGH, NULL) == pdPASS);
+    start = xTaskGetTickCount();
+    block = (const uint16_t *)PingPong_Receive(&pp, &len, portMAX_DELAY);
+    TEST_CHECK(block != NULL && block[0] == 0xBEEF && len == sizeof(uint16_t));
+    TEST_CHECK((TickType_t)(xTaskGetTickCount() - start) == (TickType_t)late);
+    PingPong_Release(&pp);
+    (void)ulTaskNotifyTake(pdTRUE, 0);
+
+    /* Bits: the consumer's other requests are left alone */
+    InitBuffer(test_task, NOTIFY_BIT);
+    (void)xTaskNotify(test_task, 0x01, eSetBits);
+    (void)PingPong_Swap(&pp, 2);
+    TEST_CHECK(xTaskNotifyWait(0, 0xFFFFFFFFUL, &bits, 0) == pdTRUE);
+    TEST_CHECK(bits == (0x01 | NOTIFY_BIT));
+    TEST_CHECK(PingPong_Receive(&pp, &len, 0) != NULL);
+    PingPong_Release(&pp);
+    Test_ExpectAssert(WaitWithBits, NULL);
+}
+
+static void TestFastConsumer(void)
+{
+    RateResult_t r;
+
+    Test_Case("consumer faster than the producer: every block, in order");
+
+    vPortSetInterruptHook(Producer);
+    RunRate(BLOCK_WORDS - 3, true, &r);
+    vPortSetInterruptHook(NULL);
+
+    TEST_CHECK(PingPong_GetOverflows(&pp) == 0 && kept == 0);
+    TEST_CHECK(swaps == r.received + r.pending);
+    TEST_CHECK(next_word >= RATE_BLOCKS * BLOCK_WORDS);
+    Test_Note("block every %u ticks, held %u: %lu of %lu blocks received",
+              BLOCK_WORDS, BLOCK_WORDS - 3, (unsigned long)r.received,
+              (unsigned long)swaps);
+}
+
+static void TestSlowConsumer(void)
+{
+    static const struct {
+        const char *name;
+        bool in_place;
+    } modes[] = {
+        { "held in place", true },
+        { "copied out    ", false }
+    };
+    RateResult_t r;
+
+    Test_Case("consumer slower: lost blocks == overflows, none torn");
+
+    for (uint8_t m = 0; m < 2; m++) {
+        uint16_t overflows;
+
+        vPortSetInterruptHook(Producer);
+        RunRate(2 * BLOCK_WORDS + 4, modes[m].in_place, &r);
+        vPortSetInterruptHook(NULL);
+        overflows = PingPong_GetOverflows(&pp);
+
+        TEST_CHECK(overflows > 0);
+        TEST_CHECK(swaps == r.received + overflows + r.pending);
+        /* Held: the producer refills its own half. Copied out: the
+         * published block is replaced. */
+        TEST_CHECK(kept == (modes[m].in_place ? overflows : 0U));
+        Test_Note("%s %u ticks: %lu received, %u lost (%lu refilled), "
+                  "%.0f%% of %lu blocks",
+                  modes[m].name, 2 * BLOCK_WORDS + 4, (unsigned long)r.received,
+                  overflows, (unsigned long)kept, 100.0 * overflows / swaps,
+                  (unsigned long)swaps);
+    }
+}
+
+static void TestVsStreamBuffer(void)
+{
+    static const uint16_t sizes[] = { 16, 64, BENCH_MAX };
+    static uint8_t half[2 * BENCH_MAX];
+    uint8_t block[BENCH_MAX];
+    uint8_t out[BENCH_MAX];
+
+    Test_Case("handover cost: ping-pong swap vs xStreamBufferSendFromISR");
+
+    for (uint8_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        uint16_t size = sizes[s];
+        StreamBufferHandle_t sb = xStreamBufferCreate(size, 1);
+        uint64_t best_pp = UINT64_MAX;
+        uint64_t best_sb = UINT64_MAX;
+        uint32_t sum = 0;
+
+        TEST_CHECK(sb != NULL);
+        PingPong_Init(&pp, half, size, NULL, 0);
+        memset(half, 0x5A, sizeof(half));
+        memset(block, 0x5A, sizeof(block));
+
+        for (uint8_t run = 0; run < BENCH_RUNS; run++) {
+            BaseType_t woken = pdFALSE;
+            uint64_t t0 = Test_Cycles();
+
+            /* In place: the producer filled its half, the consumer reads it */
+            for (uint16_t i = 0; i < BENCH_ROUNDS; i++) {
+                const uint8_t *got;
+                uint16_t len;
+
+                (void)PingPong_SwapFromISR(&pp, size, &woken);
+                got = PingPong_Receive(&pp, &len, 0);
+                sum += got[len - 1];
+                PingPong_Release(&pp);
+            }
+            t0 = Test_Cycles() - t0;
+            if (t0 < best_pp) {
+                best_pp = t0;
+            }
+
+            /* Copied in from the producer's block, out to the consumer's */
+            t0 = Test_Cycles();
+            for (uint16_t i = 0; i < BENCH_ROUNDS; i++) {
+                (void)xStreamBufferSendFromISR(sb, block, size, &woken);
+                sum += out[xStreamBufferReceive(sb, out, size, 0) - 1];
+            }
+            t0 = Test_Cycles() - t0;
+            if (t0 < best_sb) {
+                best_sb = t0;
+            }
+        }
+        TEST_CHECK(sum == 2UL * BENCH_RUNS * BENCH_ROUNDS * 0x5A);
+        TEST_CHECK(PingPong_GetOverflows(&pp) == 0);
+        Test_Note("%3u-byte block: ping-pong %4.0f host cycles, 0 bytes copied; "
+                  "stream buffer %4.0f, %u copied",
+                  size, (double)best_pp / BENCH_ROUNDS, (double)best_sb / BENCH_ROUNDS,
+                  2 * size);
+    }
+}
+
+static void RunTests(void *pvParameters)
+{
+    (void)pvParameters;
+
+    test_task = xTaskGetCurrentTaskHandle();
+
+    TestSwapReceive();
+    TestOverflows();
+    TestWaits();
+    TestFastConsumer();
+    TestSlowConsumer();
+    TestVsStreamBuffer();
+}
+
+int main(void)
+{
+    Test_Run(RunTests);
+    return 1;
+}
@@ -0,0 +1,222 @@
+/*
+ * File:   test_queue_bench.c
+ * Author: ENCM 511
+ *
+ * Queue Path Benchmarks
+ *
+ * Description: Host cycles for the queue calls the application makes most
+ *              often, with nobody waiting: a send and receive pair on
+ *              xButtonQueue-sized items, and a semaphore and a mutex give
+ *              and take. Then a send to a higher priority task blocked in
+ *              xQueueReceive(): the host cycles until that task has the
+ *              item, and the bytes the kernel copied for it (counted by
+ *              TEST_COUNT_COPIES in FreeRTOSConfig.h).
+ *
+ *              The Makefile builds this file twice, as test_queue_bench
+ *              with the kernel options of the target and as
+ *              test_queue_bench_off with configUSE_QUEUE_FAST_PATH and
+ *              configUSE_QUEUE_DIRECT_HANDOFF 0, so the two runs print the
+ *              new paths and the general paths one after the other.
+ *
+ * Created on Nov 2025
+ */
+
+#include "testing.h"
+#include "queue.h"
+#include "semphr.h"
+
+#define QUEUE_LENGTH    8
+#define BENCH_ROUNDS    2000        /* Pairs per timed run */
+#define BENCH_RUNS      15          /* Best run is reported */
+
+#define HANDOFF_ROUNDS  500
+
+#if ( configUSE_QUEUE_FAST_PATH == 1 )
+#define PATH_NAME       "fast path"
+#else
+#define PATH_NAME       "general path"
+#endif
+
+#if ( configUSE_QUEUE_DIRECT_HANDOFF == 1 )
+#define HANDOFF_NAME    "direct hand-off"
+#define HANDOFF_COPIES  1           /* Sender's item to receiver's buffer */
+#else
+#define HANDOFF_NAME    "through the storage area"
+#define HANDOFF_COPIES  2           /* In, then out again */
+#endif
+
+/* Same size as ButtonEvent_t on the target */
+typedef struct {
+    uint8_t button;
+    uint8_t event;
+    uint16_t ticks;
+} Item_t;
+
+/* A telemetry record's worth */
+typedef struct {
+    uint8_t bytes[32];
+} Record_t;
+
+static QueueHandle_t xQueue;
+static QueueHandle_t xRecordQueue;
+static volatile uint64_t receiver_done;    /* Test_Cycles() once it has the item */
+
+volatile unsigned long ulTestBytesCopied = 0;
+
+/*============================================================================
+ * HELPERS
+ *============================================================================*/
+
+typedef void (*BenchPair_t)(void *handle);
+
+static void SendReceive(void *handle)
+{
+    Item_t item = { 1, 2, 3 };
+
+    TEST_CHECK(xQueueSend(handle, &item, portMAX_DELAY) == pdPASS);
+    item.ticks = 0;
+    TEST_CHECK(xQueueReceive(handle, &item, portMAX_DELAY) == pdPASS);
+    TEST_CHECK(item.ticks == 3);
+}
+
+static void GiveTake(void *handle)
+{
+    TEST_CHECK(xSemaphoreGive(handle) == pdPASS);
+    TEST_CHECK(xSemaphoreTake(handle, portMAX_DELAY) == pdPASS);
+}
+
+static void TakeGive(void *handle)
+{
+    TEST_CHECK(xSemaphoreTake(handle, portMAX_DELAY) == pdPASS);
+    TEST_CHECK(xSemaphoreGive(handle) == pdPASS);
+}
+
+/* Above the test task: blocks, takes one item, blocks again */
+static void ReceiverTask(void *pvParameters)
+{
+    QueueHandle_t handle = pvParameters;
+    Record_t buffer;
+
+    for (;;) {
+        TEST_CHECK(xQueueReceive(handle, &buffer, portMAX_DELAY) == pdPASS);
+        receiver_done = Test_Cycles();
+    }
+}
+
+/* Host cycles per pair, best of BENCH_RUNS, and yields seen */
+static double Measure(BenchPair_t pair, void *handle, unsigned long *yields)
+{
+    uint64_t best = UINT64_MAX;
+    unsigned long yields_before = ulPortYieldCount;
+
+    for (uint8_t run = 0; run < BENCH_RUNS; run++) {
+        uint64_t t0 = Test_Cycles();
+
+        for (uint16_t i = 0; i < BENCH_ROUNDS; i++) {
+            pair(handle);
+        }
+        t0 = Test_Cycles() - t0;
+        if (t0 < best) {
+            best = t0;
+        }
+    }
+    *yields = ulPortYieldCount - yields_before;
+    return (double)best / BENCH_ROUNDS;
+}
+
+/*============================================================================
+ * TEST CASES
+ *============================================================================*/
+
+static void TestUncontended(void)
+{
+    static const struct {
+        const char *name;
+        BenchPair_t pair;
+    } benches[] = {
+        { "queue send + receive", SendReceive },
+        { "semaphore give + take", GiveTake },
+        { "mutex take + give", TakeGive }
+    };
+    void *handles[3];
+
+    Test_Case("no waiter, " PATH_NAME ": host cycles per pair");
+
+    handles[0] = xQueue;
+    handles[1] = xSemaphoreCreateBinary();
+    handles[2] = xSemaphoreCreateMutex();
+    TEST_CHECK(handles[1] != NULL && handles[2] != NULL);
+
+    for (uint8_t b = 0; b < 3; b++) {
+        unsigned long yields;
+        double cycles = Measure(benches[b].pair, handles[b], &yields);
+
+        /* Nobody waits, so neither path may switch tasks */
+        TEST_CHECK(yields == 0);
+        Test_Note("%-22s %7.1f cycles", benches[b].name, cycles);
+    }
+}
+
+static void TestHandOff(void)
+{
+    QueueHandle_t queues[2];
+    const char *names[2] = { "button event", "32-byte record" };
+
+    Test_Case("send to a blocked receiver, " HANDOFF_NAME ": latency and bytes copied");
+
+    queues[0] = xQueue;
+    queues[1] = xRecordQueue;
+    for (uint8_t q = 0; q < 2; q++) {
+        uint64_t best = UINT64_MAX;
+        uint64_t total = 0;
+        unsigned long size = uxQueueGetQueueItemSize(queues[q]);
+        unsigned long copied;
+        Record_t item = { { 0 } };
+        TaskHandle_t receiver;
+
+        TEST_CHECK(xTaskCreate(ReceiverTask, "RECV", configMINIMAL_STACK_SIZE,
+                               queues[q], TEST_PRIO_HIGH, &receiver) == pdPASS);
+
+        copied = ulTestBytesCopied;
+        for (uint16_t i = 0; i < HANDOFF_ROUNDS; i++) {
+            uint64_t t0;
+
+            item.bytes[0] = (uint8_t)i;
+            t0 = Test_Cycles();
+            TEST_CHECK(xQueueSend(queues[q], &item, 0) == pdPASS);
+            TEST_CHECK(receiver_done > t0);
+
+            /* The receiver has run and blocked again */
+            TEST_CHECK(uxQueueMessagesWaiting(queues[q]) == 0);
+            total += receiver_done - t0;
+            if (receiver_done - t0 < best) {
+                best = receiver_done - t0;
+            }
+        }
+        copied = ulTestBytesCopied - copied;
+
+        TEST_CHECK(copied == (unsigned long)HANDOFF_ROUNDS * HANDOFF_COPIES * size);
+        Test_Note("%-15s %lu bytes copied per item, %.0f cycles best, %.0f mean",
+                  names[q], copied / HANDOFF_ROUNDS, (double)best,
+                  (double)total / HANDOFF_ROUNDS);
+        vTaskSuspend(receiver);     /* heap_1 cannot free a deleted task */
+    }
+}
+
+static void RunTests(void *pvParameters)
+{
+    (void)pvParameters;
+
+    xQueue = xQueueCreate(QUEUE_LENGTH, sizeof(Item_t));
+    xRecordQueue = xQueueCreate(QUEUE_LENGTH, sizeof(Record_t));
+    TEST_CHECK(xQueue != NULL && xRecordQueue != NULL);
+
+    TestUncontended();
+    TestHandOff();
+}
+
+int main(void)
+{
+    Test_Run(RunTests);
+    return 1;
+}
@@ -0,0 +1,194 @@
+/*
+ * File:   test_queue_fastpath.c
+ * Author: ENCM 511
+ *
+ * Queue Fast Path Tests (configUSE_QUEUE_FAST_PATH)
+ *
+ * Description: The fast path must complete send, receive and take without
+ *              a yield when nobody is waiting, and must step aside as soon
+ *              as a task is blocked on the other side, so that task is
+ *              still woken. ulPortYieldCount tells the two paths apart.
+ *              A call that could block with the scheduler suspended must
+ *              still assert, even when the fast path would succeed.
+ *
+ * Created on Nov 2025
+ */
+
+#include "testing.h"
+#include "queue.h"
+#include "semphr.h"
+
+#define QUEUE_LENGTH    2
+
+static QueueHandle_t xQueue;
+static volatile int helper_step = 0;
+
+/* Blocks sending a third item into the full queue */
+static void BlockedSenderTask(void *pvParameters)
+{
+    int value = 3;
+
+    (void)pvParameters;
+    helper_step = 1;
+    TEST_CHECK(xQueueSend(xQueue, &value, portMAX_DELAY) == pdPASS);
+    helper_step = 2;
+    vTaskSuspend(NULL);     /* heap_1 cannot free a deleted task */
+}
+
+/* Blocks receiving from the empty queue */
+static void BlockedReceiverTask(void *pvParameters)
+{
+    int value = 0;
+
+    (void)pvParameters;
+    helper_step = 1;
+    TEST_CHECK(xQueueReceive(xQueue, &value, portMAX_DELAY) == pdPASS);
+    helper_step = 10 + value;
+    vTaskSuspend(NULL);     /* heap_1 cannot free a deleted task */
+}
+
+/* With the scheduler suspended, each call would succeed on the fast path
+ * but asks to wait: each must hit the configASSERT */
+static void SuspendedSend(void *arg)
+{
+    int value = 1;
+
+    (void)arg;
+    vTaskSuspendAll();
+    (void)xQueueSend(xQueue, &value, 10);
+}
+
+static void SuspendedReceive(void *arg)
+{
+    int value = 1;
+
+    (void)arg;
+    TEST_CHECK(xQueueSend(xQueue, &value, 0) == pdPASS);
+    vTaskSuspendAll();
+    (void)xQueueReceive(xQueue, &value, 10);
+}
+
+static void SuspendedTake(void *arg)
+{
+    SemaphoreHandle_t xSem = xSemaphoreCreateCounting(1, 1);
+
+    (void)arg;
+    vTaskSuspendAll();
+    (void)xSemaphoreTake(xSem, 10);
+}
+
+static void TestUncontended(void)
+{
+    SemaphoreHandle_t xSem;
+    unsigned long yields;
+    int value = 0;
+
+    Test_Case("no waiter: send, receive and take without a yield");
+
+    xSem = xSemaphoreCreateCounting(2, 2);
+    TEST_CHECK(xSem != NULL);
+
+    yields = ulPortYieldCount;
+    value = 1;
+    TEST_CHECK(xQueueSend(xQueue, &value, portMAX_DELAY) == pdPASS);
+    value = 2;
+    TEST_CHECK(xQueueSend(xQueue, &value, portMAX_DELAY) == pdPASS);
+    TEST_CHECK(xQueueReceive(xQueue, &value, portMAX_DELAY) == pdPASS);
+    TEST_CHECK(value == 1);
+    TEST_CHECK(xQueueReceive(xQueue, &value, portMAX_DELAY) == pdPASS);
+    TEST_CHECK(value == 2);
+    TEST_CHECK(xSemaphoreTake(xSem, portMAX_DELAY) == pdPASS);
+    TEST_CHECK(uxSemaphoreGetCount(xSem) == 1);
+    TEST_CHECK(ulPortYieldCount == yields);
+
+    /* Full and empty still fail immediately without a wait */
+    value = 1;
+    TEST_CHECK(xQueueSend(xQueue, &value, 0) == pdPASS);
+    TEST_CHECK(xQueueSend(xQueue, &value, 0) == pdPASS);
+    TEST_CHECK(xQueueSend(xQueue, &value, 0) == errQUEUE_FULL);
+    TEST_CHECK(xQueueReceive(xQueue, &value, 0) == pdPASS);
+    TEST_CHECK(xQueueReceive(xQueue, &value, 0) == pdPASS);
+    TEST_CHECK(xQueueReceive(xQueue, &value, 0) == errQUEUE_EMPTY);
+}
+
+static void TestReceiveWakesSender(void)
+{
+    int value = 0;
+
+    Test_Case("receive from a full queue wakes the blocked sender");
+
+    value = 1;
+    TEST_CHECK(xQueueSend(xQueue, &value, 0) == pdPASS);
+    value = 2;
+    TEST_CHECK(xQueueSend(xQueue, &value, 0) == pdPASS);
+
+    helper_step = 0;
+    TEST_CHECK(xTaskCreate(BlockedSenderTask, "SEND", configMINIMAL_STACK_SIZE,
+                           NULL, TEST_PRIO_HIGH, NULL) == pdPASS);
+    TEST_CHECK(helper_step == 1);
+
+    /* The higher priority sender runs before this receive returns */
+    TEST_CHECK(xQueueReceive(xQueue, &value, 0) == pdPASS);
+    TEST_CHECK(value == 1);
+    TEST_CHECK(helper_step == 2);
+
+    TEST_CHECK(xQueueReceive(xQueue, &value, 0) == pdPASS);
+    TEST_CHECK(value == 2);
+    TEST_CHECK(xQueueReceive(xQueue, &value, 0) == pdPASS);
+    TEST_CHECK(value == 3);
+}
+
+static void TestSendWakesReceiver(void)
+{
+    int value = 7;
+
+    Test_Case("send to an empty queue wakes the blocked receiver");
+
+    helper_step = 0;
+    TEST_CHECK(xTaskCreate(BlockedReceiverTask, "RECV", configMINIMAL_STACK_SIZE,
+                           NULL, TEST_PRIO_HIGH, NULL) == pdPASS);
+    TEST_CHECK(helper_step == 1);
+
+    TEST_CHECK(xQueueSend(xQueue, &value, 0) == pdPASS);
+    TEST_CHECK(helper_step == 17);
+    TEST_CHECK(uxQueueMessagesWaiting(xQueue) == 0);
+}
+
+static void TestSuspendedScheduler(void)
+{
+    int value = 0;
+
+    Test_Case("scheduler suspended with a timeout: asserts ahead of the fast path");
+
+    Test_ExpectAssert(SuspendedSend, NULL);
+    Test_ExpectAssert(SuspendedReceive, NULL);
+    Test_ExpectAssert(SuspendedTake, NULL);
+
+    /* A zero timeout is allowed and takes the fast path */
+    vTaskSuspendAll();
+    value = 5;
+    TEST_CHECK(xQueueSend(xQueue, &value, 0) == pdPASS);
+    value = 0;
+    TEST_CHECK(xQueueReceive(xQueue, &value, 0) == pdPASS);
+    (void)xTaskResumeAll();
+    TEST_CHECK(value == 5);
+}
+
+static void RunTests(void *pvParameters)
+{
+    (void)pvParameters;
+
+    xQueue = xQueueCreate(QUEUE_LENGTH, sizeof(int));
+    TEST_CHECK(xQueue != NULL);
+
+    TestUncontended();
+    TestReceiveWakesSender();
+    TestSendWakesReceiver();
+    TestSuspendedScheduler();
+}
+
+int main(void)
+{
+    Test_Run(RunTests);
+    return 1;
+}
@@ -0,0 +1,146 @@
+/*
+ * File:   test_queue_handoff.c
+ * Author: ENCM 511
+ *
+ * Direct Hand-Off Tests (configUSE_QUEUE_DIRECT_HANDOFF)
+ *
+ * Description: Receivers run below the test task, so after a send the
+ *              test can look at the receiver's buffer and the queue count
+ *              before the receiver runs: a hand-off has already filled the
+ *              buffer and left the queue empty, a queued item has not.
+ *
+ * Created on Nov 2025
+ */
+
+#include "testing.h"
+#include "queue.h"
+
+#define QUEUE_LENGTH    4
+#define NO_ITEM         (-1)
+
+typedef struct {
+    TickType_t wait;
+    volatile int buffer;        /* Passed to xQueueReceive() */
+    volatile int step;          /* 1 = about to block, 2 = received, 3 = timed out */
+} Receiver_t;
+
+static QueueHandle_t xQueue;
+static Receiver_t receivers[2];
+
+static void ReceiverTask(void *pvParameters)
+{
+    Receiver_t *r = pvParameters;
+
+    r->step = 1;
+    if (xQueueReceive(xQueue, (void *)&r->buffer, r->wait) == pdPASS) {
+        r->step = 2;
+    } else {
+        r->step = 3;
+    }
+    vTaskSuspend(NULL);     /* heap_1 cannot free a deleted task */
+}
+
+static void StartReceiver(Receiver_t *r, TickType_t wait)
+{
+    r->wait = wait;
+    r->buffer = NO_ITEM;
+    r->step = 0;
+    TEST_CHECK(xTaskCreate(ReceiverTask, "RECV", configMINIMAL_STACK_SIZE,
+                           r, TEST_PRIO_LOW, NULL) == pdPASS);
+}
+
+/* Let the lower priority receivers run until they block or finish */
+static void LetReceiversRun(void)
+{
+    vTaskDelay(1);
+}
+
+static void Send(int value)
+{
+    TEST_CHECK(xQueueSend(xQueue, &value, 0) == pdPASS);
+}
+
+static void TestHandOff(void)
+{
+    Receiver_t *r = &receivers[0];
+
+    Test_Case("send to a blocked receiver copies into its buffer");
+
+    StartReceiver(r, portMAX_DELAY);
+    LetReceiversRun();
+    TEST_CHECK(r->step == 1);
+
+    Send(42);
+    TEST_CHECK(r->buffer == 42);
+    TEST_CHECK(r->step == 1);
+    TEST_CHECK(uxQueueMessagesWaiting(xQueue) == 0);
+
+    LetReceiversRun();
+    TEST_CHECK(r->step == 2);
+    TEST_CHECK(r->buffer == 42);
+}
+
+static void TestQueueNotEmpty(void)
+{
+    Receiver_t *r1 = &receivers[0];
+    Receiver_t *r2 = &receivers[1];
+    BaseType_t woken = pdFALSE;
+    int value = 1;
+
+    Test_Case("queue not empty: the item is queued, FIFO order kept");
+
+    StartReceiver(r1, portMAX_DELAY);
+    StartReceiver(r2, portMAX_DELAY);
+    LetReceiversRun();
+    TEST_CHECK(r1->step == 1 && r2->step == 1);
+
+    /* ISR sends never hand off: item 1 is queued and r1 is made ready */
+    TEST_CHECK(xQueueSendFromISR(xQueue, &value, &woken) == pdPASS);
+    TEST_CHECK(uxQueueMessagesWaiting(xQueue) == 1);
+
+    /* r2 is still blocked, but item 1 is ahead of item 2 */
+    Send(2);
+    TEST_CHECK(uxQueueMessagesWaiting(xQueue) == 2);
+    TEST_CHECK(r2->buffer == NO_ITEM);
+
+    LetReceiversRun();
+    TEST_CHECK(r1->step == 2 && r1->buffer == 1);
+    TEST_CHECK(r2->step == 2 && r2->buffer == 2);
+    TEST_CHECK(uxQueueMessagesWaiting(xQueue) == 0);
+}
+
+static void TestAfterTimeout(void)
+{
+    Receiver_t *r = &receivers[0];
+    int value = NO_ITEM;
+
+    Test_Case("receiver that timed out gets no hand-off");
+
+    StartReceiver(r, 5);
+    vTaskDelay(10);
+    TEST_CHECK(r->step == 3);
+
+    Send(9);
+    TEST_CHECK(r->buffer == NO_ITEM);
+    TEST_CHECK(uxQueueMessagesWaiting(xQueue) == 1);
+    TEST_CHECK(xQueueReceive(xQueue, &value, 0) == pdPASS);
+    TEST_CHECK(value == 9);
+}
+
+static void RunTests(void *pvParameters)
+{
+    (void)pvParameters;
+
+    xQueue = xQueueCreate(QUEUE_LENGTH, sizeof(int));
+    TEST_CHECK(xQueue != NULL);
+
+    TestHandOff();
+    TestQueueNotEmpty();
+    TestAfterTimeout();
+}
+
+int main(void)
+{
+    Test_Run(RunTests);
+    return 1;
+}
@@ -0,0 +1,319 @@
+/*
+ * File:   test_queue_matching.c
+ * Author: ENCM 511
+ *
+ * xQueueReceiveMatching() Tests
+ *
+ * Description: Items are ints; the predicate keeps the even ones, or the
+ *              one value passed as the context, the way the WAIT and COUNT
+ *              tasks pick their button out of xButtonQueue.
+ *
+ * Created on Nov 2025
+ */
+
+#include "testing.h"
+#include "queue.h"
+
+#define QUEUE_LENGTH    8
+#define BENCH_DEPTH_MAX 32
+#define BENCH_ROUNDS    2000
+
+typedef struct {
+    int button;                 /* Item this waiter filters for */
+    volatile int received;      /* 0 until xQueueReceiveMatching() returns */
+} ButtonWaiter_t;
+
+static QueueHandle_t xQueue;
+static volatile int helper_received = 0;
+
+volatile unsigned long ulTraceMatchingEnters = 0;
+volatile long lTraceMatchingReturn = 0;
+
+static BaseType_t MatchEven(const void *pvItem, void *pvContext)
+{
+    (void)pvContext;
+    return (*(const int *)pvItem % 2) == 0;
+}
+
+static BaseType_t MatchButton(const void *pvItem, void *pvContext)
+{
+    return *(const int *)pvItem == *(const int *)pvContext;
+}
+
+static void Send(int value)
+{
+    TEST_CHECK(xQueueSend(xQueue, &value, 0) == pdPASS);
+}
+
+static int Receive(void)
+{
+    int value = -1;
+
+    TEST_CHECK(xQueueReceive(xQueue, &value, 0) == pdPASS);
+    return value;
+}
+
+/* Blocks for an even item, then stores it in helper_received */
+static void MatchingReceiverTask(void *pvParameters)
+{
+    int value;
+
+    (void)pvParameters;
+    if (xQueueReceiveMatching(xQueue, &value, MatchEven, NULL, portMAX_DELAY) == pdPASS) {
+        helper_received = value;
+    }
+    vTaskSuspend(NULL);     /* heap_1 cannot free a deleted task */
+}
+
+/* Blocks for its own button, then records it */
+static void ButtonWaiterTask(void *pvParameters)
+{
+    ButtonWaiter_t *w = pvParameters;
+    int value;
+
+    if (xQueueReceiveMatching(xQueue, &value, MatchButton, &w->button, portMAX_DELAY) == pdPASS) {
+        w->received = value;
+    }
+    vTaskSuspend(NULL);     /* heap_1 cannot free a deleted task */
+}
+
+/* Leave pcReadFrom on slot `last` of an empty queue */
+static void MoveReadPosition(int last)
+{
+    for (int i = 0; i <= last; i++) {
+        Send(100);
+        TEST_CHECK(Receive() == 100);
+    }
+}
+
+static void TestBehindNonMatching(void)
+{
+    int value = -1;
+
+    Test_Case("matching item behind a non-matching one");
+
+    Send(1);
+    Send(2);
+    TEST_CHECK(xQueueReceiveMatching(xQueue, &value, MatchEven, NULL, 0) == pdPASS);
+    TEST_CHECK(value == 2);
+    TEST_CHECK(uxQueueMessagesWaiting(xQueue) == 1);
+
+    /* The item taken from the middle leaves the others in FIFO order */
+    Send(3);
+    Send(4);
+    Send(5);
+    TEST_CHECK(xQueueReceiveMatching(xQueue, &value, MatchEven, NULL, 0) == pdPASS);
+    TEST_CHECK(value == 4);
+    TEST_CHECK(Receive() == 1);
+    TEST_CHECK(Receive() == 3);
+    TEST_CHECK(Receive() == 5);
+    TEST_CHECK(uxQueueMessagesWaiting(xQueue) == 0);
+}
+
+static void TestTimeout(void)
+{
+    const TickType_t wait = pdMS_TO_TICKS(20);
+    TickType_t start;
+    int value = -1;
+
+    Test_Case("timeout with only non-matching items queued");
+
+    Send(7);
+    start = xTaskGetTickCount();
+    TEST_CHECK(xQueueReceiveMatching(xQueue, &value, MatchEven, NULL, wait) == errQUEUE_EMPTY);
+    TEST_CHECK((TickType_t)(xTaskGetTickCount() - start) >= wait);
+    TEST_CHECK(value == -1);
+
+    /* The non-matching item is still there */
+    TEST_CHECK(uxQueueMessagesWaiting(xQueue) == 1);
+    TEST_CHECK(Receive() == 7);
+}
+
+static void TestBlockedReceiver(void)
+{
+    Test_Case("blocked receiver woken only by a matching send");
+
+    helper_received = 0;
+    TEST_CHECK(xTaskCreate(MatchingReceiverTask, "MATCH", configMINIMAL_STACK_SIZE,
+                           NULL, TEST_PRIO_HIGH, NULL) == pdPASS);
+
+    /* The helper preempted us and is now blocked on the empty queue */
+    Send(9);
+    TEST_CHECK(helper_received == 0);
+    TEST_CHECK(uxQueueMessagesWaiting(xQueue) == 1);
+
+    Send(6);
+    TEST_CHECK(helper_received == 6);
+    TEST_CHECK(uxQueueMessagesWaiting(xQueue) == 1);
+    TEST_CHECK(Receive() == 9);
+}
+
+static void TestTwoWaiters(void)
+{
+    static ButtonWaiter_t waiters[2] = { { .button = 1 }, { .button = 2 } };
+    TaskHandle_t handles[2];
+
+    Test_Case("two waiters, different buttons: only the matching one returns");
+
+    for (int i = 0; i < 2; i++) {
+        waiters[i].received = 0;
+        TEST_CHECK(xTaskCreate(ButtonWaiterTask, "BTN", configMINIMAL_STACK_SIZE,
+                               &waiters[i], TEST_PRIO_HIGH, &handles[i]) == pdPASS);
+    }
+    TEST_CHECK(eTaskGetState(handles[0]) == eBlocked);
+    TEST_CHECK(eTaskGetState(handles[1]) == eBlocked);
+
+    /* Both wake and rescan; button 1's waiter finds nothing and blocks again */
+    Send(2);
+    TEST_CHECK(waiters[1].received == 2);
+    TEST_CHECK(waiters[0].received == 0);
+    TEST_CHECK(eTaskGetState(handles[0]) == eBlocked);
+    TEST_CHECK(eTaskGetState(handles[1]) == eSuspended);
+    TEST_CHECK(uxQueueMessagesWaiting(xQueue) == 0);
+
+    /* Nobody wants 3: it stays queued, and 1 still reaches its waiter */
+    Send(3);
+    TEST_CHECK(eTaskGetState(handles[0]) == eBlocked);
+    Send(1);
+    TEST_CHECK(waiters[0].received == 1);
+    TEST_CHECK(eTaskGetState(handles[0]) == eSuspended);
+    TEST_CHECK(Receive() == 3);
+    TEST_CHECK(uxQueueMessagesWaiting(xQueue) == 0);
+}
+
+static void TestWrapAround(void)
+{
+    int value = -1;
+
+    Test_Case("match past the end of the storage area shifts older items across the wrap");
+
+    /* Slots 6 7 | 0 1 2 hold 1 3 | 5 8 7: the match sits past pcTail */
+    MoveReadPosition(QUEUE_LENGTH - 3);
+    Send(1);
+    Send(3);
+    Send(5);
+    Send(8);
+    Send(7);
+    TEST_CHECK(xQueueReceiveMatching(xQueue, &value, MatchEven, NULL, 0) == pdPASS);
+    TEST_CHECK(value == 8);
+    TEST_CHECK(uxQueueMessagesWaiting(xQueue) == 4);
+
+    /* Refill behind the gap to check the write position was not disturbed */
+    Send(9);
+    Send(11);
+    Send(13);
+    Send(15);
+    TEST_CHECK(xQueueSend(xQueue, &value, 0) == errQUEUE_FULL);
+    TEST_CHECK(Receive() == 1);
+    TEST_CHECK(Receive() == 3);
+    TEST_CHECK(Receive() == 5);
+    TEST_CHECK(Receive() == 7);
+
+    /* Slots 5 6 7 | 0 hold 13 15 17 | 10: the match is first after the wrap */
+    TEST_CHECK(Receive() == 9);
+    TEST_CHECK(Receive() == 11);
+    Send(17);
+    Send(10);
+    TEST_CHECK(xQueueReceiveMatching(xQueue, &value, MatchEven, NULL, 0) == pdPASS);
+    TEST_CHECK(value == 10);
+    TEST_CHECK(Receive() == 13);
+    TEST_CHECK(Receive() == 15);
+    TEST_CHECK(Receive() == 17);
+    TEST_CHECK(uxQueueMessagesWaiting(xQueue) == 0);
+}
+
+static void TestTracePoints(void)
+{
+    int value = -1;
+
+    Test_Case("traceENTER/traceRETURN_xQueueReceiveMatching on every return path");
+
+    ulTraceMatchingEnters = 0;
+    lTraceMatchingReturn = 0;
+
+    TEST_CHECK(xQueueReceiveMatching(xQueue, &value, MatchEven, NULL, 0) == errQUEUE_EMPTY);
+    TEST_CHECK(ulTraceMatchingEnters == 1);
+    TEST_CHECK(lTraceMatchingReturn == errQUEUE_EMPTY);
+
+    Send(4);
+    TEST_CHECK(xQueueReceiveMatching(xQueue, &value, MatchEven, NULL, 0) == pdPASS);
+    TEST_CHECK(ulTraceMatchingEnters == 2);
+    TEST_CHECK(lTraceMatchingReturn == pdPASS);
+
+    /* Blocked, timed out, rescanned: still one entry and one return */
+    lTraceMatchingReturn = 0;
+    TEST_CHECK(xQueueReceiveMatching(xQueue, &value, MatchEven, NULL, 2) == errQUEUE_EMPTY);
+    TEST_CHECK(ulTraceMatchingEnters == 3);
+    TEST_CHECK(lTraceMatchingReturn == errQUEUE_EMPTY);
+}
+
+static void BenchMatchCost(void)
+{
+    static const int depths[] = { 1, 2, 4, 8, 16, 32 };
+    QueueHandle_t xBench = xQueueCreate(BENCH_DEPTH_MAX, sizeof(int));
+    QueueHandle_t xSaved = xQueue;
+
+    Test_Case("benchmark: match cost by queue depth (match is the newest item)");
+
+    TEST_CHECK(xBench != NULL);
+    xQueue = xBench;
+
+    for (unsigned int d = 0; d < sizeof(depths) / sizeof(depths[0]); d++) {
+        uint64_t match_cycles = 0;
+        uint64_t plain_cycles = 0;
+        int value;
+
+        /* depth - 1 odd items stay queued; the even one is sent each round */
+        for (int i = 1; i < depths[d]; i++) {
+            Send(2 * i + 1);
+        }
+        for (int r = 0; r < BENCH_ROUNDS; r++) {
+            uint64_t t0;
+
+            Send(2);
+            t0 = Test_Cycles();
+            (void)xQueueReceiveMatching(xQueue, &value, MatchEven, NULL, 0);
+            match_cycles += Test_Cycles() - t0;
+        }
+
+        /* The same depth through xQueueReceive(), which only takes the head */
+        for (int r = 0; r < BENCH_ROUNDS; r++) {
+            uint64_t t0;
+
+            Send(2);
+            t0 = Test_Cycles();
+            (void)xQueueReceive(xQueue, &value, 0);
+            plain_cycles += Test_Cycles() - t0;
+        }
+        TEST_CHECK(uxQueueMessagesWaiting(xQueue) == (UBaseType_t)(depths[d] - 1));
+        xQueueReset(xQueue);
+
+        Test_Note("depth %2d: %4llu cycles matching, %4llu cycles xQueueReceive",
+                  depths[d], (unsigned long long)(match_cycles / BENCH_ROUNDS),
+                  (unsigned long long)(plain_cycles / BENCH_ROUNDS));
+    }
+
+    xQueue = xSaved;
+}
+
+static void RunTests(void *pvParameters)
+{
+    (void)pvParameters;
+
+    xQueue = xQueueCreate(QUEUE_LENGTH, sizeof(int));
+    TEST_CHECK(xQueue != NULL);
+
+    TestBehindNonMatching();
+    TestTimeout();
+    TestBlockedReceiver();
+    TestTwoWaiters();
+    TestWrapAround();
+    TestTracePoints();
+    BenchMatchCost();
+}
+
+int main(void)
+{
+    Test_Run(RunTests);
+    return 1;
+}
@@ -0,0 +1,390 @@
+/*
+ * File:   test_rtcc.c
+ * Author: ENCM 511
+ *
+ * RTCC Time Base Tests (rtcc.c)
+ *
+ * Description: The alarm ISR, the LPRC trim and RTCC_Sleep() against the
+ *              RTCC model in hw/rtcc_model.c, with the kernel's own
+ *              tickless idle calling RTCC_Sleep() (TEST_TICKLESS). The
+ *              test task is the COUNT task: it waits on RTCC_WaitSeconds()
+ *              and records when each second arrives, in kernel ticks and
+ *              in the model's real time. The interrupt hook plays Timer1
+ *              and the CPU: every tick the port makes is a 1 ms period,
+ *              then the pending Timer1 interrupt (the tick RTCC_Sleep()
+ *              leaves on T1IF) and the RTCC alarm are vectored.
+ *
+ *              The LPRC runs 3.1% fast. Checked: the registers RTCC_Init()
+ *              sets up; that the trim brings the second to within 0.05%
+ *              awake; that across a minute of sleeping between alarms every
+ *              second is exactly 1000 ticks and a task due at an alarm
+ *              wakes on that tick at that instant; and that after early
+ *              wakes the lost ticks are caught up at the next alarm, with
+ *              no sleep before it. Each minute's time awake and asleep is
+ *              turned into an energy estimate.
+ *
+ * Created on Nov 2025
+ */
+
+#include "testing.h"
+#include "rtcc.h"
+#include "hw/rtcc_model.h"
+#include <xc.h>
+#include <stdlib.h>
+
+#define LPRC_HZ         (RTCC_LPRC_HZ * 1.031)
+#define TICKS_PER_SEC   ((TickType_t)configTICK_RATE_HZ)
+#define MINUTE          60
+#define WAIT_TICKS      ((TickType_t)(RTCC_FALLBACK_SECONDS * configTICK_RATE_HZ))
+#define MAX_ERROR_PPM   500
+#define EARLY_EVERY     3               /* Seconds between early wakes */
+
+/* Assumed supply currents at 3.3 V, for the energy estimate only (order
+ * of magnitude, not measured): running from the FRC, and in Sleep with
+ * the LPRC and the RTCC on */
+#define VDD_V           3.3
+#define RUN_MA          1.5
+#define SLEEP_UA        4.0
+
+void _RTCCInterrupt(void);
+
+typedef struct {
+    uint32_t seconds;               /* Delivered, one per wait */
+    uint64_t first_ns;              /* Real time of the first delivery */
+    uint64_t last_ns;
+    TickType_t first_tick;
+    TickType_t last_tick;
+    uint32_t off_tick;              /* Deliveries not 1000 ticks per second on */
+    uint64_t max_late_ns;           /* Delivery after its alarm */
+    uint64_t awake_ns;
+    uint64_t asleep_ns;
+} Minute_t;
+
+static bool sleep_allowed;
+static uint32_t forced_ticks;
+static uint32_t wrap_declines;      /* Idle time cut short by the tick wrap */
+
+/* Task due at every alarm tick from deadline_tick on */
+static TickType_t deadline_tick;
+static uint32_t deadline_wakes;
+static uint32_t deadline_off_tick;
+static uint32_t deadline_off_time;
+
+static Minute_t awake_minute;
+static Minute_t sleep_minute;
+static Minute_t early_minute;
+
+/*============================================================================
+ * HELPERS
+ *============================================================================*/
+
+/* portSUPPRESS_TICKS_AND_SLEEP(), as in main.c without the peripheral checks */
+void vApplicationSleep(uint16_t xExpectedIdleTime)
+{
+    if (sleep_allowed && RTCC_Sleep(xExpectedIdleTime) == 0 &&
+        (TickType_t)(xTaskGetTickCount() + xExpectedIdleTime) == portMAX_DELAY) {
+        wrap_declines++;
+    }
+}
+
+/* CPU: a tick of the port is a Timer1 period; then Timer1's interrupt and
+ * the RTCC alarm if pending and above the IPL */
+static BaseType_t RtccVector(PortInterruptPoint_t where)
+{
+    BaseType_t switch_task = pdFALSE;
+
+    if (where == portINTERRUPT_AT_TICK) {
+        HwRtcc_Tick();
+    }
+    if (hw_IFS0bits.T1IF && configKERNEL_INTERRUPT_PRIORITY > SRbits.IPL) {
+        hw_IFS0bits.T1IF = 0;
+        forced_ticks++;
+        switch_task = xTaskIncrementTick();
+    }
+    if (hw_IFS3bits.RTCIF && hw_IEC3bits.RTCIE && hw_IPC15bits.RTCIP > SRbits.IPL) {
+        _RTCCInterrupt();
+    }
+    return switch_task;
+}
+
+/* Above the test task: due on every alarm tick, records how it lands */
+static void Deadline(void *pvParameters)
+{
+    TickType_t when = deadline_tick;
+
+    (void)pvParameters;
+    for (;;) {
+        vTaskDelayUntil(&when, TICKS_PER_SEC);
+        deadline_wakes++;
+        if (xTaskGetTickCount() != when) {
+            deadline_off_tick++;
+        }
+        if (HwRtcc_Now() != HwRtcc_LastAlarm()) {
+            deadline_off_time++;
+        }
+    }
+}
+
+static void Begin(Minute_t *m)
+{
+    TEST_CHECK(RTCC_WaitSeconds(WAIT_TICKS) == 1);
+    m->seconds = 0;
+    m->first_ns = HwRtcc_Now();
+    m->first_tick = xTaskGetTickCount();
+    m->off_tick = 0;
+    m->max_late_ns = 0;
+    m->awake_ns = HwRtcc_AwakeNs();
+    m->asleep_ns = HwRtcc_AsleepNs();
+}
+
+/* One second as the COUNT task sees it */
+static void Second(Minute_t *m)
+{
+    uint64_t late;
+
+    TEST_CHECK(RTCC_WaitSeconds(WAIT_TICKS) == 1);
+    m->seconds++;
+    m->last_ns = HwRtcc_Now();
+    m->last_tick = xTaskGetTickCount();
+    if ((TickType_t)(m->last_tick - m->first_tick) != (TickType_t)(m->seconds * TICKS_PER_SEC)) {
+        m->off_tick++;
+    }
+    late = m->last_ns - HwRtcc_LastAlarm();
+    if (late > m->max_late_ns) {
+        m->max_late_ns = late;
+    }
+}
+
+static void End(Minute_t *m)
+{
+    m->awake_ns = HwRtcc_AwakeNs() - m->awake_ns;
+    m->asleep_ns = HwRtcc_AsleepNs() - m->asleep_ns;
+}
+
+/* Length of the minute against 60 s */
+static double ErrorPpm(const Minute_t *m)
+{
+    double real = (double)(m->last_ns - m->first_ns);
+
+    return (real / (m->seconds * 1e9) - 1.0) * 1e6;
+}
+
+/* Estimated energy for the minute, in mJ */
+static double EnergyMj(const Minute_t *m)
+{
+    return VDD_V * (RUN_MA * 1e-3 * m->awake_ns * 1e-9 +
+                    SLEEP_UA * 1e-6 * m->asleep_ns * 1e-9) * 1e3;
+}
+
+/*============================================================================
+ * TEST CASES
+ *============================================================================*/
+
+static void TestSetup(void)
+{
+    Test_Case("RTCC_Init: LPRC, nominal divider, chime alarm every second, locked");
+
+    TEST_CHECK(hw_RTCCON2L.bits.CLKSEL == 0b01);
+    TEST_CHECK(hw_RTCCON2H == RTCC_DIV_NOMINAL);
+    TEST_CHECK(hw_RTCCON1H.bits.AMASK == 0b0001);
+    TEST_CHECK(hw_RTCCON1H.bits.CHIME && hw_RTCCON1H.bits.ALRMEN);
+    TEST_CHECK(hw_RTCCON1Lbits.RTCEN && hw_RTCCON1Lbits.WRLOCK);
+    TEST_CHECK(hw_IEC3bits.RTCIE && hw_IPC15bits.RTCIP == configKERNEL_INTERRUPT_PRIORITY);
+    TEST_CHECK(!hw_IFS3bits.RTCIF);
+}
+
+static void TestTrim(void)
+{
+    Minute_t *m = &awake_minute;
+    RtccStats_t stats;
+    uint32_t seconds = 0;
+    double untrimmed = 2.0 * (RTCC_DIV_NOMINAL + 1) / LPRC_HZ;
+
+    Test_Case("awake: the trim brings the LPRC second to the tick");
+
+    sleep_allowed = false;
+    RTCC_StartSeconds();
+
+    /* Three measurements: the first starts at the first alarm */
+    while (seconds < 3 * RTCC_CAL_SECONDS + 1) {
+        seconds += RTCC_WaitSeconds(WAIT_TICKS);
+    }
+    RTCC_GetStats(&stats);
+    TEST_CHECK(stats.trims >= 1);
+    TEST_CHECK(abs((int)stats.div - (int)(LPRC_HZ / 2 - 1)) <= 8);
+    TEST_CHECK(HwRtcc_LockedWrites() == 0);
+    TEST_CHECK(stats.sleeps == 0 && stats.early_wakes == 0);
+
+    Begin(m);
+    for (uint8_t s = 0; s < MINUTE; s++) {
+        Second(m);
+    }
+    End(m);
+
+    TEST_CHECK(m->seconds == MINUTE);
+    TEST_CHECK(abs((int)ErrorPpm(m)) <= MAX_ERROR_PPM);
+    TEST_CHECK(m->max_late_ns < HWRTCC_TICK_NS);
+    TEST_CHECK(m->asleep_ns == 0);
+    RTCC_GetStats(&stats);
+    Test_Note("LPRC %.0f Hz: second %.4f s untrimmed, div %u after %u trims, "
+              "minute %+.1f ppm", LPRC_HZ, untrimmed, stats.div, stats.trims,
+              ErrorPpm(m));
+}
+
+static void TestSleepCycles(void)
+{
+    Minute_t *m = &sleep_minute;
+    RtccStats_t before;
+    RtccStats_t after;
+    TaskHandle_t deadline;
+    uint32_t forced;
+    uint32_t wrap;
+
+    Test_Case("sleeping between alarms: 1000 ticks a second, deadlines on the alarm");
+
+    sleep_allowed = true;
+
+    /* Woken by the alarm, so the tick now is the alarm tick */
+    Begin(m);
+    RTCC_GetStats(&before);
+    TEST_CHECK(HwRtcc_Now() == HwRtcc_LastAlarm());
+    deadline_tick = xTaskGetTickCount();
+    TEST_CHECK(xTaskCreate(Deadline, "DUE", configMINIMAL_STACK_SIZE, NULL,
+                           TEST_PRIO_HIGH, &deadline) == pdPASS);
+    forced = forced_ticks;
+    wrap = wrap_declines;
+
+    for (uint8_t s = 0; s < MINUTE; s++) {
+        Second(m);
+    }
+    End(m);
+    vTaskSuspend(deadline);
+    RTCC_GetStats(&after);
+
+    /* Stepping to_alarm - 1 and leaving the last tick on T1IF is exact */
+    TEST_CHECK(m->seconds == MINUTE);
+    TEST_CHECK(m->off_tick == 0);
+    TEST_CHECK((TickType_t)(m->last_tick - m->first_tick) == MINUTE * TICKS_PER_SEC);
+    TEST_CHECK(m->max_late_ns == 0);
+    TEST_CHECK(after.sleeps - before.sleeps == MINUTE);
+    TEST_CHECK(forced_ticks - forced == MINUTE);
+    TEST_CHECK(deadline_wakes == MINUTE);
+    TEST_CHECK(deadline_off_tick == 0 && deadline_off_time == 0);
+
+    /* Sleeping stops the trim, not the second */
+    TEST_CHECK(after.div == before.div && after.trims == before.trims);
+    TEST_CHECK(abs((int)ErrorPpm(m)) <= MAX_ERROR_PPM);
+    TEST_CHECK(after.early_wakes == before.early_wakes);
+    TEST_CHECK(m->awake_ns / HWRTCC_TICK_NS + (after.slept_ticks - before.slept_ticks) ==
+               MINUTE * TICKS_PER_SEC);
+
+    Test_Note("%u sleeps, %lu ticks stepped, awake %.0f ms (%lu waiting out the "
+              "tick wrap), minute %+.1f ppm", after.sleeps - before.sleeps,
+              (unsigned long)(after.slept_ticks - before.slept_ticks),
+              m->awake_ns / 1e6, (unsigned long)(wrap_declines - wrap), ErrorPpm(m));
+}
+
+static void TestEarlyWakes(void)
+{
+    Minute_t *m = &early_minute;
+    RtccStats_t before;
+    RtccStats_t after;
+    uint32_t pressed = 0;
+    uint32_t wakes;
+    uint32_t lost_ms = 0;
+    uint32_t caught;
+
+    Test_Case("early wakes: ticks caught up at the next alarm, no sleep before it");
+
+    sleep_allowed = true;
+
+    Begin(m);
+    RTCC_GetStats(&before);
+    wakes = HwRtcc_Wakes();
+
+    for (uint8_t s = 0; s < MINUTE; s++) {
+        if (s % EARLY_EVERY == 0) {
+            /* A button press somewhere in the second */
+            uint32_t offset_ms = 100 + (s * 137U) % 800;
+
+            HwRtcc_WakeAt(HwRtcc_LastAlarm() + offset_ms * HWRTCC_TICK_NS);
+            lost_ms += offset_ms;
+            pressed++;
+        }
+        Second(m);
+    }
+    End(m);
+    RTCC_GetStats(&after);
+    wakes = HwRtcc_Wakes() - wakes;
+
+    TEST_CHECK(m->seconds == MINUTE);
+    TEST_CHECK(m->off_tick == 0);
+    TEST_CHECK((TickType_t)(m->last_tick - m->first_tick) == MINUTE * TICKS_PER_SEC);
+
+    /* A press in the second spent awake for the tick wrap wakes nothing */
+    TEST_CHECK(wakes >= pressed - 1);
+    TEST_CHECK(after.early_wakes - before.early_wakes == (int)wakes);
+    TEST_CHECK(after.sleeps - before.sleeps == MINUTE - (int)wakes);
+
+    /* Every tick of the minute was made awake, stepped over after an
+     * alarm or caught up after an early wake - each exactly once */
+    caught = after.caught_up_ticks - before.caught_up_ticks;
+    TEST_CHECK(m->awake_ns / HWRTCC_TICK_NS + (after.slept_ticks - before.slept_ticks) +
+               caught == MINUTE * TICKS_PER_SEC);
+    TEST_CHECK(caught > 0 && caught < lost_ms);
+    TEST_CHECK(abs((int)ErrorPpm(m)) <= MAX_ERROR_PPM);
+
+    Test_Note("%u presses, %u early wakes: %lu ticks caught up, awake %.0f ms, "
+              "minute %+.1f ppm", pressed, wakes, (unsigned long)caught,
+              m->awake_ns / 1e6, ErrorPpm(m));
+}
+
+static void TestEnergy(void)
+{
+    const Minute_t *minutes[] = { &awake_minute, &sleep_minute, &early_minute };
+    const char *names[] = { "awake", "sleeping", "early wake every 3 s" };
+
+    Test_Case("energy per minute (assumed currents)");
+
+    Test_Note("%.1f mA running, %.1f uA in Sleep, %.1f V", RUN_MA, SLEEP_UA, VDD_V);
+    for (uint8_t i = 0; i < 3; i++) {
+        const Minute_t *m = minutes[i];
+
+        TEST_CHECK(m->awake_ns + m->asleep_ns == m->last_ns - m->first_ns);
+        Test_Note("%-21s awake %6.0f ms, asleep %6.0f ms: %6.2f mJ",
+                  names[i], m->awake_ns / 1e6, m->asleep_ns / 1e6, EnergyMj(m));
+    }
+
+    /* A tick or two awake per second, and once every 65.5 s the rest of
+     * the second before the 16-bit tick count wraps: the kernel's expected
+     * idle time stops at the wrap, so the alarm is further away than it
+     * allows and RTCC_Sleep() declines */
+    TEST_CHECK(sleep_minute.awake_ns <= (2 * MINUTE + TICKS_PER_SEC) * HWRTCC_TICK_NS);
+    TEST_CHECK(EnergyMj(&sleep_minute) < EnergyMj(&early_minute));
+    TEST_CHECK(EnergyMj(&early_minute) < EnergyMj(&awake_minute));
+}
+
+static void RunTests(void *pvParameters)
+{
+    (void)pvParameters;
+
+    HwRtcc_Reset(LPRC_HZ);
+    hw_T1CON.bits.TON = 1;
+    RTCC_Init();
+    vPortSetInterruptHook(RtccVector);
+
+    TestSetup();
+    TestTrim();
+    TestSleepCycles();
+    TestEarlyWakes();
+    TestEnergy();
+
+    sleep_allowed = false;
+    vPortSetInterruptHook(NULL);
+}
+
+int main(void)
+{
+    Test_Run(RunTests);
+    return 1;
+}
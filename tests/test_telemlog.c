@@ -0,0 +1,380 @@
+/*
+ * File:   test_telemlog.c
+ * Author: ENCM 511
+ *
+ * Flash Telemetry Log Power-Fail Tests (telemlog.c)
+ *
+ * Description: telemlog.c runs against the flash model in hw/nvm_model.c.
+ *              Each boot is a Test_RunInChild() child, so the module's
+ *              statics start from their reset values while the flash
+ *              carries over. A batch is flushed with the power cut after
+ *              every possible number of programmed double words. The next
+ *              boot's TelemLog_Recover() and iterator must return exactly
+ *              the records that were fully programmed. Records on a page
+ *              the batch erased are gone. The log must then take new
+ *              records as usual.
+ *
+ * Created on Nov 2025
+ */
+
+#include "testing.h"
+#include "telemlog.h"
+#include "appcfg.h"
+#include "crc.h"
+#include "nvm.h"
+#include "hw/nvm_model.h"
+#include <string.h>
+#include <sys/mman.h>
+
+#define MAX_RECORDS     1024
+#define BATCH_RECORDS   12
+#define MORE_RECORDS    3
+
+/* A record as the test knows it, and the page the iterator found it on */
+typedef struct {
+    uint8_t type;
+    uint8_t len;
+    uint16_t seconds;
+    uint8_t data[TELEMLOG_MAX_PAYLOAD];
+    uint8_t page;
+} Rec_t;
+
+/* Passed from one boot to the next */
+typedef struct {
+    Rec_t expect[MAX_RECORDS];
+    uint16_t expected;
+    uint16_t completed;             /* Batch records fully programmed */
+    bool power_lost;
+} Shared_t;
+
+static Shared_t *shared;
+
+static Rec_t batch[BATCH_RECORDS + MORE_RECORDS];
+static Rec_t got[MAX_RECORDS];
+
+/*============================================================================
+ * HELPERS
+ *============================================================================*/
+
+static uint16_t RecordWords(uint8_t len)
+{
+    return (uint16_t)((4 + (len + 1) / 2) & ~1);
+}
+
+static void MakeRecord(Rec_t *r, uint8_t type, uint8_t len, uint16_t seconds)
+{
+    r->type = type;
+    r->len = len;
+    r->seconds = seconds;
+    for (uint8_t i = 0; i < len; i++) {
+        r->data[i] = (uint8_t)(type * 31 + seconds + i);
+    }
+}
+
+/* Program a page header and records straight into the flash model */
+static uint16_t CraftPage(uint8_t page, uint16_t seq, const Rec_t *recs, uint16_t count)
+{
+    const volatile uint16_t *base = HwNvm_Base() + (uint32_t)page * HWNVM_PAGE_WORDS;
+    uint16_t off = 2;
+
+    TEST_CHECK(Nvm_ErasePage(base));
+    TEST_CHECK(Nvm_ProgramDword(base, TELEMLOG_MAGIC, seq));
+    for (uint16_t k = 0; k < count; k++) {
+        uint16_t w[8];
+        uint16_t data_words = (uint16_t)(2 + (recs[k].len + 1) / 2);
+        uint16_t words = RecordWords(recs[k].len);
+
+        memset(w, 0, sizeof(w));
+        w[0] = (uint16_t)(recs[k].type << 8 | recs[k].len);
+        w[1] = recs[k].seconds;
+        memcpy(&w[2], recs[k].data, recs[k].len);
+        w[data_words] = Crc16_Compute(w, (uint16_t)(data_words * 2));
+        for (uint16_t i = 0; i < words; i += 2) {
+            TEST_CHECK(Nvm_ProgramDword(base + off + i, w[i], w[i + 1]));
+        }
+        off += words;
+    }
+    return off;
+}
+
+static uint16_t ReadAll(Rec_t *out)
+{
+    TelemLogIter_t it;
+    TelemLogRecord_t rec;
+    uint16_t n = 0;
+
+    TelemLog_IterBegin(&it);
+    while (TelemLog_IterNext(&it, &rec)) {
+        TEST_CHECK(n < MAX_RECORDS);
+        out[n].type = rec.type;
+        out[n].len = rec.len;
+        out[n].seconds = rec.seconds;
+        memcpy(out[n].data, rec.data, rec.len);
+        out[n].page = it.page;
+        n++;
+    }
+    return n;
+}
+
+static bool SameRecord(const Rec_t *a, const Rec_t *b)
+{
+    return a->type == b->type && a->len == b->len && a->seconds == b->seconds &&
+           memcmp(a->data, b->data, a->len) == 0;
+}
+
+static void Append(const Rec_t *recs, uint16_t count)
+{
+    for (uint16_t k = 0; k < count; k++) {
+        TEST_CHECK(TelemLog_Append(recs[k].type, recs[k].data, recs[k].len));
+    }
+}
+
+/**
+ * @brief What the log must hold after a flush of recs
+ *
+ * Records on pages this boot erased are gone; of recs, those whose every
+ * double word reached the flash are added. The operation log says which.
+ */
+static uint16_t Expect(Rec_t *list, uint16_t n, const Rec_t *recs, uint16_t count)
+{
+    const HwNvmOp_t *log;
+    uint16_t ops;
+    uint16_t kept = 0;
+    uint16_t done = 0;
+    uint16_t words = 0;
+    uint8_t page[BATCH_RECORDS];
+    bool erased[TELEMLOG_PAGES] = { false };
+
+    log = HwNvm_Log(&ops);
+    for (uint16_t i = 0; i < ops; i++) {
+        if (log[i].erase) {
+            erased[log[i].word / HWNVM_PAGE_WORDS] = true;
+        } else if (log[i].word % HWNVM_PAGE_WORDS != 0) {   /* Not a header */
+            words += 2;
+            TEST_CHECK(done < count);
+            if (words == RecordWords(recs[done].len)) {
+                page[done++] = (uint8_t)(log[i].word / HWNVM_PAGE_WORDS);
+                words = 0;
+            }
+        }
+    }
+
+    for (uint16_t i = 0; i < n; i++) {
+        if (!erased[list[i].page]) {
+            list[kept++] = list[i];
+        }
+    }
+    for (uint16_t i = 0; i < done; i++) {
+        list[kept] = recs[i];
+        list[kept++].page = page[i];
+    }
+    shared->completed = done;
+    return kept;
+}
+
+static void CheckList(const Rec_t *want, uint16_t n)
+{
+    uint16_t count = ReadAll(got);
+
+    TEST_CHECK(count == n);
+    for (uint16_t i = 0; i < n; i++) {
+        if (!SameRecord(&got[i], &want[i])) {
+            TEST_CHECK(SameRecord(&got[i], &want[i]));
+        }
+    }
+}
+
+/*============================================================================
+ * BOOTS
+ *============================================================================*/
+
+/* Boot 1: recover, then flush the batch with the power cut after n dwords */
+static void WriteBoot(void *arg)
+{
+    uint32_t cut = *(const uint32_t *)arg;
+    uint16_t n;
+
+    HwNvm_PowerOn();
+    TelemLog_Recover();
+    n = ReadAll(shared->expect);
+
+    Append(batch, BATCH_RECORDS);
+    HwNvm_CutPowerAfter(cut);
+    TelemLog_Flush();
+
+    shared->power_lost = HwNvm_PowerLost();
+    shared->expected = Expect(shared->expect, n, batch, BATCH_RECORDS);
+    if (!shared->power_lost) {
+        TEST_CHECK(shared->completed == BATCH_RECORDS);
+    }
+}
+
+/* Boot 2: exactly the fully written records, and the log still works */
+static void CheckBoot(void *arg)
+{
+    TelemLogStats_t stats;
+    uint16_t n = shared->expected;
+
+    (void)arg;
+    HwNvm_PowerOn();
+    TelemLog_Recover();
+    CheckList(shared->expect, n);
+
+    Append(&batch[BATCH_RECORDS], MORE_RECORDS);
+    TelemLog_Flush();
+    n = Expect(shared->expect, n, &batch[BATCH_RECORDS], MORE_RECORDS);
+    TEST_CHECK(shared->completed == MORE_RECORDS);
+    CheckList(shared->expect, n);
+
+    TelemLog_GetStats(&stats);
+    TEST_CHECK(stats.records_written == MORE_RECORDS);
+    TEST_CHECK(stats.dropped == 0);
+    TEST_CHECK(HwNvm_Reprograms() == 0);
+}
+
+/**
+ * @brief Cut the power after 0, 1, 2 ... double words until a flush completes
+ *
+ * @param craft Puts the flash in its starting state
+ * @return Number of cut points tried
+ */
+static uint32_t CutSweep(void (*craft)(void))
+{
+    uint32_t cut;
+
+    for (cut = 0; ; cut++) {
+        craft();
+        Test_RunInChild(WriteBoot, &cut);
+        Test_RunInChild(CheckBoot, NULL);
+        if (!shared->power_lost) {
+            break;
+        }
+    }
+    return cut;
+}
+
+static void CraftBlank(void)
+{
+    HwNvm_Reset();
+}
+
+/* Pages 0-7 hold sequences 0xFFF8-0xFFFF; the head (page 7) has room for
+ * four batch records, so the flush erases page 0 and opens sequence 0 */
+static void CraftWrap(void)
+{
+    static Rec_t recs[125];
+    uint16_t end = 0;
+
+    HwNvm_Reset();
+    for (uint8_t page = 0; page < TELEMLOG_PAGES; page++) {
+        uint16_t count = (page == TELEMLOG_PAGES - 1) ? 125 : 5;
+
+        for (uint16_t k = 0; k < count; k++) {
+            MakeRecord(&recs[k], TELEM_POT, (uint8_t)((k + page) % (TELEMLOG_MAX_PAYLOAD + 1)),
+                       (uint16_t)(page * 1000 + k));
+        }
+        if (page == TELEMLOG_PAGES - 1) {
+            for (uint16_t k = 0; k < count; k++) {
+                recs[k].len = TELEMLOG_MAX_PAYLOAD;
+            }
+        }
+        end = CraftPage(page, (uint16_t)(0xFFF8 + page), recs, count);
+    }
+    TEST_CHECK(HWNVM_PAGE_WORDS - end == 22);
+}
+
+/* Every operation fails: the whole batch is counted as dropped */
+static void WornOutBoot(void *arg)
+{
+    uint32_t good_ops = *(const uint32_t *)arg;
+    TelemLogStats_t stats;
+
+    HwNvm_PowerOn();
+    TelemLog_Recover();
+    HwNvm_FailAfter(good_ops);
+    Append(batch, 5);
+    TelemLog_Flush();
+
+    TelemLog_GetStats(&stats);
+    TEST_CHECK(stats.records_written + stats.dropped == 5);
+    TEST_CHECK(ReadAll(got) == stats.records_written);
+    shared->completed = stats.records_written;
+    shared->expected = stats.dropped;
+}
+
+/*============================================================================
+ * TEST CASES
+ *============================================================================*/
+
+static void TestFlashModel(void)
+{
+    Test_Case("flash model: the log's pages are the whole flash");
+
+    TEST_CHECK(HwNvm_Words() == (uint32_t)TELEMLOG_PAGES * HWNVM_PAGE_WORDS);
+    TEST_CHECK(HWNVM_PAGE_WORDS == APPCFG_PAGE_SIZE / 2);
+
+    HwNvm_Reset();
+    TEST_CHECK(HwNvm_Base()[0] == 0xFFFF);
+    TEST_CHECK(Nvm_ProgramDword(HwNvm_Base(), 0x1234, 0xFFFF));
+    TEST_CHECK(HwNvm_Base()[0] == 0x1234 && HwNvm_Base()[1] == 0xFFFF);
+    TEST_CHECK(HwNvm_Reprograms() == 0);
+}
+
+static void TestCutBlank(void)
+{
+    Test_Case("power cut after every double word, blank flash");
+
+    Test_Note("%lu cut points", (unsigned long)CutSweep(CraftBlank));
+}
+
+static void TestCutWrap(void)
+{
+    Test_Case("power cut after every double word, page change at sequence 0xFFFF");
+
+    Test_Note("%lu cut points", (unsigned long)CutSweep(CraftWrap));
+}
+
+static void TestWornOut(void)
+{
+    uint32_t good_ops;
+
+    Test_Case("no page will open: the rest of the batch counts as dropped");
+
+    /* Nothing programs */
+    good_ops = 0;
+    HwNvm_Reset();
+    Test_RunInChild(WornOutBoot, &good_ops);
+    TEST_CHECK(shared->completed == 0 && shared->expected == 5);
+
+    /* Erase, header and the first record, then the flash wears out */
+    good_ops = 4;
+    HwNvm_Reset();
+    Test_RunInChild(WornOutBoot, &good_ops);
+    TEST_CHECK(shared->completed == 1 && shared->expected == 4);
+}
+
+static void RunTests(void *pvParameters)
+{
+    (void)pvParameters;
+
+    shared = mmap(NULL, sizeof(Shared_t), PROT_READ | PROT_WRITE,
+                  MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    TEST_CHECK(shared != MAP_FAILED);
+
+    /* Lengths 0-8 and back: 64 words, one full RAM batch */
+    for (uint16_t k = 0; k < BATCH_RECORDS + MORE_RECORDS; k++) {
+        MakeRecord(&batch[k], (uint8_t)(TELEM_BOOT + k % 8),
+                   (uint8_t)(k % (TELEMLOG_MAX_PAYLOAD + 1)), 0);
+    }
+
+    TestFlashModel();
+    TestCutBlank();
+    TestCutWrap();
+    TestWornOut();
+}
+
+int main(void)
+{
+    Test_Run(RunTests);
+    return 1;
+}
@@ -0,0 +1,500 @@
+/*
+ * File:   test_uart_dma.c
+ * Author: ENCM 511
+ *
+ * UART DMA Transmit Tests (uart_dma.c)
+ *
+ * Description: uart_dma.c and uart.c against the UART2 transmitter model
+ *              (hw/uart_model.c) and DMA channel 0 (hw/dma_model.c).
+ *              Blocks live in the DMA model's data space, so DMASRC0 holds
+ *              the address they would have on the target. The interrupt
+ *              hook vectors to _DMA0Interrupt(); while the test task is
+ *              blocked, a low priority task lets the bus run. Checked: the
+ *              channel setup, bytes on the line in order with no gap
+ *              between double-buffered blocks, slot accounting, a block at
+ *              the top of RAM, a completion ISR too late for the next TX
+ *              event, the vLogTask ping-pong writer (chained blocks must
+ *              not overfill the TX FIFO), the CPU cost per KB against the
+ *              polled byte path (UART2_Write()), Disp2String() on a 64-byte
+ *              line against a copy of the original (strlen() per
+ *              character, one byte at a time to TRMT), and a fault report
+ *              that abandons a DMA block with UartDma_Abort().
+ *
+ * Created on Nov 2025
+ */
+
+#include "testing.h"
+#include "uart.h"
+#include "uart_dma.h"
+#include "app.h"
+#include "hw/uart_model.h"
+#include "hw/dma_model.h"
+#include <string.h>
+
+#define BLOCK_ADDR      0x1000          /* Data space address of the test blocks */
+#define KB              1024
+#define BUS_SLICE       64              /* Bus cycles per pass of BusTask */
+#define TICK_CYCLES     (configCPU_CLOCK_HZ / 1000)
+
+void _DMA0Interrupt(void);
+
+/* heapstat.c is not linked; the semaphore's label goes nowhere */
+void HeapStat_Name(void *owner, const char *name)
+{
+    (void)owner;
+    (void)name;
+}
+
+static TaskHandle_t bus_task;
+static uint32_t isr_calls;
+static uint64_t isr_cycles;
+
+/*============================================================================
+ * HELPERS
+ *============================================================================*/
+
+/* CPU: take the DMA0 interrupt if it is pending and above the IPL */
+static BaseType_t Vector(PortInterruptPoint_t where)
+{
+    uint64_t t0;
+
+    (void)where;
+    if (!hw_IFS0bits.DMA0IF || !hw_IEC0bits.DMA0IE ||
+        hw_IPC1bits.DMA0IP <= SRbits.IPL) {
+        return pdFALSE;
+    }
+    t0 = Test_Cycles();
+    _DMA0Interrupt();
+    isr_cycles += Test_Cycles() - t0;
+    isr_calls++;
+    return pdFALSE;
+}
+
+/* Below the test task: the bus runs whenever the test task is blocked,
+ * with the stall check once per millisecond as the tick hook makes it */
+static void BusTask(void *pvParameters)
+{
+    uint32_t since_tick = 0;
+
+    (void)pvParameters;
+
+    for (;;) {
+        Hw_Run(BUS_SLICE);
+        since_tick += BUS_SLICE;
+        if (since_tick >= TICK_CYCLES) {
+            since_tick = 0;
+            UartDma_TxStallTick();
+        }
+    }
+}
+
+static void Pattern(uint8_t *p, uint16_t len, uint8_t seed)
+{
+    for (uint16_t i = 0; i < len; i++) {
+        p[i] = (uint8_t)(seed + i * 7);
+    }
+}
+
+/* Let the bus run until the last byte has left the shift register */
+static void Drain(void)
+{
+    while (!UartDma_IsIdle()) {
+        Hw_Run(BUS_SLICE);
+    }
+}
+
+static bool LineIs(const uint8_t *expect, uint16_t len)
+{
+    static uint8_t got[4 * KB + 1];
+
+    return HwUart_TakeLine(got, sizeof(got)) == len && memcmp(got, expect, len) == 0;
+}
+
+/*============================================================================
+ * TEST CASES
+ *============================================================================*/
+
+static void TestSetup(void)
+{
+    Test_Case("UartDma_Init: channel 0 one-shot bytes into U2TXREG on the U2TX event");
+
+    TEST_CHECK(hw_DMACONbits.DMAEN == 1);
+    TEST_CHECK(hw_DMAL == HWDMA_RAM_START && hw_DMAH == HWDMA_RAM_END);
+    TEST_CHECK(hw_DMACH0.bits.SIZE == 1 && hw_DMACH0.bits.TRMODE == 0b00);
+    TEST_CHECK(hw_DMACH0.bits.SAMODE == 0b01 && hw_DMACH0.bits.DAMODE == 0b00);
+    TEST_CHECK(hw_DMADST0 == HwUart_TxAddress());
+    TEST_CHECK(hw_DMAINT0.bits.CHSEL == UART_DMA_TRIG_U2TX);
+    TEST_CHECK(hw_IEC0bits.DMA0IE == 1 && hw_IPC1bits.DMA0IP == UART_DMA_IPL);
+    TEST_CHECK(hw_IEC1bits.U2TXIE == 0);
+    TEST_CHECK(hw_U2STAbits.UTXEN == 1 && hw_U2MODE.bits.UARTEN == 1);
+    TEST_CHECK(UartDma_IsIdle());
+    Test_Note("%lu bus cycles per byte on the line",
+              (unsigned long)HwUart_ByteCycles());
+}
+
+static void TestOneBlock(void)
+{
+    uint8_t *block = HwDma_Ram(BLOCK_ADDR);
+    uint32_t calls = isr_calls;
+
+    Test_Case("one block: bytes in order, one interrupt, idle only once sent");
+
+    Pattern(block, LOG_TX_CHUNK, 1);
+    TEST_CHECK(UartDma_WaitSlot(0));
+    UartDma_Submit(block, LOG_TX_CHUNK);
+    TEST_CHECK(!UartDma_IsIdle());
+
+    /* The last transfer is done before the last byte is out */
+    while (isr_calls == calls) {
+        Hw_Run(1);
+    }
+    TEST_CHECK(!UartDma_IsIdle());
+    Drain();
+    TEST_CHECK(isr_calls == calls + 1);
+    TEST_CHECK(LineIs(block, LOG_TX_CHUNK));
+    TEST_CHECK(HwUart_Overruns() == 0);
+}
+
+static void TestSlots(void)
+{
+    uint8_t *a = HwDma_Ram(BLOCK_ADDR);
+    uint8_t *b = HwDma_Ram(BLOCK_ADDR + LOG_TX_CHUNK);
+    uint8_t expect[2 * LOG_TX_CHUNK];
+    uint32_t gaps = HwUart_GapCycles();
+    uint32_t calls = isr_calls;
+
+    Test_Case("two slots: a third block waits; the second follows with no gap");
+
+    Pattern(a, LOG_TX_CHUNK, 10);
+    Pattern(b, LOG_TX_CHUNK, 90);
+    memcpy(expect, a, LOG_TX_CHUNK);
+    memcpy(expect + LOG_TX_CHUNK, b, LOG_TX_CHUNK);
+
+    TEST_CHECK(UartDma_WaitSlot(0));
+    UartDma_Submit(a, LOG_TX_CHUNK);
+    TEST_CHECK(UartDma_WaitSlot(0));
+    UartDma_Submit(b, LOG_TX_CHUNK);
+    TEST_CHECK(!UartDma_WaitSlot(0));
+
+    /* First block done: one slot back, the second already started */
+    while (isr_calls == calls) {
+        Hw_Run(1);
+    }
+    TEST_CHECK(hw_DMACH0.bits.CHEN == 1);
+    TEST_CHECK(UartDma_WaitSlot(0));
+    TEST_CHECK(!UartDma_WaitSlot(0));
+    UartDma_Submit(a, 0);                       /* Gives the slot back */
+    Drain();
+
+    TEST_CHECK(isr_calls == calls + 2);
+    TEST_CHECK(LineIs(expect, sizeof(expect)));
+    TEST_CHECK(HwUart_GapCycles() == gaps);
+    TEST_CHECK(UartDma_WaitSlot(0) && UartDma_WaitSlot(0));
+    UartDma_Submit(a, 0);
+    UartDma_Submit(a, 0);
+}
+
+static void TestRamEnds(void)
+{
+    uint16_t addrs[2] = { HWDMA_RAM_START, HWDMA_RAM_END + 1 - LOG_TX_CHUNK };
+
+    Test_Case("blocks at the bottom and the top of RAM go out");
+
+    for (uint8_t k = 0; k < 2; k++) {
+        uint8_t *block = HwDma_Ram(addrs[k]);
+
+        Pattern(block, LOG_TX_CHUNK, (uint8_t)(k * 50));
+        TEST_CHECK(UartDma_WaitSlot(0));
+        UartDma_Submit(block, LOG_TX_CHUNK);
+        Drain();
+        TEST_CHECK(LineIs(block, LOG_TX_CHUNK));
+        TEST_CHECK(!hw_DMAINT0.bits.LOWIF && !hw_DMAINT0.bits.HIGHIF);
+    }
+}
+
+static void TestLateInterrupt(void)
+{
+    uint8_t *a = HwDma_Ram(BLOCK_ADDR);
+    uint8_t *b = HwDma_Ram(BLOCK_ADDR + LOG_TX_CHUNK);
+    uint8_t expect[2 * LOG_TX_CHUNK];
+    uint32_t calls = isr_calls;
+    uint16_t saved_ipl;
+
+    Test_Case("completion ISR later than the next TX event: the stall tick restarts");
+
+    Pattern(a, LOG_TX_CHUNK, 3);
+    Pattern(b, LOG_TX_CHUNK, 200);
+    memcpy(expect, a, LOG_TX_CHUNK);
+    memcpy(expect + LOG_TX_CHUNK, b, LOG_TX_CHUNK);
+
+    TEST_CHECK(UartDma_WaitSlot(0));
+    UartDma_Submit(a, LOG_TX_CHUNK);
+    TEST_CHECK(UartDma_WaitSlot(0));
+    UartDma_Submit(b, LOG_TX_CHUNK);
+
+    /* Held off until the FIFO's last byte has gone into the shift register */
+    SET_AND_SAVE_CPU_IPL(saved_ipl, 7);
+    while (!hw_IFS0bits.DMA0IF) {
+        Hw_Run(1);
+    }
+    Hw_Run(HwUart_ByteCycles() * 3 / 2);
+    RESTORE_CPU_IPL(saved_ipl);
+    TEST_CHECK(isr_calls == calls + 1);
+
+    /* Enabled, but no event will come */
+    Hw_Run(HwUart_ByteCycles() * 3);
+    TEST_CHECK(hw_U2STAbits.TRMT && hw_DMACH0.bits.CHEN && !UartDma_IsIdle());
+    UartDma_TxStallTick();
+    Drain();
+    TEST_CHECK(isr_calls == calls + 2);
+    TEST_CHECK(LineIs(expect, sizeof(expect)));
+    TEST_CHECK(HwUart_Overruns() == 0);
+}
+
+/* vLogTask's loop: refill the chunk submitted two calls ago once a slot is
+ * held. Returns the host cycles spent in CPU code (not blocked). */
+static uint64_t PingPong(const uint8_t *src, uint16_t len)
+{
+    uint8_t *chunk[2] = { HwDma_Ram(BLOCK_ADDR), HwDma_Ram(BLOCK_ADDR + LOG_TX_CHUNK) };
+    uint8_t which = 0;
+    uint64_t cycles = 0;
+
+    vTaskResume(bus_task);
+    while (len > 0) {
+        uint16_t count = len < LOG_TX_CHUNK ? len : LOG_TX_CHUNK;
+        uint64_t t0;
+
+        TEST_CHECK(UartDma_WaitSlot(portMAX_DELAY));
+        t0 = Test_Cycles();
+        memcpy(chunk[which], src, count);
+        UartDma_Submit(chunk[which], count);
+        cycles += Test_Cycles() - t0;
+        src += count;
+        len -= count;
+        which ^= 1;
+    }
+    vTaskSuspend(bus_task);
+    Drain();
+    return cycles;
+}
+
+static void TestPingPong(void)
+{
+    static uint8_t text[4 * KB];
+    uint32_t gaps = HwUart_GapCycles();
+
+    Test_Case("log writer ping-pong, 4 KB: line matches, no gaps, no overruns");
+
+    Pattern(text, sizeof(text), 33);
+    (void)PingPong(text, sizeof(text));
+    TEST_CHECK(LineIs(text, sizeof(text)));
+    TEST_CHECK(HwUart_GapCycles() == gaps);
+    TEST_CHECK(HwUart_Overruns() == 0);
+}
+
+static void TestCostPerKb(void)
+{
+    static uint8_t text[KB];
+    uint32_t bus;
+    uint32_t run;
+    uint32_t calls;
+    uint64_t cycles;
+    uint64_t isr;
+    uint64_t t0;
+
+    Test_Case("CPU cost per KB: DMA blocks against the polled byte path");
+
+    Pattern(text, sizeof(text), 5);
+
+    /* Byte path: the CPU polls UTXBF for the whole transmission */
+    bus = Hw_Cycles();
+    t0 = Test_Cycles();
+    UART2_Write((const char *)text, sizeof(text));
+    cycles = Test_Cycles() - t0;
+    bus = Hw_Cycles() - bus;
+    Drain();
+    TEST_CHECK(LineIs(text, sizeof(text)));
+    TEST_CHECK(bus >= (sizeof(text) - 5) * HwUart_ByteCycles());
+    Test_Note("byte path: CPU held %lu bus cycles, %.0f host cycles",
+              (unsigned long)bus, (double)cycles);
+
+    /* DMA: the CPU only runs the writer and the completion ISR */
+    bus = Hw_Cycles();
+    run = Hw_RunCycles();
+    calls = isr_calls;
+    isr = isr_cycles;
+    cycles = PingPong(text, sizeof(text));
+    bus = (Hw_Cycles() - bus) - (Hw_RunCycles() - run);
+    calls = isr_calls - calls;
+    isr = isr_cycles - isr;
+    TEST_CHECK(LineIs(text, sizeof(text)));
+    TEST_CHECK(calls == sizeof(text) / LOG_TX_CHUNK);
+    Test_Note("DMA, %u-byte blocks: %lu CPU register accesses, %lu interrupts, "
+              "%.0f host cycles (writer %.0f, ISR %.0f)",
+              LOG_TX_CHUNK, (unsigned long)bus, (unsigned long)calls,
+              (double)(cycles + isr), (double)cycles, (double)isr);
+}
+
+/*============================================================================
+ * REFERENCE: Disp2String() AND XmitUART2() BEFORE THE POLLED BULK WRITER
+ *
+ * strlen() on every pass of the loop, the NUL sent as well, and each byte
+ * waited out to TRMT with the transmitter disabled again before the next.
+ *============================================================================*/
+
+#define STRLEN_CYCLES_PER_CHAR  1   /* Lower bound on the target */
+
+static uint32_t ref_scanned;        /* Characters strlen() looked at */
+
+/* The scan runs while the transmitter waits, so its cycles go on the bus */
+static size_t RefStrlen(const char *str)
+{
+    size_t n = strlen(str);
+
+    ref_scanned += n + 1;
+    Hw_Run((n + 1) * STRLEN_CYCLES_PER_CHAR);
+    return n;
+}
+
+static void RefXmitUART2(char CharNum, unsigned int repeatNo)
+{
+    U2STAbits.UTXEN = 1;
+    while (repeatNo != 0) {
+        while (U2STAbits.UTXBF == 1) {
+        }
+        U2TXREG = CharNum;
+        repeatNo--;
+    }
+    while (U2STAbits.TRMT == 0) {
+    }
+    U2STAbits.UTXEN = 0;
+}
+
+static void RefDisp2String(char *str)
+{
+    unsigned int i;
+
+    for (i = 0; i <= RefStrlen(str); i++) {
+        RefXmitUART2(str[i], 1);
+    }
+}
+
+static void TestDisp2String(void)
+{
+    static char line[64 + 1];
+    uint8_t expect[sizeof(line)];
+    uint32_t bus;
+    uint32_t gaps;
+
+    Test_Case("Disp2String, 64-byte line: polled bulk writer against the original");
+
+    Pattern((uint8_t *)line, sizeof(line) - 1, 1);
+    line[sizeof(line) - 1] = '\0';
+    memcpy(expect, line, sizeof(line));
+
+    /* Bus cycles until the last stop bit (TRMT set), with the one strlen()
+     * charged at the same rate as the reference's */
+    gaps = HwUart_GapCycles();
+    bus = Hw_Cycles();
+    Hw_Run(sizeof(line) * STRLEN_CYCLES_PER_CHAR);
+    Disp2String(line);
+    while (!U2STAbits.TRMT) {
+    }
+    bus = Hw_Cycles() - bus;
+    gaps = HwUart_GapCycles() - gaps;
+    TEST_CHECK(LineIs(expect, sizeof(line) - 1));
+    TEST_CHECK(gaps == 0);
+    Test_Note("now:      %2u bytes, %5lu bus cycles, %4lu idle between bytes, strlen %4u chars",
+              (unsigned)(sizeof(line) - 1), (unsigned long)bus, (unsigned long)gaps,
+              (unsigned)sizeof(line));
+
+    ref_scanned = 0;
+    gaps = HwUart_GapCycles();
+    bus = Hw_Cycles();
+    RefDisp2String(line);
+    bus = Hw_Cycles() - bus;
+    gaps = HwUart_GapCycles() - gaps;
+    U2STAbits.UTXEN = 1;            /* As InitUART2() left it */
+
+    /* Same text, then the NUL */
+    TEST_CHECK(LineIs(expect, sizeof(line)));
+    TEST_CHECK(ref_scanned == (sizeof(line) + 1) * sizeof(line));
+    TEST_CHECK(gaps >= ref_scanned * STRLEN_CYCLES_PER_CHAR - sizeof(line));
+    TEST_CHECK(bus > (sizeof(line) - 1) * HwUart_ByteCycles() + gaps);
+    Test_Note("original: %2u bytes, %5lu bus cycles, %4lu idle between bytes, strlen %4lu chars",
+              (unsigned)sizeof(line), (unsigned long)bus, (unsigned long)gaps,
+              (unsigned long)ref_scanned);
+}
+
+static void TestFaultReport(void)
+{
+    static const char report[] = "\r\n[fault] stack overflow in LOG\r\n";
+    uint8_t *block = HwDma_Ram(BLOCK_ADDR);
+    uint8_t got[LOG_TX_CHUNK + sizeof(report)];
+    uint16_t sent;
+    uint16_t n;
+    uint16_t saved_ipl;
+
+    Test_Case("fault report: DMA block abandoned, report goes out polled");
+
+    Pattern(block, LOG_TX_CHUNK, 77);
+    TEST_CHECK(UartDma_WaitSlot(0));
+    UartDma_Submit(block, LOG_TX_CHUNK);
+    Hw_Run(HwUart_ByteCycles() * 10);
+
+    /* As FaultBegin() and vApplicationStackOverflowHook() in main.c */
+    SET_AND_SAVE_CPU_IPL(saved_ipl, 7);
+    UartDma_Abort();
+    UART2_WriteStr(UART_STR("\r\n[fault] "));
+    UART2_WriteStr(UART_STR("stack overflow in "));
+    Disp2String("LOG");
+    UART2_WriteStr(UART_STR("\r\n"));
+    while (!U2STAbits.TRMT) {
+    }
+    RESTORE_CPU_IPL(saved_ipl);
+    Hw_Run(HwUart_ByteCycles() * 2);
+
+    /* A prefix of the block - what the FIFO held at the abort - then all
+     * of the report, and no DMA interrupt */
+    n = HwUart_TakeLine(got, sizeof(got));
+    sent = (uint16_t)(n - (sizeof(report) - 1));
+    TEST_CHECK(n > sizeof(report) - 1 && sent < LOG_TX_CHUNK);
+    TEST_CHECK(memcmp(got, block, sent) == 0);
+    TEST_CHECK(memcmp(got + sent, report, sizeof(report) - 1) == 0);
+    TEST_CHECK(!hw_DMACH0.bits.CHEN && !hw_IEC0bits.DMA0IE);
+    TEST_CHECK(HwUart_Overruns() == 0);
+    Test_Note("%u of %u block bytes went out before the report", sent, LOG_TX_CHUNK);
+}
+
+static void RunTests(void *pvParameters)
+{
+    (void)pvParameters;
+
+    HwUart_Reset();
+    HwDma_Reset();
+    InitUART2();
+    UartDma_Init();
+    vPortSetInterruptHook(Vector);
+
+    TEST_CHECK(xTaskCreate(BusTask, "BUS", configMINIMAL_STACK_SIZE, NULL,
+                           TEST_PRIO_LOW, &bus_task) == pdPASS);
+    vTaskSuspend(bus_task);
+
+    TestSetup();
+    TestOneBlock();
+    TestSlots();
+    TestRamEnds();
+    TestLateInterrupt();
+    TestPingPong();
+    TestCostPerKb();
+    TestDisp2String();
+    TestFaultReport();          /* Last: the slots are not given back */
+
+    vPortSetInterruptHook(NULL);
+}
+
+int main(void)
+{
+    Test_Run(RunTests);
+    return 1;
+}
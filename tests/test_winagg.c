@@ -0,0 +1,402 @@
+/*
+ * File:   test_winagg.c
+ * Author: ENCM 511
+ *
+ * Windowed Aggregation Tests (winagg.c, telemagg.c)
+ *
+ * Description: Every closed window is checked against a double-precision
+ *              two-pass reference over the same samples: count, min, max,
+ *              mean (within the 0.5 of rounding) and the population
+ *              variance rounded down. The edges are the ones winagg.h
+ *              documents: the 65535-sample rollover, negative offsets,
+ *              the 16-bit tick count wrapping inside a window and the
+ *              count x spread < 2^31 limit on the running sum. The last
+ *              case drives telemagg.c and parses its "@agg" lines.
+ *
+ * Created on Nov 2025
+ */
+
+#include "testing.h"
+#include "winagg.h"
+#include "telemagg.h"
+#include "logbuf.h"
+#include "app.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_WINDOW      65535
+#define CAPTURE_BYTES   1024
+
+static int16_t window_samples[MAX_WINDOW];
+
+static char capture[CAPTURE_BYTES];
+static volatile uint32_t capture_len = 0;
+
+static uint32_t seed = 1;
+
+/*============================================================================
+ * HELPERS
+ *============================================================================*/
+
+static int32_t Random(int32_t span)
+{
+    seed = seed * 1103515245UL + 12345UL;
+    return (int32_t)((seed >> 16) % (uint32_t)span);
+}
+
+/* Check one summary against the samples it covers */
+static void CheckSummary(const WinAggSummary_t *sum, const int16_t *x, uint32_t n)
+{
+    double mean = 0.0;
+    double scatter = 0.0;
+    int16_t min = x[0];
+    int16_t max = x[0];
+
+    for (uint32_t i = 0; i < n; i++) {
+        mean += x[i];
+        if (x[i] < min) {
+            min = x[i];
+        }
+        if (x[i] > max) {
+            max = x[i];
+        }
+    }
+    mean /= n;
+    for (uint32_t i = 0; i < n; i++) {
+        scatter += (x[i] - mean) * (x[i] - mean);
+    }
+
+    TEST_CHECK(sum->count == n);
+    TEST_CHECK(sum->min == min);
+    TEST_CHECK(sum->max == max);
+    /* Ties round away from the window's first sample, not from zero */
+    TEST_CHECK(fabs(sum->mean - mean) <= 0.5);
+    TEST_CHECK(sum->variance == (uint32_t)floor(scatter / n + 1e-9));
+}
+
+/* Log consumer: keeps every line the report sends */
+static void CaptureTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for (;;) {
+        uint16_t n;
+
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        while ((n = LogBuf_Read((uint8_t *)&capture[capture_len],
+                                (uint16_t)(CAPTURE_BYTES - 1 - capture_len))) > 0) {
+            capture_len += n;
+        }
+    }
+}
+
+/*============================================================================
+ * TEST CASES
+ *============================================================================*/
+
+static void TestRandomWindows(void)
+{
+    WinAgg_t agg;
+    WinAggSummary_t sum;
+    TickType_t now = 0;
+    uint32_t n = 0;
+    uint32_t windows = 0;
+
+    Test_Case("random windows match the double-precision reference");
+
+    WinAgg_Init(&agg, 100);
+    TEST_CHECK(agg.window == pdMS_TO_TICKS(100));
+    TEST_CHECK(!WinAgg_Take(&agg, &sum));
+
+    for (uint32_t i = 0; i < 20000; i++) {
+        /* Mostly pot-like values, now and then anywhere in int16_t range */
+        int32_t centre = (windows % 4 == 3) ? -20000 : 512;
+        int16_t x = (int16_t)((Random(10) == 0) ? Random(65536) - 32768 :
+                              centre + Random(200) - 100);
+
+        /* The sample that reaches the window end closes it */
+        if (n != 0 && (TickType_t)(now - agg.start) >= agg.window) {
+            WinAgg_Add(&agg, x, now);
+            TEST_CHECK(WinAgg_Take(&agg, &sum));
+            TEST_CHECK(sum.window_ms == 100);
+            CheckSummary(&sum, window_samples, n);
+            TEST_CHECK(!WinAgg_Take(&agg, &sum));
+            windows++;
+            n = 0;
+        } else {
+            WinAgg_Add(&agg, x, now);
+            TEST_CHECK(!WinAgg_Take(&agg, &sum));
+        }
+        window_samples[n++] = x;
+        now = (TickType_t)(now + Random(3));
+    }
+    Test_Note("%lu windows checked", (unsigned long)windows);
+}
+
+static void TestNegativeOffset(void)
+{
+    static const int16_t ties[] = { -3, -4 };
+    static const int16_t cross[] = { -1000, -1200, 300, 500, -32768, 32767, -1 };
+    WinAgg_t agg;
+    WinAggSummary_t sum;
+    int16_t x[1000];
+
+    Test_Case("windows opened by a negative sample");
+
+    WinAgg_Init(&agg, 10);
+
+    /* Mean exactly between two integers: -3.5 */
+    WinAgg_Add(&agg, ties[0], 0);
+    WinAgg_Add(&agg, ties[1], 0);
+    WinAgg_Add(&agg, 0, agg.window);
+    TEST_CHECK(WinAgg_Take(&agg, &sum));
+    CheckSummary(&sum, ties, 2);
+    TEST_CHECK(sum.mean == -4);
+
+    /* First sample below the rest, and the full int16_t range */
+    WinAgg_Init(&agg, 10);
+    for (uint16_t i = 0; i < sizeof(cross) / sizeof(cross[0]); i++) {
+        WinAgg_Add(&agg, cross[i], 0);
+    }
+    WinAgg_Add(&agg, 0, agg.window);
+    TEST_CHECK(WinAgg_Take(&agg, &sum));
+    CheckSummary(&sum, cross, sizeof(cross) / sizeof(cross[0]));
+
+    /* All negative, offset at the top of the range */
+    WinAgg_Init(&agg, 10);
+    for (uint16_t i = 0; i < 1000; i++) {
+        x[i] = (int16_t)(-5000 - Random(3000));
+        WinAgg_Add(&agg, x[i], 0);
+    }
+    WinAgg_Add(&agg, 0, agg.window);
+    TEST_CHECK(WinAgg_Take(&agg, &sum));
+    CheckSummary(&sum, x, 1000);
+}
+
+static void TestCountRollover(void)
+{
+    WinAgg_t agg;
+    WinAggSummary_t sum;
+    int16_t next = 77;
+
+    Test_Case("the 65536th sample closes the window early");
+
+    WinAgg_Init(&agg, 1000);
+    for (uint32_t i = 0; i < MAX_WINDOW; i++) {
+        window_samples[i] = (int16_t)(Random(1024) - 512);
+        WinAgg_Add(&agg, window_samples[i], 0);
+    }
+    TEST_CHECK(agg.open.count == 0xFFFF);
+    TEST_CHECK(!WinAgg_Take(&agg, &sum));
+
+    /* Same tick, window not over: still closes */
+    WinAgg_Add(&agg, next, 0);
+    TEST_CHECK(WinAgg_Take(&agg, &sum));
+    CheckSummary(&sum, window_samples, MAX_WINDOW);
+
+    /* The next window opened with that sample */
+    WinAgg_Add(&agg, 0, agg.window);
+    TEST_CHECK(WinAgg_Take(&agg, &sum));
+    CheckSummary(&sum, &next, 1);
+}
+
+static void TestTickWrap(void)
+{
+    WinAgg_t agg;
+    WinAggSummary_t sum;
+    TickType_t start = (TickType_t)(0xFFFF - 3);
+    TickType_t now = start;
+    uint32_t n = 0;
+
+    Test_Case("a window across the tick count wrap closes on time");
+
+    WinAgg_Init(&agg, 100);
+    for (TickType_t t = 0; t < agg.window; t++) {
+        now = (TickType_t)(start + t);
+        window_samples[n] = (int16_t)(t * 3 - 50);
+        WinAgg_Add(&agg, window_samples[n++], now);
+        TEST_CHECK(!WinAgg_Take(&agg, &sum));
+    }
+    TEST_CHECK(now < start);                    /* Wrapped */
+
+    now = (TickType_t)(start + agg.window);
+    WinAgg_Add(&agg, 1, now);
+    TEST_CHECK(WinAgg_Take(&agg, &sum));
+    CheckSummary(&sum, window_samples, n);
+    TEST_CHECK(agg.start == now);
+}
+
+static void TestSpreadLimit(void)
+{
+    static const struct {
+        int16_t first;
+        int16_t rest;
+        uint16_t count;
+    } edges[] = {
+        { -32768, 32767, 32768 },       /* Spread 65535 */
+        { 0, 32767, 65535 },            /* Spread 32767, full count */
+        { 32767, -32768, 32768 }        /* Same, sum negative */
+    };
+    WinAgg_t agg;
+    WinAggSummary_t sum;
+
+    Test_Case("count x spread just under 2^31: sums stay exact");
+
+    for (uint8_t k = 0; k < sizeof(edges) / sizeof(edges[0]); k++) {
+        uint32_t spread = (uint32_t)abs(edges[k].rest - edges[k].first);
+
+        TEST_CHECK((uint64_t)edges[k].count * spread < (1ULL << 31));
+        WinAgg_Init(&agg, 1000);
+        window_samples[0] = edges[k].first;
+        for (uint32_t i = 1; i < edges[k].count; i++) {
+            window_samples[i] = edges[k].rest;
+        }
+        for (uint32_t i = 0; i < edges[k].count; i++) {
+            WinAgg_Add(&agg, window_samples[i], 0);
+        }
+        WinAgg_Add(&agg, 0, agg.window);
+        TEST_CHECK(WinAgg_Take(&agg, &sum));
+        CheckSummary(&sum, window_samples, edges[k].count);
+        Test_Note("count %5u spread %5lu: mean %d variance %lu", edges[k].count,
+                  (unsigned long)spread, sum.mean, (unsigned long)sum.variance);
+    }
+}
+
+static void TestUntakenWindow(void)
+{
+    WinAgg_t agg;
+    WinAggSummary_t sum;
+
+    Test_Case("an untaken window is replaced by the next one");
+
+    WinAgg_Init(&agg, 10);
+    WinAgg_Add(&agg, 1, 0);
+    WinAgg_Add(&agg, 5, agg.window);            /* Closes {1} */
+    WinAgg_Add(&agg, 9, (TickType_t)(2 * agg.window));     /* Closes {5} */
+    TEST_CHECK(WinAgg_Take(&agg, &sum));
+    TEST_CHECK(sum.count == 1 && sum.min == 5);
+    TEST_CHECK(!WinAgg_Take(&agg, &sum));
+}
+
+static void TestReportLines(void)
+{
+    TaskHandle_t capture_task;
+    WinAgg_t *rxq;
+    char name[16];
+    unsigned window;
+    unsigned count;
+    int min;
+    int max;
+    int mean;
+    unsigned long variance;
+    int16_t x[AGG_SAMPLE_TICKS];
+
+    Test_Case("telemagg.c prints each closed window as one @agg line");
+
+    TEST_CHECK(xTaskCreate(CaptureTask, "CAP", configMINIMAL_STACK_SIZE, NULL,
+                           TEST_PRIO_HIGH, &capture_task) == pdPASS);
+    LogBuf_Init(capture_task);
+
+    TelemAgg_Init();
+    rxq = TelemAgg_Get(AGG_RX_QUEUE);
+    TEST_CHECK(rxq->window_ms == AGG_SLOW_WINDOW_MS);
+    TEST_CHECK(TelemAgg_Get(AGG_POT_FAST)->window_ms == AGG_FAST_WINDOW_MS);
+
+    /* Closed while the report was off: dropped by TelemAgg_Start() */
+    WinAgg_Add(rxq, 40, 0);
+    WinAgg_Add(rxq, 1, rxq->window);
+    TelemAgg_Report();
+    TEST_CHECK(capture_len == 0);
+    TelemAgg_Start();
+    TEST_CHECK(TelemAgg_Running());
+    TelemAgg_Report();
+    TEST_CHECK(capture_len == 0);
+
+    /* One window of queue depths; the 1 that closed the dropped window
+     * opened this one */
+    for (uint8_t i = 0; i < AGG_SAMPLE_TICKS; i++) {
+        x[i] = (int16_t)((i == 0) ? 1 : i % 4);
+        if (i > 0) {
+            WinAgg_Add(rxq, x[i], (TickType_t)(rxq->window + i));
+        }
+    }
+    WinAgg_Add(rxq, 0, (TickType_t)(2 * rxq->window));
+    TelemAgg_Report();
+    capture[capture_len] = '\0';
+
+    TEST_CHECK(sscanf(capture, "@agg %15s %u %u %d %d %d %lu", name, &window, &count,
+                      &min, &max, &mean, &variance) == 7);
+    TEST_CHECK(strcmp(name, "rxq") == 0);
+    TEST_CHECK(window == AGG_SLOW_WINDOW_MS);
+    TEST_CHECK(count == AGG_SAMPLE_TICKS);
+    TEST_CHECK(min == 0 && max == 3);
+    TEST_CHECK(strstr(capture, "\r\n") == capture + strlen(capture) - 2);
+    {
+        WinAggSummary_t sum = { AGG_SLOW_WINDOW_MS, (uint16_t)count, (int16_t)min,
+                                (int16_t)max, (int16_t)mean, (uint32_t)variance };
+
+        CheckSummary(&sum, x, AGG_SAMPLE_TICKS);
+    }
+    Test_Note("%.*s", (int)(capture_len - 2), capture);
+
+    /* Off again: windows keep closing, nothing is printed */
+    capture_len = 0;
+    TelemAgg_Stop();
+    WinAgg_Add(rxq, 0, (TickType_t)(3 * rxq->window));
+    TelemAgg_Report();
+    TEST_CHECK(capture_len == 0);
+}
+
+static void BenchAdd(void)
+{
+    WinAgg_t agg;
+    WinAggSummary_t sum;
+    uint64_t t0;
+    uint64_t add;
+    uint64_t take;
+    const uint32_t samples = 1000000;
+    const uint32_t takes = 100000;
+
+    Test_Case("benchmark: cost per sample");
+
+    WinAgg_Init(&agg, 1000);
+    t0 = Test_Cycles();
+    for (uint32_t i = 0; i < samples; i++) {
+        /* A close every 1000 samples, like a 1 kHz producer */
+        WinAgg_Add(&agg, (int16_t)(i & 0x3FF), (TickType_t)(i / 1000 * agg.window));
+    }
+    add = Test_Cycles() - t0;
+
+    t0 = Test_Cycles();
+    for (uint32_t i = 0; i < takes; i++) {
+        agg.ready = true;
+        (void)WinAgg_Take(&agg, &sum);
+    }
+    take = Test_Cycles() - t0;
+
+    Test_Note("WinAgg_Add:  %.1f cycles/sample (including a close every 1000)",
+              (double)add / samples);
+    Test_Note("WinAgg_Take: %.1f cycles/window (64-bit divides)", (double)take / takes);
+}
+
+static void RunTests(void *pvParameters)
+{
+    (void)pvParameters;
+
+    TestRandomWindows();
+    TestNegativeOffset();
+    TestCountRollover();
+    TestTickWrap();
+    TestSpreadLimit();
+    TestUntakenWindow();
+    TestReportLines();
+    BenchAdd();
+}
+
+int main(void)
+{
+    Test_Run(RunTests);
+    return 1;
+}
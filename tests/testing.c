@@ -0,0 +1,154 @@
+/*
+ * File:   testing.c
+ * Author: ENCM 511
+ *
+ * Host Test Support Implementation
+ *
+ * Created on Nov 2025
+ */
+
+#include "testing.h"
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/* Exit status of a child stopped by configASSERT in Test_ExpectAssert() */
+#define TEST_EXIT_ASSERT    2
+
+static unsigned int test_checks = 0;
+static unsigned int test_cases = 0;
+static bool test_expect_assert = false;
+
+static void TestTask(void *pvParameters)
+{
+    ((TaskFunction_t)pvParameters)(NULL);
+
+    printf("  %u cases, %u checks passed\n", test_cases, test_checks);
+    exit(0);
+}
+
+void Test_Check(int ok, const char *expr, const char *file, int line)
+{
+    test_checks++;
+    if (!ok) {
+        fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expr);
+        exit(1);
+    }
+}
+
+void Test_AssertFailed(const char *file, int line)
+{
+    if (test_expect_assert) {
+        _exit(TEST_EXIT_ASSERT);
+    }
+    fprintf(stderr, "%s:%d: configASSERT failed\n", file, line);
+    exit(1);
+}
+
+void Test_Case(const char *name)
+{
+    test_cases++;
+    printf("  %s\n", name);
+}
+
+void Test_Note(const char *fmt, ...)
+{
+    va_list args;
+
+    printf("    ");
+    va_start(args, fmt);
+    vprintf(fmt, args);
+    va_end(args);
+    printf("\n");
+}
+
+uint64_t Test_Cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+/* Fork, run body in the child, return its exit status (-1 if it crashed) */
+static int RunChild(void (*body)(void *arg), void *arg, bool expect_assert)
+{
+    int fds[2];
+    pid_t pid;
+    int status;
+    unsigned int checks = 0;
+
+    /* Unflushed output would be printed by both processes */
+    fflush(stdout);
+    if (pipe(fds) != 0 || (pid = fork()) < 0) {
+        fprintf(stderr, "cannot fork a child\n");
+        exit(1);
+    }
+    if (pid == 0) {
+        close(fds[0]);
+        test_checks = 0;
+        test_expect_assert = expect_assert;
+        body(arg);
+        fflush(stdout);
+        if (write(fds[1], &test_checks, sizeof(test_checks)) != sizeof(test_checks)) {
+            _exit(1);
+        }
+        _exit(0);
+    }
+
+    close(fds[1]);
+    if (read(fds[0], &checks, sizeof(checks)) != sizeof(checks)) {
+        checks = 0;
+    }
+    close(fds[0]);
+    test_checks += checks;
+    if (waitpid(pid, &status, 0) != pid || !WIFEXITED(status)) {
+        return -1;
+    }
+    return WEXITSTATUS(status);
+}
+
+void Test_RunInChild(void (*body)(void *arg), void *arg)
+{
+    if (RunChild(body, arg, false) != 0) {
+        fprintf(stderr, "child failed\n");
+        exit(1);
+    }
+}
+
+void Test_ExpectAssert(void (*body)(void *arg), void *arg)
+{
+    int status = RunChild(body, arg, true);
+
+    test_checks++;
+    if (status != TEST_EXIT_ASSERT) {
+        fprintf(stderr, "child %s instead of hitting configASSERT\n",
+                (status == 0) ? "returned" : "failed");
+        exit(1);
+    }
+}
+
+void Test_Run(TaskFunction_t body)
+{
+    if (xTaskCreate(TestTask, "TEST", configMINIMAL_STACK_SIZE, (void *)body,
+                    TEST_PRIO_MAIN, NULL) != pdPASS) {
+        fprintf(stderr, "cannot create the test task\n");
+        exit(1);
+    }
+
+    vTaskStartScheduler();
+
+    fprintf(stderr, "scheduler returned\n");
+    exit(1);
+}
@@ -0,0 +1,75 @@
+/*
+ * File:   testing.h
+ * Author: ENCM 511
+ *
+ * Host Test Support
+ *
+ * Description: Checks and the run loop shared by the kernel tests. Each
+ *              test program runs its cases one after another from a single
+ *              task at TEST_PRIO_MAIN; helper tasks go above or below it.
+ *              The first failed check ends the program with exit status 1.
+ *              Benchmarks print their figures with Test_Note() and do not
+ *              check them: they vary with the host.
+ *
+ * Created on Nov 2025
+ */
+
+#ifndef TESTING_H
+#define TESTING_H
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define TEST_PRIO_LOW   ( tskIDLE_PRIORITY + 1 )
+#define TEST_PRIO_MAIN  ( tskIDLE_PRIORITY + 2 )
+#define TEST_PRIO_HIGH  ( tskIDLE_PRIORITY + 3 )
+
+#define TEST_CHECK(cond) \
+    Test_Check((cond) ? 1 : 0, #cond, __FILE__, __LINE__)
+
+void Test_Check(int ok, const char *expr, const char *file, int line);
+
+/**
+ * @brief Announce the next case
+ */
+void Test_Case(const char *name);
+
+/**
+ * @brief Print an indented result line under the current case
+ */
+void Test_Note(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+
+/**
+ * @brief Read a free-running host cycle counter
+ *
+ * Only differences between two readings mean anything. Host cycles are
+ * not PIC24 cycles; compare figures from the same run with each other.
+ */
+uint64_t Test_Cycles(void);
+
+/**
+ * @brief Run body(arg) in a forked copy of the test, and wait for it
+ *
+ * The child starts with every static as it is in the parent, so modules
+ * the parent never called start from their power-on state: one child is
+ * one boot. Its checks count towards the parent's; a failed check in the
+ * child fails the test. Shared memory is the only way back.
+ */
+void Test_RunInChild(void (*body)(void *arg), void *arg);
+
+/**
+ * @brief Run body(arg) in a forked copy of the test; it must hit a
+ *        configASSERT
+ *
+ * One check: it fails if the child returns or fails a check instead.
+ */
+void Test_ExpectAssert(void (*body)(void *arg), void *arg);
+
+/**
+ * @brief Start the kernel, run body as a task, exit with the result
+ *
+ * Never returns.
+ */
+void Test_Run(TaskFunction_t body);
+
+#endif /* TESTING_H */
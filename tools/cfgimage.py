@@ -0,0 +1,319 @@
+#!/usr/bin/env python3
+"""
+File:   cfgimage.py
+Author: ENCM 511
+
+Configuration Image Tool
+
+Description: Builds and checks the flash configuration images read by
+             appcfg.c. Layout, limits and defaults are taken from appcfg.h,
+             hw_config.h and app.h, so the tool follows the firmware when
+             they change.
+
+Commands:
+    build   Write one image as Intel HEX for a slot. Unset fields take the
+            compiled-in defaults.
+                tools/cfgimage.py build --set pwm_frequency_hz=250 \\
+                    --seq 2 --slot 1 -o cfg.hex
+            Merge cfg.hex into the production .hex (MPLAB X: Loadables, or
+            hexmate) to program it with the application.
+    check   Decode both slots from a .hex file, validate them the way
+            AppCfg_Init() does and report which one the firmware will use.
+
+Hex layout:
+    Each instruction word is 4 bytes in the .hex at byte address PC * 2:
+    the 16-bit data word (low byte first), the upper byte (0) and the
+    phantom byte (0). PSV sees only the data word.
+
+Exit status of check is 1 if a slot holds an image that fails validation.
+
+Created on Nov 2025
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+#=============================================================================
+# CONFIGURATION
+#=============================================================================
+
+REPO_ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+DEFINE_FILES = ("appcfg.h", "hw_config.h", "app.h")
+
+# AppConfig_t in order: name, struct code, default macro, limit macro prefix
+FIELDS = (
+    ("button_debounce_ms",   "H", "BUTTON_DEBOUNCE_MS",            "APPCFG_DEBOUNCE"),
+    ("button_long_press_ms", "H", "BUTTON_LONG_PRESS_MS",          "APPCFG_LONG_PRESS"),
+    ("pwm_frequency_hz",     "H", "PWM_FREQUENCY_HZ",              "APPCFG_PWM_HZ"),
+    ("adc_scan_period_ms",   "H", "ADC_SCAN_PERIOD_MS",            "APPCFG_ADC_MS"),
+    ("button_queue_size",    "B", "BUTTON_QUEUE_SIZE",             "APPCFG_BTN_QUEUE"),
+    ("uart_rx_queue_size",   "B", "UART_RX_QUEUE_SIZE",            "APPCFG_RX_QUEUE"),
+    ("show_extended_info",   "B", "DISPLAY_EXTENDED_INFO_DEFAULT", None),
+    ("led2_solid_mode",      "B", "DISPLAY_LED2_SOLID_DEFAULT",    None),
+)
+
+# AppConfigImage_t: magic, version, length, sequence, AppConfig_t, reserved, crc
+HEADER_FMT = "<HHHH"
+CONFIG_FMT = "<" + "".join(code for _, code, _, _ in FIELDS)
+TRAILER_FMT = "<HH"
+IMAGE_SIZE = (struct.calcsize(HEADER_FMT) + struct.calcsize(CONFIG_FMT)
+              + struct.calcsize(TRAILER_FMT))
+
+SLOT_DEFAULTS = "defaults"
+
+#=============================================================================
+# SOURCE CONFIGURATION
+#=============================================================================
+
+RE_DEFINE = re.compile(r"^\s*#define\s+(\w+)\s+(.+?)\s*(?:/\*.*)?(?://.*)?$")
+
+
+def read_defines(root):
+    defines = {}
+    for rel in DEFINE_FILES:
+        path = os.path.join(root, rel)
+        if not os.path.exists(path):
+            continue
+        with open(path, errors="replace") as f:
+            for line in f:
+                m = RE_DEFINE.match(line)
+                if m:
+                    defines.setdefault(m.group(1), m.group(2))
+    return defines
+
+
+def number(defines, name):
+    value = defines[name]
+    value = re.sub(r"(?<=[0-9a-fA-F])[uUlL]+$", "", value.strip("() "))
+    return int(value, 0)
+
+
+class Layout:
+    """Addresses, limits and defaults as compiled into the firmware."""
+
+    def __init__(self, root):
+        d = read_defines(root)
+        self.magic = number(d, "APPCFG_MAGIC")
+        self.version = number(d, "APPCFG_VERSION")
+        self.flash_addr = number(d, "APPCFG_FLASH_ADDR")
+        self.page_size = number(d, "APPCFG_PAGE_SIZE")
+        self.slots = number(d, "APPCFG_SLOTS")
+        self.defaults = {}
+        self.limits = {}
+        for name, _, default, limit in FIELDS:
+            self.defaults[name] = number(d, default)
+            if limit:
+                self.limits[name] = (number(d, limit + "_MIN"), number(d, limit + "_MAX"))
+            else:
+                self.limits[name] = (0, 1)
+
+    def slot_addr(self, slot):
+        return self.flash_addr + slot * self.page_size
+
+    def problems(self, cfg):
+        """Range checks from SettingsValid() in appcfg.c."""
+        out = []
+        for name, _, _, _ in FIELDS:
+            lo, hi = self.limits[name]
+            if not lo <= cfg[name] <= hi:
+                out.append("%s=%d outside %d..%d" % (name, cfg[name], lo, hi))
+        if cfg["button_long_press_ms"] <= cfg["button_debounce_ms"]:
+            out.append("button_long_press_ms must exceed button_debounce_ms")
+        return out
+
+#=============================================================================
+# IMAGE ENCODING
+#=============================================================================
+
+def crc16(data):
+    """CRC-16/CCITT-FALSE, as crc.c."""
+    crc = 0xFFFF
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) & 0xFFFF if crc & 0x8000 else (crc << 1) & 0xFFFF
+    return crc
+
+
+def encode(layout, cfg, sequence):
+    body = struct.pack(HEADER_FMT, layout.magic, layout.version, IMAGE_SIZE, sequence & 0xFFFF)
+    body += struct.pack(CONFIG_FMT, *[cfg[name] for name, _, _, _ in FIELDS])
+    body += struct.pack("<H", 0)
+    return body + struct.pack("<H", crc16(body))
+
+
+def decode(layout, data):
+    """Return (fields, sequence, problems) for one slot's image bytes."""
+    magic, version, length, sequence = struct.unpack_from(HEADER_FMT, data, 0)
+    values = struct.unpack_from(CONFIG_FMT, data, struct.calcsize(HEADER_FMT))
+    cfg = dict(zip([name for name, _, _, _ in FIELDS], values))
+    _, crc = struct.unpack_from(TRAILER_FMT, data, IMAGE_SIZE - struct.calcsize(TRAILER_FMT))
+
+    problems = []
+    if magic != layout.magic:
+        problems.append("bad magic 0x%04X" % magic)
+    elif version != layout.version:
+        problems.append("version %d, firmware expects %d" % (version, layout.version))
+    elif length != IMAGE_SIZE:
+        problems.append("length %d, firmware expects %d" % (length, IMAGE_SIZE))
+    elif crc != crc16(data[:IMAGE_SIZE - 2]):
+        problems.append("CRC 0x%04X, computed 0x%04X" % (crc, crc16(data[:IMAGE_SIZE - 2])))
+    else:
+        problems.extend(layout.problems(cfg))
+    return cfg, sequence, problems
+
+#=============================================================================
+# INTEL HEX
+#=============================================================================
+
+def hex_record(addr, rtype, data):
+    rec = bytes([len(data), (addr >> 8) & 0xFF, addr & 0xFF, rtype]) + bytes(data)
+    return ":%s%02X" % (rec.hex().upper(), (-sum(rec)) & 0xFF)
+
+
+def write_hex(f, pc_addr, words):
+    data = bytearray()
+    for w in words:
+        data += bytes([w & 0xFF, w >> 8, 0, 0])
+    addr = pc_addr * 2
+    upper = None
+    for i in range(0, len(data), 16):
+        a = addr + i
+        if a >> 16 != upper:
+            upper = a >> 16
+            f.write(hex_record(0, 4, [upper >> 8, upper & 0xFF]) + "\n")
+        f.write(hex_record(a & 0xFFFF, 0, data[i:i + 16]) + "\n")
+    f.write(hex_record(0, 1, []) + "\n")
+
+
+def read_hex(path):
+    """Return {byte address: value} for every data byte in the file."""
+    mem = {}
+    base = 0
+    with open(path) as f:
+        for lineno, line in enumerate(f, 1):
+            line = line.strip()
+            if not line:
+                continue
+            if not line.startswith(":"):
+                raise ValueError("%s:%d: not an Intel HEX record" % (path, lineno))
+            rec = bytes.fromhex(line[1:])
+            if sum(rec) & 0xFF:
+                raise ValueError("%s:%d: bad checksum" % (path, lineno))
+            count, addr, rtype = rec[0], (rec[1] << 8) | rec[2], rec[3]
+            data = rec[4:4 + count]
+            if rtype == 0:
+                for i, b in enumerate(data):
+                    mem[base + addr + i] = b
+            elif rtype == 4:
+                base = ((data[0] << 8) | data[1]) << 16
+            elif rtype == 2:
+                base = ((data[0] << 8) | data[1]) << 4
+            elif rtype == 1:
+                break
+    return mem
+
+
+def slot_bytes(layout, mem, slot):
+    """Image bytes as PSV sees them, or None if the slot is not in the file."""
+    addr = layout.slot_addr(slot) * 2
+    out = bytearray()
+    present = False
+    for i in range(IMAGE_SIZE // 2):
+        lo = mem.get(addr + 4 * i)
+        hi = mem.get(addr + 4 * i + 1)
+        present = present or lo is not None or hi is not None
+        out += bytes([0xFF if lo is None else lo, 0xFF if hi is None else hi])
+    return bytes(out) if present else None
+
+#=============================================================================
+# COMMANDS
+#=============================================================================
+
+def cmd_build(layout, args, parser):
+    cfg = dict(layout.defaults)
+    for item in args.set:
+        name, _, value = item.partition("=")
+        if name not in cfg:
+            parser.error("unknown field %s (fields: %s)" % (name, ", ".join(cfg)))
+        cfg[name] = int(value, 0)
+    problems = layout.problems(cfg)
+    if problems:
+        parser.error("; ".join(problems))
+    if not 0 <= args.slot < layout.slots:
+        parser.error("slot must be 0..%d" % (layout.slots - 1))
+
+    image = encode(layout, cfg, args.seq)
+    words = struct.unpack("<%dH" % (len(image) // 2), image)
+    if args.output == "-":
+        write_hex(sys.stdout, layout.slot_addr(args.slot), words)
+    else:
+        with open(args.output, "w") as f:
+            write_hex(f, layout.slot_addr(args.slot), words)
+    return 0
+
+
+def cmd_check(layout, args, parser):
+    mem = read_hex(args.hexfile)
+    valid = {}
+    bad = False
+
+    for slot in range(layout.slots):
+        data = slot_bytes(layout, mem, slot)
+        label = "slot %d @ 0x%05X" % (slot, layout.slot_addr(slot))
+        if data is None:
+            print("%s: empty" % label)
+            continue
+        cfg, seq, problems = decode(layout, data)
+        if problems:
+            bad = True
+            print("%s: INVALID (%s)" % (label, "; ".join(problems)))
+            continue
+        valid[slot] = seq
+        print("%s: valid, sequence %d" % (label, seq))
+        for name, _, _, _ in FIELDS:
+            mark = "" if cfg[name] == layout.defaults[name] else "  (default %d)" % layout.defaults[name]
+            print("    %-22s %6d%s" % (name, cfg[name], mark))
+
+    # Same choice as AppCfg_Init(): newest by signed sequence distance
+    active = SLOT_DEFAULTS
+    for slot, seq in valid.items():
+        if active == SLOT_DEFAULTS:
+            active = slot
+        elif (seq - valid[active]) & 0x8000 == 0 and seq != valid[active]:
+            active = slot
+    print("firmware will use: %s" % (active if active == SLOT_DEFAULTS else "slot %d" % active))
+    return 1 if bad else 0
+
+#=============================================================================
+# MAIN
+#=============================================================================
+
+def main():
+    parser = argparse.ArgumentParser(description="Build and check flash configuration images.")
+    parser.add_argument("--root", default=REPO_ROOT, help="project root (appcfg.h, hw_config.h, app.h)")
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    p = sub.add_parser("build", help="write an image as Intel HEX")
+    p.add_argument("--set", action="append", default=[], metavar="FIELD=VALUE",
+                   help="override a default, e.g. button_debounce_ms=30")
+    p.add_argument("--seq", type=int, default=1, help="sequence number (newest valid image wins)")
+    p.add_argument("--slot", type=int, default=0, help="slot to place the image in")
+    p.add_argument("-o", "--output", default="-", help="output .hex (default stdout)")
+
+    p = sub.add_parser("check", help="validate the slots in a .hex file")
+    p.add_argument("hexfile")
+
+    args = parser.parse_args()
+    layout = Layout(args.root)
+    if args.command == "build":
+        return cmd_build(layout, args, parser)
+    return cmd_check(layout, args, parser)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,285 @@
+#!/usr/bin/env python3
+"""
+File:   deltapack.py
+Author: ENCM 511
+
+Delta-Packed Telemetry Decoder
+
+Description: Host side of deltapack.c. Decodes the "@tz" stream that the
+             's' key turns on, and re-packs recorded traces with the same
+             rules to measure the compression ratio offline.
+
+Commands:
+    decode LOG      Decode every "@tz" line in a terminal capture to CSV
+                    and print the stream summary: samples, raw vs packed vs
+                    on-the-wire bytes, and encode cycles per sample from the
+                    "@tz end" line.
+                        tools/deltapack.py decode capture.log -o trace.csv
+    pack CSV        Pack a recorded trace (header row of field names, one
+                    sample per row) in blocks like the firmware does, check
+                    that it decodes back exactly, and print the ratio.
+                        tools/deltapack.py pack trace.csv --columns pot,duty
+
+Token format (see deltapack.h):
+    varint(zigzag(delta) << 1)  one changed field
+    varint(run << 1 | 1)        run unchanged fields
+
+Created on Nov 2025
+"""
+
+import argparse
+import base64
+import csv
+import sys
+
+#=============================================================================
+# CONFIGURATION
+#=============================================================================
+
+# Match TELEM_STREAM_BLOCK / TELEM_STREAM_KEY_BLOCKS in app.h
+DEFAULT_BLOCK = 72
+DEFAULT_KEY_BLOCKS = 8
+MAX_RUN = 0x7FFF
+
+# Line overhead on the wire: "@tz k " and CRLF
+LINE_OVERHEAD = 8
+
+#=============================================================================
+# CODEC
+#=============================================================================
+
+
+def to_i16(v):
+    v &= 0xFFFF
+    return v - 0x10000 if v & 0x8000 else v
+
+
+def put_varint(out, value):
+    while value >= 0x80:
+        out.append((value & 0x7F) | 0x80)
+        value >>= 7
+    out.append(value)
+
+
+class Packer:
+    """Mirror of DeltaPack_Encode()/DeltaPack_Flush()."""
+
+    def __init__(self, fields):
+        self.fields = fields
+        self.reset()
+
+    def reset(self):
+        self.prev = [0] * self.fields
+        self.run = 0
+
+    def _put_run(self, out):
+        if self.run:
+            put_varint(out, (self.run << 1) | 1)
+            self.run = 0
+
+    def encode(self, sample):
+        out = bytearray()
+        for i, value in enumerate(sample):
+            delta = to_i16(value - self.prev[i])
+            if delta == 0:
+                self.run += 1
+                if self.run == MAX_RUN:
+                    self._put_run(out)
+                continue
+            self._put_run(out)
+            zigzag = ((delta << 1) ^ (delta >> 15)) & 0xFFFF
+            put_varint(out, zigzag << 1)
+            self.prev[i] = to_i16(value)
+        return out
+
+    def flush(self):
+        out = bytearray()
+        self._put_run(out)
+        return out
+
+
+class Unpacker:
+    def __init__(self, fields):
+        self.fields = fields
+        self.reset()
+
+    def reset(self):
+        self.prev = [0] * self.fields
+
+    def decode(self, data):
+        """Return the samples in one block."""
+        values = []
+        pos = 0
+        while pos < len(data):
+            token = 0
+            shift = 0
+            while True:
+                byte = data[pos]
+                pos += 1
+                token |= (byte & 0x7F) << shift
+                shift += 7
+                if not byte & 0x80:
+                    break
+            if token & 1:
+                for _ in range(token >> 1):
+                    i = len(values) % self.fields
+                    values.append(self.prev[i])
+            else:
+                zigzag = token >> 1
+                delta = (zigzag >> 1) ^ -(zigzag & 1)
+                i = len(values) % self.fields
+                self.prev[i] = to_i16(self.prev[i] + delta)
+                values.append(self.prev[i])
+        if len(values) % self.fields:
+            raise ValueError("block ends mid-sample")
+        return [values[i:i + self.fields] for i in range(0, len(values), self.fields)]
+
+
+#=============================================================================
+# COMMANDS
+#=============================================================================
+
+
+def decode_log(path):
+    names = None
+    period = None
+    unpacker = None
+    synced = False
+    samples = []
+    packed = 0
+    wire = 0
+    end = None
+    skipped = 0
+
+    with open(path, errors="replace") as f:
+        for line in f:
+            start = line.find("@tz ")
+            if start < 0:
+                continue
+            parts = line[start:].split()
+            kind = parts[1] if len(parts) > 1 else ""
+            if kind == "start" and len(parts) >= 4:
+                names = parts[2].split(",")
+                period = int(parts[3])
+                unpacker = Unpacker(len(names))
+                synced = False
+            elif kind in ("k", "c") and unpacker and len(parts) >= 3:
+                if kind == "k":
+                    unpacker.reset()
+                    synced = True
+                if not synced:
+                    skipped += 1
+                    continue
+                data = base64.b64decode(parts[2])
+                samples.extend(unpacker.decode(data))
+                packed += len(data)
+                wire += len(parts[2]) + LINE_OVERHEAD
+            elif kind == "end" and len(parts) >= 5:
+                end = [int(x) for x in parts[2:5]]
+    if names is None:
+        raise ValueError("no '@tz start' line found")
+    return names, period, samples, packed, wire, end, skipped
+
+
+def summary(fields, count, packed, wire=None):
+    raw = count * fields * 2
+    print("samples:         %d (%d fields)" % (count, fields))
+    print("raw bytes:       %d (int16 per field)" % raw)
+    print("packed bytes:    %d  ratio %.2f:1  %.2f bytes/sample"
+          % (packed, raw / packed if packed else 0, packed / count if count else 0))
+    if wire is not None:
+        print("on the wire:     %d  ratio %.2f:1 (base64 lines)" % (wire, raw / wire if wire else 0))
+
+
+def cmd_decode(args):
+    names, period, samples, packed, wire, end, skipped = decode_log(args.log)
+    out = open(args.output, "w", newline="") if args.output else sys.stdout
+    writer = csv.writer(out)
+    writer.writerow(names)
+    writer.writerows(samples)
+    if args.output:
+        out.close()
+    else:
+        return 0
+
+    print("period:          %d ms" % period)
+    summary(len(names), len(samples), packed, wire)
+    if skipped:
+        print("skipped:         %d lines before the first 'k' block" % skipped)
+    if end and end[0]:
+        print("encode:          %.0f cycles/sample (board, %d samples)" % (end[2] / end[0], end[0]))
+    return 0
+
+
+def cmd_pack(args):
+    with open(args.csv, newline="") as f:
+        rows = list(csv.reader(f))
+    header, rows = rows[0], rows[1:]
+    columns = args.columns.split(",") if args.columns else header
+    index = [header.index(c) for c in columns]
+    samples = [[to_i16(int(float(r[i]))) for i in index] for r in rows if r]
+
+    packer = Packer(len(columns))
+    unpacker = Unpacker(len(columns))
+    worst = 3 * len(columns) + 3
+    packed = 0
+    wire = 0
+    decoded = []
+    block = bytearray()
+    blocks = 0
+
+    def send():
+        nonlocal block, blocks, packed, wire
+        block += packer.flush()
+        if not block:
+            return
+        if blocks == 0:
+            unpacker.reset()
+        decoded.extend(unpacker.decode(bytes(block)))
+        packed += len(block)
+        wire += 4 * ((len(block) + 2) // 3) + LINE_OVERHEAD
+        block = bytearray()
+        blocks += 1
+        if blocks == args.key_blocks:
+            blocks = 0
+            packer.reset()
+
+    for sample in samples:
+        if len(block) + worst + 3 > args.block:
+            send()
+        block += packer.encode(sample)
+    send()
+
+    if decoded != samples:
+        print("error: round trip mismatch", file=sys.stderr)
+        return 1
+    summary(len(columns), len(samples), packed, wire)
+    return 0
+
+
+#=============================================================================
+# MAIN
+#=============================================================================
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Delta-packed telemetry decoder.")
+    sub = parser.add_subparsers(dest="cmd", required=True)
+
+    p = sub.add_parser("decode", help="decode '@tz' lines from a terminal capture")
+    p.add_argument("log")
+    p.add_argument("-o", "--output", help="CSV file (default: stdout, no summary)")
+
+    p = sub.add_parser("pack", help="pack a recorded CSV trace and report the ratio")
+    p.add_argument("csv")
+    p.add_argument("--columns", help="comma-separated columns (default: all)")
+    p.add_argument("--block", type=int, default=DEFAULT_BLOCK, help="packed bytes per line")
+    p.add_argument("--key-blocks", type=int, default=DEFAULT_KEY_BLOCKS,
+                   help="lines per self-contained group")
+
+    args = parser.parse_args()
+    return cmd_decode(args) if args.cmd == "decode" else cmd_pack(args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,309 @@
+#!/usr/bin/env python3
+"""
+File:   kernstat.py
+Author: ENCM 511
+
+Kernel Object Inspector
+
+Description: Host side of inspect.c. Asks the board for its object catalog
+             ('o') and kernel snapshots ('k') over the UART and renders
+             them as a table: task state, priority and stack left, queue
+             and semaphore fill, mutex holder, heap cost per object, free
+             heap, and how long the snapshot held the scheduler.
+
+Commands:
+    snap PORT       Request the catalog once, then one snapshot (or one
+                    every --watch seconds) and print each.
+                        tools/kernstat.py snap /dev/ttyUSB0 --watch 1
+    decode FILE     Render every frame in a raw capture of the UART.
+                        cat /dev/ttyUSB0 > capture.bin
+
+Stack sizes come from main.c (same parsing as stackstat.py), so task rows
+show words used of words allocated.
+
+Frame format: see inspect.h.
+
+Created on Nov 2025
+"""
+
+import argparse
+import json
+import os
+import struct
+import sys
+import time
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from cfgimage import crc16  # noqa: E402
+from stackstat import REPO_ROOT, read_defines, read_tasks  # noqa: E402
+
+#=============================================================================
+# CONFIGURATION
+#=============================================================================
+
+DEFAULT_BAUD = 38400
+
+# Match inspect.h
+SYNC = 0xA5
+FRAME_SNAPSHOT = 0x01
+FRAME_CATALOG = 0x02
+NO_ID = 0xFF
+HEADER = struct.Struct("<HHHHHHBB")
+RECORD = struct.Struct("<BBBBHH")
+NAME = struct.Struct("<BB8s")
+
+# Longest payload a frame can announce before it is treated as noise
+MAX_PAYLOAD = 512
+
+# queueQUEUE_TYPE_* and HEAPSTAT_KIND_TASK, as in heapstat.c (no queue sets)
+KINDS = {0: "queue", 1: "mutex", 2: "csem", 3: "bsem", 4: "rmutex", 6: "task"}
+KIND_TASK = 6
+MUTEX_KINDS = (1, 4)
+
+# eTaskState
+TASK_STATES = ["running", "ready", "blocked", "suspended", "deleted", "invalid"]
+
+# SystemState_t in app.h
+APP_STATES = ["WAITING", "TIME_INPUT", "READY", "COUNTDOWN", "PAUSED", "COMPLETED"]
+
+#=============================================================================
+# FRAMES
+#=============================================================================
+
+
+class FrameReader:
+    """Pulls CRC-checked frames out of a byte stream mixed with log text."""
+
+    def __init__(self):
+        self.buf = bytearray()
+        self.bad = 0
+
+    def feed(self, data):
+        self.buf += data
+        frames = []
+        while True:
+            start = self.buf.find(SYNC)
+            if start < 0:
+                self.buf.clear()
+                break
+            del self.buf[:start]
+            if len(self.buf) < 4:
+                break
+            length = self.buf[2] | self.buf[3] << 8
+            if length > MAX_PAYLOAD:
+                del self.buf[:1]
+                continue
+            if len(self.buf) < length + 6:
+                break
+            body = bytes(self.buf[1:4 + length])
+            crc = self.buf[4 + length] | self.buf[5 + length] << 8
+            if crc16(body) != crc:
+                self.bad += 1
+                del self.buf[:1]
+                continue
+            frames.append((body[0], body[3:]))
+            del self.buf[:length + 6]
+        return frames
+
+
+def parse_catalog(payload):
+    names = {}
+    for off in range(0, len(payload) - NAME.size + 1, NAME.size):
+        oid, kind, raw = NAME.unpack_from(payload, off)
+        names[oid] = (kind, raw.split(b"\0", 1)[0].decode("ascii", "replace"))
+    return names
+
+
+def parse_snapshot(payload):
+    (seq, tick, heap_free, heap_total, snapshot_us, suspended_us,
+     count, app_state) = HEADER.unpack_from(payload, 0)
+    records = []
+    for i in range(count):
+        oid, kind, state, level, detail, heap = RECORD.unpack_from(
+            payload, HEADER.size + i * RECORD.size)
+        records.append({"id": oid, "kind": kind, "state": state, "level": level,
+                        "detail": detail, "heap_bytes": heap})
+    return {"seq": seq, "tick": tick, "heap_free": heap_free, "heap_total": heap_total,
+            "snapshot_us": snapshot_us, "suspended_us": suspended_us,
+            "app_state": app_state, "objects": records}
+
+#=============================================================================
+# RENDERING
+#=============================================================================
+
+
+def stack_sizes(root):
+    defines = read_defines(root)
+    return {name: words for name, _, words in read_tasks(root, defines)}
+
+
+def label(names, oid):
+    return names.get(oid, (None, "#%d" % oid))[1] or "#%d" % oid
+
+
+def annotate(snap, names, stacks):
+    """Resolve IDs and codes to names, for the table and for --json."""
+    for rec in snap["objects"]:
+        rec["name"] = label(names, rec["id"])
+        kind = rec["kind"]
+        rec["kind_name"] = KINDS.get(kind, "?%d" % kind)
+        if kind == KIND_TASK:
+            state = rec["state"]
+            rec["state_name"] = TASK_STATES[state] if state < len(TASK_STATES) else "?"
+            rec["priority"] = rec["level"]
+            rec["stack_free_words"] = rec["detail"]
+            size = stacks.get(rec["name"])
+            if size is not None:
+                rec["stack_words"] = size
+        else:
+            rec["items"] = rec["state"]
+            rec["capacity"] = rec["level"]
+            if kind in MUTEX_KINDS:
+                holder = rec["detail"]
+                rec["holder"] = None if holder == NO_ID else label(names, holder)
+    state = snap["app_state"]
+    snap["app_state_name"] = APP_STATES[state] if state < len(APP_STATES) else "?"
+    return snap
+
+
+def render(snap):
+    print("snapshot %d  tick %d  %s  heap %d free of %d  took %d us, scheduler held %d us"
+          % (snap["seq"], snap["tick"], snap["app_state_name"], snap["heap_free"],
+             snap["heap_total"], snap["snapshot_us"], snap["suspended_us"]))
+    print("  %-3s %-8s %-6s %-22s %6s" % ("id", "name", "kind", "status", "heap"))
+    for rec in snap["objects"]:
+        if rec["kind"] == KIND_TASK:
+            status = "%-9s prio %d" % (rec["state_name"], rec["priority"])
+            if "stack_words" in rec:
+                used = rec["stack_words"] - rec["stack_free_words"]
+                status += "  stack %d/%d w" % (used, rec["stack_words"])
+            else:
+                status += "  stack %d w free" % rec["stack_free_words"]
+        elif "holder" in rec:
+            status = "held by %s" % rec["holder"] if rec["holder"] else "free"
+        else:
+            status = "%d/%d" % (rec["items"], rec["capacity"])
+        print("  %-3d %-8s %-6s %-22s %6d" % (rec["id"], rec["name"], rec["kind_name"],
+                                              status, rec["heap_bytes"]))
+    print()
+
+
+def emit(snap, names, stacks, as_json):
+    snap = annotate(snap, names, stacks)
+    if as_json:
+        print(json.dumps(snap))
+    else:
+        render(snap)
+
+#=============================================================================
+# SERIAL PORT
+#=============================================================================
+
+
+class Port:
+    """Raw tty without pyserial - stdlib only, like the other tools."""
+
+    def __init__(self, path, baud):
+        import termios
+        import tty
+
+        self.fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+        tty.setraw(self.fd)
+        attrs = termios.tcgetattr(self.fd)
+        speed = getattr(termios, "B%d" % baud)
+        attrs[4] = attrs[5] = speed
+        termios.tcsetattr(self.fd, termios.TCSANOW, attrs)
+        termios.tcflush(self.fd, termios.TCIOFLUSH)
+
+    def close(self):
+        os.close(self.fd)
+
+    def send(self, text):
+        os.write(self.fd, text.encode("ascii"))
+
+    def read(self, timeout):
+        import select
+
+        ready, _, _ = select.select([self.fd], [], [], timeout)
+        return os.read(self.fd, 256) if ready else b""
+
+
+def request(port, reader, key, kind, timeout=2.0):
+    """Send one key and wait for the frame it asks for."""
+    port.send(key)
+    deadline = time.time() + timeout
+    while time.time() < deadline:
+        for frame_kind, payload in reader.feed(port.read(deadline - time.time())):
+            if frame_kind == kind:
+                return payload
+    raise TimeoutError("no answer to %r" % key)
+
+#=============================================================================
+# COMMANDS
+#=============================================================================
+
+
+def cmd_snap(args):
+    stacks = stack_sizes(args.root)
+    port = Port(args.port, args.baud)
+    reader = FrameReader()
+    try:
+        names = parse_catalog(request(port, reader, "o", FRAME_CATALOG))
+        while True:
+            snap = parse_snapshot(request(port, reader, "k", FRAME_SNAPSHOT))
+            emit(snap, names, stacks, args.json)
+            if not args.watch:
+                break
+            time.sleep(args.watch)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        port.close()
+    if reader.bad:
+        print("%d frames failed the CRC" % reader.bad, file=sys.stderr)
+    return 0
+
+
+def cmd_decode(args):
+    stacks = stack_sizes(args.root)
+    reader = FrameReader()
+    names = {}
+    with open(args.file, "rb") as f:
+        frames = reader.feed(f.read())
+    for kind, payload in frames:
+        if kind == FRAME_CATALOG:
+            names = parse_catalog(payload)
+        elif kind == FRAME_SNAPSHOT:
+            emit(parse_snapshot(payload), names, stacks, args.json)
+    if reader.bad:
+        print("%d frames failed the CRC" % reader.bad, file=sys.stderr)
+    if not frames:
+        print("error: no frames found", file=sys.stderr)
+        return 1
+    return 0
+
+#=============================================================================
+# MAIN
+#=============================================================================
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Kernel object inspector.")
+    parser.add_argument("--root", default=REPO_ROOT, help="project directory (for stack sizes)")
+    parser.add_argument("--json", action="store_true", help="one JSON object per snapshot")
+    sub = parser.add_subparsers(dest="cmd", required=True)
+
+    p = sub.add_parser("snap", help="request and print snapshots over the UART")
+    p.add_argument("port")
+    p.add_argument("--baud", type=int, default=DEFAULT_BAUD)
+    p.add_argument("--watch", type=float, default=0, help="repeat every N seconds")
+
+    p = sub.add_parser("decode", help="print the frames in a raw UART capture")
+    p.add_argument("file")
+
+    args = parser.parse_args()
+    return cmd_snap(args) if args.cmd == "snap" else cmd_decode(args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,534 @@
+#!/usr/bin/env python3
+"""
+File:   mapstat.py
+Author: ENCM 511
+
+Linker Map Analyzer
+
+Description: Reads the xc16 linker map (and, when available, the ELF symbol
+             table next to it) and attributes flash and RAM to each source
+             module. The report is written as JSON with sorted keys and a
+             stable symbol order, so two reports can be diffed directly or
+             compared with --diff.
+
+Usage:
+    tools/mapstat.py "dist/default/production/freertos-start.X 2.production.map"
+    tools/mapstat.py MAP --elf ELF --top 40 -o report.json
+    tools/mapstat.py --diff old.json new.json
+
+Units:
+    - Program memory lengths in the map and ELF are in PC units (two per
+      24-bit instruction word); they are converted to bytes as units * 3 / 2,
+      the same rule the linker uses for its "program" memory summary.
+    - Data memory lengths are already bytes.
+
+Exit status is 1 if the attributed totals do not add up to the totals in
+the map's own memory summary, so a parser regression is caught at once.
+
+Created on Nov 2025
+"""
+
+import argparse
+import json
+import os
+import re
+import struct
+import sys
+
+#=============================================================================
+# CONFIGURATION
+#=============================================================================
+
+REPO_ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+# Object path prefix MPLAB X uses for project sources
+BUILD_PREFIXES = ("build/default/production/", "build/default/debug/")
+
+# Source extensions tried when mapping an object back to its source file
+SOURCE_EXTS = (".c", ".S", ".s")
+
+# Output sections that live outside the "program" region (reset vector,
+# interrupt vector table, configuration words)
+VECTOR_PREFIXES = (".reset", ".ivt", ".aivt", ".config_")
+
+# Module name for linker-generated input (jump tables, fill, data init)
+LINKER_MODULE = "<linker>"
+
+# Output sections the linker reserves without any input (RAM the debugger
+# takes in a debug build), and the module they are charged to
+RESERVE_PREFIX = "reserve_"
+RESERVED_MODULE = "<reserved>"
+
+DEFAULT_TOP = 25
+
+#=============================================================================
+# MAP PARSING
+#=============================================================================
+
+RE_HEX = r"(0x[0-9a-fA-F]+)"
+RE_SUMMARY = re.compile(r'^"(program|data)" Memory')
+RE_SUMMARY_ROW = re.compile(r"^(\S+)\s+" + RE_HEX + r"\s+\w+\s+" + RE_HEX)
+RE_SUMMARY_TOTAL = re.compile(r'Total "(program|data)" memory used \(bytes\):\s+' + RE_HEX)
+RE_OUT_SECTION = re.compile(r"^(\.\S+|__\S+|reserve_\S+)(?:\s+" + RE_HEX + r"\s+" + RE_HEX + r"(.*))?$")
+RE_IN_SECTION = re.compile(r"^ (\.\S+|\*fill\*|__\S+)(?:\s+" + RE_HEX + r"\s+" + RE_HEX + r"\s*(.*))?$")
+RE_CONTINUATION = re.compile(r"^\s+" + RE_HEX + r"\s+" + RE_HEX + r"\s*(.*)$")
+RE_LOAD_ADDR = re.compile(r"load address\s+" + RE_HEX)
+RE_SYMBOL = re.compile(r"^\s+" + RE_HEX + r"\s+([A-Za-z_.$][\w.$:/\-]*)$")
+
+
+class OutputSection:
+    def __init__(self, name, addr, length, rest=""):
+        self.name = name
+        self.addr = addr
+        self.length = length
+        # PSV sections (.const) run at a data-space alias of their flash address
+        m = RE_LOAD_ADDR.search(rest or "")
+        self.load_addr = int(m.group(1), 16) if m else addr
+        self.region = None
+        self.inputs = []
+        self.reserved = name.startswith(RESERVE_PREFIX)
+
+
+class InputSection:
+    def __init__(self, name, addr, length, origin):
+        self.name = name
+        self.addr = addr
+        self.length = length
+        self.origin = origin
+        self.symbols = []
+
+
+def parse_summary(lines):
+    """Return the linker's own section tables and totals.
+
+    sections: {"program": {(name, addr), ...}, "data": {...}}
+    totals:   {"program": bytes, "data": bytes}
+    """
+    sections = {"program": set(), "data": set()}
+    totals = {}
+    current = None
+
+    for line in lines:
+        if line.startswith("Linker script and memory map"):
+            break
+        m = RE_SUMMARY.match(line)
+        if m:
+            current = m.group(1)
+            continue
+        m = RE_SUMMARY_TOTAL.search(line)
+        if m:
+            totals[m.group(1)] = int(m.group(2), 16)
+            current = None
+            continue
+        if current is not None:
+            m = RE_SUMMARY_ROW.match(line)
+            if m:
+                sections[current].add((m.group(1), int(m.group(2), 16)))
+
+    return sections, totals
+
+
+def parse_layout(lines):
+    """Parse the "Linker script and memory map" section into output sections."""
+    out_sections = []
+    current_out = None
+    current_in = None
+    pending_out = None
+    pending_in = None
+    started = False
+
+    for raw in lines:
+        line = raw.rstrip("\n").rstrip()
+        if not started:
+            started = line.startswith("Linker script and memory map")
+            continue
+        if not line or line.startswith("LOAD ") or line.lstrip().startswith("*("):
+            continue
+
+        if pending_out is not None:
+            m = RE_CONTINUATION.match(line)
+            if m:
+                current_out = OutputSection(pending_out, int(m.group(1), 16), int(m.group(2), 16),
+                                            m.group(3))
+                out_sections.append(current_out)
+                current_in = None
+                pending_out = None
+                continue
+            pending_out = None
+
+        if pending_in is not None:
+            m = RE_CONTINUATION.match(line)
+            if m and current_out is not None:
+                current_in = InputSection(pending_in, int(m.group(1), 16), int(m.group(2), 16),
+                                          m.group(3).strip())
+                current_out.inputs.append(current_in)
+                pending_in = None
+                continue
+            pending_in = None
+
+        if not line[0].isspace():
+            m = RE_OUT_SECTION.match(line)
+            if not m:
+                current_out = None
+                current_in = None
+                continue
+            if m.group(2) is None:
+                pending_out = m.group(1)
+            else:
+                current_out = OutputSection(m.group(1), int(m.group(2), 16), int(m.group(3), 16),
+                                            m.group(4))
+                out_sections.append(current_out)
+                current_in = None
+            continue
+
+        if current_out is None or current_out.reserved:
+            # A reservation's *fill* line gives the fill pattern, not input
+            continue
+
+        m = RE_IN_SECTION.match(line)
+        if m:
+            if m.group(2) is None:
+                pending_in = m.group(1)
+            else:
+                current_in = InputSection(m.group(1), int(m.group(2), 16), int(m.group(3), 16),
+                                          m.group(4).strip())
+                current_out.inputs.append(current_in)
+            continue
+
+        m = RE_SYMBOL.match(line)
+        if m and current_in is not None:
+            current_in.symbols.append((int(m.group(1), 16), m.group(2)))
+            continue
+
+        m = RE_CONTINUATION.match(line)
+        if m:
+            # Linker-generated data (SHORT/LONG statements) inside an output section
+            current_in = InputSection("(linker)", int(m.group(1), 16), int(m.group(2), 16), "")
+            current_out.inputs.append(current_in)
+
+    for sec in out_sections:
+        fold_linker_data(sec)
+    return out_sections
+
+
+def fold_linker_data(sec):
+    """Cap SHORT/LONG statements at what the output section has left.
+
+    In a program section (.reset) they are listed one per data word with
+    lengths that add up to more than the section, which would count the
+    reset vector's words twice.
+    """
+    data = [inp for inp in sec.inputs if inp.name == "(linker)" and not inp.origin]
+    if not data or sum(inp.length for inp in sec.inputs) <= sec.length:
+        return
+    rest = sum(inp.length for inp in sec.inputs if inp not in data)
+    folded = InputSection("(linker)", data[0].addr, max(sec.length - rest, 0), "")
+    sec.inputs = [inp for inp in sec.inputs if inp not in data] + [folded]
+
+
+def classify(out_sections, summary_sections):
+    for sec in out_sections:
+        if (sec.name, sec.load_addr) in summary_sections["program"]:
+            sec.region = "flash"
+        elif (sec.name, sec.addr) in summary_sections["data"]:
+            sec.region = "ram"
+        elif sec.name.startswith(VECTOR_PREFIXES):
+            sec.region = "vectors"
+
+
+#=============================================================================
+# ELF SYMBOLS
+#=============================================================================
+
+SHT_SYMTAB = 2
+STT_OBJECT = 1
+STT_FUNC = 2
+
+
+def read_elf_symbols(path):
+    """Return [(name, section_name, section_addr, value, size)] from an ELF32 LE file.
+
+    Only sized OBJECT and FUNC symbols are returned.
+    """
+    with open(path, "rb") as f:
+        data = f.read()
+
+    if data[:4] != b"\x7fELF" or data[4] != 1 or data[5] != 1:
+        raise ValueError("%s: not a little-endian ELF32 file" % path)
+
+    e_shoff, = struct.unpack_from("<I", data, 0x20)
+    e_shentsize, e_shnum, e_shstrndx = struct.unpack_from("<HHH", data, 0x2E)
+
+    headers = []
+    for i in range(e_shnum):
+        headers.append(struct.unpack_from("<IIIIIIIIII", data, e_shoff + i * e_shentsize))
+
+    def c_string(offset):
+        end = data.index(b"\0", offset)
+        return data[offset:end].decode("ascii", "replace")
+
+    shstr_off = headers[e_shstrndx][4]
+    sec_names = [c_string(shstr_off + h[0]) for h in headers]
+
+    symbols = []
+    for h in headers:
+        if h[1] != SHT_SYMTAB:
+            continue
+        offset, size, link, entsize = h[4], h[5], h[6], h[9]
+        str_off = headers[link][4]
+        for pos in range(offset, offset + size, entsize):
+            st_name, st_value, st_size, st_info, _, st_shndx = struct.unpack_from("<IIIBBH", data, pos)
+            if st_size == 0 or (st_info & 0xF) not in (STT_OBJECT, STT_FUNC):
+                continue
+            if st_shndx == 0 or st_shndx >= len(headers):
+                continue
+            symbols.append((c_string(str_off + st_name), sec_names[st_shndx],
+                            headers[st_shndx][3], st_value, st_size))
+    return symbols
+
+
+#=============================================================================
+# ATTRIBUTION
+#=============================================================================
+
+def module_name(origin):
+    """Map an input-section origin to a module name."""
+    if not origin or "/" not in origin and "." not in origin:
+        return LINKER_MODULE
+
+    m = re.match(r"^(.*\.a)\((.*)\)$", origin)
+    if m:
+        return "lib/" + os.path.basename(m.group(1))
+
+    path = origin
+    for prefix in BUILD_PREFIXES:
+        if path.startswith(prefix):
+            path = path[len(prefix):]
+            break
+
+    base, ext = os.path.splitext(path)
+    if ext == ".o":
+        for src_ext in SOURCE_EXTS:
+            if os.path.exists(os.path.join(REPO_ROOT, base + src_ext)):
+                return base + src_ext
+    return path
+
+
+def to_bytes(region, units):
+    return units * 3 // 2 if region in ("flash", "vectors") else units
+
+
+def c_name(symbol):
+    """XC16 prefixes C identifiers with one underscore."""
+    return symbol[1:] if symbol.startswith("_") else symbol
+
+
+def analyse(map_path, elf_path, top):
+    with open(map_path, "r", errors="replace") as f:
+        lines = f.readlines()
+
+    summary_sections, summary_totals = parse_summary(lines)
+    out_sections = parse_layout(lines)
+    classify(out_sections, summary_sections)
+
+    modules = {}
+    totals_units = {"flash": 0, "ram": 0, "vectors": 0}
+    # (region, start, end, module) for every input section, used to place ELF symbols
+    ranges = []
+    map_symbols = []
+
+    for sec in out_sections:
+        if sec.region is None:
+            continue
+        totals_units[sec.region] += sec.length
+        for inp in sec.inputs:
+            mod = module_name(inp.origin)
+            entry = modules.setdefault(mod, {"flash": 0, "ram": 0, "vectors": 0, "sections": {}})
+            entry[sec.region] += inp.length
+            entry["sections"][sec.name] = entry["sections"].get(sec.name, 0) + inp.length
+            ranges.append((sec.region, sec.name, inp.addr, inp.addr + inp.length, mod))
+
+            # Map-only size estimate: distance to the next symbol in the input section
+            syms = sorted(set(inp.symbols))
+            for i, (addr, name) in enumerate(syms):
+                end = syms[i + 1][0] if i + 1 < len(syms) else inp.addr + inp.length
+                if end > addr:
+                    map_symbols.append((name, sec.region, addr, end - addr, mod))
+
+    # Each output section's linker padding is attributed to the linker, and
+    # a reservation as a whole to RESERVED_MODULE
+    for sec in out_sections:
+        if sec.region is None:
+            continue
+        used = sum(inp.length for inp in sec.inputs)
+        if sec.length > used:
+            mod = RESERVED_MODULE if sec.reserved else LINKER_MODULE
+            entry = modules.setdefault(mod, {"flash": 0, "ram": 0, "vectors": 0, "sections": {}})
+            entry[sec.region] += sec.length - used
+            entry["sections"][sec.name] = entry["sections"].get(sec.name, 0) + sec.length - used
+
+    symbols = []
+    symbol_source = "map"
+    if elf_path:
+        symbol_source = "elf"
+        region_by_section = {(s.name, s.addr): s.region for s in out_sections}
+        seen = set()
+        for name, sec_name, sec_addr, value, size in read_elf_symbols(elf_path):
+            region = region_by_section.get((sec_name, sec_addr))
+            if region is None or (name, value) in seen:
+                continue
+            seen.add((name, value))
+            mod = LINKER_MODULE
+            for r_region, r_sec, start, end, r_mod in ranges:
+                if r_region == region and r_sec == sec_name and start <= value < end:
+                    mod = r_mod
+                    break
+            symbols.append((name, region, value, size, mod))
+    else:
+        symbols = map_symbols
+
+    # Static functions appear as "build/.../file.o:_name" in the map
+    symbol_list = [{
+        "name": c_name(name.rsplit(":", 1)[-1]),
+        "module": mod,
+        "region": region,
+        "bytes": to_bytes(region, size),
+    } for name, region, _, size, mod in symbols]
+    symbol_list.sort(key=lambda s: (-s["bytes"], s["name"], s["module"]))
+
+    report_modules = {}
+    for mod, entry in modules.items():
+        report_modules[mod] = {
+            "flash_bytes": to_bytes("flash", entry["flash"]),
+            "ram_bytes": entry["ram"],
+            "vector_bytes": to_bytes("vectors", entry["vectors"]),
+            "sections": {name: to_bytes(_section_region(out_sections, name), units)
+                         for name, units in entry["sections"].items()},
+        }
+
+    totals = {
+        "flash_bytes": to_bytes("flash", totals_units["flash"]),
+        "ram_bytes": totals_units["ram"],
+        "vector_bytes": to_bytes("vectors", totals_units["vectors"]),
+    }
+
+    report = {
+        "map": os.path.basename(map_path),
+        "symbol_source": symbol_source,
+        "totals": totals,
+        "linker_summary": {
+            "flash_bytes": summary_totals.get("program"),
+            "ram_bytes": summary_totals.get("data"),
+        },
+        "modules": report_modules,
+        "largest_symbols": symbol_list[:top],
+    }
+
+    errors = []
+    # Summary rows round each output section separately; allow that rounding
+    flash_slack = len(summary_sections["program"])
+    if summary_totals.get("program") is not None and \
+            abs(totals["flash_bytes"] - summary_totals["program"]) > flash_slack:
+        errors.append("flash: attributed %d bytes, linker summary %d"
+                      % (totals["flash_bytes"], summary_totals["program"]))
+    if summary_totals.get("data") is not None and totals["ram_bytes"] != summary_totals["data"]:
+        errors.append("ram: attributed %d bytes, linker summary %d"
+                      % (totals["ram_bytes"], summary_totals["data"]))
+    # Program lengths are whole instruction words (even PC units), so the
+    # per-module byte counts add up exactly
+    for key in ("flash_bytes", "ram_bytes", "vector_bytes"):
+        attributed = sum(m[key] for m in report_modules.values())
+        if attributed != totals[key]:
+            errors.append("%s: modules add up to %d, sections to %d" % (key, attributed, totals[key]))
+    return report, errors
+
+
+def _section_region(out_sections, name):
+    for sec in out_sections:
+        if sec.name == name and sec.region is not None:
+            return sec.region
+    return "ram"
+
+
+#=============================================================================
+# DIFF
+#=============================================================================
+
+def diff_reports(old, new):
+    lines = []
+
+    def row(label, a, b):
+        if a != b:
+            lines.append("  %-52s %8d -> %8d  (%+d)" % (label, a, b, b - a))
+
+    lines.append("totals:")
+    for key in ("flash_bytes", "ram_bytes", "vector_bytes"):
+        row(key, old["totals"].get(key, 0), new["totals"].get(key, 0))
+
+    lines.append("modules:")
+    for mod in sorted(set(old["modules"]) | set(new["modules"])):
+        a = old["modules"].get(mod, {})
+        b = new["modules"].get(mod, {})
+        for key in ("flash_bytes", "ram_bytes"):
+            row("%s %s" % (mod, key.split("_")[0]), a.get(key, 0), b.get(key, 0))
+
+    lines.append("symbols:")
+    a_syms = {(s["name"], s["module"]): s["bytes"] for s in old["largest_symbols"]}
+    b_syms = {(s["name"], s["module"]): s["bytes"] for s in new["largest_symbols"]}
+    for key in sorted(set(a_syms) | set(b_syms)):
+        row("%s (%s)" % key, a_syms.get(key, 0), b_syms.get(key, 0))
+
+    return "\n".join(lines)
+
+
+#=============================================================================
+# MAIN
+#=============================================================================
+
+def default_elf(map_path):
+    """The ELF MPLAB X writes next to the map ("X 2" in the map, "X_2" in the ELF)."""
+    directory = os.path.dirname(map_path) or "."
+    for name in os.listdir(directory):
+        if name.endswith(".elf"):
+            return os.path.join(directory, name)
+    return None
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Attribute xc16 flash/RAM usage to source modules.")
+    parser.add_argument("map", nargs="?", help="xc16 linker map file")
+    parser.add_argument("--elf", help="ELF file for symbol sizes (default: the .elf next to the map)")
+    parser.add_argument("--no-elf", action="store_true", help="estimate symbol sizes from the map only")
+    parser.add_argument("--top", type=int, default=DEFAULT_TOP, help="number of largest symbols to list")
+    parser.add_argument("-o", "--output", help="write the JSON report here instead of stdout")
+    parser.add_argument("--diff", nargs=2, metavar=("OLD", "NEW"), help="compare two JSON reports")
+    args = parser.parse_args()
+
+    if args.diff:
+        with open(args.diff[0]) as f:
+            old = json.load(f)
+        with open(args.diff[1]) as f:
+            new = json.load(f)
+        print(diff_reports(old, new))
+        return 0
+
+    if not args.map:
+        parser.error("a map file is required")
+
+    elf = None if args.no_elf else (args.elf or default_elf(args.map))
+    report, errors = analyse(args.map, elf, args.top)
+
+    text = json.dumps(report, indent=2, sort_keys=True) + "\n"
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(text)
+    else:
+        sys.stdout.write(text)
+
+    for err in errors:
+        sys.stderr.write("mapstat: %s\n" % err)
+    return 1 if errors else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,400 @@
+#!/usr/bin/env python3
+"""
+File:   stackstat.py
+Author: ENCM 511
+
+Worst-Case Stack Analyzer
+
+Description: Combines per-function frame sizes from the compiler with a
+             call graph and reports the deepest stack each task can reach,
+             compared against the sizes given to xTaskCreate() in main.c.
+
+Inputs (files or directories, searched recursively):
+    *.ci    GCC -fcallgraph-info=su output: frames and call edges in one file
+    *.su    GCC -fstack-usage output: frames only
+    *.dis   Disassembly (objdump -dr / xc16-objdump -d): call edges for *.su
+
+    xc16:   add -fstack-usage to the compiler options, then
+            xc16-objdump -d dist/default/production/*.elf > build/app.dis
+            tools/stackstat.py build/default/production build/app.dis
+    host:   gcc -fcallgraph-info=su -c <same sources> (against stub device
+            headers), then tools/stackstat.py <dir with the .ci files>
+
+Model:
+    - Task worst case = deepest call path from the task function
+                      + one saved context (the port pushes every register
+                        on the task stack when it switches out)
+                      + the deepest ISR nesting chain.
+    - ISRs run on the interrupted task's stack. An ISR can only be
+      interrupted by a higher IPL, so the deepest chain takes the worst ISR
+      at each distinct IPL. IPLs are read from the IPCxbits.xxIP
+      assignments in the sources; --ipl overrides them.
+    - Recursion and calls through function pointers cannot be bounded and
+      are listed as warnings.
+
+Exit status is 1 if any task's worst case exceeds its configured stack.
+
+Created on Nov 2025
+"""
+
+import argparse
+import os
+import re
+import sys
+
+#=============================================================================
+# CONFIGURATION
+#=============================================================================
+
+REPO_ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+# Headers whose #defines are used to evaluate stack sizes and IPLs
+DEFINE_FILES = ("FreeRTOSConfig.h", "app.h", "hw_config.h", "uart_dma.h", "adc.c",
+                "rtcc.c", "buttons.c")
+
+# Sources scanned for IPCxbits.xxIP assignments
+IPL_FILES = ("uart.c", "pwm.c", "adc.c", "uart_dma.c", "rtcc.c", "buttons.c",
+             "FreeRTOS/portable/MPLAB/PIC24_dsPIC/port.c")
+
+# IPC field prefix -> interrupt name where the two differ
+IPL_ALIASES = {"AD1": "ADC1", "RTC": "RTCC"}
+
+# Registers portSAVE_CONTEXT pushes (portasm_PIC24.S): SR, W0-W14, RCOUNT,
+# TBLPAG, CORCON, DSRPAG, DSWPAG, critical nesting, plus the return PC
+DEFAULT_CONTEXT_BYTES = 48
+
+# Return PC and SR pushed by the CPU on interrupt entry
+ISR_ENTRY_BYTES = 4
+
+# sizeof(StackType_t) on the PIC24 port
+DEFAULT_WORD_BYTES = 2
+
+# Idle task created by vTaskStartScheduler()
+IDLE_TASK = ("IDLE", "prvIdleTask", "configMINIMAL_STACK_SIZE")
+
+INDIRECT = "__indirect_call"
+
+#=============================================================================
+# INPUT PARSING
+#=============================================================================
+
+RE_CI_NODE = re.compile(r'^node: \{ title: "([^"]+)" label: "([^"]*)"')
+RE_CI_FRAME = re.compile(r"\\n(\d+) bytes \((static|dynamic|dynamic,bounded)\)")
+RE_CI_EDGE = re.compile(r'^edge: \{ sourcename: "([^"]+)" targetname: "([^"]+)"')
+RE_SU_LINE = re.compile(r"^(.*):(\d+):(\d+):(\S+)\t(\d+)\t(\S+)")
+RE_DIS_FUNC = re.compile(r"^[0-9a-fA-F]+ <([^>]+)>:$")
+RE_DIS_CALL = re.compile(r"\s(r?call|call\.[lw]|goto|jmp)\s+(.*)$")
+RE_DIS_TARGET = re.compile(r"<([^>+]+)(?:\+0x[0-9a-fA-F]+)?>")
+RE_DIS_RELOC = re.compile(r"\sR_\w+\s+([A-Za-z_.$][\w.$]*)")
+
+
+class CallGraph:
+    def __init__(self):
+        self.frames = {}        # function -> frame bytes
+        self.dynamic = set()    # functions with alloca/VLA frames
+        self.calls = {}         # function -> set of callees
+
+    def add_call(self, caller, callee):
+        self.calls.setdefault(caller, set()).add(callee)
+
+
+def short_name(title):
+    """GCC qualifies static functions as "file.c:name"."""
+    return title.rsplit(":", 1)[-1]
+
+
+def load_ci(path, graph):
+    with open(path, errors="replace") as f:
+        for line in f:
+            m = RE_CI_NODE.match(line)
+            if m:
+                frame = RE_CI_FRAME.search(m.group(2))
+                if frame:
+                    name = short_name(m.group(1))
+                    graph.frames[name] = max(graph.frames.get(name, 0), int(frame.group(1)))
+                    if frame.group(2) == "dynamic":
+                        graph.dynamic.add(name)
+                continue
+            m = RE_CI_EDGE.match(line)
+            if m:
+                graph.add_call(short_name(m.group(1)), short_name(m.group(2)))
+
+
+def load_su(path, graph):
+    with open(path, errors="replace") as f:
+        for line in f:
+            m = RE_SU_LINE.match(line)
+            if m:
+                name = short_name(m.group(4))
+                graph.frames[name] = max(graph.frames.get(name, 0), int(m.group(5)))
+                if m.group(6) == "dynamic":
+                    graph.dynamic.add(name)
+
+
+def load_dis(path, graph):
+    current = None
+    pending = False     # call whose target is in the next relocation line
+    with open(path, errors="replace") as f:
+        for line in f:
+            m = RE_DIS_FUNC.match(line.rstrip())
+            if m:
+                current = m.group(1)
+                pending = False
+                continue
+            if current is None:
+                continue
+            if pending:
+                pending = False
+                m = RE_DIS_RELOC.search(line)
+                if m:
+                    graph.add_call(current, m.group(1))
+                    continue
+            m = RE_DIS_CALL.search(line)
+            if not m:
+                continue
+            target = RE_DIS_TARGET.search(m.group(2))
+            if target and target.group(1) != current:
+                graph.add_call(current, target.group(1))
+            elif target or re.match(r"^(0x)?[0-9a-fA-F]+\s*$", m.group(2)):
+                # Unlinked object (objdump -dr): target is in the relocation
+                pending = True
+            elif m.group(1).startswith(("call", "rcall")):
+                # call Wn / call *%rax
+                graph.add_call(current, INDIRECT)
+
+
+def load_inputs(paths):
+    graph = CallGraph()
+    dis_files = []
+
+    for path in paths:
+        if os.path.isdir(path):
+            for root, _, files in os.walk(path):
+                for name in sorted(files):
+                    full = os.path.join(root, name)
+                    if name.endswith(".ci"):
+                        load_ci(full, graph)
+                    elif name.endswith(".su"):
+                        load_su(full, graph)
+        elif path.endswith(".ci"):
+            load_ci(path, graph)
+        elif path.endswith(".su"):
+            load_su(path, graph)
+        else:
+            dis_files.append(path)
+
+    for path in dis_files:
+        load_dis(path, graph)
+
+    # Disassembly names carry the assembler's leading underscore
+    calls = {}
+    for caller, callees in graph.calls.items():
+        calls.setdefault(c_name(graph, caller), set()).update(c_name(graph, c) for c in callees)
+    graph.calls = calls
+    return graph
+
+
+def c_name(graph, name):
+    if name not in graph.frames and name.startswith("_") and name[1:] in graph.frames:
+        return name[1:]
+    return name
+
+
+#=============================================================================
+# SOURCE CONFIGURATION
+#=============================================================================
+
+RE_DEFINE = re.compile(r"^\s*#define\s+(\w+)\s+(.+?)\s*(?:/\*.*)?(?://.*)?$")
+RE_TASK_CREATE = re.compile(r'xTaskCreate\(\s*(\w+)\s*,\s*"([^"]*)"\s*,\s*(\w+)', re.S)
+RE_IPL = re.compile(r"IPC\d+bits\.(\w+?)IP\s*=\s*(\w+)\s*;")
+RE_CAST = re.compile(r"\(\s*(?:unsigned|signed|const|volatile|\s)*\s*(?:char|short|int|long|size_t|u?int\d+_t|UBaseType_t|TickType_t)\s*\)")
+
+
+def read_defines(root):
+    defines = {}
+    for rel in DEFINE_FILES:
+        path = os.path.join(root, rel)
+        if not os.path.exists(path):
+            continue
+        with open(path, errors="replace") as f:
+            for line in f:
+                m = RE_DEFINE.match(line)
+                if m and "(" not in m.group(1):
+                    defines.setdefault(m.group(1), m.group(2))
+    return defines
+
+
+def evaluate(expr, defines, depth=0):
+    """Evaluate a simple integer macro expression."""
+    if depth > 16:
+        raise ValueError("macro nesting too deep: %s" % expr)
+    expr = RE_CAST.sub("", expr)
+
+    def expand(m):
+        word = m.group(0)
+        if word in defines:
+            return "(%d)" % evaluate(defines[word], defines, depth + 1)
+        raise ValueError("unknown macro %s" % word)
+
+    expr = re.sub(r"\b[A-Za-z_]\w*\b", expand, expr)
+    expr = re.sub(r"\b(0x[0-9a-fA-F]+|\d+)[uUlL]+\b", r"\1", expr)
+    if not re.match(r"^[\s\d()+\-*/x0-9a-fA-F<>|&]*$", expr):
+        raise ValueError("cannot evaluate %s" % expr)
+    return int(eval(expr.replace("/", "//")))
+
+
+def read_tasks(root, defines):
+    with open(os.path.join(root, "main.c"), errors="replace") as f:
+        text = f.read()
+    tasks = [(name, entry, evaluate(size, defines))
+             for entry, name, size in RE_TASK_CREATE.findall(text)]
+    tasks.append((IDLE_TASK[0], IDLE_TASK[1], evaluate(IDLE_TASK[2], defines)))
+    return tasks
+
+
+def read_ipls(root, defines):
+    ipls = {}
+    for rel in IPL_FILES:
+        path = os.path.join(root, rel)
+        if not os.path.exists(path):
+            continue
+        with open(path, errors="replace") as f:
+            for field, value in RE_IPL.findall(f.read()):
+                name = "_%sInterrupt" % IPL_ALIASES.get(field, field)
+                ipls[name] = evaluate(value, defines)
+    return ipls
+
+
+#=============================================================================
+# ANALYSIS
+#=============================================================================
+
+class Analyzer:
+    def __init__(self, graph):
+        self.graph = graph
+        self.memo = {}
+        self.active = set()
+        self.recursive = set()
+        self.indirect = set()
+        self.unknown = set()
+
+    def worst(self, func):
+        """Return (bytes, path) for the deepest call chain starting at func."""
+        if func in self.memo:
+            return self.memo[func]
+        if func == INDIRECT:
+            return 0, []
+        if func in self.active:
+            self.recursive.add(func)
+            return 0, []
+
+        self.active.add(func)
+        if func not in self.graph.frames:
+            self.unknown.add(func)
+        best, best_path = 0, []
+        for callee in sorted(self.graph.calls.get(func, ())):
+            if callee == INDIRECT:
+                self.indirect.add(func)
+                continue
+            depth, path = self.worst(callee)
+            if depth > best:
+                best, best_path = depth, path
+        self.active.discard(func)
+
+        result = (self.graph.frames.get(func, 0) + best, [func] + best_path)
+        self.memo[func] = result
+        return result
+
+
+def isr_chain(analyzer, graph, ipls):
+    """Worst ISR per IPL, and the nesting chain total."""
+    isrs = sorted(name for name in graph.frames if re.match(r"^_\w+Interrupt$", name))
+    rows = []
+    per_level = {}
+    for name in isrs:
+        depth, path = analyzer.worst(name)
+        cost = depth + ISR_ENTRY_BYTES
+        ipl = ipls.get(name)
+        rows.append((name, ipl, cost, path))
+        # Unknown IPL: assume it can nest under everything else
+        level = ipl if ipl is not None else ("?", name)
+        if cost > per_level.get(level, (0, None))[0]:
+            per_level[level] = (cost, name)
+    chain = [per_level[k][1] for k in sorted(per_level, key=str)]
+    return rows, sum(v[0] for v in per_level.values()), chain
+
+
+#=============================================================================
+# MAIN
+#=============================================================================
+
+def main():
+    parser = argparse.ArgumentParser(description="Worst-case stack depth per task and ISR.")
+    parser.add_argument("inputs", nargs="+", help=".ci/.su files, disassembly files, or directories")
+    parser.add_argument("--root", default=REPO_ROOT, help="project root (main.c, app.h, ...)")
+    parser.add_argument("--context-bytes", type=int, default=DEFAULT_CONTEXT_BYTES,
+                        help="bytes the port saves on a task stack at a switch")
+    parser.add_argument("--word-bytes", type=int, default=DEFAULT_WORD_BYTES,
+                        help="sizeof(StackType_t)")
+    parser.add_argument("--ipl", action="append", default=[], metavar="ISR=N",
+                        help="override an ISR priority, e.g. _U2RXInterrupt=4")
+    parser.add_argument("-v", "--verbose", action="store_true", help="print the deepest call path")
+    args = parser.parse_args()
+
+    graph = load_inputs(args.inputs)
+    if not graph.frames:
+        parser.error("no stack usage found in the inputs")
+
+    defines = read_defines(args.root)
+    tasks = read_tasks(args.root, defines)
+    ipls = read_ipls(args.root, defines)
+    for item in args.ipl:
+        name, _, value = item.partition("=")
+        ipls[name] = int(value, 0)
+
+    analyzer = Analyzer(graph)
+    isr_rows, isr_bytes, chain = isr_chain(analyzer, graph, ipls)
+
+    print("ISR                    IPL  Worst(B)")
+    for name, ipl, cost, path in isr_rows:
+        print("%-22s %3s  %8d" % (name, "?" if ipl is None else ipl, cost))
+        if args.verbose:
+            print("    " + " > ".join(path))
+    print("Deepest nesting chain: %s = %d B" % (" > ".join(chain) or "(none)", isr_bytes))
+    print()
+
+    print("Task   Entry                 Size(B)  Path(B)  Ctx(B)  ISR(B)  Total(B)  Margin(B)")
+    over = False
+    for name, entry, words in tasks:
+        size = words * args.word_bytes
+        depth, path = analyzer.worst(entry)
+        total = depth + args.context_bytes + isr_bytes
+        margin = size - total
+        flag = ""
+        if entry not in graph.frames:
+            flag = "  (no frame info)"
+        elif margin < 0:
+            flag = "  OVER"
+            over = True
+        print("%-6s %-20s %8d %8d %7d %7d %9d %10d%s"
+              % (name, entry, size, depth, args.context_bytes, isr_bytes, total, margin, flag))
+        if args.verbose:
+            print("    " + " > ".join(path))
+
+    warnings = []
+    if analyzer.recursive:
+        warnings.append("recursion (not bounded): " + ", ".join(sorted(analyzer.recursive)))
+    if analyzer.indirect:
+        warnings.append("calls through pointers (not followed): " + ", ".join(sorted(analyzer.indirect)))
+    if graph.dynamic:
+        warnings.append("dynamic frames: " + ", ".join(sorted(graph.dynamic)))
+    if analyzer.unknown:
+        warnings.append("no frame info (counted as 0): " + ", ".join(sorted(analyzer.unknown)))
+    for w in warnings:
+        print("warning: " + w)
+
+    return 1 if over else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,325 @@
+#!/usr/bin/env python3
+"""
+File:   stateprof.py
+Author: ENCM 511
+
+State Profile Driver
+
+Description: Walks the board through every application state over the
+             UART, asks for the per-phase profile (the 'p' key, with
+             STATEPROF_ENABLE set to 1 in FreeRTOSConfig.h) and turns the
+             "@prof" lines into one JSON report. Two reports can be diffed
+             to see what a change cost in each state.
+
+Commands:
+    capture PORT    Drive the board and write the report. Buttons cannot be
+                    pressed from here, so the script says which one to press
+                    and waits for the board to confirm it.
+    report LOG      Build the report from a saved terminal log instead.
+    diff OLD NEW    Compare two reports phase by phase.
+
+Report (per phase):
+    seconds, cpu_percent per task and per ISR ("isr:NAME"), wakeups_per_s,
+    switches_per_s, uart_bytes_per_s, plus stack_peak_bytes per task using
+    the stack sizes from main.c (same parsing as stackstat.py).
+
+    Task percentages include time spent in ISRs that interrupted the task;
+    the ISR rows show that time on its own.
+
+Created on Nov 2025
+"""
+
+import argparse
+import json
+import os
+import sys
+import time
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from stackstat import REPO_ROOT, read_defines, read_tasks  # noqa: E402
+
+#=============================================================================
+# CONFIGURATION
+#=============================================================================
+
+DEFAULT_BAUD = 38400
+DEFAULT_DWELL = 10          # Seconds spent in each phase
+
+PROF_PREFIX = "@prof "
+PROF_END = "@prof end"
+
+# Countdown outlasts READY..PAUSED dwells; PAUSED does not count down
+COUNTDOWN_MARGIN_S = 30
+
+#=============================================================================
+# SERIAL PORT
+#=============================================================================
+
+
+class Port:
+    """Raw tty without pyserial - stdlib only, like the other tools."""
+
+    def __init__(self, path, baud, log=None):
+        import termios
+        import tty
+
+        self.fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+        tty.setraw(self.fd)
+        attrs = termios.tcgetattr(self.fd)
+        speed = getattr(termios, "B%d" % baud)
+        attrs[4] = attrs[5] = speed
+        termios.tcsetattr(self.fd, termios.TCSANOW, attrs)
+        termios.tcflush(self.fd, termios.TCIOFLUSH)
+        self.buf = ""
+        self.log = log
+
+    def close(self):
+        os.close(self.fd)
+
+    def send(self, text):
+        os.write(self.fd, text.encode("ascii"))
+
+    def pump(self, timeout):
+        import select
+
+        ready, _, _ = select.select([self.fd], [], [], timeout)
+        if ready:
+            data = os.read(self.fd, 256).decode("ascii", "replace")
+            self.buf += data
+            if self.log:
+                self.log.write(data)
+                self.log.flush()
+
+    def expect(self, text, timeout):
+        """Wait for text; drop everything up to and including it."""
+        deadline = time.time() + timeout
+        while text not in self.buf:
+            left = deadline - time.time()
+            if left <= 0:
+                raise TimeoutError("board did not print %r" % text)
+            self.pump(min(left, 0.2))
+        self.buf = self.buf.split(text, 1)[1]
+
+    def drain(self, seconds):
+        deadline = time.time() + seconds
+        while time.time() < deadline:
+            self.pump(deadline - time.time())
+        self.buf = self.buf[-256:]
+
+
+#=============================================================================
+# CAPTURE
+#=============================================================================
+
+
+def prompt(message):
+    print(">>> " + message, flush=True)
+
+
+def capture(port, dwell):
+    """Visit every phase once, dwelling in each, then fetch the profile."""
+    seconds = dwell * 2 + COUNTDOWN_MARGIN_S
+    wait = dwell + 30           # Time allowed for a human to press a button
+
+    print("WAITING: %d s" % dwell, flush=True)
+    port.drain(dwell)
+
+    prompt("press PB1")
+    port.expect("Enter countdown time", wait)
+    print("TIME_INPUT: %d s" % dwell, flush=True)
+    port.drain(dwell)
+    port.send("%02d:%02d\r" % (seconds // 60, seconds % 60))
+    port.expect("Time set!", 5)
+
+    print("READY: %d s" % dwell, flush=True)
+    port.drain(dwell)
+    prompt("press PB2+PB3 together")
+    port.expect("[COUNTDOWN STARTED]", wait)
+
+    print("COUNTDOWN: %d s" % (dwell // 2), flush=True)
+    port.drain(dwell // 2)
+    port.send("i")
+    port.expect("[INFO MODE ON]", 5)
+    print("COUNTDOWN_I: %d s" % (dwell // 2), flush=True)
+    port.drain(dwell // 2)
+    port.send("i")
+    port.expect("[INFO MODE OFF]", 5)
+
+    prompt("click PB3 (pause)")
+    port.expect("[PAUSED]", wait)
+    print("PAUSED: %d s" % dwell, flush=True)
+    port.drain(dwell)
+    prompt("click PB3 (resume)")
+    port.expect("[RESUMED]", wait)
+
+    print("waiting for the countdown to finish", flush=True)
+    port.expect("The countdown is done.", seconds + 10)
+    port.drain(4)               # COMPLETED lasts 5 s
+
+    port.send("p")
+    port.expect(PROF_END, 10)
+
+
+#=============================================================================
+# REPORT
+#=============================================================================
+
+
+def parse_lines(text):
+    """Return the JSON objects from the last complete profile in text."""
+    last = None
+    records = []
+    for line in text.splitlines():
+        line = line.strip()
+        start = line.find(PROF_PREFIX)
+        if start < 0:
+            continue
+        line = line[start:]
+        if line == PROF_END:
+            last = records or last
+            records = []
+            continue
+        try:
+            records.append(json.loads(line[len(PROF_PREFIX):]))
+        except ValueError:
+            pass                # Partial line from the start of the log
+    if last is None:
+        raise ValueError("no complete @prof report found")
+    return last
+
+
+def stack_sizes(root):
+    defines = read_defines(root)
+    return {name: words for name, _, words in read_tasks(root, defines)}
+
+
+def build_report(records, root):
+    header = next(r for r in records if "tasks" in r)
+    stacks = next((r for r in records if "stack_free_words" in r), None)
+    per_ms = float(header["counts_per_ms"])
+    tasks = header["tasks"]
+    isrs = header["isrs"]
+
+    phases = {}
+    for r in records:
+        if "phase" not in r:
+            continue
+        ms = r["ms"]
+        secs = ms / 1000.0
+        cpu = {}
+        if ms:
+            for name, counts in zip(tasks, r["task"]):
+                cpu[name] = round(100.0 * counts / per_ms / ms, 2)
+            for name, counts in zip(isrs, r["isr"]):
+                cpu["isr:" + name] = round(100.0 * counts / per_ms / ms, 2)
+        phases[r["phase"]] = {
+            "seconds": round(secs, 3),
+            "cpu_percent": cpu,
+            "wakeups_per_s": round(r["wakeups"] / secs, 1) if ms else 0,
+            "switches_per_s": round(r["switches"] / secs, 1) if ms else 0,
+            "uart_bytes_per_s": round(r["uart_bytes"] / secs, 1) if ms else 0,
+        }
+
+    report = {"phases": phases}
+    if stacks:
+        sizes = stack_sizes(root)
+        word = stacks["stack_word_bytes"]
+        peak = {}
+        for name, free in zip(tasks, stacks["stack_free_words"]):
+            if name in sizes:
+                peak[name] = (sizes[name] - free) * word
+        report["stack_peak_bytes"] = peak
+    return report
+
+
+#=============================================================================
+# DIFF
+#=============================================================================
+
+
+def diff(old, new):
+    rows = []
+    for phase in new["phases"]:
+        a = old["phases"].get(phase)
+        b = new["phases"][phase]
+        if a is None:
+            continue
+        for key in ("wakeups_per_s", "switches_per_s", "uart_bytes_per_s"):
+            rows.append((phase, key, a[key], b[key]))
+        for name in sorted(set(a["cpu_percent"]) | set(b["cpu_percent"])):
+            rows.append((phase, "cpu% " + name,
+                         a["cpu_percent"].get(name, 0), b["cpu_percent"].get(name, 0)))
+    for name in sorted(new.get("stack_peak_bytes", {})):
+        rows.append(("-", "stack " + name,
+                     old.get("stack_peak_bytes", {}).get(name, 0),
+                     new["stack_peak_bytes"][name]))
+
+    print("%-12s %-22s %10s %10s %10s" % ("Phase", "Metric", "Old", "New", "Change"))
+    for phase, key, a, b in rows:
+        if a == b:
+            continue
+        print("%-12s %-22s %10s %10s %+10.2f" % (phase, key, a, b, b - a))
+
+
+#=============================================================================
+# MAIN
+#=============================================================================
+
+
+def write_report(report, path):
+    text = json.dumps(report, indent=2, sort_keys=True)
+    if path:
+        with open(path, "w") as f:
+            f.write(text + "\n")
+    else:
+        print(text)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Per-state CPU/wake-up/UART profile.")
+    parser.add_argument("--root", default=REPO_ROOT, help="project root (main.c, app.h, ...)")
+    sub = parser.add_subparsers(dest="cmd", required=True)
+
+    p = sub.add_parser("capture", help="drive the board and build a report")
+    p.add_argument("port", help="serial device, e.g. /dev/ttyUSB0")
+    p.add_argument("--baud", type=int, default=DEFAULT_BAUD)
+    p.add_argument("--dwell", type=int, default=DEFAULT_DWELL, help="seconds per phase")
+    p.add_argument("--log", help="also save the raw terminal output here")
+    p.add_argument("-o", "--output", help="report file (default: stdout)")
+
+    p = sub.add_parser("report", help="build a report from a terminal log")
+    p.add_argument("log")
+    p.add_argument("-o", "--output", help="report file (default: stdout)")
+
+    p = sub.add_parser("diff", help="compare two reports")
+    p.add_argument("old")
+    p.add_argument("new")
+
+    args = parser.parse_args()
+
+    if args.cmd == "capture":
+        log_path = args.log or (args.output or "stateprof") + ".log"
+        with open(log_path, "w") as log:
+            port = Port(args.port, args.baud, log)
+            try:
+                capture(port, args.dwell)
+            finally:
+                port.close()
+        with open(log_path, errors="replace") as f:
+            records = parse_lines(f.read())
+        write_report(build_report(records, args.root), args.output)
+    elif args.cmd == "report":
+        with open(args.log, errors="replace") as f:
+            records = parse_lines(f.read())
+        write_report(build_report(records, args.root), args.output)
+    else:
+        with open(args.old) as f:
+            old = json.load(f)
+        with open(args.new) as f:
+            new = json.load(f)
+        diff(old, new)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
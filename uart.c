@@ -7,32 +7,70 @@
 
 
 #include "uart.h"
+#include "hw_config.h"
+#include "FreeRTOS.h"
+
+/* Baud rate generator with BRGH = 1 */
+#define UART_FCY                ((unsigned long)configCPU_CLOCK_HZ)
+#define UART_BRG_VALUE          ((UART_FCY + 2UL * UART_BAUD_RATE) / (4UL * UART_BAUD_RATE) - 1UL)
+#define UART_ACTUAL_BAUD        (UART_FCY / (4UL * (UART_BRG_VALUE + 1UL)))
+#define UART_BAUD_DIFF          ((UART_ACTUAL_BAUD > UART_BAUD_RATE) ? \
+                                 (UART_ACTUAL_BAUD - UART_BAUD_RATE) : (UART_BAUD_RATE - UART_ACTUAL_BAUD))
+
+/* Fails to compile if UART_BAUD_RATE is more than 2% off at this FCY */
+typedef char uart_baud_rate_check[(UART_BAUD_DIFF * 50UL <= UART_BAUD_RATE &&
+                                   UART_BRG_VALUE <= 0xFFFFUL) ? 1 : -1];
+
+/* PPS output function numbers */
+#define PPS_OUT_U2TX            5
+#define PPS_OUT_U2RTS           6
+
+/* RPORx field for pin RPn, e.g. PPS_OUT(10) -> _RP10R */
+#define PPS_OUT_(rp)            _RP ## rp ## R
+#define PPS_OUT(rp)             PPS_OUT_(rp)
 
 uint8_t received_char = 0;
 uint8_t RXFlag = 0;
 
+volatile UartRxStats_t uart2_rx_stats = {0};
+
+static uint8_t rx_idle_ticks = 0;
+
 void InitUART2(void) 
 {
+    /* Peripheral pin select (see UART CONFIGURATION in hw_config.h) */
+    RPINR19bits.U2RXR = UART_RX_RP;
+    PPS_OUT(UART_TX_RP) = PPS_OUT_U2TX;
 
-    RPINR19bits.U2RXR = 11; // ??????????????????????
-    RPOR5bits.RP10R = 5;    // ??????????????????????
+    U2MODE = 0b0000000010001000;    /* WAKE, BRGH = 1, 8N1 */
 
-    U2MODE = 0b0000000010001000;
+#if UART_FLOW_CONTROL
+    UART_CTS_Init_Pin();
+    UART_RTS_Init_Pin();
+    RPINR19bits.U2CTSR = UART_CTS_RP;
+    PPS_OUT(UART_RTS_RP) = PPS_OUT_U2RTS;
 
-    U2BRG = 103;            // ??????????????????????
+    /* TX, RX, CTS and RTS in use; RTS in flow control mode: the hardware
+     * holds transmission while CTS is high and raises RTS while the RX
+     * FIFO is full, so neither side drops bytes */
+    U2MODEbits.RTSMD = 0;
+    U2MODEbits.UEN = 0b10;
+#endif
+
+    U2BRG = (uint16_t)UART_BRG_VALUE;
     
 	U2STAbits.UTXISEL0 = 0;
     U2STAbits.UTXISEL1 = 0;
     U2STAbits.URXEN = 1;
     U2STAbits.UTXEN = 1;
-    U2STAbits.URXISEL = 0b00;
+    U2STAbits.URXISEL = UART_RX_ISEL;
 
 	IFS1bits.U2TXIF = 0;	
     IPC7bits.U2TXIP = 3; 
     
 	IEC1bits.U2TXIE = 1; 
 	IFS1bits.U2RXIF = 0; 
-	IPC7bits.U2RXIP = 4; 
+	IPC7bits.U2RXIP = configKERNEL_INTERRUPT_PRIORITY;  /* Calls FromISR APIs */
     IEC1bits.U2RXIE = 1;
 
 	U2MODEbits.UARTEN = 1;	
@@ -41,33 +79,114 @@ void InitUART2(void)
 	return;
 }
 
-void Disp2String(char *str) //Displays String of characters
+/************************************************************************
+ * Pop one byte from the UART2 RX FIFO
+ * Description: Called in a loop by the RX ISR until it returns 0, so every
+ * byte in the 4-deep FIFO is taken per interrupt. FERR/PERR describe the
+ * byte at the top of the FIFO and are checked before it is read; such bytes
+ * are counted and discarded. OERR is only cleared once the FIFO is empty,
+ * since clearing it resets the FIFO and would throw away the bytes that
+ * were received before the overrun.
+ ************************************************************************/
+uint8_t UART2_RxPop(char *out)
 {
-    unsigned int i;
-    for (i=0; i<= strlen(str); i++)
-    {
-        XmitUART2(str[i],1);
+    while (U2STAbits.URXDA) {
+        uint8_t ferr = U2STAbits.FERR;
+        uint8_t perr = U2STAbits.PERR;
+        char c = U2RXREG;
+
+        if (ferr) {
+            uart2_rx_stats.framing_errors++;
+        } else if (perr) {
+            uart2_rx_stats.parity_errors++;
+        } else {
+            uart2_rx_stats.bytes++;
+            *out = c;
+            return 1;
+        }
     }
 
-    return;
+    if (U2STAbits.OERR) {
+        uart2_rx_stats.overruns++;
+        U2STAbits.OERR = 0;
+    }
+    return 0;
+}
+
+/************************************************************************
+ * RX idle timeout, called once per RTOS tick
+ * Description: With URXISEL above "any character" the hardware does not
+ * interrupt for the last one or two bytes of a burst (e.g. a single
+ * keypress). If bytes are waiting and the receiver has been idle for
+ * UART_RX_IDLE_TICKS, raise U2RXIF in software so the ISR drains them.
+ ************************************************************************/
+void UART2_RxIdleTick(void)
+{
+    if (U2STAbits.URXDA && U2STAbits.RIDLE) {
+        if (++rx_idle_ticks >= UART_RX_IDLE_TICKS) {
+            rx_idle_ticks = 0;
+            IFS1bits.U2RXIF = 1;
+        }
+    } else {
+        rx_idle_ticks = 0;
+    }
+}
+
+void UART2_GetRxStats(UartRxStats_t *out)
+{
+    uint16_t saved_ipl;
+
+    /* Snapshot all counters without an RX interrupt in between */
+    SET_AND_SAVE_CPU_IPL(saved_ipl, 7);
+    out->bytes = uart2_rx_stats.bytes;
+    out->interrupts = uart2_rx_stats.interrupts;
+    out->overruns = uart2_rx_stats.overruns;
+    out->framing_errors = uart2_rx_stats.framing_errors;
+    out->parity_errors = uart2_rx_stats.parity_errors;
+    RESTORE_CPU_IPL(saved_ipl);
+}
+
+/************************************************************************
+ * Polled bulk transmit
+ * Description: Loads U2TXREG for as long as the 4-deep TX FIFO has room,
+ * then waits for room again, so the FIFO and the shift register stay full
+ * for the whole block. UTXEN is set once by InitUART2() and left alone -
+ * clearing it would abort the byte in the shift register and would also
+ * stop the DMA engine that feeds the same transmitter.
+ ************************************************************************/
+void UART2_Write(const char *data, uint16_t len)
+{
+    while (len > 0) {
+        while (U2STAbits.UTXBF) {
+        }
+        while (len > 0 && !U2STAbits.UTXBF) {
+            U2TXREG = *data++;
+            len--;
+        }
+    }
+}
+
+void UART2_WriteStr(UartStr_t s)
+{
+    UART2_Write(s.str, s.len);
+}
+
+void Disp2String(const char *str) //Displays String of characters
+{
+    /* One strlen() per call; the NUL terminator is not sent */
+    UART2_Write(str, (uint16_t)strlen(str));
 }
 
 void XmitUART2(char CharNum, unsigned int repeatNo)
-{	
-	U2STAbits.UTXEN = 1;
-	while(repeatNo!=0) 
-	{
-		while(U2STAbits.UTXBF==1)   // We loop here because.... 
-		{
-		}	
-		U2TXREG=CharNum;            // We put XXXXXX here because .....
-		repeatNo--;
-	}
-	while(U2STAbits.TRMT==0)        // We check XXXXX because .........
-	{
-	}
-
-    U2STAbits.UTXEN = 0;
+{
+    while (repeatNo != 0) {
+        while (U2STAbits.UTXBF) {
+        }
+        while (repeatNo != 0 && !U2STAbits.UTXBF) {
+            U2TXREG = CharNum;
+            repeatNo--;
+        }
+    }
 }
 
 /************************************************************************
@@ -63,8 +63,52 @@
 // TODO Insert declarations or function prototypes (right here) to leverage 
 // live documentation
 
+/* RX interrupt threshold (U2STA.URXISEL). The ISR drains the whole FIFO,
+ * so interrupting at 3 of 4 bytes leaves one byte plus the shift register
+ * of slack before an overrun. Fewer bytes are picked up by the idle check. */
+#define UART_RX_ISEL_ANY        0b00    /* Every character */
+#define UART_RX_ISEL_3_4        0b10    /* FIFO 3/4 full (3 characters) */
+#define UART_RX_ISEL_FULL       0b11    /* FIFO full (4 characters) */
+#define UART_RX_ISEL            UART_RX_ISEL_3_4
+
+/* Ticks the line must stay idle with bytes below the threshold before
+ * UART2_RxIdleTick() forces an RX interrupt */
+#define UART_RX_IDLE_TICKS      2
+
+/* RX counters, updated from the RX ISR */
+typedef struct {
+    uint16_t bytes;             /* Bytes delivered */
+    uint16_t interrupts;        /* RX interrupts taken */
+    uint16_t overruns;          /* OERR events (one byte lost each) */
+    uint16_t framing_errors;    /* Bytes discarded with FERR set */
+    uint16_t parity_errors;     /* Bytes discarded with PERR set */
+} UartRxStats_t;
+
+extern volatile UartRxStats_t uart2_rx_stats;
+
+/* Length-aware string view. Output functions take a pointer and a length,
+ * so nothing calls strlen() per character and the terminating NUL is never
+ * sent. UART_STR() takes a string literal only and gets its length from
+ * sizeof at compile time. */
+typedef struct {
+    const char *str;
+    uint16_t len;
+} UartStr_t;
+
+#define UART_STR(lit)           ((UartStr_t){ ("" lit), (uint16_t)(sizeof(lit) - 1) })
+
 void InitUART2(void);
-void Disp2String(char *str);
+uint8_t UART2_RxPop(char *out);
+void UART2_RxIdleTick(void);
+void UART2_GetRxStats(UartRxStats_t *out);
+
+/* Polled transmit. Each pass tops up the TX FIFO until UTXBF is set, and
+ * the transmitter is left enabled. Only for use while nothing else owns
+ * the transmitter (before UartDma_Init(), or from a fault handler after
+ * UartDma_Abort()). */
+void UART2_Write(const char *data, uint16_t len);
+void UART2_WriteStr(UartStr_t s);
+void Disp2String(const char *str);
 void XmitUART2(char CharNum, unsigned int repeatNo);
 void RecvUart(char* input, uint8_t buf_size);
 char RecvUartChar(void);
@@ -0,0 +1,190 @@
+/*
+ * File:   uart_dma.c
+ * Author: ENCM 511
+ *
+ * DMA-Driven UART2 Transmit Implementation
+ *
+ * Description: DMA channel 0 runs in one-shot mode, byte sized, source
+ *              incrementing, destination fixed at U2TXREG. With UTXISEL = 00
+ *              the UART raises a TX event each time a byte moves from the
+ *              FIFO to the shift register, and each event moves one more
+ *              byte, so the FIFO is never overfilled. A block that starts
+ *              while a byte is still in the FIFO is started by that byte's
+ *              TX event; only an idle transmitter needs the first byte
+ *              requested with CHREQ. A request on top of a coming event
+ *              would add a byte to the FIFO for every chained block until
+ *              it overflowed.
+ *
+ * Slots:
+ *   - xDmaSlots counts free slots (two). WaitSlot() takes one, the
+ *     completion ISR (or an empty Submit()) gives one back.
+ *   - dma_active/dma_pending are only changed with the IPL raised above
+ *     UART_DMA_IPL, so Submit() and the ISR never race on them.
+ *
+ * Missed events:
+ *   - If the completion ISR is held off until the FIFO's last byte has
+ *     moved on (longer than one byte time, e.g. behind a flash erase), the
+ *     event that would start the next block came while the channel was
+ *     off. UartDma_TxStallTick() finds the channel enabled with the
+ *     transmitter idle and requests the byte.
+ *
+ * Created on Nov 2025
+ */
+
+#include "uart_dma.h"
+#include "task.h"
+#include "semphr.h"
+#include "heapstat.h"
+#include "stateprof.h"
+#include <xc.h>
+
+/*============================================================================
+ * CONFIGURATION CONSTANTS
+ *============================================================================*/
+
+/* Data RAM window the DMA controller may access (SFRs are always allowed):
+ * the 16 KB of RAM on the PIC24FJ256GA702, 0x0800-0x47FF */
+#define UART_DMA_RAM_START      0x0800
+#define UART_DMA_RAM_END        0x47FF
+
+/*============================================================================
+ * STATIC VARIABLES
+ *============================================================================*/
+
+typedef struct {
+    const uint8_t *data;
+    uint16_t len;
+} DmaBlock_t;
+
+static SemaphoreHandle_t xDmaSlots = NULL;
+
+static volatile bool dma_active = false;
+static volatile bool dma_has_pending = false;
+static DmaBlock_t dma_pending;
+
+/*============================================================================
+ * STATIC HELPER FUNCTIONS
+ *============================================================================*/
+
+/**
+ * @brief Load a block into channel 0 and start it
+ *
+ * Called with the IPL at or above UART_DMA_IPL.
+ */
+static void StartBlock(const uint8_t *data, uint16_t len)
+{
+    DMASRC0 = (uint16_t)data;
+    DMACNT0 = len;
+    DMACH0bits.CHEN = 1;
+    if (U2STAbits.TRMT) {
+        DMACH0bits.CHREQ = 1;  /* First byte; the UART triggers the rest */
+    }
+    dma_active = true;
+}
+
+/*============================================================================
+ * INTERRUPT SERVICE ROUTINE
+ *============================================================================*/
+
+void __attribute__((interrupt, no_auto_psv)) _DMA0Interrupt(void)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    STATEPROF_ISR_ENTER();
+
+    DMAINT0bits.DONEIF = 0;
+    IFS0bits.DMA0IF = 0;
+
+    if (dma_has_pending) {
+        dma_has_pending = false;
+        StartBlock(dma_pending.data, dma_pending.len);
+    } else {
+        dma_active = false;
+    }
+
+    xSemaphoreGiveFromISR(xDmaSlots, &xHigherPriorityTaskWoken);
+    STATEPROF_ISR_EXIT(STATEPROF_ISR_DMA0);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+/*============================================================================
+ * PUBLIC FUNCTION IMPLEMENTATIONS
+ *============================================================================*/
+
+void UartDma_Init(void)
+{
+    xDmaSlots = xSemaphoreCreateCounting(2, 2);
+    HeapStat_Name(xDmaSlots, "DMA");
+
+    /* CPU no longer services TX; the event still triggers the DMA */
+    IEC1bits.U2TXIE = 0;
+    U2STAbits.UTXEN = 1;
+
+    DMACONbits.DMAEN = 1;
+    DMACONbits.PRSSEL = 0;      /* Fixed channel priority */
+    DMAL = UART_DMA_RAM_START;
+    DMAH = UART_DMA_RAM_END;
+
+    DMACH0 = 0;
+    DMACH0bits.SIZE = 1;        /* Byte transfers */
+    DMACH0bits.TRMODE = 0b00;   /* One-shot */
+    DMACH0bits.SAMODE = 0b01;   /* Source increments */
+    DMACH0bits.DAMODE = 0b00;   /* Destination fixed */
+    DMADST0 = (uint16_t)&U2TXREG;
+
+    DMAINT0 = 0;
+    DMAINT0bits.CHSEL = UART_DMA_TRIG_U2TX;
+
+    IFS0bits.DMA0IF = 0;
+    IPC1bits.DMA0IP = UART_DMA_IPL;
+    IEC0bits.DMA0IE = 1;
+}
+
+bool UartDma_WaitSlot(TickType_t xTicksToWait)
+{
+    return xSemaphoreTake(xDmaSlots, xTicksToWait) == pdTRUE;
+}
+
+void UartDma_Submit(const uint8_t *data, uint16_t len)
+{
+    uint16_t saved_ipl;
+
+    if (len == 0) {
+        xSemaphoreGive(xDmaSlots);
+        return;
+    }
+
+    SET_AND_SAVE_CPU_IPL(saved_ipl, 7);
+    if (dma_active) {
+        /* A free slot while active means the pending slot is empty */
+        dma_pending.data = data;
+        dma_pending.len = len;
+        dma_has_pending = true;
+    } else {
+        StartBlock(data, len);
+    }
+    RESTORE_CPU_IPL(saved_ipl);
+
+    STATEPROF_UART_BYTES(len);
+}
+
+void UartDma_Abort(void)
+{
+    IEC0bits.DMA0IE = 0;
+    DMACH0bits.CHEN = 0;
+    dma_active = false;
+    dma_has_pending = false;
+}
+
+void UartDma_TxStallTick(void)
+{
+    /* Bytes left but nothing in the transmitter to raise the next event */
+    if (dma_active && DMACH0bits.CHEN && U2STAbits.TRMT) {
+        DMACH0bits.CHREQ = 1;
+    }
+}
+
+bool UartDma_IsIdle(void)
+{
+    /* TRMT covers the TX FIFO and the shift register after the DMA is done */
+    return !dma_active && !dma_has_pending && U2STAbits.TRMT;
+}
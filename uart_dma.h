@@ -0,0 +1,100 @@
+/*
+ * File:   uart_dma.h
+ * Author: ENCM 511
+ *
+ * DMA-Driven UART2 Transmit Header
+ *
+ * Description: Feeds U2TXREG from RAM with DMA channel 0, triggered by the
+ *              UART2 TX interrupt event, so the CPU takes one interrupt per
+ *              block instead of one per byte. Blocks are double-buffered:
+ *              while one is in flight a second can be queued, and the DMA
+ *              completion ISR starts it immediately.
+ *
+ * Buffer ownership (zero-copy):
+ *   - UartDma_Submit() does not copy. The caller must leave the buffer
+ *     untouched until the block has been sent.
+ *   - A block needs one of two slots, taken with UartDma_WaitSlot() before
+ *     the buffer is filled. Blocks complete in order, so once WaitSlot()
+ *     returns, at most the block submitted last is still outstanding. A
+ *     writer alternating between two buffers can therefore refill the one
+ *     it submitted two calls ago.
+ *
+ * Created on Nov 2025
+ */
+
+#ifndef UART_DMA_H
+#define UART_DMA_H
+
+#include "FreeRTOS.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/*============================================================================
+ * CONFIGURATION
+ *============================================================================*/
+
+/* DMA channel trigger source for "UART2 transmit" (DMAINTn.CHSEL) */
+#define UART_DMA_TRIG_U2TX      0x0C
+
+/* Interrupt priority of the DMA0 completion interrupt. It gives xDmaSlots,
+ * so it must not run above the kernel (see FreeRTOSConfig.h). */
+#define UART_DMA_IPL            configKERNEL_INTERRUPT_PRIORITY
+
+/*============================================================================
+ * FUNCTION PROTOTYPES
+ *============================================================================*/
+
+/**
+ * @brief Configure DMA channel 0 for UART2 transmit
+ *
+ * Must be called after InitUART2(). Leaves the transmitter enabled and
+ * disables the (now unused) U2TX CPU interrupt.
+ */
+void UartDma_Init(void);
+
+/**
+ * @brief Take a slot for the next block
+ *
+ * Blocks up to xTicksToWait while two blocks are already outstanding.
+ * Every successful call must be followed by one UartDma_Submit().
+ *
+ * @param xTicksToWait Maximum time to wait for a free slot
+ * @return true if a slot was taken
+ */
+bool UartDma_WaitSlot(TickType_t xTicksToWait);
+
+/**
+ * @brief Queue a block in the slot taken by UartDma_WaitSlot()
+ *
+ * Does not block or copy.
+ *
+ * @param data Bytes to send (must stay valid until sent, see above)
+ * @param len Number of bytes; 0 sends nothing and gives the slot back
+ */
+void UartDma_Submit(const uint8_t *data, uint16_t len);
+
+/**
+ * @brief Stop channel 0 and forget both blocks, for a fault report
+ *
+ * Call with interrupts masked; UART2_Write() then owns the transmitter.
+ * Bytes already in the TX FIFO still go out first.
+ */
+void UartDma_Abort(void);
+
+/**
+ * @brief Restart a block whose first TX event was missed
+ *
+ * Call once per tick from the tick hook (same IPL as the DMA interrupt).
+ */
+void UartDma_TxStallTick(void);
+
+/**
+ * @brief Check that nothing is queued, in flight or still shifting out
+ *
+ * Does not block; for the sleep decision (any context).
+ *
+ * @return true if the DMA engine and the UART transmitter are both idle
+ */
+bool UartDma_IsIdle(void);
+
+#endif /* UART_DMA_H */
@@ -0,0 +1,105 @@
+/*
+ * File:   winagg.c
+ * Author: ENCM 511
+ *
+ * Windowed Aggregation Implementation
+ *
+ * Description: Running sums per window; closing a window is a struct
+ *              copy, so it is cheap enough for the producing ISR. The
+ *              64-bit divisions happen in WinAgg_Take().
+ *
+ * Created on Nov 2025
+ */
+
+#include "winagg.h"
+#include <xc.h>
+
+/*============================================================================
+ * STATIC HELPER FUNCTIONS
+ *============================================================================*/
+
+static void OpenWindow(WinAgg_t *agg, int16_t x, TickType_t now)
+{
+    agg->start = now;
+    agg->open.count = 0;
+    agg->open.min = x;
+    agg->open.max = x;
+    agg->open.offset = x;
+    agg->open.sum = 0;
+    agg->open.sum_sq = 0;
+}
+
+/*============================================================================
+ * PUBLIC FUNCTION IMPLEMENTATIONS
+ *============================================================================*/
+
+void WinAgg_Init(WinAgg_t *agg, uint16_t window_ms)
+{
+    agg->window_ms = window_ms;
+    agg->window = pdMS_TO_TICKS(window_ms);
+    agg->open.count = 0;
+    agg->ready = false;
+}
+
+void WinAgg_Add(WinAgg_t *agg, int16_t x, TickType_t now)
+{
+    int32_t d;
+    uint32_t magnitude;
+
+    if (agg->open.count == 0) {
+        OpenWindow(agg, x, now);
+    } else if ((TickType_t)(now - agg->start) >= agg->window ||
+               agg->open.count == 0xFFFF) {
+        agg->closed = agg->open;
+        agg->ready = true;
+        OpenWindow(agg, x, now);
+    }
+
+    d = (int32_t)x - agg->open.offset;
+    agg->open.count++;
+    agg->open.sum += d;
+    magnitude = (uint32_t)((d < 0) ? -d : d);
+    agg->open.sum_sq += magnitude * magnitude;
+    if (x < agg->open.min) {
+        agg->open.min = x;
+    }
+    if (x > agg->open.max) {
+        agg->open.max = x;
+    }
+}
+
+bool WinAgg_Take(WinAgg_t *agg, WinAggSummary_t *out)
+{
+    WinAggSums_t s;
+    uint16_t saved_ipl;
+    int64_t sum;
+    uint64_t scatter;
+    int32_t mean_d;
+    bool ready;
+
+    /* Consistent copy; the producer may be an ISR at any IPL */
+    SET_AND_SAVE_CPU_IPL(saved_ipl, 7);
+    ready = agg->ready;
+    s = agg->closed;
+    agg->ready = false;
+    RESTORE_CPU_IPL(saved_ipl);
+
+    if (!ready || s.count == 0) {
+        return false;
+    }
+
+    sum = s.sum;
+    mean_d = (int32_t)((sum >= 0) ? (sum + s.count / 2) / s.count :
+                                    -((-sum + s.count / 2) / s.count));
+    /* sum((x - mean)^2) = sum(d^2) - sum(d)^2 / n; the quotient is rounded
+     * up so the scatter, and the variance after it, round down */
+    scatter = s.sum_sq - ((uint64_t)(sum * sum) + s.count - 1) / s.count;
+
+    out->window_ms = agg->window_ms;
+    out->count = s.count;
+    out->min = s.min;
+    out->max = s.max;
+    out->mean = (int16_t)(s.offset + mean_d);
+    out->variance = (uint32_t)(scatter / s.count);
+    return true;
+}
@@ -0,0 +1,97 @@
+/*
+ * File:   winagg.h
+ * Author: ENCM 511
+ *
+ * Windowed Aggregation Header
+ *
+ * Description: Streaming min/max/mean/variance/count over fixed time
+ *              windows, so a metric sampled at 100 Hz can be reported as
+ *              one summary per window instead of every sample (or one
+ *              sample per second). Memory per metric is constant: running
+ *              sums for the open window and a snapshot of the last closed
+ *              one.
+ *
+ * Arithmetic:
+ *   - Samples are stored as x - (first sample of the window), so the
+ *     sums stay small for slowly changing values. WinAgg_Add() is one
+ *     compare pair, a 32-bit multiply for the square, a 64-bit add into
+ *     sum_sq and a few 32-bit adds.
+ *   - Mean and variance (population, divide by count) are only worked
+ *     out in WinAgg_Take(), in task context.
+ *   - Limits per window: at most 65535 samples, and count x spread must
+ *     stay below 2^31.
+ *
+ * Concurrency:
+ *   - One producer per aggregator (an ISR, the tick hook or a task).
+ *   - A window closes on the first sample at or after its end; the
+ *     snapshot is replaced if the consumer has not taken it yet.
+ *   - WinAgg_Take() copies the snapshot at IPL 7 (see FreeRTOSConfig.h),
+ *     so the producer may be any ISR.
+ *
+ * Created on Nov 2025
+ */
+
+#ifndef WINAGG_H
+#define WINAGG_H
+
+#include "FreeRTOS.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/*============================================================================
+ * TYPE DEFINITIONS
+ *============================================================================*/
+
+/* One closed window */
+typedef struct {
+    uint16_t window_ms;
+    uint16_t count;
+    int16_t min;
+    int16_t max;
+    int16_t mean;                   /* Rounded to nearest */
+    uint32_t variance;              /* Population variance, rounded down */
+} WinAggSummary_t;
+
+/* Running sums for one window - contents are private to winagg.c */
+typedef struct {
+    uint16_t count;
+    int16_t min;
+    int16_t max;
+    int16_t offset;                 /* First sample of the window */
+    int32_t sum;                    /* Of x - offset */
+    uint64_t sum_sq;                /* Of (x - offset)^2 */
+} WinAggSums_t;
+
+typedef struct {
+    TickType_t window;              /* Length in ticks */
+    TickType_t start;
+    uint16_t window_ms;
+    WinAggSums_t open;
+    WinAggSums_t closed;
+    volatile bool ready;            /* closed holds an untaken window */
+} WinAgg_t;
+
+/*============================================================================
+ * FUNCTION PROTOTYPES
+ *============================================================================*/
+
+/**
+ * @brief Set the window length; the first sample opens the first window
+ */
+void WinAgg_Init(WinAgg_t *agg, uint16_t window_ms);
+
+/**
+ * @brief Add one sample (producer only, any context)
+ *
+ * @param now Tick count at the sample
+ */
+void WinAgg_Add(WinAgg_t *agg, int16_t x, TickType_t now);
+
+/**
+ * @brief Take the last closed window, if there is a new one (task context)
+ *
+ * @return false if no window has closed since the last call
+ */
+bool WinAgg_Take(WinAgg_t *agg, WinAggSummary_t *out);
+
+#endif /* WINAGG_H */